@@ -13,6 +13,9 @@
         return [Number(a) || 0, Number(b) || 0, Number(c) || 0];
     }
 
+    // Callbacks of createModelAsync by entity id, called once from __ogleModelReady.
+    var modelReadyCallbacks = {};
+
     var ogle = {
         log: global.log.log.bind(global.log),
 
@@ -30,6 +33,25 @@
                 var radius = Number(options.radius) || 0.5;
                 return global.world.createSphere(options.name || 'Sphere', pos, radius);
             },
+            // hierarchy: true keeps the file's node tree as child entities sharing meshes.
+            createModel: function (options) {
+                options = options || {};
+                if (options.hierarchy) {
+                    return global.world.createModelHierarchy(options.name || 'Model', String(options.path || ''));
+                }
+                return global.world.createModel(options.name || 'Model', String(options.path || ''));
+            },
+            // Returns the entity at once (a placeholder cube until the mesh is uploaded).
+            // callback(entityId, success) runs when the import finished; a global
+            // onModelReady(entityId, success) is called for every async import too.
+            createModelAsync: function (options, callback) {
+                options = options || {};
+                var entityId = global.world.createModelAsync(options.name || 'Model', String(options.path || ''));
+                if (typeof callback === 'function') {
+                    modelReadyCallbacks[entityId] = callback;
+                }
+                return entityId;
+            },
             createDirectionalLight: function (options) {
                 options = options || {};
                 var rot = options.rotation ? unpackVec3(options.rotation) : [-50, 45, 0];
@@ -53,6 +75,10 @@
             getName: global.entity.getName.bind(global.entity),
             getPosition: global.entity.getPosition.bind(global.entity),
             getRotation: global.entity.getRotation.bind(global.entity),
+            getParent: global.entity.getParent.bind(global.entity),
+            setParent: function (entityId, parentId) {
+                return global.entity.setParent(entityId, parentId == null ? -1 : parentId);
+            },
             setPosition: function (entityId, a, b, c) {
                 var v = unpackVec3(a, b, c);
                 return global.entity.setPosition(entityId, v);
@@ -80,6 +106,18 @@
 
     // Expose the new API wrapper as 'ogle' (lowercase) for scripts to use.
     global.ogle = ogle;
+
+    // Called by ScriptManager::NotifyModelReady.
+    global.__ogleModelReady = function (entityId, success) {
+        var callback = modelReadyCallbacks[entityId];
+        delete modelReadyCallbacks[entityId];
+        if (typeof callback === 'function') {
+            callback(entityId, success);
+        }
+        if (typeof global.onModelReady === 'function') {
+            global.onModelReady(entityId, success);
+        }
+    };
     
     // The original C++ binding creates a global 'OGLE' (uppercase).
     // The old_startup script uses 'ogle' (lowercase).
@@ -3,29 +3,39 @@ in vec3 vWorldNormal;
 in vec3 vWorldPosition;
 in vec4 vLightSpacePosition;
 in vec2 vTexCoord;
+in float vSelectionMix;
 uniform sampler2D uTexture_diffuse;
 uniform sampler2D uTexture_emissive;
 uniform sampler2D uShadowMap;
 uniform int uHasTexture_diffuse;
 uniform int uHasTexture_emissive;
-uniform int uHasDirectionalLight;
-uniform int uDirectionalLightCastsShadows;
-uniform int uPointLightCount;
-uniform vec3 uBaseColor;
-uniform vec3 uEmissiveColor;
-uniform vec3 uViewPosition;
-uniform vec3 uDirectionalLightDirection;
-uniform vec3 uDirectionalLightColor;
-uniform float uDirectionalLightIntensity;
-uniform vec3 uPointLightPositions[4];
-uniform vec3 uPointLightColors[4];
-uniform float uPointLightIntensities[4];
-uniform float uPointLightRanges[4];
-uniform float uRoughness;
-uniform float uMetallic;
-uniform float uAlphaCutoff;
-uniform vec3 uSelectionTint;
-uniform float uSelectionMix;
+// Submesh material slot tint, multiplied into uBaseColor.
+uniform vec3 uSlotBaseColor = vec3(1.0);
+layout(std140) uniform FrameBlock {
+    mat4 uLightSpaceMatrix;
+    vec3 uViewPosition;
+    int uHasDirectionalLight;
+    vec3 uDirectionalLightDirection;
+    float uDirectionalLightIntensity;
+    vec3 uDirectionalLightColor;
+    int uDirectionalLightCastsShadows;
+    vec3 uSelectionTint;
+    mat4 uViewProjection;
+};
+layout(std140) uniform LightBlock {
+    vec4 uPointLightPositionRange[4];  // xyz: position, w: range
+    vec4 uPointLightColorIntensity[4]; // rgb: color, a: intensity
+    int uPointLightCount;
+};
+layout(std140) uniform MaterialBlock {
+    vec3 uBaseColor;
+    float uRoughness;
+    vec3 uEmissiveColor;
+    float uMetallic;
+    vec2 uUvTiling;
+    vec2 uUvOffset;
+    float uAlphaCutoff;
+};
 out vec4 FragColor;
 
 float ComputeShadowFactor(vec4 lightSpacePosition, vec3 normal, vec3 lightDirection) {
@@ -65,7 +75,7 @@ void main() {
         discard;
     }
 
-    vec3 albedo = uBaseColor * diffuseSample.rgb;
+    vec3 albedo = uBaseColor * uSlotBaseColor * diffuseSample.rgb;
     vec3 emissive = uEmissiveColor;
     if (uHasTexture_emissive == 1) {
         emissive *= texture(uTexture_emissive, vTexCoord).rgb;
@@ -94,9 +104,10 @@ void main() {
     }
 
     for (int i = 0; i < uPointLightCount; ++i) {
-        vec3 toLight = uPointLightPositions[i] - vWorldPosition;
+        vec3 toLight = uPointLightPositionRange[i].xyz - vWorldPosition;
         float distanceToLight = length(toLight);
-        if (distanceToLight > uPointLightRanges[i]) {
+        float range = uPointLightPositionRange[i].w;
+        if (distanceToLight > range) {
             continue;
         }
 
@@ -104,16 +115,16 @@ void main() {
         vec3 halfVector = normalize(lightDirection + viewDirection);
         float diffuse = max(dot(normal, lightDirection), 0.0);
         float specular = pow(max(dot(normal, halfVector), 0.0), shininess) * specularStrength;
-        float attenuation = 1.0 - clamp(distanceToLight / max(uPointLightRanges[i], 0.0001), 0.0, 1.0);
+        float attenuation = 1.0 - clamp(distanceToLight / max(range, 0.0001), 0.0, 1.0);
         attenuation *= attenuation;
         litColor +=
             (albedo * diffuse + vec3(specular)) *
-            uPointLightColors[i] *
-            uPointLightIntensities[i] *
+            uPointLightColorIntensity[i].rgb *
+            uPointLightColorIntensity[i].a *
             attenuation;
     }
 
     litColor += emissive;
-    litColor = mix(litColor, uSelectionTint, uSelectionMix);
+    litColor = mix(litColor, uSelectionTint, vSelectionMix);
     FragColor = vec4(litColor, diffuseSample.a);
 }
\ No newline at end of file
@@ -2,20 +2,58 @@
 layout(location = 0) in vec3 aPosition;
 layout(location = 1) in vec3 aNormal;
 layout(location = 2) in vec2 aTexCoord;
+// Instanced draws: per-instance model matrix and x = selection mix, streamed by the renderer.
+layout(location = 8) in mat4 aInstanceModel;
+layout(location = 12) in vec4 aInstanceParams;
+uniform bool uInstanced;
 uniform mat4 uMVP;
 uniform mat4 uModel;
-uniform mat4 uLightSpaceMatrix;
-uniform vec2 uUvTiling;
-uniform vec2 uUvOffset;
+uniform float uSelectionMix;
+// Blocks shared with default.fs; the CPU side packs them in OpenGLRenderer::UploadFrameUniforms and Material::Bind.
+layout(std140) uniform FrameBlock {
+    mat4 uLightSpaceMatrix;
+    vec3 uViewPosition;
+    int uHasDirectionalLight;
+    vec3 uDirectionalLightDirection;
+    float uDirectionalLightIntensity;
+    vec3 uDirectionalLightColor;
+    int uDirectionalLightCastsShadows;
+    vec3 uSelectionTint;
+    mat4 uViewProjection;
+};
+layout(std140) uniform MaterialBlock {
+    vec3 uBaseColor;
+    float uRoughness;
+    vec3 uEmissiveColor;
+    float uMetallic;
+    vec2 uUvTiling;
+    vec2 uUvOffset;
+    float uAlphaCutoff;
+};
+// Quantized layout: unorm16 position inside the mesh AABB, octahedral normal in xy.
+uniform bool uQuantizedVertices;
+uniform vec3 uPositionOffset;
+uniform vec3 uPositionScale;
 out vec3 vWorldNormal;
 out vec3 vWorldPosition;
 out vec4 vLightSpacePosition;
 out vec2 vTexCoord;
+out float vSelectionMix;
+vec3 DecodeOctahedral(vec2 encoded) {
+    vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float fold = max(-normal.z, 0.0);
+    normal.xy += mix(vec2(fold), vec2(-fold), greaterThanEqual(normal.xy, vec2(0.0)));
+    return normalize(normal);
+}
 void main() {
-    vec4 worldPosition = uModel * vec4(aPosition, 1.0);
-    vWorldNormal = mat3(transpose(inverse(uModel))) * aNormal;
+    vec3 position = uQuantizedVertices ? uPositionOffset + aPosition * uPositionScale : aPosition;
+    vec3 normal = uQuantizedVertices ? DecodeOctahedral(aNormal.xy) : aNormal;
+    mat4 model = uInstanced ? aInstanceModel : uModel;
+    vec4 worldPosition = model * vec4(position, 1.0);
+    vWorldNormal = mat3(transpose(inverse(model))) * normal;
     vWorldPosition = worldPosition.xyz;
     vLightSpacePosition = uLightSpaceMatrix * worldPosition;
     vTexCoord = aTexCoord * uUvTiling + uUvOffset;
-    gl_Position = uMVP * vec4(aPosition, 1.0);
+    vSelectionMix = uInstanced ? aInstanceParams.x : uSelectionMix;
+    gl_Position = uInstanced ? uViewProjection * worldPosition : uMVP * vec4(position, 1.0);
 }
\ No newline at end of file
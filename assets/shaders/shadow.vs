@@ -1,7 +1,14 @@
 #version 330 core
 layout(location = 0) in vec3 aPosition;
+layout(location = 8) in mat4 aInstanceModel; // Instanced draws, see default.vs
+uniform bool uInstanced;
 uniform mat4 uLightMVP;
 uniform mat4 uModel;
+uniform bool uQuantizedVertices;
+uniform vec3 uPositionOffset;
+uniform vec3 uPositionScale;
 void main() {
-    gl_Position = uLightMVP * uModel * vec4(aPosition, 1.0);
+    vec3 position = uQuantizedVertices ? uPositionOffset + aPosition * uPositionScale : aPosition;
+    mat4 model = uInstanced ? aInstanceModel : uModel;
+    gl_Position = uLightMVP * model * vec4(position, 1.0);
 }
\ No newline at end of file
@@ -3,13 +3,27 @@
 #include "Logger.h"
 #include "core/Events.h"
 #include "core/FileSystem.h"
+#include "core/FrameTimeStats.h"
+#include "core/JobSystem.h"
 #include "core/Layer.h"
+#include "models/ImportCache.h"
+#include "models/MeshCache.h"
+#include "models/ModelImportQueue.h"
+#include "render/AnimationLibrary.h"
+#include "world/SystemScheduler.h"
+#ifndef OGLE_HEADLESS
 #include "core/ExampleLayer.h"
+#endif
 #include "opengl/Camera.h"
 #include "ui/IWindow.h"
 #include <glm/vec3.hpp>
 #include <entt/entt.hpp>
+#ifndef OGLE_HEADLESS
 #include <imgui.h>
+#endif
+#include <algorithm>
+#include <chrono>
+#include <iostream>
 #include <string>
 
 // Initialize singleton instance
@@ -30,20 +44,19 @@ public:
 
     void OnUpdate(float deltaTime) override
     {
-        auto& imguiManager = m_app.GetImGuiManager();
-        auto& inputActionsManager = m_app.GetInputActionsManager();
         auto& cameraManager = m_app.GetCameraManager();
-        auto& scriptManager = m_app.GetScriptManager();
-        auto& physicsManager = m_app.GetPhysicsManager();
-        auto& worldManager = m_app.GetWorldManager();    
+        auto& worldManager = m_app.GetWorldManager();
+#ifndef OGLE_HEADLESS
+        auto& inputActionsManager = m_app.GetInputActionsManager();
         inputActionsManager.UpdateCameraControls(cameraManager, deltaTime);
-        scriptManager.Update(deltaTime);
-        physicsManager.Update(deltaTime);
+#endif
+        // Scripts, physics, animation and transforms run through the world's system scheduler.
         worldManager.Update(deltaTime);
 
         cameraManager.Update(deltaTime);
     }
 
+#ifndef OGLE_HEADLESS
     void OnImGuiRender() override
     {
         auto& eventBus = m_app.GetEventBus();
@@ -55,9 +68,10 @@ public:
         auto& configManager = m_app.GetConfigManager();
         auto& renderManager = m_app.GetRenderManager();
 
-        imguiManager.BuildDefaultUi(cameraManager, worldManager, timeManager.GetDeltaTime());
+        imguiManager.BuildDefaultUi(cameraManager, worldManager, timeManager.GetDeltaTime(), renderManager.GetRenderStats());
 
     }
+#endif
 
 private:
     App& m_app;
@@ -92,59 +106,124 @@ void App::InitializeWorldFromConfig()
     }
 }
 
-int App::Run(HINSTANCE hInstance, int nCmdShow)
+void App::RegisterSimulationSystems()
 {
-    if (!m_window || !m_window->Create(hInstance))
-    {
-        LOG_ERROR("Window creation failed");
-        return -1;
-    }
-
-    LOG_INFO("Window created successfully");
-    m_inputManager.AttachToWindow(*m_window);
-    m_inputActionsManager.ConfigureDefaultActions();
-
-    // m_cameraManager.SetPosition(glm::vec3(7.0f, 5.0f, 9.0f));
-    // m_cameraManager.LookAt(glm::vec3(0.0f, 0.0f, 0.0f));
-
-    if (!m_renderManager.Initialize(*m_window, m_cameraManager, m_worldManager)) {
-        return -1;
-    }
-
-    if (!m_imguiManager.Initialize(*m_window)) {
-        LOG_ERROR("ImGui initialization failed");
-        return -1;
-    }
+    // Scripts can touch anything (and create GL resources), so they and the
+    // collision dispatch are exclusive main-thread systems. An exclusive system
+    // conflicts with every other one, so collisions are dispatched last, after
+    // Transforms; otherwise it would sit between Physics and Animation and split
+    // them. Physics (main thread) then shares a stage with Animation (worker).
+    // Transforms changed by collision handlers are applied by the renderer's
+    // UpdateTransforms before the frame is drawn.
+    // Finished background imports are uploaded first, within the frame budget,
+    // so scripts see the swapped-in meshes in the same frame.
+    m_worldManager.RegisterSystem({
+        "AssetUploads",
+        OGLE::SystemOrder::AssetUploads,
+        OGLE::SystemAccess().Exclusive().MainThread(),
+        [this](float) {
+            OGLE::ModelImportQueue::Instance().ProcessUploads(m_configManager.GetConfig().assets.uploadBudgetMs);
+            for (const OGLE::ModelReadyEvent& ready : m_worldManager.GetActiveWorld().TakeReadyModels()) {
+                if (!ready.success) {
+                    LOG_WARN("Async model import failed, placeholder kept: " + ready.path);
+                }
+                m_eventBus.Dispatch(ready);
+            }
+        }
+    });
+    m_worldManager.RegisterSystem({
+        "Scripts",
+        OGLE::SystemOrder::Scripts,
+        OGLE::SystemAccess().Exclusive().MainThread(),
+        [this](float deltaTime) { m_scriptManager.Update(deltaTime); }
+    });
+    m_worldManager.RegisterSystem({
+        "Physics",
+        OGLE::SystemOrder::Physics,
+        OGLE::SystemAccess()
+            .Reads<OGLE::PhysicsBodyComponent>()
+            .Writes<OGLE::TransformComponent, OGLE::TransformDirtyTag>()
+            .MainThread(),
+        [this](float deltaTime) { m_physicsManager.Update(deltaTime); }
+    });
+    m_worldManager.RegisterSystem({
+        "CollisionEvents",
+        OGLE::SystemOrder::CollisionEvents,
+        OGLE::SystemAccess().Exclusive().MainThread(),
+        [this](float) {
+            for (const OGLE::CollisionEvent& collision : m_pendingCollisions) {
+                const auto eidA = static_cast<unsigned int>(entt::to_integral(collision.entityA));
+                const auto eidB = static_cast<unsigned int>(entt::to_integral(collision.entityB));
+                LOG_INFO("Collision detected between entities " + std::to_string(eidA) + " and " + std::to_string(eidB));
+                m_eventBus.Dispatch(collision);
+            }
+            m_pendingCollisions.clear();
+        }
+    });
+}
 
-    // if (!m_editor.Initialize()) {
-    //     LOG_ERROR("Editor initialization failed");
-    //     return -1;
-    // }
-    // m_editor.SetEnabled(m_configManager.GetConfig().editor.enabled);
+bool App::InitializeSimulation()
+{
+    JobSystem::Instance().Initialize();
+
+    const AppConfig::AnimationSettings& animationConfig = m_configManager.GetConfig().animation;
+    OGLE::AnimationCompressionSettings compression;
+    compression.translationTolerance = animationConfig.translationTolerance;
+    compression.rotationTolerance = animationConfig.rotationTolerance;
+    compression.scaleTolerance = animationConfig.scaleTolerance;
+    OGLE::AnimationLibrary::Instance().SetCompressionSettings(compression);
+
+    const AppConfig::MeshOptimizerSettings& meshConfig = m_configManager.GetConfig().meshOptimizer;
+    OGLE::MeshOptimizerSettings meshOptimizer;
+    meshOptimizer.weldVertices = meshConfig.weldVertices;
+    meshOptimizer.optimizeVertexCache = meshConfig.optimizeVertexCache;
+    meshOptimizer.optimizeOverdraw = meshConfig.optimizeOverdraw;
+    meshOptimizer.optimizeVertexFetch = meshConfig.optimizeVertexFetch;
+    meshOptimizer.overdrawThreshold = meshConfig.overdrawThreshold;
+    OGLE::MeshCache::Instance().SetOptimizerSettings(meshOptimizer);
+    OGLE::MeshCache::Instance().SetVertexFormat(meshConfig.quantizeVertices ? OGLE::VertexFormat::Quantized : OGLE::VertexFormat::Float32);
+
+    const AppConfig::LODSettings& lodConfig = m_configManager.GetConfig().lod;
+    OGLE::LODSettings lod;
+    lod.enabled = lodConfig.enabled;
+    lod.levelCount = lodConfig.levelCount;
+    lod.reductionPerLevel = lodConfig.reductionPerLevel;
+    lod.maxNormalDeviation = lodConfig.maxNormalDeviation;
+    lod.firstScreenSize = lodConfig.firstScreenSize;
+    lod.minTriangles = static_cast<std::size_t>(std::max(0, lodConfig.minTriangles));
+    OGLE::MeshCache::Instance().SetLODSettings(lod);
+
+    const AppConfig::AssetsSettings& assetsConfig = m_configManager.GetConfig().assets;
+    OGLE::ImportCache::Instance().SetEnabled(assetsConfig.importCacheEnabled);
+    OGLE::ImportCache::Instance().SetDirectory(assetsConfig.importCachePath);
 
     InitializeWorldFromConfig();
 
     if (!m_physicsManager.Initialize(m_worldManager)) {
         LOG_ERROR("Physics system initialization failed");
-        return -1;
+        return false;
     }
 
+    // Queued rather than dispatched: script handlers must not run while other
+    // systems of the same stage are still iterating the registry.
     m_physicsManager.SetCollisionCallback([this](entt::entity a, entt::entity b) {
-        const auto eidA = static_cast<unsigned int>(entt::to_integral(a));
-        const auto eidB = static_cast<unsigned int>(entt::to_integral(b));
-        LOG_INFO("Collision detected between entities " + std::to_string(eidA) + " and " + std::to_string(eidB));
-        m_eventBus.Dispatch(OGLE::CollisionEvent{a, b});
+        m_pendingCollisions.push_back(OGLE::CollisionEvent{a, b});
     });
 
     m_eventBus.Subscribe<OGLE::CollisionEvent>([this](const OGLE::CollisionEvent& e) {
         m_scriptManager.NotifyCollision(e.entityA, e.entityB);
     });
+    m_eventBus.Subscribe<OGLE::ModelReadyEvent>([this](const OGLE::ModelReadyEvent& e) {
+        m_scriptManager.NotifyModelReady(e.entity, e.success);
+    });
 
     if (!m_scriptManager.Initialize(m_worldManager, m_physicsManager, "assets/scripts/internal/api_bootstrap.js")) {
         LOG_ERROR("Script system initialization failed");
-        return -1;
+        return false;
     }
 
+    RegisterSimulationSystems();
+
     const AppConfig& config = m_configManager.GetConfig();
     if (config.scripts.runStartupScript &&
         !config.scripts.startupScriptPath.empty()) {
@@ -158,6 +237,44 @@ int App::Run(HINSTANCE hInstance, int nCmdShow)
         }
     }
 
+    return true;
+}
+
+#ifndef OGLE_HEADLESS
+int App::Run(HINSTANCE hInstance, int nCmdShow)
+{
+    if (!m_window || !m_window->Create(hInstance))
+    {
+        LOG_ERROR("Window creation failed");
+        return -1;
+    }
+
+    LOG_INFO("Window created successfully");
+    m_inputManager.AttachToWindow(*m_window);
+    m_inputActionsManager.ConfigureDefaultActions();
+
+    // m_cameraManager.SetPosition(glm::vec3(7.0f, 5.0f, 9.0f));
+    // m_cameraManager.LookAt(glm::vec3(0.0f, 0.0f, 0.0f));
+
+    if (!m_renderManager.Initialize(*m_window, m_cameraManager, m_worldManager)) {
+        return -1;
+    }
+
+    if (!m_imguiManager.Initialize(*m_window)) {
+        LOG_ERROR("ImGui initialization failed");
+        return -1;
+    }
+
+    // if (!m_editor.Initialize()) {
+    //     LOG_ERROR("Editor initialization failed");
+    //     return -1;
+    // }
+    // m_editor.SetEnabled(m_configManager.GetConfig().editor.enabled);
+
+    if (!InitializeSimulation()) {
+        return -1;
+    }
+
     // Push layers onto the stack
     m_layerStack.PushLayer(new MainApplicationLayer(*this));
     // m_layerStack.PushLayer(new ExampleLayer());
@@ -211,6 +328,54 @@ int App::Run(HINSTANCE hInstance, int nCmdShow)
     }
 
     LOG_INFO("Main loop exited");
+    JobSystem::Instance().Shutdown();
 
     return static_cast<int>(msg.wParam);
 }
+#endif
+
+int App::RunHeadless(std::uint32_t frameCount, float fixedDeltaTime)
+{
+    if (!m_window || !m_window->Create(nullptr))
+    {
+        LOG_ERROR("Headless window creation failed");
+        return -1;
+    }
+
+    LOG_INFO("Headless run: " + std::to_string(frameCount) + " frames, fixed dt " + std::to_string(fixedDeltaTime) + " s");
+
+    if (!InitializeSimulation()) {
+        return -1;
+    }
+
+    m_layerStack.PushLayer(new MainApplicationLayer(*this));
+
+    OGLE::TextureManager::Get().Initialize();
+    m_timeManager.SetFixedDeltaTime(fixedDeltaTime);
+    m_timeManager.Reset();
+
+    FrameTimeStats frameStats;
+    frameStats.Reserve(frameCount);
+
+    for (std::uint32_t frame = 0; frame < frameCount; ++frame) {
+        const auto frameStart = std::chrono::steady_clock::now();
+        const float deltaTime = m_timeManager.Tick();
+
+        for (auto* layer : m_layerStack)
+            layer->OnUpdate(deltaTime);
+
+        frameStats.AddSample(std::chrono::duration<float>(std::chrono::steady_clock::now() - frameStart).count());
+    }
+
+    const std::string report = frameStats.BuildReport("Headless frame time");
+    LOG_INFO(report);
+    std::cout << report << std::endl;
+
+    const std::string schedule = m_worldManager.GetActiveWorld().GetScheduler().DumpSchedule();
+    LOG_INFO(schedule);
+    std::cout << schedule << std::endl;
+
+    LOG_INFO("Headless loop exited");
+    JobSystem::Instance().Shutdown();
+    return 0;
+}
@@ -2,20 +2,25 @@
 
 #include "config/ConfigManager.h"
 #include "core/EventBus.h"
+#include "core/Events.h"
 #include "core/LayerStack.h"
 // #include "Old_editor/Old_Editor.h"
 #include "managers/CameraManager.h"
+#ifndef OGLE_HEADLESS
 #include "managers/ImGuiManager.h"
 #include "managers/InputActionsManager.h"
 #include "managers/InputManager.h"
-#include "managers/PhysicsManager.h"
 #include "managers/RenderManager.h"
+#endif
+#include "managers/PhysicsManager.h"
 #include "managers/ScriptManager.h"
 #include "managers/TimeManager.h"
 #include "managers/WorldManager.h"
 #include "render/TextureManager.h"
+#include "ui/WindowTypes.h"
+#include <cstdint>
 #include <memory>
-#include <windows.h>
+#include <vector>
 
 class IWindow;
 
@@ -23,7 +28,12 @@ class App
 {
 public:
     App(std::unique_ptr<IWindow> window, ConfigManager configManager);
+#ifndef OGLE_HEADLESS
     int Run(HINSTANCE hInstance, int nCmdShow);
+#endif
+    // Simulation-only loop: no message pump, no renderer, no ImGui.
+    // Steps the world with a fixed delta for frameCount frames and logs frame-time statistics.
+    int RunHeadless(std::uint32_t frameCount, float fixedDeltaTime);
 
     static App* Get() { return s_instance; }
 
@@ -36,18 +46,22 @@ public:
     // const Old_Editor& GetEditor() const { return m_editor; }
     CameraManager& GetCameraManager() { return m_cameraManager; }
     const CameraManager& GetCameraManager() const { return m_cameraManager; }
+#ifndef OGLE_HEADLESS
     ImGuiManager& GetImGuiManager() { return m_imguiManager; }
     const ImGuiManager& GetImGuiManager() const { return m_imguiManager; }
     InputActionsManager& GetInputActionsManager() { return m_inputActionsManager; }
     const InputActionsManager& GetInputActionsManager() const { return m_inputActionsManager; }
     InputManager& GetInputManager() { return m_inputManager; }
     const InputManager& GetInputManager() const { return m_inputManager; }
+#endif
     PhysicsManager& GetPhysicsManager() { return m_physicsManager; }
     const PhysicsManager& GetPhysicsManager() const { return m_physicsManager; }
     TimeManager& GetTimeManager() { return m_timeManager; }
     const TimeManager& GetTimeManager() const { return m_timeManager; }
+#ifndef OGLE_HEADLESS
     RenderManager& GetRenderManager() { return m_renderManager; }
     const RenderManager& GetRenderManager() const { return m_renderManager; }
+#endif
     ScriptManager& GetScriptManager() { return m_scriptManager; }
     const ScriptManager& GetScriptManager() const { return m_scriptManager; }
     WorldManager& GetWorldManager() { return m_worldManager; }
@@ -62,6 +76,8 @@ public:
 
 private:
     void InitializeWorldFromConfig();
+    bool InitializeSimulation();
+    void RegisterSimulationSystems();
 
     static App* s_instance;
 
@@ -70,13 +86,19 @@ private:
     ConfigManager m_configManager;
     // Old_Editor m_editor;
     CameraManager m_cameraManager;
+#ifndef OGLE_HEADLESS
     ImGuiManager m_imguiManager;
     InputActionsManager m_inputActionsManager;
     InputManager m_inputManager;
+#endif
     PhysicsManager m_physicsManager;
     TimeManager m_timeManager;
+#ifndef OGLE_HEADLESS
     RenderManager m_renderManager;
+#endif
     ScriptManager m_scriptManager;
     WorldManager m_worldManager;
     EventBus m_eventBus;
+    // Collisions reported during the physics step; dispatched by the "CollisionEvents" system.
+    std::vector<OGLE::CollisionEvent> m_pendingCollisions;
 };
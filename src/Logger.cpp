@@ -1,4 +1,5 @@
 #include "Logger.h"
+#include <filesystem>
 #include <iomanip>
 #include <sstream>
 
@@ -25,7 +26,7 @@ bool Logger::Init(const std::wstring& filePath)
     if (m_initialized)
         return true;
 
-    m_file.open(filePath, std::ios::out | std::ios::app);
+    m_file.open(std::filesystem::path(filePath), std::ios::out | std::ios::app);
     if (!m_file.is_open())
         return false;
 
@@ -88,7 +89,11 @@ std::string Logger::GetTimestamp()
     auto ms = duration_cast<milliseconds>(now.time_since_epoch()) % 1000;
 
     std::tm localTime;
+#ifdef _WIN32
     localtime_s(&localTime, &now_t);
+#else
+    localtime_r(&now_t, &localTime);
+#endif
 
     std::ostringstream oss;
     oss << std::put_time(&localTime, "%Y-%m-%d %H:%M:%S") << "." << std::setfill('0') << std::setw(3) << ms.count();
@@ -22,8 +22,40 @@ struct AppConfig
 
     struct AssetsSettings {
         std::string path = "assets";
+        // Время главного потока на загрузку фоновых импортов в GPU за кадр (см. ModelImportQueue).
+        float uploadBudgetMs = 2.0f;
+        // Результаты импорта Assimp, сохранённые как .omdl (см. ImportCache).
+        bool importCacheEnabled = true;
+        std::string importCachePath = "cache/imports";
     } assets;
 
+    // Допуски сжатия анимационных клипов при импорте (см. AnimationCompressor).
+    struct AnimationSettings {
+        float translationTolerance = 0.0005f;
+        float rotationTolerance = 0.001f;
+        float scaleTolerance = 0.0005f;
+    } animation;
+
+    // Стадии оптимизации мешей при импорте (см. MeshOptimizer).
+    struct MeshOptimizerSettings {
+        bool weldVertices = true;
+        bool optimizeVertexCache = true;
+        bool optimizeOverdraw = true;
+        bool optimizeVertexFetch = true;
+        float overdrawThreshold = 1.05f;
+        bool quantizeVertices = true; // Общие меши на GPU в 16-байтной раскладке (VertexFormat::Quantized)
+    } meshOptimizer;
+
+    // Цепочка LOD для общих мешей (см. MeshSimplifier, LODSystem).
+    struct LODSettings {
+        bool enabled = true;
+        int levelCount = 3;
+        float reductionPerLevel = 0.5f;
+        float maxNormalDeviation = 45.0f;
+        float firstScreenSize = 0.5f;
+        int minTriangles = 512;
+    } lod;
+
     struct ScriptSettings {
         bool runStartupScript = true;
         std::string startupScriptPath = "assets/scripts/startup.js";
@@ -3,11 +3,16 @@
 #include "Logger.h"
 #include "core/FileSystem.h"
 
+#include <cstdint>
 #include <nlohmann/json.hpp>
+
+#ifdef _WIN32
 #include <windows.h>
+#endif
 
 namespace
 {
+#ifdef _WIN32
     std::string Narrow(const std::wstring& value)
     {
         if (value.empty()) {
@@ -69,6 +74,62 @@ namespace
             sizeNeeded);
         return result;
     }
+#else
+    // wchar_t is UTF-32 outside Windows, so UTF-8 conversion is done by hand.
+    std::string Narrow(const std::wstring& value)
+    {
+        std::string result;
+        result.reserve(value.size());
+        for (const wchar_t ch : value) {
+            const auto codePoint = static_cast<std::uint32_t>(ch);
+            if (codePoint < 0x80) {
+                result.push_back(static_cast<char>(codePoint));
+            } else if (codePoint < 0x800) {
+                result.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+                result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            } else if (codePoint < 0x10000) {
+                result.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+                result.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+                result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            } else {
+                result.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+                result.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+                result.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+                result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            }
+        }
+        return result;
+    }
+
+    std::wstring Widen(const std::string& value)
+    {
+        std::wstring result;
+        result.reserve(value.size());
+        std::size_t index = 0;
+        while (index < value.size()) {
+            const auto lead = static_cast<unsigned char>(value[index]);
+            std::uint32_t codePoint = lead;
+            std::size_t extraBytes = 0;
+            if (lead >= 0xF0) {
+                codePoint = lead & 0x07;
+                extraBytes = 3;
+            } else if (lead >= 0xE0) {
+                codePoint = lead & 0x0F;
+                extraBytes = 2;
+            } else if (lead >= 0xC0) {
+                codePoint = lead & 0x1F;
+                extraBytes = 1;
+            }
+
+            ++index;
+            for (std::size_t i = 0; i < extraBytes && index < value.size(); ++i, ++index) {
+                codePoint = (codePoint << 6) | (static_cast<unsigned char>(value[index]) & 0x3F);
+            }
+            result.push_back(static_cast<wchar_t>(codePoint));
+        }
+        return result;
+    }
+#endif
 }
 
 ConfigManager::ConfigManager(std::filesystem::path configPath)
@@ -114,6 +175,36 @@ bool ConfigManager::Load()
     if (json.contains("assets")) {
         const auto& assets = json["assets"];
         loadedConfig.assets.path = assets.value("path", loadedConfig.assets.path);
+        loadedConfig.assets.uploadBudgetMs = assets.value("uploadBudgetMs", loadedConfig.assets.uploadBudgetMs);
+        loadedConfig.assets.importCacheEnabled = assets.value("importCacheEnabled", loadedConfig.assets.importCacheEnabled);
+        loadedConfig.assets.importCachePath = assets.value("importCachePath", loadedConfig.assets.importCachePath);
+    }
+
+    if (json.contains("animation")) {
+        const auto& animation = json["animation"];
+        loadedConfig.animation.translationTolerance = animation.value("translationTolerance", loadedConfig.animation.translationTolerance);
+        loadedConfig.animation.rotationTolerance = animation.value("rotationTolerance", loadedConfig.animation.rotationTolerance);
+        loadedConfig.animation.scaleTolerance = animation.value("scaleTolerance", loadedConfig.animation.scaleTolerance);
+    }
+
+    if (json.contains("meshOptimizer")) {
+        const auto& meshOptimizer = json["meshOptimizer"];
+        loadedConfig.meshOptimizer.weldVertices = meshOptimizer.value("weldVertices", loadedConfig.meshOptimizer.weldVertices);
+        loadedConfig.meshOptimizer.optimizeVertexCache = meshOptimizer.value("optimizeVertexCache", loadedConfig.meshOptimizer.optimizeVertexCache);
+        loadedConfig.meshOptimizer.optimizeOverdraw = meshOptimizer.value("optimizeOverdraw", loadedConfig.meshOptimizer.optimizeOverdraw);
+        loadedConfig.meshOptimizer.optimizeVertexFetch = meshOptimizer.value("optimizeVertexFetch", loadedConfig.meshOptimizer.optimizeVertexFetch);
+        loadedConfig.meshOptimizer.overdrawThreshold = meshOptimizer.value("overdrawThreshold", loadedConfig.meshOptimizer.overdrawThreshold);
+        loadedConfig.meshOptimizer.quantizeVertices = meshOptimizer.value("quantizeVertices", loadedConfig.meshOptimizer.quantizeVertices);
+    }
+
+    if (json.contains("lod")) {
+        const auto& lod = json["lod"];
+        loadedConfig.lod.enabled = lod.value("enabled", loadedConfig.lod.enabled);
+        loadedConfig.lod.levelCount = lod.value("levelCount", loadedConfig.lod.levelCount);
+        loadedConfig.lod.reductionPerLevel = lod.value("reductionPerLevel", loadedConfig.lod.reductionPerLevel);
+        loadedConfig.lod.maxNormalDeviation = lod.value("maxNormalDeviation", loadedConfig.lod.maxNormalDeviation);
+        loadedConfig.lod.firstScreenSize = lod.value("firstScreenSize", loadedConfig.lod.firstScreenSize);
+        loadedConfig.lod.minTriangles = lod.value("minTriangles", loadedConfig.lod.minTriangles);
     }
 
     if (json.contains("scripts")) {
@@ -145,7 +236,31 @@ bool ConfigManager::Save() const
         { "saveDefaultWorldIfMissing", m_config.world.saveDefaultWorldIfMissing }
     };
     json["assets"] = {
-        { "path", m_config.assets.path }
+        { "path", m_config.assets.path },
+        { "uploadBudgetMs", m_config.assets.uploadBudgetMs },
+        { "importCacheEnabled", m_config.assets.importCacheEnabled },
+        { "importCachePath", m_config.assets.importCachePath }
+    };
+    json["animation"] = {
+        { "translationTolerance", m_config.animation.translationTolerance },
+        { "rotationTolerance", m_config.animation.rotationTolerance },
+        { "scaleTolerance", m_config.animation.scaleTolerance }
+    };
+    json["meshOptimizer"] = {
+        { "weldVertices", m_config.meshOptimizer.weldVertices },
+        { "optimizeVertexCache", m_config.meshOptimizer.optimizeVertexCache },
+        { "optimizeOverdraw", m_config.meshOptimizer.optimizeOverdraw },
+        { "optimizeVertexFetch", m_config.meshOptimizer.optimizeVertexFetch },
+        { "overdrawThreshold", m_config.meshOptimizer.overdrawThreshold },
+        { "quantizeVertices", m_config.meshOptimizer.quantizeVertices }
+    };
+    json["lod"] = {
+        { "enabled", m_config.lod.enabled },
+        { "levelCount", m_config.lod.levelCount },
+        { "reductionPerLevel", m_config.lod.reductionPerLevel },
+        { "maxNormalDeviation", m_config.lod.maxNormalDeviation },
+        { "firstScreenSize", m_config.lod.firstScreenSize },
+        { "minTriangles", m_config.lod.minTriangles }
     };
     json["scripts"] = {
         { "runStartupScript", m_config.scripts.runStartupScript },
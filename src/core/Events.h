@@ -22,6 +22,16 @@ namespace OGLE
         entt::entity entityB;
     };
 
+    // ── ModelReadyEvent ────────────────────────────────────────────────────
+    // Emitted when an asynchronous model import (World::CreateModelFromFileAsync)
+    // finished. On failure the entity keeps its placeholder mesh.
+    struct ModelReadyEvent
+    {
+        entt::entity entity;
+        std::string path;
+        bool success;
+    };
+
     // ── Editor Events ──────────────────────────────────────────────────────
 
     struct EditorLoadWorldEvent
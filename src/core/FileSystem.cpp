@@ -2,7 +2,10 @@
 
 #include <fstream>
 #include <sstream>
+
+#ifdef _WIN32
 #include <windows.h>
+#endif
 
 bool FileSystem::Exists(const std::filesystem::path& path)
 {
@@ -62,6 +65,21 @@ bool FileSystem::WriteTextFile(const std::filesystem::path& path, const std::str
     return output.good();
 }
 
+bool FileSystem::WriteBinaryFile(const std::filesystem::path& path, const void* data, std::size_t size)
+{
+    if (!EnsureParentDirectory(path)) {
+        return false;
+    }
+
+    std::ofstream output(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!output.is_open()) {
+        return false;
+    }
+
+    output.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    return output.good();
+}
+
 std::filesystem::path FileSystem::GetWorkingDirectory()
 {
     std::error_code errorCode;
@@ -70,12 +88,22 @@ std::filesystem::path FileSystem::GetWorkingDirectory()
 
 std::filesystem::path FileSystem::GetExecutableDirectory()
 {
+#ifdef _WIN32
     char moduleFileName[MAX_PATH] = {};
     if (GetModuleFileNameA(nullptr, moduleFileName, MAX_PATH) == 0) {
         return {};
     }
 
     return std::filesystem::path(moduleFileName).parent_path();
+#else
+    std::error_code errorCode;
+    const std::filesystem::path executablePath = std::filesystem::read_symlink("/proc/self/exe", errorCode);
+    if (errorCode) {
+        return {};
+    }
+
+    return executablePath.parent_path();
+#endif
 }
 
 std::filesystem::path FileSystem::ResolvePath(const std::filesystem::path& path)
@@ -96,3 +124,20 @@ std::filesystem::path FileSystem::ResolvePath(const std::filesystem::path& path)
 
     return GetWorkingDirectory() / path;
 }
+
+std::filesystem::path FileSystem::MakeProjectRelative(const std::filesystem::path& path)
+{
+    const std::filesystem::path resolved = ResolvePath(path).lexically_normal();
+    for (const std::filesystem::path& root : {GetWorkingDirectory(), GetExecutableDirectory()}) {
+        if (root.empty()) {
+            continue;
+        }
+
+        const std::filesystem::path relative = resolved.lexically_relative(root.lexically_normal());
+        if (!relative.empty() && *relative.begin() != "..") {
+            return relative;
+        }
+    }
+
+    return resolved;
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <filesystem>
 #include <string>
 
@@ -11,7 +12,11 @@ public:
     static bool EnsureParentDirectory(const std::filesystem::path& filePath);
     static bool ReadTextFile(const std::filesystem::path& path, std::string& content);
     static bool WriteTextFile(const std::filesystem::path& path, const std::string& content);
+    static bool WriteBinaryFile(const std::filesystem::path& path, const void* data, std::size_t size);
     static std::filesystem::path GetWorkingDirectory();
     static std::filesystem::path GetExecutableDirectory();
     static std::filesystem::path ResolvePath(const std::filesystem::path& path);
+    // Inverse of ResolvePath for files inside the working or executable directory;
+    // paths outside both stay absolute.
+    static std::filesystem::path MakeProjectRelative(const std::filesystem::path& path);
 };
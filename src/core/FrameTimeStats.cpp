@@ -0,0 +1,80 @@
+#include "core/FrameTimeStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+void FrameTimeStats::Reserve(std::size_t frameCount)
+{
+    m_samples.reserve(frameCount);
+}
+
+void FrameTimeStats::AddSample(float seconds)
+{
+    m_samples.push_back(seconds);
+    m_totalSeconds += seconds;
+}
+
+void FrameTimeStats::Clear()
+{
+    m_samples.clear();
+    m_totalSeconds = 0.0;
+}
+
+std::size_t FrameTimeStats::GetSampleCount() const
+{
+    return m_samples.size();
+}
+
+float FrameTimeStats::GetTotalSeconds() const
+{
+    return static_cast<float>(m_totalSeconds);
+}
+
+float FrameTimeStats::GetAverageSeconds() const
+{
+    if (m_samples.empty()) {
+        return 0.0f;
+    }
+
+    return static_cast<float>(m_totalSeconds / static_cast<double>(m_samples.size()));
+}
+
+float FrameTimeStats::GetPercentileSeconds(float percentile) const
+{
+    if (m_samples.empty()) {
+        return 0.0f;
+    }
+
+    std::vector<float> sorted = m_samples;
+    const float clamped = std::clamp(percentile, 0.0f, 100.0f);
+    const std::size_t index = static_cast<std::size_t>(
+        std::lround((clamped / 100.0f) * static_cast<float>(sorted.size() - 1)));
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
+
+std::string FrameTimeStats::BuildReport(const std::string& label) const
+{
+    std::ostringstream report;
+    report << label << ": " << m_samples.size() << " frames";
+    if (m_samples.empty()) {
+        return report.str();
+    }
+
+    const auto [minIt, maxIt] = std::minmax_element(m_samples.begin(), m_samples.end());
+    const float averageSeconds = GetAverageSeconds();
+
+    report << std::fixed << std::setprecision(3)
+        << ", total " << m_totalSeconds << " s"
+        << ", avg " << averageSeconds * 1000.0f << " ms"
+        << ", min " << *minIt * 1000.0f << " ms"
+        << ", p50 " << GetPercentileSeconds(50.0f) * 1000.0f << " ms"
+        << ", p95 " << GetPercentileSeconds(95.0f) * 1000.0f << " ms"
+        << ", p99 " << GetPercentileSeconds(99.0f) * 1000.0f << " ms"
+        << ", max " << *maxIt * 1000.0f << " ms"
+        << std::setprecision(1)
+        << ", " << (averageSeconds > 0.0f ? 1.0f / averageSeconds : 0.0f) << " FPS";
+    return report.str();
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Collects per-frame durations and summarizes them (avg/min/percentiles/max).
+// Used by the headless runner to report frame-time statistics at exit.
+class FrameTimeStats
+{
+public:
+    void Reserve(std::size_t frameCount);
+    void AddSample(float seconds);
+    void Clear();
+
+    std::size_t GetSampleCount() const;
+    float GetTotalSeconds() const;
+    float GetAverageSeconds() const;
+    float GetPercentileSeconds(float percentile) const;
+
+    std::string BuildReport(const std::string& label) const;
+
+private:
+    std::vector<float> m_samples;
+    double m_totalSeconds = 0.0;
+};
@@ -0,0 +1,292 @@
+#include "core/JobSystem.h"
+
+#include "Logger.h"
+
+#include <string>
+
+namespace
+{
+// Deque owned by the current thread: 1..N for pool workers, 0 for everyone else.
+thread_local std::size_t t_queueIndex = 0;
+}
+
+bool JobSystem::JobHandle::IsDone() const
+{
+    return !m_state || m_state->finished.load(std::memory_order_acquire);
+}
+
+JobSystem& JobSystem::Instance()
+{
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::~JobSystem()
+{
+    Shutdown();
+}
+
+void JobSystem::Initialize(std::size_t workerCount)
+{
+    Shutdown();
+
+    if (workerCount == kDefaultWorkerCount) {
+        const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    m_queues.clear();
+    for (std::size_t i = 0; i < workerCount + 1; ++i) {
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    m_running = true;
+    m_workers.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+    }
+
+    LOG_INFO("JobSystem initialized with " + std::to_string(workerCount) + " worker threads");
+}
+
+void JobSystem::Shutdown()
+{
+    if (m_workers.empty()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_running = false;
+    }
+    m_wakeCondition.notify_all();
+
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    m_workers.clear();
+
+    // Jobs still queued run on the calling thread so that nobody waits forever.
+    std::shared_ptr<JobState> job;
+    while (TryPop(0, job)) {
+        Execute(job);
+    }
+    while (TryPopBackground(job)) {
+        Execute(job);
+    }
+}
+
+JobSystem::JobHandle JobSystem::Schedule(Job job)
+{
+    return Schedule(std::move(job), {});
+}
+
+JobSystem::JobHandle JobSystem::Schedule(Job job, const std::vector<JobHandle>& dependencies)
+{
+    auto state = std::make_shared<JobState>();
+    state->function = std::move(job);
+
+    // Guard count keeps the job from being enqueued while dependencies are
+    // still being registered.
+    state->pendingDependencies.store(1, std::memory_order_relaxed);
+    for (const JobHandle& dependency : dependencies) {
+        if (!dependency.m_state) {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(dependency.m_state->continuationMutex);
+        if (!dependency.m_state->finished.load(std::memory_order_acquire)) {
+            state->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+            dependency.m_state->continuations.push_back(state);
+        }
+    }
+
+    JobHandle handle;
+    handle.m_state = state;
+    if (state->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        Enqueue(std::move(state));
+    }
+    return handle;
+}
+
+JobSystem::JobHandle JobSystem::ScheduleBackground(Job job)
+{
+    auto state = std::make_shared<JobState>();
+    state->function = std::move(job);
+
+    JobHandle handle;
+    handle.m_state = state;
+    if (m_workers.empty()) {
+        Execute(state);
+        return handle;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_backgroundQueue.mutex);
+        m_backgroundQueue.jobs.push_back(std::move(state));
+    }
+    m_queuedJobs.fetch_add(1, std::memory_order_release);
+
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+    }
+    m_wakeCondition.notify_one();
+    return handle;
+}
+
+void JobSystem::Wait(const JobHandle& handle)
+{
+    if (!handle.m_state) {
+        return;
+    }
+
+    std::shared_ptr<JobState> job;
+    while (!handle.m_state->finished.load(std::memory_order_acquire)) {
+        if (TryPop(t_queueIndex, job)) {
+            Execute(job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::RunChunks(std::size_t chunkCount, const std::function<void(std::size_t)>& chunkFunction)
+{
+    if (m_workers.empty() || chunkCount == 1) {
+        for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            chunkFunction(chunk);
+        }
+        return;
+    }
+
+    // Helpers claim chunks from a shared counter, so a slow chunk never leaves
+    // the remaining threads idle behind a static partition.
+    std::atomic<std::size_t> nextChunk{ 0 };
+    auto drain = [&nextChunk, chunkCount, &chunkFunction]() {
+        for (std::size_t chunk = nextChunk.fetch_add(1, std::memory_order_relaxed);
+             chunk < chunkCount;
+             chunk = nextChunk.fetch_add(1, std::memory_order_relaxed)) {
+            chunkFunction(chunk);
+        }
+    };
+
+    const std::size_t helperCount = std::min(m_workers.size(), chunkCount - 1);
+    std::vector<JobHandle> helpers;
+    helpers.reserve(helperCount);
+    for (std::size_t i = 0; i < helperCount; ++i) {
+        helpers.push_back(Schedule(drain));
+    }
+
+    drain();
+
+    for (const JobHandle& helper : helpers) {
+        Wait(helper);
+    }
+}
+
+void JobSystem::Enqueue(std::shared_ptr<JobState> job)
+{
+    if (m_workers.empty()) {
+        Execute(job);
+        return;
+    }
+
+    WorkerQueue& queue = *m_queues[t_queueIndex < m_queues.size() ? t_queueIndex : 0];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+    m_queuedJobs.fetch_add(1, std::memory_order_release);
+
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+    }
+    m_wakeCondition.notify_one();
+}
+
+bool JobSystem::TryPop(std::size_t queueIndex, std::shared_ptr<JobState>& job)
+{
+    const std::size_t queueCount = m_queues.size();
+    if (queueCount == 0) {
+        return false;
+    }
+
+    {
+        WorkerQueue& own = *m_queues[queueIndex % queueCount];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            m_queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+
+    for (std::size_t offset = 1; offset < queueCount; ++offset) {
+        WorkerQueue& victim = *m_queues[(queueIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            m_queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool JobSystem::TryPopBackground(std::shared_ptr<JobState>& job)
+{
+    std::lock_guard<std::mutex> lock(m_backgroundQueue.mutex);
+    if (m_backgroundQueue.jobs.empty()) {
+        return false;
+    }
+
+    job = std::move(m_backgroundQueue.jobs.front());
+    m_backgroundQueue.jobs.pop_front();
+    m_queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+void JobSystem::Execute(const std::shared_ptr<JobState>& job)
+{
+    if (job->function) {
+        job->function();
+    }
+
+    std::vector<std::shared_ptr<JobState>> continuations;
+    {
+        std::lock_guard<std::mutex> lock(job->continuationMutex);
+        job->finished.store(true, std::memory_order_release);
+        continuations.swap(job->continuations);
+    }
+
+    for (auto& continuation : continuations) {
+        if (continuation->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            Enqueue(std::move(continuation));
+        }
+    }
+}
+
+void JobSystem::WorkerLoop(std::size_t queueIndex)
+{
+    t_queueIndex = queueIndex;
+
+    std::shared_ptr<JobState> job;
+    while (m_running.load(std::memory_order_acquire)) {
+        if (TryPop(queueIndex, job) || TryPopBackground(job)) {
+            Execute(job);
+            job.reset();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wakeCondition.wait(lock, [this]() {
+            return !m_running.load(std::memory_order_acquire) ||
+                m_queuedJobs.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// JobSystem — a fixed pool of worker threads with per-thread job deques.
+//
+// Each worker pops its own deque from the back (LIFO, cache-warm) and steals
+// from the front of other deques when it runs dry. Threads outside the pool
+// (the main thread) share deque 0 and help execute jobs while they Wait().
+//
+// Usage:
+//   auto& jobs = JobSystem::Instance();
+//   auto load = jobs.Schedule([] { ... });
+//   auto post = jobs.Schedule([] { ... }, { load }); // runs after `load`
+//   jobs.Wait(post);
+//
+//   jobs.ParallelFor(count, [&](std::size_t begin, std::size_t end) { ... });
+//   jobs.ParallelForEach(registry.storage<T>(), [&](entt::entity e) { ... });
+//
+// Long jobs that must not stall a frame (asset imports) go through
+// ScheduleBackground(): only pool workers run them, after their regular jobs,
+// so a Wait() on the main thread never picks one up.
+//
+// Without workers (Initialize(0) or before Initialize) everything runs inline
+// on the calling thread, so systems behave exactly like the serial code.
+// ─────────────────────────────────────────────────────────────────────────────
+
+class JobSystem
+{
+    struct JobState;
+
+public:
+    using Job = std::function<void()>;
+
+    class JobHandle
+    {
+    public:
+        bool IsValid() const { return m_state != nullptr; }
+        bool IsDone() const;
+
+    private:
+        friend class JobSystem;
+        std::shared_ptr<JobState> m_state;
+    };
+
+    // Chunks are sized so that one chunk of component data fits in roughly
+    // half of a typical L1 data cache.
+    static constexpr std::size_t kCacheChunkBytes = 16 * 1024;
+    static constexpr std::size_t kDefaultWorkerCount = static_cast<std::size_t>(-1);
+
+    static JobSystem& Instance();
+
+    ~JobSystem();
+
+    // kDefaultWorkerCount uses hardware_concurrency() - 1 workers (the calling
+    // thread is the remaining one). Re-initializing restarts the pool.
+    void Initialize(std::size_t workerCount = kDefaultWorkerCount);
+    void Shutdown();
+
+    std::size_t GetWorkerCount() const { return m_workers.size(); }
+    // Workers plus the calling thread.
+    std::size_t GetThreadCount() const { return m_workers.size() + 1; }
+
+    JobHandle Schedule(Job job);
+    JobHandle Schedule(Job job, const std::vector<JobHandle>& dependencies);
+    // Blocks until the job finished, executing queued jobs in the meantime.
+    void Wait(const JobHandle& handle);
+
+    // Runs on a pool worker once it has no regular jobs. Never executed by
+    // Wait()/ParallelFor on the calling thread; inline when there are no workers.
+    JobHandle ScheduleBackground(Job job);
+
+    static constexpr std::size_t ChunkSizeFor(std::size_t bytesPerItem)
+    {
+        const std::size_t items = bytesPerItem > 0 ? kCacheChunkBytes / bytesPerItem : kCacheChunkBytes;
+        return items < 16 ? 16 : (items > 4096 ? 4096 : items);
+    }
+
+    // Calls function(begin, end) over [0, count) split into chunks of chunkSize
+    // items. Returns when all chunks are done; the caller works on chunks too.
+    template <typename Function>
+    void ParallelFor(std::size_t count, Function&& function, std::size_t chunkSize = 0)
+    {
+        if (count == 0) {
+            return;
+        }
+
+        if (chunkSize == 0) {
+            chunkSize = std::max<std::size_t>(64, count / (GetThreadCount() * 4));
+        }
+
+        const std::size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+        RunChunks(chunkCount, [&](std::size_t chunk) {
+            const std::size_t begin = chunk * chunkSize;
+            function(begin, std::min(count, begin + chunkSize));
+        });
+    }
+
+    // Calls function(entity) for every entity of an entt sparse set/storage.
+    // The packed array is split by index, so the set must not be modified
+    // (no emplace/remove of that component) while the loop runs.
+    template <typename Storage, typename Function>
+    void ParallelForEach(const Storage& storage, Function&& function, std::size_t chunkSize = 0)
+    {
+        const auto* entities = storage.data();
+        ParallelFor(storage.size(), [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                function(entities[i]);
+            }
+        }, chunkSize);
+    }
+
+private:
+    struct JobState
+    {
+        Job function;
+        std::atomic<int> pendingDependencies{ 0 };
+        std::atomic<bool> finished{ false };
+        std::mutex continuationMutex;
+        std::vector<std::shared_ptr<JobState>> continuations;
+    };
+
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<JobState>> jobs;
+    };
+
+    JobSystem() = default;
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void RunChunks(std::size_t chunkCount, const std::function<void(std::size_t)>& chunkFunction);
+
+    void Enqueue(std::shared_ptr<JobState> job);
+    bool TryPop(std::size_t queueIndex, std::shared_ptr<JobState>& job);
+    bool TryPopBackground(std::shared_ptr<JobState>& job);
+    void Execute(const std::shared_ptr<JobState>& job);
+    void WorkerLoop(std::size_t queueIndex);
+
+    // Index 0 is shared by all threads outside the pool.
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    // Shared FIFO for ScheduleBackground(), only popped by WorkerLoop.
+    WorkerQueue m_backgroundQueue;
+    std::vector<std::thread> m_workers;
+    std::atomic<bool> m_running{ false };
+    std::atomic<std::size_t> m_queuedJobs{ 0 };
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+// 64-bit FNV-1a. The string overload is constexpr, so names spelled in code
+// (programs, uniforms) hash at compile time when used in a constant expression.
+constexpr std::uint64_t kFnv1aOffsetBasis = 14695981039346656037ull;
+constexpr std::uint64_t kFnv1aPrime = 1099511628211ull;
+
+constexpr std::uint64_t Fnv1a(std::string_view text, std::uint64_t hash = kFnv1aOffsetBasis)
+{
+    for (const char c : text) {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= kFnv1aPrime;
+    }
+    return hash;
+}
+
+inline std::uint64_t Fnv1aBytes(const void* data, std::size_t size, std::uint64_t hash = kFnv1aOffsetBasis)
+{
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= kFnv1aPrime;
+    }
+    return hash;
+}
+
+// Hashed name used as a map key instead of the string itself. Converts
+// implicitly from strings so lookups accept either; hot paths keep the ids in
+// constexpr constants (or "name"_id) so nothing is hashed per call.
+class StringId
+{
+public:
+    constexpr StringId() = default;
+    constexpr StringId(std::string_view text) : m_value(Fnv1a(text)) {}
+    constexpr StringId(const char* text) : StringId(std::string_view(text)) {}
+    StringId(const std::string& text) : StringId(std::string_view(text)) {}
+
+    constexpr std::uint64_t GetValue() const { return m_value; }
+    constexpr bool IsValid() const { return m_value != 0; }
+
+    constexpr bool operator==(StringId other) const { return m_value == other.m_value; }
+    constexpr bool operator!=(StringId other) const { return m_value != other.m_value; }
+
+private:
+    std::uint64_t m_value = 0;
+};
+
+namespace StringIdLiterals {
+    constexpr StringId operator""_id(const char* text, std::size_t length)
+    {
+        return StringId(std::string_view(text, length));
+    }
+}
+
+namespace std {
+    template <>
+    struct hash<StringId> {
+        std::size_t operator()(StringId id) const noexcept
+        {
+            return static_cast<std::size_t>(id.GetValue());
+        }
+    };
+}
@@ -0,0 +1,1341 @@
+#include "App.h"
+#include "config/ConfigManager.h"
+#include "core/FileSystem.h"
+#include "core/JobSystem.h"
+#include "models/ImportCache.h"
+#include "models/MeshCache.h"
+#include "models/MeshOptimizer.h"
+#include "models/MeshSimplifier.h"
+#include "models/ModelEntity.h"
+#include "models/ModelImportQueue.h"
+#include "models/PrimitiveFactory.h"
+#include "models/VertexLayout.h"
+#include "opengl/UniformBuffer.h"
+#include "render/AnimationLibrary.h"
+#include "render/Material.h"
+#include "ui/HeadlessWindow.h"
+#include "world/World.h"
+#include "world/WorldComponents.h"
+#include "world/systems/AnimationCompressor.h"
+#include "world/systems/AnimationSystem.h"
+#include "world/systems/LODSystem.h"
+#include "world/systems/SkinningSystem.h"
+#include "world/systems/TransformSystem.h"
+#include "Logger.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Runs `iteration` with 1, 2, 4, ... threads up to hardware_concurrency() and
+// reports ms/iteration and speedup against the single-thread run.
+int RunScalingBenchmark(
+    const std::string& title,
+    std::uint32_t iterations,
+    const std::function<void()>& warmUp,
+    const std::function<void(std::uint32_t)>& iteration)
+{
+    const unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned int> threadCounts;
+    for (unsigned int threads = 1; threads < hardwareThreads; threads *= 2)
+    {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(hardwareThreads);
+
+    std::ostringstream report;
+    report << title << ", " << iterations << " iterations\n";
+    report << std::fixed << std::setprecision(3);
+
+    double baselineMs = 0.0;
+    for (const unsigned int threads : threadCounts)
+    {
+        JobSystem::Instance().Initialize(threads - 1);
+        warmUp();
+
+        const auto start = std::chrono::steady_clock::now();
+        for (std::uint32_t i = 0; i < iterations; ++i)
+        {
+            iteration(i);
+        }
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+        if (baselineMs == 0.0)
+        {
+            baselineMs = ms;
+        }
+
+        report << "  threads " << std::setw(2) << threads << ": " << ms << " ms/iter, speedup x" << (ms > 0.0 ? baselineMs / ms : 0.0) << "\n";
+    }
+    JobSystem::Instance().Shutdown();
+
+    LOG_INFO(report.str());
+    std::cout << report.str();
+    return 0;
+}
+
+// Animation + full transform recompose on a synthetic registry.
+int RunJobSystemBenchmark(std::size_t entityCount, std::uint32_t iterations)
+{
+    entt::registry registry;
+    OGLE::TransformSystem transformSystem(registry);
+    OGLE::AnimationSystem animationSystem(registry);
+
+    for (std::size_t i = 0; i < entityCount; ++i)
+    {
+        const auto entity = registry.create();
+        const float f = static_cast<float>(i);
+        registry.emplace<OGLE::WorldObjectComponent>(entity);
+        registry.emplace<OGLE::TransformComponent>(entity, OGLE::TransformComponent{
+            glm::vec3(f, f * 0.5f, -f), glm::vec3(f * 0.1f, f * 0.2f, f * 0.3f), glm::vec3(1.0f) });
+        auto& animation = registry.emplace<OGLE::AnimationComponent>(entity);
+        animation.enabled = true;
+        animation.playing = true;
+    }
+
+    return RunScalingBenchmark(
+        "JobSystem benchmark: " + std::to_string(entityCount) + " entities",
+        iterations,
+        [&]() { transformSystem.SyncAllModels(); },
+        [&](std::uint32_t) {
+            animationSystem.Update(1.0f / 60.0f);
+            transformSystem.SyncAllModels();
+        });
+}
+
+// Keyframe sampling: entityCount animated entities sharing one synthetic clip
+// (60 tracks, 30 keys/s) through AnimationLibrary, updated by AnimationSystem.
+int RunAnimationBenchmark(std::size_t entityCount, std::uint32_t iterations)
+{
+    constexpr std::size_t kTrackCount = 60;
+    constexpr std::size_t kKeyCount = 120;
+    constexpr float kKeyStep = 1.0f / 30.0f;
+
+    OGLE::AnimationClipSource source;
+    source.name = "benchmark";
+    source.duration = kKeyStep * static_cast<float>(kKeyCount - 1);
+    source.tracks.resize(kTrackCount);
+    for (std::size_t track = 0; track < kTrackCount; ++track)
+    {
+        auto& channels = source.tracks[track];
+        channels.nodeName = "bone_" + std::to_string(track);
+        for (std::size_t key = 0; key < kKeyCount; ++key)
+        {
+            const float t = kKeyStep * static_cast<float>(key);
+            channels.translationTimes.push_back(t);
+            channels.translations.push_back(glm::vec3(std::sin(t + track), std::cos(t), 0.1f * track));
+            channels.rotationTimes.push_back(t);
+            channels.rotations.push_back(glm::angleAxis(t + 0.05f * track, glm::normalize(glm::vec3(0.3f, 1.0f, 0.2f))));
+            channels.scaleTimes.push_back(t);
+            channels.scales.push_back(glm::vec3(1.0f + 0.1f * std::sin(t)));
+        }
+    }
+
+    std::vector<OGLE::AnimationClip> clips;
+    clips.push_back(OGLE::AnimationCompressor::CompressClip(source, OGLE::AnimationLibrary::Instance().GetCompressionSettings()));
+    const std::size_t sourceBytes = OGLE::AnimationCompressor::GetSourceBytes(source);
+    const std::size_t compressedBytes = OGLE::AnimationCompressor::GetCompressedBytes(clips.front());
+    const auto handles = OGLE::AnimationLibrary::Instance().RegisterClips(std::string(), std::move(clips));
+
+    entt::registry registry;
+    OGLE::AnimationSystem animationSystem(registry);
+    for (std::size_t i = 0; i < entityCount; ++i)
+    {
+        const auto entity = registry.create();
+        registry.emplace<OGLE::WorldObjectComponent>(entity);
+        auto& animation = registry.emplace<OGLE::AnimationComponent>(entity);
+        animation.enabled = true;
+        animation.playing = true;
+        animation.clips = handles;
+        animation.currentClip = handles.front()->name;
+        animation.duration = handles.front()->duration;
+        animation.currentTime = std::fmod(0.013f * static_cast<float>(i), animation.duration);
+    }
+
+    std::ostringstream title;
+    title << "Animation sampling benchmark: " << entityCount << " entities x " << kTrackCount << " tracks, clip "
+          << sourceBytes / 1024 << " KB -> " << compressedBytes / 1024 << " KB compressed";
+    return RunScalingBenchmark(
+        title.str(),
+        iterations,
+        [&]() { animationSystem.Update(1.0f / 60.0f); },
+        [&](std::uint32_t) { animationSystem.Update(1.0f / 60.0f); });
+}
+
+// CPU skinning: characterCount instances of one synthetic skinned mesh (32-bone
+// chain, 4 influences per vertex) animated by AnimationSystem. Palettes are built
+// per character and vertices are skinned in 1024-vertex chunks, as SkinningSystem does.
+int RunSkinningBenchmark(std::size_t characterCount, std::uint32_t iterations)
+{
+    constexpr std::size_t kBoneCount = 32;
+    constexpr std::size_t kVertexCount = 4096;
+    constexpr std::size_t kKeyCount = 60;
+    constexpr std::size_t kVerticesPerChunk = 1024;
+    constexpr float kKeyStep = 1.0f / 30.0f;
+    constexpr float kBoneLength = 0.25f;
+
+    auto skin = std::make_shared<OGLE::SkinData>();
+    OGLE::AnimationClipSource source;
+    source.name = "skinning_benchmark";
+    source.duration = kKeyStep * static_cast<float>(kKeyCount - 1);
+    for (std::size_t bone = 0; bone < kBoneCount; ++bone)
+    {
+        OGLE::SkinJoint joint;
+        joint.name = "bone_" + std::to_string(bone);
+        joint.parent = static_cast<int>(bone) - 1;
+        joint.bindLocal = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, bone == 0 ? 0.0f : kBoneLength, 0.0f));
+        skin->joints.push_back(joint);
+        skin->boneJoints.push_back(static_cast<int>(bone));
+        skin->inverseBindMatrices.push_back(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -kBoneLength * bone, 0.0f)));
+
+        OGLE::AnimationTrackSource track;
+        track.nodeName = joint.name;
+        for (std::size_t key = 0; key < kKeyCount; ++key)
+        {
+            const float t = kKeyStep * static_cast<float>(key);
+            track.translationTimes.push_back(t);
+            track.translations.push_back(glm::vec3(0.0f, bone == 0 ? 0.0f : kBoneLength, 0.0f));
+            track.rotationTimes.push_back(t);
+            track.rotations.push_back(glm::angleAxis(0.2f * std::sin(3.0f * t + 0.4f * bone), glm::vec3(0.0f, 0.0f, 1.0f)));
+        }
+        source.tracks.push_back(std::move(track));
+    }
+
+    skin->influences.resize(kVertexCount);
+    skin->bindVertices.resize(kVertexCount * 8);
+    for (std::size_t vertex = 0; vertex < kVertexCount; ++vertex)
+    {
+        const float height = kBoneLength * (kBoneCount - 1) * static_cast<float>(vertex) / kVertexCount;
+        const float angle = 0.37f * static_cast<float>(vertex);
+        float* data = &skin->bindVertices[vertex * 8];
+        data[0] = 0.1f * std::cos(angle);
+        data[1] = height;
+        data[2] = 0.1f * std::sin(angle);
+        data[3] = std::cos(angle);
+        data[4] = 0.0f;
+        data[5] = std::sin(angle);
+        data[6] = angle;
+        data[7] = height;
+
+        const auto bone = static_cast<std::size_t>(height / kBoneLength);
+        auto& influence = skin->influences[vertex];
+        const float weights[4] = {0.55f, 0.25f, 0.15f, 0.05f};
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            influence.bones[i] = static_cast<std::uint16_t>(std::min(kBoneCount - 1, bone + i));
+            influence.weights[i] = weights[i];
+        }
+    }
+
+    std::vector<OGLE::AnimationClip> clips;
+    clips.push_back(OGLE::AnimationCompressor::CompressClip(source, OGLE::AnimationLibrary::Instance().GetCompressionSettings()));
+    const auto handles = OGLE::AnimationLibrary::Instance().RegisterClips(std::string(), std::move(clips));
+
+    entt::registry registry;
+    OGLE::AnimationSystem animationSystem(registry);
+    std::vector<entt::entity> characters;
+    for (std::size_t i = 0; i < characterCount; ++i)
+    {
+        const auto entity = registry.create();
+        registry.emplace<OGLE::WorldObjectComponent>(entity);
+        auto& animation = registry.emplace<OGLE::AnimationComponent>(entity);
+        animation.enabled = true;
+        animation.playing = true;
+        animation.clips = handles;
+        animation.currentClip = handles.front()->name;
+        animation.duration = handles.front()->duration;
+        animation.currentTime = std::fmod(0.021f * static_cast<float>(i), animation.duration);
+        characters.push_back(entity);
+    }
+
+    std::vector<OGLE::SkinningStateComponent> states(characterCount);
+    std::vector<std::vector<float>> vertices(characterCount, skin->bindVertices);
+    const std::size_t chunksPerCharacter = (kVertexCount + kVerticesPerChunk - 1) / kVerticesPerChunk;
+    const auto& poses = registry.storage<OGLE::AnimationPoseComponent>();
+
+    const auto frame = [&]() {
+        animationSystem.Update(1.0f / 60.0f);
+        JobSystem::Instance().ParallelFor(characterCount, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                OGLE::SkinningSystem::ComputePalette(*skin, handles.front().get(), &poses.get(characters[i]), states[i]);
+            }
+        }, 1);
+        JobSystem::Instance().ParallelFor(characterCount * chunksPerCharacter, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t chunk = begin; chunk < end; ++chunk)
+            {
+                const std::size_t character = chunk / chunksPerCharacter;
+                const std::size_t first = (chunk % chunksPerCharacter) * kVerticesPerChunk;
+                OGLE::SkinningSystem::SkinVertices(*skin, states[character].palette.data(), first,
+                    std::min(kVertexCount, first + kVerticesPerChunk), vertices[character].data());
+            }
+        }, 1);
+    };
+
+    std::ostringstream title;
+    title << "Skinning benchmark: " << characterCount << " characters x " << kVertexCount << " vertices, "
+          << kBoneCount << " bones";
+    return RunScalingBenchmark(title.str(), iterations, frame, [&](std::uint32_t) { frame(); });
+}
+
+// .omdl load time: the same synthetic grid mesh (triangleCount triangles) saved as
+// legacy JSON v1 and as binary v3, each loaded `iterations` times. Also checks
+// that a v3 save/load round trip reproduces the mesh exactly.
+int RunModelFormatBenchmark(std::size_t triangleCount, std::uint32_t iterations)
+{
+    const std::size_t side = std::max<std::size_t>(1, static_cast<std::size_t>(std::sqrt(static_cast<double>(triangleCount) / 2.0)));
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+    vertices.reserve((side + 1) * (side + 1) * 8);
+    indices.reserve(side * side * 6);
+    for (std::size_t z = 0; z <= side; ++z)
+    {
+        for (std::size_t x = 0; x <= side; ++x)
+        {
+            const float u = static_cast<float>(x) / side;
+            const float v = static_cast<float>(z) / side;
+            const float vertex[8] = {u, 0.05f * std::sin(u * 40.0f) * std::cos(v * 40.0f), v, 0.0f, 1.0f, 0.0f, u, v};
+            vertices.insert(vertices.end(), vertex, vertex + 8);
+        }
+    }
+    for (std::size_t z = 0; z < side; ++z)
+    {
+        for (std::size_t x = 0; x < side; ++x)
+        {
+            const auto corner = static_cast<unsigned int>(z * (side + 1) + x);
+            const auto below = static_cast<unsigned int>(corner + side + 1);
+            const unsigned int quad[6] = {corner, below, corner + 1, corner + 1, below, below + 1};
+            indices.insert(indices.end(), quad, quad + 6);
+        }
+    }
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    const std::filesystem::path jsonPath = directory / "ogle_bench_v1.omdl";
+    const std::filesystem::path binaryPath = directory / "ogle_bench_v3.omdl";
+
+    nlohmann::json legacy;
+    legacy["version"] = 1;
+    legacy["mesh"] = {{"vertices", vertices}, {"indices", indices}};
+    legacy["skeleton"] = {{"boneCount", 0}};
+    if (!FileSystem::WriteTextFile(jsonPath, legacy.dump(4)))
+    {
+        std::cerr << "Failed to write " << jsonPath.string() << std::endl;
+        return 1;
+    }
+
+    OGLE::ModelEntity source;
+    source.SetMeshData(vertices, indices);
+    if (!source.SaveToCustomFile(binaryPath.string()))
+    {
+        std::cerr << "Failed to write " << binaryPath.string() << std::endl;
+        return 1;
+    }
+
+    OGLE::ModelEntity loaded;
+    const bool roundTrip = loaded.LoadCustomFile(binaryPath.string())
+        && loaded.GetVertices() == vertices && loaded.GetIndices() == indices;
+
+    const auto timeLoads = [iterations](const std::filesystem::path& path) {
+        const auto start = std::chrono::steady_clock::now();
+        for (std::uint32_t i = 0; i < iterations; ++i)
+        {
+            OGLE::BaseModel model;
+            model.LoadCustomFile(path.string());
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+    };
+    const double jsonMs = timeLoads(jsonPath);
+    const double binaryMs = timeLoads(binaryPath);
+
+    std::error_code errorCode;
+    const double megabyte = 1024.0 * 1024.0;
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(3);
+    report << ".omdl load benchmark: " << indices.size() / 3 << " triangles, " << iterations << " iterations\n";
+    report << "  v1 json:   " << std::filesystem::file_size(jsonPath, errorCode) / megabyte << " MB, " << jsonMs << " ms/load\n";
+    report << "  v3 binary: " << std::filesystem::file_size(binaryPath, errorCode) / megabyte << " MB, " << binaryMs << " ms/load, x"
+           << (binaryMs > 0.0 ? jsonMs / binaryMs : 0.0) << "\n";
+    report << "  v3 round trip: " << (roundTrip ? "exact" : "MISMATCH") << "\n";
+    LOG_INFO(report.str());
+    std::cout << report.str();
+
+    std::filesystem::remove(jsonPath, errorCode);
+    std::filesystem::remove(binaryPath, errorCode);
+    return roundTrip ? 0 : 1;
+}
+
+// Spawning entityCount primitives (cubes, spheres and planes in turn) into a World:
+// once with a private mesh per entity (the previous PrimitiveFactory behaviour) and
+// once through MeshCache. Reports spawn time, vertex/index buffer bytes, the CPU
+// copies MeshCache keeps for detaching and serialization, and index bytes with 32-bit
+// indices vs the width MeshBuffer selects per mesh. The null render path still sizes
+// buffers.
+int RunSpawnBenchmark(std::size_t entityCount)
+{
+    const OGLE::PrimitiveType kTypes[] = {OGLE::PrimitiveType::Cube, OGLE::PrimitiveType::Sphere, OGLE::PrimitiveType::Plane};
+    constexpr std::size_t kTypeCount = sizeof(kTypes) / sizeof(kTypes[0]);
+    std::vector<float> vertices[kTypeCount];
+    std::vector<unsigned int> indices[kTypeCount];
+    std::size_t meshBytes = 0;
+    std::size_t wideIndexBytes = 0;
+    std::size_t indexBytes = 0;
+    for (std::size_t type = 0; type < kTypeCount; ++type)
+    {
+        PrimitiveFactory::BuildPrimitiveGeometry(kTypes[type], vertices[type], indices[type]);
+        const std::size_t count = entityCount / kTypeCount + (type < entityCount % kTypeCount ? 1 : 0);
+        const std::size_t indexSize = OGLE::GetIndexSize(OGLE::SelectIndexFormat(vertices[type].size() / 8));
+        meshBytes += count * (vertices[type].size() * sizeof(float) + indices[type].size() * indexSize);
+        wideIndexBytes += count * indices[type].size() * sizeof(std::uint32_t);
+        indexBytes += count * indices[type].size() * indexSize;
+    }
+
+    // onSpawned runs while the world (and its meshes) is still alive.
+    const auto spawn = [entityCount](
+        const std::function<std::shared_ptr<OGLE::ModelEntity>(std::size_t)>& makeModel,
+        const std::function<void()>& onSpawned) {
+        OGLE::World world;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < entityCount; ++i)
+        {
+            const float f = static_cast<float>(i);
+            const auto entity = world.AddModel(makeModel(i % kTypeCount), "Primitive" + std::to_string(i));
+            world.SetTransform(entity, glm::vec3(f, 0.0f, -f), glm::vec3(0.0f), glm::vec3(1.0f));
+        }
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        onSpawned();
+        return ms;
+    };
+
+    const double uniqueMs = spawn(
+        [&](std::size_t type) {
+            auto model = std::make_shared<OGLE::ModelEntity>(OGLE::ModelType::STATIC);
+            model->SetMeshData(vertices[type], indices[type]);
+            return model;
+        },
+        []() {});
+
+    OGLE::MeshCacheStats cacheStats;
+    const double cachedMs = spawn(
+        [&](std::size_t type) { return PrimitiveFactory::CreatePrimitiveModel(kTypes[type]); },
+        [&]() { cacheStats = OGLE::MeshCache::Instance().GetStats(); });
+
+    const double kilobyte = 1024.0;
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(3);
+    report << "Spawn benchmark: " << entityCount << " primitives (cube, sphere, plane)\n";
+    report << "  unique meshes: " << uniqueMs << " ms, " << meshBytes / kilobyte << " KB GPU buffers\n";
+    report << "  MeshCache:     " << cachedMs << " ms, " << cacheStats.gpuBytes / kilobyte << " KB GPU buffers, "
+           << cacheStats.cpuBytes / kilobyte << " KB CPU copies (" << cacheStats.liveMeshes << " meshes, "
+           << cacheStats.hits << " hits, " << cacheStats.misses << " misses)\n";
+    report << "  index buffers: " << wideIndexBytes / kilobyte << " KB as uint32, " << indexBytes / kilobyte
+           << " KB with per-mesh width (-" << (wideIndexBytes > 0 ? 100.0 * (wideIndexBytes - indexBytes) / wideIndexBytes : 0.0)
+           << "%)\n";
+    LOG_INFO(report.str());
+    std::cout << report.str();
+    return 0;
+}
+
+// Imports `path` with the optimizer disabled, then runs every MeshOptimizer stage
+// on the raw geometry and prints ACMR/ATVR after each one (asset-pipeline metrics).
+int RunMeshOptimizerReport(const std::string& path)
+{
+    OGLE::MeshCache& meshCache = OGLE::MeshCache::Instance();
+    const OGLE::MeshOptimizerSettings settings = meshCache.GetOptimizerSettings();
+    OGLE::MeshOptimizerSettings disabled;
+    disabled.weldVertices = false;
+    disabled.optimizeVertexCache = false;
+    disabled.optimizeOverdraw = false;
+    disabled.optimizeVertexFetch = false;
+    meshCache.SetOptimizerSettings(disabled);
+
+    OGLE::ModelEntity model;
+    const bool loaded = model.LoadFromFile(path);
+    meshCache.SetOptimizerSettings(settings);
+    if (!loaded)
+    {
+        std::cerr << "Failed to load mesh: " << path << std::endl;
+        return 1;
+    }
+
+    const OGLE::ModelEntity& source = model;
+    std::vector<float> vertices = source.GetVertices();
+    std::vector<unsigned int> indices = source.GetIndices();
+    std::vector<OGLE::SkinInfluence> influences;
+    if (const OGLE::SkinData* skin = source.GetSkin())
+    {
+        influences = skin->influences;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const OGLE::MeshOptimizerReport report = OGLE::MeshOptimizer::Optimize(
+        vertices, indices, settings, influences.empty() ? nullptr : &influences);
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(3);
+    text << "Mesh optimizer: " << path << ", " << OGLE::MeshOptimizer::FormatReport(report) << "\n";
+    text << "  total " << ms << " ms\n";
+    LOG_INFO(text.str());
+    std::cout << text.str();
+    return 0;
+}
+
+// Builds the LOD chain of `path` with the MeshCache settings and prints triangle
+// reduction per level, then moves a camera away from the mesh and prints the level
+// LODSystem selects at each distance. Non-zero exit when the selection is not
+// monotonic (finer level farther away) or never reaches the coarsest level.
+int RunLODReport(const std::string& path)
+{
+    OGLE::ModelEntity model;
+    if (!model.LoadFromFile(path))
+    {
+        std::cerr << "Failed to load mesh: " << path << std::endl;
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    model.GenerateLODs(OGLE::MeshCache::Instance().GetLODSettings());
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    const OGLE::MeshLODChain* chain = model.GetLODs();
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(3);
+    report << "LOD chain: " << path << "\n";
+    if (!chain)
+    {
+        report << "  no levels (mesh below lod.minTriangles, skinned, or not simplifiable)\n";
+        LOG_INFO(report.str());
+        std::cout << report.str();
+        return 0;
+    }
+    report << "  " << OGLE::MeshSimplifier::FormatReport(*chain) << "\n";
+    report << "  generated in " << ms << " ms\n";
+
+    // 45-degree vertical field of view; the camera backs away along +Z.
+    const float projectionScaleY = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 1000.0f)[1][1];
+    const int coarsestLevel = static_cast<int>(chain->levels.size());
+    const float radius = std::max(chain->radius, 1.0e-3f);
+    OGLE::LODComponent lod;
+    int previousLevel = 0;
+    bool monotonic = true;
+    report << "  selection (distance in bounding radii: screen size -> level):";
+    for (int step = 0; step <= 24; ++step)
+    {
+        const float distance = radius * std::pow(2.0f, static_cast<float>(step) * 0.5f);
+        const int level = OGLE::LODSystem::Update(
+            lod, *chain, glm::mat4(1.0f), chain->center + glm::vec3(0.0f, 0.0f, distance), projectionScaleY);
+        monotonic = monotonic && level >= previousLevel;
+        previousLevel = level;
+        report << (step % 4 == 0 ? "\n    " : ", ") << distance / radius << ": " << lod.screenSize << " -> " << level;
+    }
+    const bool passed = monotonic && previousLevel == coarsestLevel;
+    report << "\n  " << (passed ? "selection monotonic, coarsest level reached" : "SELECTION FAILED") << "\n";
+    LOG_INFO(report.str());
+    std::cout << report.str();
+    return passed ? 0 : 1;
+}
+
+// Loads `path` once synchronously (the main-thread stall of
+// World::CreateModelFromFile) and once through CreateModelFromFileAsync with a simulated 60 Hz
+// frame loop: prints the time the spawning call blocks, the frames until the mesh
+// is swapped in and the worst per-frame upload time. Non-zero exit if it fails.
+int RunImportBenchmark(const std::string& path)
+{
+    JobSystem::Instance().Initialize();
+    const double uploadBudgetMs = AppConfig{}.assets.uploadBudgetMs;
+
+    double syncMs = 0.0;
+    {
+        // The world keeps the only reference: the cache entry expires with it.
+        OGLE::World world;
+        const auto start = std::chrono::steady_clock::now();
+        const auto entity = world.CreateModelFromFile(path, OGLE::ModelType::STATIC, "SyncImport");
+        syncMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (!world.IsValid(entity))
+        {
+            std::cerr << "Failed to load mesh: " << path << std::endl;
+            JobSystem::Instance().Shutdown();
+            return 1;
+        }
+    }
+
+    OGLE::World world;
+    const auto callStart = std::chrono::steady_clock::now();
+    const auto entity = world.CreateModelFromFileAsync(path, OGLE::ModelType::STATIC, "AsyncImport");
+    const double asyncCallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - callStart).count();
+
+    const auto frameTime = std::chrono::duration<double, std::milli>(1000.0 / 60.0);
+    std::vector<OGLE::ModelReadyEvent> ready;
+    std::uint32_t frames = 0;
+    double worstUploadMs = 0.0;
+    while (ready.empty() && frames < 60 * 60)
+    {
+        const auto frameStart = std::chrono::steady_clock::now();
+        OGLE::ModelImportQueue::Instance().ProcessUploads(uploadBudgetMs);
+        worstUploadMs = std::max(worstUploadMs, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count());
+        ready = world.TakeReadyModels();
+        ++frames;
+        std::this_thread::sleep_until(frameStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(frameTime));
+    }
+
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(3);
+    report << "Import benchmark: " << path << " (" << JobSystem::Instance().GetWorkerCount() << " workers, upload budget "
+           << uploadBudgetMs << " ms)\n";
+    report << "  synchronous:  " << syncMs << " ms main-thread stall\n";
+    report << "  asynchronous: " << asyncCallMs << " ms in CreateModelFromFileAsync, ready after " << frames
+           << " frames, worst upload frame " << worstUploadMs << " ms\n";
+    const OGLE::ImportCacheStats cacheStats = OGLE::ImportCache::Instance().GetStats();
+    report << "  import cache: " << cacheStats.hits << " hits, " << cacheStats.misses << " misses, "
+           << cacheStats.importMs - cacheStats.loadMs << " ms saved\n";
+    const bool loaded = !ready.empty() && ready.front().entity == entity && ready.front().success;
+    if (!loaded)
+    {
+        report << "  async import did not complete\n";
+    }
+    LOG_INFO(report.str());
+    std::cout << report.str();
+    JobSystem::Instance().Shutdown();
+    return loaded ? 0 : 1;
+}
+
+// Packs `vertexCount` random vertices (with 4 bone influences) into the quantized
+// layout, unpacks them and checks every attribute against the documented error
+// bounds. Non-zero exit when any bound is exceeded.
+int RunQuantizationCheck(std::size_t vertexCount)
+{
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<float> vertices;
+    std::vector<OGLE::SkinInfluence> influences(vertexCount);
+    vertices.reserve(vertexCount * 8);
+    for (std::size_t i = 0; i < vertexCount; ++i)
+    {
+        glm::vec3 normal(unit(random), unit(random), unit(random));
+        normal = glm::length(normal) > 1.0e-3f ? glm::normalize(normal) : glm::vec3(0.0f, 1.0f, 0.0f);
+        const float vertex[8] = {unit(random) * 50.0f, unit(random) * 3.0f + 10.0f, unit(random) * 200.0f,
+            normal.x, normal.y, normal.z, unit(random) * 4.0f, unit(random) * 0.5f + 0.5f};
+        vertices.insert(vertices.end(), vertex, vertex + 8);
+
+        float sum = 0.0f;
+        for (int k = 0; k < 4; ++k)
+        {
+            influences[i].bones[k] = static_cast<std::uint16_t>(random() % 256);
+            influences[i].weights[k] = std::abs(unit(random)) + 1.0e-3f;
+            sum += influences[i].weights[k];
+        }
+        for (float& weight : influences[i].weights)
+        {
+            weight /= sum;
+        }
+    }
+
+    OGLE::VertexLayout layout = OGLE::VertexLayout::Create(OGLE::VertexFormat::Quantized, true);
+    std::vector<std::uint8_t> packed;
+    const auto start = std::chrono::steady_clock::now();
+    if (!OGLE::VertexQuantization::PackVertices(vertices, &influences, layout, packed))
+    {
+        std::cerr << "PackVertices failed" << std::endl;
+        return 1;
+    }
+    const double packMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<float> unpacked;
+    std::vector<OGLE::SkinInfluence> unpackedInfluences;
+    OGLE::VertexQuantization::UnpackVertices(packed.data(), vertexCount, layout, unpacked, &unpackedInfluences);
+
+    // Worst error of each attribute as a fraction of its bound (<= 1 passes).
+    const glm::vec3 positionTolerance = OGLE::VertexQuantization::GetPositionTolerance(layout);
+    double positionRatio = 0.0;
+    double normalRatio = 0.0;
+    double uvRatio = 0.0;
+    double weightRatio = 0.0;
+    std::size_t boneMismatches = 0;
+    for (std::size_t i = 0; i < vertexCount; ++i)
+    {
+        const float* source = vertices.data() + i * 8;
+        const float* result = unpacked.data() + i * 8;
+        for (int k = 0; k < 3; ++k)
+        {
+            positionRatio = std::max(positionRatio, static_cast<double>(std::abs(result[k] - source[k]) / positionTolerance[k]));
+        }
+
+        const glm::dvec3 a(source[3], source[4], source[5]);
+        const glm::dvec3 b(result[3], result[4], result[5]);
+        const double angle = std::atan2(glm::length(glm::cross(a, b)), glm::dot(a, b));
+        normalRatio = std::max(normalRatio, angle / OGLE::VertexQuantization::kOctNormalMaxAngle);
+
+        for (int k = 6; k < 8; ++k)
+        {
+            const float bound = std::max(std::abs(source[k]) * std::ldexp(1.0f, -11), std::ldexp(1.0f, -25));
+            uvRatio = std::max(uvRatio, static_cast<double>(std::abs(result[k] - source[k]) / bound));
+        }
+
+        for (int k = 0; k < 4; ++k)
+        {
+            weightRatio = std::max(weightRatio, static_cast<double>(std::abs(unpackedInfluences[i].weights[k] - influences[i].weights[k]) * 255.0f));
+            boneMismatches += unpackedInfluences[i].bones[k] != influences[i].bones[k] ? 1 : 0;
+        }
+    }
+
+    const bool passed = positionRatio <= 1.0 && normalRatio <= 1.0 && uvRatio <= 1.0 && weightRatio <= 1.0 && boneMismatches == 0;
+    const OGLE::VertexLayout floatLayout = OGLE::VertexLayout::Create(OGLE::VertexFormat::Float32, true);
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(3);
+    report << "Vertex quantization: " << vertexCount << " vertices, " << floatLayout.stride << " -> " << layout.stride
+           << " bytes/vertex (" << OGLE::VertexLayout::Create(OGLE::VertexFormat::Float32).stride << " -> "
+           << OGLE::VertexLayout::Create(OGLE::VertexFormat::Quantized).stride << " without bones), pack " << packMs << " ms\n";
+    report << "  error / bound: position " << positionRatio << ", normal " << normalRatio << ", uv " << uvRatio
+           << ", weight " << weightRatio << ", bone index mismatches " << boneMismatches << "\n";
+    report << "  " << (passed ? "all within bounds" : "BOUND EXCEEDED") << "\n";
+    LOG_INFO(report.str());
+    std::cout << report.str();
+    return passed ? 0 : 1;
+}
+
+// Prints a failed expectation of a --test check and returns `condition`.
+bool Expect(bool condition, const std::string& what)
+{
+    if (!condition)
+    {
+        std::cerr << "  FAILED: " << what << std::endl;
+    }
+    return condition;
+}
+
+// --test quantization: the error bounds documented in VertexLayout.h on the inputs
+// the random --bench-quantize run rarely hits: a flat AABB axis, axis-aligned and
+// fold-edge normals, half-float range limits and weight splits that don't divide 255.
+bool TestVertexQuantization()
+{
+    namespace Quantization = OGLE::VertexQuantization;
+    bool passed = true;
+
+    const float r = 1.0f / std::sqrt(3.0f);
+    const glm::vec3 normals[] = {
+        {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1},
+        {r, r, r}, {-r, r, -r}, {r, -r, -r}, {-r, -r, -r},
+        glm::normalize(glm::vec3(1.0f, 1.0f, 0.0f)), glm::normalize(glm::vec3(-1.0f, 0.0f, -1.0e-4f)),
+        glm::normalize(glm::vec3(1.0e-4f, 1.0e-4f, -1.0f)), glm::normalize(glm::vec3(0.3f, -0.7f, -1.0e-6f))};
+    const float texCoords[] = {0.0f, 1.0f, -1.0f, 0.5f, 1.0f / 3.0f, 1.0e-3f, 1.0e-6f, -2047.75f, 65504.0f};
+    const float weightSets[][4] = {
+        {1.0f, 0.0f, 0.0f, 0.0f}, {0.25f, 0.25f, 0.25f, 0.25f}, {1.0f / 3.0f, 1.0f / 3.0f, 1.0f / 3.0f, 0.0f},
+        {0.5f, 0.5f, 0.0f, 0.0f}, {0.997f, 0.001f, 0.001f, 0.001f}, {0.0f, 0.0f, 0.0f, 0.0f}};
+    constexpr std::size_t kNormalCount = sizeof(normals) / sizeof(normals[0]);
+    constexpr std::size_t kTexCoordCount = sizeof(texCoords) / sizeof(texCoords[0]);
+    constexpr std::size_t kWeightSetCount = sizeof(weightSets) / sizeof(weightSets[0]);
+
+    // Z is the same for every vertex: a zero-size AABB axis must decode to its offset.
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    const std::size_t vertexCount = 256;
+    std::vector<float> vertices;
+    std::vector<OGLE::SkinInfluence> influences(vertexCount);
+    for (std::size_t i = 0; i < vertexCount; ++i)
+    {
+        const glm::vec3& normal = normals[i % kNormalCount];
+        const float x = i == 0 ? -3.0f : i == 1 ? 5.0f : -3.0f + 8.0f * unit(random);
+        const float y = i == 0 ? 1000.0f : i == 1 ? 1000.5f : 1000.0f + 0.5f * unit(random);
+        const float vertex[8] = {x, y, 2.5f, normal.x, normal.y, normal.z,
+            texCoords[i % kTexCoordCount], texCoords[(i + 3) % kTexCoordCount]};
+        vertices.insert(vertices.end(), vertex, vertex + 8);
+        for (int k = 0; k < 4; ++k)
+        {
+            influences[i].bones[k] = static_cast<std::uint16_t>((i * 4 + k) % 256);
+            influences[i].weights[k] = weightSets[i % kWeightSetCount][k];
+        }
+    }
+
+    OGLE::VertexLayout layout = OGLE::VertexLayout::Create(OGLE::VertexFormat::Quantized, true);
+    std::vector<std::uint8_t> packed;
+    passed &= Expect(Quantization::PackVertices(vertices, &influences, layout, packed), "PackVertices with 8-bit bone indices");
+    passed &= Expect(packed.size() == vertexCount * layout.stride, "packed size is vertexCount * stride");
+    if (!passed)
+    {
+        return false;
+    }
+    passed &= Expect(layout.positionOffset == glm::vec3(-3.0f, 1000.0f, 2.5f), "position offset is the AABB minimum");
+    passed &= Expect(layout.positionScale.z == 0.0f, "flat axis has zero scale");
+
+    std::vector<float> unpacked;
+    std::vector<OGLE::SkinInfluence> unpackedInfluences;
+    Quantization::UnpackVertices(packed.data(), vertexCount, layout, unpacked, &unpackedInfluences);
+
+    const glm::vec3 tolerance = Quantization::GetPositionTolerance(layout);
+    for (std::size_t i = 0; i < vertexCount && passed; ++i)
+    {
+        const float* source = vertices.data() + i * 8;
+        const float* result = unpacked.data() + i * 8;
+        const std::string vertex = "vertex " + std::to_string(i) + ": ";
+        for (int k = 0; k < 3; ++k)
+        {
+            passed &= Expect(std::abs(result[k] - source[k]) <= tolerance[k], vertex + "position within half a grid step");
+        }
+
+        const glm::dvec3 a(source[3], source[4], source[5]);
+        const glm::dvec3 b(result[3], result[4], result[5]);
+        const double angle = std::atan2(glm::length(glm::cross(a, b)), glm::dot(a, b));
+        passed &= Expect(angle <= Quantization::kOctNormalMaxAngle, vertex + "normal within kOctNormalMaxAngle");
+
+        // Half keeps 11 significant bits; below 2^-14 it is denormal with a 2^-24 step.
+        for (int k = 6; k < 8; ++k)
+        {
+            const float bound = std::max(std::abs(source[k]) * std::ldexp(1.0f, -11), std::ldexp(1.0f, -25));
+            passed &= Expect(std::abs(result[k] - source[k]) <= bound, vertex + "uv within half precision");
+        }
+
+        int weightSum = 0;
+        float sourceTotal = 0.0f;
+        for (int k = 0; k < 4; ++k)
+        {
+            sourceTotal += influences[i].weights[k];
+        }
+        for (int k = 0; k < 4; ++k)
+        {
+            const int quantized = static_cast<int>(std::lround(unpackedInfluences[i].weights[k] * 255.0f));
+            weightSum += quantized;
+            passed &= Expect(unpackedInfluences[i].bones[k] == influences[i].bones[k], vertex + "bone index kept");
+            if (sourceTotal > 0.0f)
+            {
+                passed &= Expect(std::abs(unpackedInfluences[i].weights[k] - influences[i].weights[k] / sourceTotal) <= 1.0f / 255.0f,
+                    vertex + "weight within 1/255");
+            }
+        }
+        passed &= Expect(weightSum == 255, vertex + "weights sum to exactly 255");
+    }
+
+    // Values half represents exactly survive unchanged, larger ones become infinity.
+    for (const float exact : {0.0f, 0.5f, 1.0f, -2.0f, 1024.0f, 65504.0f, std::ldexp(1.0f, -24)})
+    {
+        passed &= Expect(Quantization::HalfToFloat(Quantization::FloatToHalf(exact)) == exact, "exact half " + std::to_string(exact));
+    }
+    passed &= Expect(std::isinf(Quantization::HalfToFloat(Quantization::FloatToHalf(65520.0f))), "65520 rounds to infinity");
+
+    // A single full weight stays exactly 255, an all-zero set goes to the first bone.
+    std::uint8_t quantizedWeights[4];
+    Quantization::QuantizeWeights(weightSets[0], quantizedWeights);
+    passed &= Expect(quantizedWeights[0] == 255 && quantizedWeights[1] == 0, "single bone weight is 255");
+    Quantization::QuantizeWeights(weightSets[kWeightSetCount - 1], quantizedWeights);
+    passed &= Expect(quantizedWeights[0] == 255 && quantizedWeights[1] == 0, "zero weights go to the first bone");
+
+    // Layouts the 8-bit bone attributes can't hold are rejected, not truncated.
+    influences[5].bones[2] = 256;
+    OGLE::VertexLayout rejected = OGLE::VertexLayout::Create(OGLE::VertexFormat::Quantized, true);
+    passed &= Expect(!Quantization::PackVertices(vertices, &influences, rejected, packed), "bone index 256 is rejected");
+    passed &= Expect(!Quantization::PackVertices(vertices, nullptr, rejected, packed), "missing influences are rejected");
+
+    // The Float32 layout is a lossless copy.
+    OGLE::VertexLayout floatLayout = OGLE::VertexLayout::Create(OGLE::VertexFormat::Float32);
+    passed &= Expect(Quantization::PackVertices(vertices, nullptr, floatLayout, packed), "PackVertices Float32");
+    Quantization::UnpackVertices(packed.data(), vertexCount, floatLayout, unpacked);
+    passed &= Expect(unpacked == vertices, "Float32 round trip is exact");
+    return passed;
+}
+
+// ModelEntity with the protected geometry and submesh setters, standing in for an import.
+class SubmeshTestModel : public OGLE::ModelEntity
+{
+public:
+    using OGLE::ModelEntity::ModelEntity;
+    using OGLE::BaseModel::SetMeshGeometry;
+    using OGLE::BaseModel::SetSubmeshes;
+};
+
+// --test detached-materials: a shared two-slot cube keeps its slot textures when it
+// is detached (copy on write) or copied, and drops them with new geometry.
+bool TestDetachedMaterialTextures()
+{
+    bool passed = true;
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+    PrimitiveFactory::BuildPrimitiveGeometry(OGLE::PrimitiveType::Cube, vertices, indices);
+
+    OGLE::MeshSubmesh first;
+    first.indexCount = static_cast<std::uint32_t>(indices.size() / 2);
+    first.materialIndex = 0;
+    OGLE::MeshSubmesh second;
+    second.indexOffset = first.indexCount;
+    second.indexCount = static_cast<std::uint32_t>(indices.size()) - first.indexCount;
+    second.materialIndex = 1;
+    OGLE::MeshMaterialSlot textured;
+    textured.name = "textured";
+    textured.diffuseTexturePath = FileSystem::ResolvePath("assets/Q4JOI.jpg").string();
+    OGLE::MeshMaterialSlot plain;
+    plain.name = "plain";
+
+    SubmeshTestModel source(OGLE::ModelType::STATIC);
+    source.SetMeshData(vertices, indices);
+    source.SetSubmeshes({first, second}, {textured, plain});
+    const std::shared_ptr<OGLE::SharedMesh> mesh = source.CreateSharedMesh("test:detached-materials");
+    passed &= Expect(mesh->materialTextures.size() == 2 && mesh->materialTextures[0], "shared mesh loads the slot texture " + textured.diffuseTexturePath);
+    if (!passed)
+    {
+        return false;
+    }
+
+    OGLE::ModelEntity detached(OGLE::ModelType::STATIC);
+    detached.ShareMesh(mesh);
+    passed &= Expect(detached.GetMaterialTexture(0) == mesh->materialTextures[0].get(), "shared model reads the slot texture");
+    passed &= Expect(detached.DetachMesh() && !detached.IsMeshShared(), "DetachMesh gives the model its own mesh");
+    passed &= Expect(detached.GetSubmeshes().size() == 2 && detached.GetMaterialSlots().size() == 2, "submeshes and slots are copied");
+    passed &= Expect(detached.GetMaterialTexture(0) == mesh->materialTextures[0].get(), "slot texture survives DetachMesh");
+    passed &= Expect(detached.GetMaterialTexture(1) == nullptr, "slot without texture stays without one");
+
+    // World::MakeModelUnique copies a shared ModelEntity, then detaches the copy.
+    OGLE::ModelEntity copy(detached);
+    passed &= Expect(copy.DetachMesh() && copy.GetMaterialTexture(0) == mesh->materialTextures[0].get(), "a copy of the detached model keeps the texture");
+
+    detached.SetMeshData(vertices, indices);
+    passed &= Expect(detached.GetMaterialSlots().empty() && detached.GetMaterialTexture(0) == nullptr, "new geometry drops slots and their textures");
+    return passed;
+}
+
+// --test hierarchy-destroy: destroying a root entity swaps other nodes into its slot of
+// the HierarchyComponent storage; parents must still be propagated before their
+// children in the same frame.
+bool TestHierarchyAfterDestroy()
+{
+    bool passed = true;
+    OGLE::World world;
+    constexpr int kPairs = 8;
+    std::vector<OGLE::Entity> roots;
+    std::vector<OGLE::Entity> children;
+    for (int i = 0; i < kPairs; ++i)
+    {
+        const OGLE::Entity root = world.CreateEntity("Root" + std::to_string(i));
+        const OGLE::Entity child = world.CreateEntity("Child" + std::to_string(i));
+        world.SetTransform(root, glm::vec3(static_cast<float>(i), 0.0f, 0.0f), glm::vec3(0.0f), glm::vec3(1.0f));
+        world.SetTransform(child, glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f), glm::vec3(1.0f));
+        passed &= Expect(world.SetParent(child, root), "SetParent " + std::to_string(i));
+        roots.push_back(root);
+        children.push_back(child);
+    }
+    world.UpdateTransforms();
+
+    // Roots 0 and 3 are destroyed, the others move in the same frame.
+    world.DestroyEntity(roots[0]);
+    world.DestroyEntity(roots[3]);
+    for (int i = 0; i < kPairs; ++i)
+    {
+        if (i == 0 || i == 3)
+        {
+            passed &= Expect(!world.IsValid(children[i]), "child " + std::to_string(i) + " is destroyed with its root");
+            continue;
+        }
+        world.SetTransform(roots[i], glm::vec3(static_cast<float>(i), 10.0f, 0.0f), glm::vec3(0.0f), glm::vec3(1.0f));
+    }
+    world.UpdateTransforms();
+
+    for (int i = 0; i < kPairs; ++i)
+    {
+        if (i == 0 || i == 3)
+        {
+            continue;
+        }
+        const glm::mat4* matrix = world.GetWorldMatrix(children[i]);
+        const glm::vec3 expected(static_cast<float>(i), 11.0f, 0.0f);
+        passed &= Expect(matrix && glm::length(glm::vec3((*matrix)[3]) - expected) < 1.0e-5f,
+            "child " + std::to_string(i) + " follows its moved root");
+    }
+    return passed;
+}
+
+// World bounds and render proxy bounds of `entity` are the model's local bounds moved by `offset`.
+bool ExpectBoundsFollowModel(const OGLE::World& world, OGLE::Entity entity, const glm::vec3& offset, const std::string& step)
+{
+    const OGLE::MeshBounds& local = world.GetModel(entity)->GetBounds();
+    const OGLE::WorldBoundsComponent* bounds = world.GetWorldBounds(entity);
+    bool passed = Expect(bounds
+        && glm::length(bounds->min - (local.min + offset)) < 1.0e-4f
+        && glm::length(bounds->max - (local.max + offset)) < 1.0e-4f
+        && std::abs(bounds->radius - local.radius) < 1.0e-4f,
+        step + ": WorldBoundsComponent matches the new mesh");
+
+    const OGLE::RenderProxies& proxies = world.GetRenderProxies();
+    const auto proxy = std::find(proxies.entities.begin(), proxies.entities.end(), entity);
+    const glm::vec4 expected(local.center + offset, local.radius);
+    passed &= Expect(proxy != proxies.entities.end()
+        && glm::length(proxies.bounds[static_cast<std::size_t>(proxy - proxies.entities.begin())] - expected) < 1.0e-4f,
+        step + ": render proxy bounds match the new mesh");
+    return passed;
+}
+
+// --test bounds: UpdateGeometry, SetMeshData and ShareMesh on a model that is already
+// in the world move its WorldBoundsComponent and render proxy bounds on the next
+// UpdateTransforms, without touching the transform.
+bool TestBoundsAfterGeometryChange()
+{
+    bool passed = true;
+    OGLE::World world;
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+    PrimitiveFactory::BuildPrimitiveGeometry(OGLE::PrimitiveType::Cube, vertices, indices);
+
+    auto model = std::make_shared<SubmeshTestModel>(OGLE::ModelType::DYNAMIC);
+    model->SetMeshGeometry(vertices, indices);
+    model->BakeToGPU();
+    const OGLE::Entity entity = world.AddModel(model, "Bounds");
+    const glm::vec3 offset(5.0f, -2.0f, 1.0f);
+    world.SetTransform(entity, offset, glm::vec3(0.0f), glm::vec3(1.0f));
+    world.UpdateTransforms();
+    passed &= ExpectBoundsFollowModel(world, entity, offset, "initial cube");
+    const float cubeRadius = model->GetBounds().radius;
+
+    // Positions are the first 3 of 8 floats per vertex.
+    std::vector<float>& positions = model->GetMutableVertices();
+    for (std::size_t i = 0; i + 8 <= positions.size(); i += 8)
+    {
+        positions[i] = positions[i] * 3.0f + 4.0f;
+        positions[i + 1] *= 3.0f;
+        positions[i + 2] *= 3.0f;
+    }
+    model->UpdateGeometry();
+    world.UpdateTransforms();
+    passed &= Expect(std::abs(model->GetBounds().radius - cubeRadius * 3.0f) < 1.0e-4f, "UpdateGeometry recomputes the local bounds");
+    passed &= ExpectBoundsFollowModel(world, entity, offset, "UpdateGeometry");
+
+    PrimitiveFactory::BuildPrimitiveGeometry(OGLE::PrimitiveType::Sphere, vertices, indices);
+    for (std::size_t i = 0; i + 8 <= vertices.size(); i += 8)
+    {
+        vertices[i + 1] += 10.0f;
+    }
+    model->SetMeshData(vertices, indices);
+    world.UpdateTransforms();
+    passed &= ExpectBoundsFollowModel(world, entity, offset, "SetMeshData");
+
+    model->ShareMesh(OGLE::MeshCache::Instance().GetPrimitive(OGLE::PrimitiveType::Plane));
+    world.UpdateTransforms();
+    passed &= ExpectBoundsFollowModel(world, entity, offset, "ShareMesh");
+    return passed;
+}
+
+// --test scene-key: scene mesh keys, and the meshKey a scene saves for them, hold a
+// project-relative path that resolves back to the same file on load.
+bool TestSceneMeshKey()
+{
+    bool passed = true;
+    const std::string relativePath = "assets/spiderExport.stl.glb";
+    const std::filesystem::path absolutePath = FileSystem::ResolvePath(relativePath).lexically_normal();
+    const std::string key = OGLE::MeshCache::MakeSceneMeshKey(relativePath, 2);
+    passed &= Expect(key == "scene:" + relativePath + "#2", "relative path gives a relative key, got " + key);
+    passed &= Expect(OGLE::MeshCache::MakeSceneMeshKey(absolutePath.string(), 2) == key, "absolute path gives the same key");
+    passed &= Expect(OGLE::MeshCache::MakeSceneMeshKey("./assets/../" + relativePath, 2) == key, "non-normal path gives the same key");
+    passed &= Expect(FileSystem::ResolvePath(FileSystem::MakeProjectRelative(absolutePath)) == absolutePath,
+        "project-relative path resolves back to " + absolutePath.string());
+    const std::filesystem::path outside = FileSystem::GetWorkingDirectory().root_path() / "ogle-outside" / "model.glb";
+    passed &= Expect(FileSystem::GetWorkingDirectory() == FileSystem::GetWorkingDirectory().root_path()
+        || FileSystem::MakeProjectRelative(outside) == outside, "a file outside the project keeps its absolute path");
+
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+    PrimitiveFactory::BuildPrimitiveGeometry(OGLE::PrimitiveType::Cube, vertices, indices);
+    SubmeshTestModel source(OGLE::ModelType::STATIC);
+    source.SetMeshData(vertices, indices);
+    OGLE::ModelEntity model(OGLE::ModelType::STATIC);
+    model.ShareMesh(source.CreateSharedMesh(key));
+    nlohmann::json json;
+    model.ToJson(json);
+    passed &= Expect(json.value("meshKey", std::string()) == key, "the scene saves the project-relative key");
+    return passed;
+}
+
+// Float at byte `offset` of a packed uniform block.
+float ReadBlockFloat(const OGLE::Std140Writer& writer, std::size_t offset)
+{
+    float value = 0.0f;
+    if (offset + sizeof(value) <= writer.GetOffset())
+    {
+        std::memcpy(&value, writer.GetData() + offset, sizeof(value));
+    }
+    return value;
+}
+
+// --test std140: offsets and sizes of FrameBlock and LightBlock as declared in
+// default.vs/default.fs and written by the renderer, MaterialBlock as written by
+// Material::WriteParameterBlock, plus array stride and vec3 + scalar packing.
+bool TestStd140Layout()
+{
+    bool passed = true;
+    OGLE::Std140Writer writer;
+    // A member of `size` bytes written at `offset` ends at offset + size.
+    const auto expectEnd = [&](std::size_t offset, std::size_t size, const std::string& member) {
+        passed &= Expect(writer.GetOffset() == offset + size,
+            member + " at offset " + std::to_string(offset) + " (ends at " + std::to_string(writer.GetOffset()) + ")");
+    };
+
+    writer.Write(glm::mat4(1.0f));
+    expectEnd(0, 64, "FrameBlock.uLightSpaceMatrix");
+    writer.Write(glm::vec3(0.0f));
+    expectEnd(64, 12, "FrameBlock.uViewPosition");
+    writer.Write(true);
+    expectEnd(76, 4, "FrameBlock.uHasDirectionalLight");
+    writer.Write(glm::vec3(0.0f));
+    expectEnd(80, 12, "FrameBlock.uDirectionalLightDirection");
+    writer.Write(1.5f);
+    expectEnd(92, 4, "FrameBlock.uDirectionalLightIntensity");
+    writer.Write(glm::vec3(0.0f));
+    expectEnd(96, 12, "FrameBlock.uDirectionalLightColor");
+    writer.Write(false);
+    expectEnd(108, 4, "FrameBlock.uDirectionalLightCastsShadows");
+    writer.Write(glm::vec3(0.0f));
+    expectEnd(112, 12, "FrameBlock.uSelectionTint");
+    passed &= Expect(writer.GetSize() == 128, "FrameBlock without uViewProjection is 128 bytes");
+    writer.Write(glm::mat4(1.0f));
+    expectEnd(128, 64, "FrameBlock.uViewProjection");
+    passed &= Expect(writer.GetSize() == 192, "FrameBlock is 192 bytes");
+
+    // vec4 arrays: element i of uPointLightPositionRange at 16 * i.
+    writer.Clear();
+    std::array<glm::vec4, 4> positions;
+    std::array<glm::vec4, 4> colors;
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+        positions[i] = glm::vec4(static_cast<float>(i + 1));
+        colors[i] = glm::vec4(static_cast<float>(i + 10));
+    }
+    writer.WriteArray(positions.data(), positions.size());
+    expectEnd(0, 64, "LightBlock.uPointLightPositionRange[4]");
+    writer.WriteArray(colors.data(), colors.size());
+    expectEnd(64, 64, "LightBlock.uPointLightColorIntensity[4]");
+    writer.Write(std::int32_t(3));
+    expectEnd(128, 4, "LightBlock.uPointLightCount");
+    passed &= Expect(writer.GetSize() == 144, "LightBlock is 144 bytes");
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+        passed &= Expect(ReadBlockFloat(writer, 16 * i) == positions[i].x && ReadBlockFloat(writer, 64 + 16 * i) == colors[i].x,
+            "LightBlock element " + std::to_string(i) + " at stride 16");
+    }
+
+    // Scalar and vec3 arrays are padded to a 16-byte stride too.
+    writer.Clear();
+    const float scalars[3] = {1.0f, 2.0f, 3.0f};
+    writer.WriteArray(scalars, 3);
+    passed &= Expect(writer.GetOffset() == 48 && ReadBlockFloat(writer, 16) == 2.0f && ReadBlockFloat(writer, 32) == 3.0f,
+        "float[3] has a 16-byte stride");
+    writer.Clear();
+    const glm::vec3 vectors[2] = {glm::vec3(1.0f), glm::vec3(2.0f)};
+    writer.WriteArray(vectors, 2);
+    passed &= Expect(writer.GetOffset() == 32 && ReadBlockFloat(writer, 16) == 2.0f, "vec3[2] has a 16-byte stride");
+
+    // A scalar fills the last 4 bytes of a vec3 slot; a vec2 or vec3 does not.
+    writer.Clear();
+    writer.Write(glm::vec3(1.0f));
+    writer.Write(2.0f);
+    expectEnd(12, 4, "float after vec3");
+    writer.Write(glm::vec3(3.0f));
+    writer.Write(glm::vec2(4.0f));
+    expectEnd(32, 8, "vec2 after vec3");
+    writer.Write(glm::vec3(5.0f));
+    expectEnd(48, 12, "vec3 after vec2");
+
+    OGLE::Material material;
+    material.SetBaseColor(glm::vec3(0.1f, 0.2f, 0.3f));
+    material.SetRoughness(0.25f);
+    material.SetEmissiveColor(glm::vec3(0.4f, 0.5f, 0.6f));
+    material.SetMetallic(0.5f);
+    material.SetUvTiling(glm::vec2(2.0f, 3.0f));
+    material.SetUvOffset(glm::vec2(0.5f, 0.75f));
+    material.SetAlphaCutoff(0.125f);
+    writer.Clear();
+    material.WriteParameterBlock(writer);
+    const std::pair<std::size_t, float> materialMembers[] = {
+        {0, 0.1f}, {4, 0.2f}, {8, 0.3f}, {12, 0.25f}, {16, 0.4f}, {20, 0.5f}, {24, 0.6f}, {28, 0.5f},
+        {32, 2.0f}, {36, 3.0f}, {40, 0.5f}, {44, 0.75f}, {48, 0.125f}};
+    for (const auto& [offset, value] : materialMembers)
+    {
+        passed &= Expect(ReadBlockFloat(writer, offset) == value, "MaterialBlock float at offset " + std::to_string(offset));
+    }
+    passed &= Expect(writer.GetSize() == 64, "MaterialBlock is 64 bytes");
+    return passed;
+}
+
+// Checks selected with --test <name>; CMakeLists.txt registers each one with ctest.
+struct SelfTest
+{
+    const char* name;
+    bool (*run)();
+};
+
+const SelfTest kSelfTests[] = {
+    {"quantization", TestVertexQuantization},
+    {"detached-materials", TestDetachedMaterialTextures},
+    {"hierarchy-destroy", TestHierarchyAfterDestroy},
+    {"std140", TestStd140Layout},
+    {"bounds", TestBoundsAfterGeometryChange},
+    {"scene-key", TestSceneMeshKey},
+};
+}
+
+// Entry point of the OGLE3D_headless target.
+// Usage: OGLE3D_headless [--frames N] [--dt seconds] [--bench-jobs entities] [--bench-anim entities] [--bench-skin characters] [--bench-omdl triangles] [--bench-spawn entities] [--mesh-stats path] [--bench-quantize vertices] [--lod-report path] [--bench-import path] [--test name]
+int main(int argc, char** argv)
+{
+    std::uint32_t frameCount = 600;
+    float fixedDeltaTime = 1.0f / 60.0f;
+    std::size_t benchmarkEntities = 0;
+    std::size_t animationBenchmarkEntities = 0;
+    std::size_t skinningBenchmarkCharacters = 0;
+    std::size_t modelFormatBenchmarkTriangles = 0;
+    std::size_t spawnBenchmarkEntities = 0;
+    std::string meshStatsPath;
+    std::size_t quantizationVertices = 0;
+    std::string lodReportPath;
+    std::string importBenchmarkPath;
+    std::string testName;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--frames" && i + 1 < argc)
+        {
+            frameCount = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (argument == "--dt" && i + 1 < argc)
+        {
+            fixedDeltaTime = std::strtof(argv[++i], nullptr);
+        }
+        else if (argument == "--bench-jobs" && i + 1 < argc)
+        {
+            benchmarkEntities = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (argument == "--bench-anim" && i + 1 < argc)
+        {
+            animationBenchmarkEntities = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (argument == "--bench-skin" && i + 1 < argc)
+        {
+            skinningBenchmarkCharacters = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (argument == "--bench-omdl" && i + 1 < argc)
+        {
+            modelFormatBenchmarkTriangles = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (argument == "--bench-spawn" && i + 1 < argc)
+        {
+            spawnBenchmarkEntities = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (argument == "--mesh-stats" && i + 1 < argc)
+        {
+            meshStatsPath = argv[++i];
+        }
+        else if (argument == "--bench-quantize" && i + 1 < argc)
+        {
+            quantizationVertices = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (argument == "--lod-report" && i + 1 < argc)
+        {
+            lodReportPath = argv[++i];
+        }
+        else if (argument == "--bench-import" && i + 1 < argc)
+        {
+            importBenchmarkPath = argv[++i];
+        }
+        else if (argument == "--test" && i + 1 < argc)
+        {
+            testName = argv[++i];
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--frames N] [--dt seconds] [--bench-jobs entities] [--bench-anim entities] [--bench-skin characters] [--bench-omdl triangles] [--bench-spawn entities] [--mesh-stats path] [--bench-quantize vertices] [--lod-report path] [--bench-import path] [--test name]" << std::endl;
+            return 1;
+        }
+    }
+
+    if (!Logger::Instance().Init(L"log.txt"))
+    {
+        return -1;
+    }
+    Logger::Instance().SetLevel(Logger::Level::Info);
+
+    if (!testName.empty())
+    {
+        const auto test = std::find_if(std::begin(kSelfTests), std::end(kSelfTests),
+            [&testName](const SelfTest& candidate) { return testName == candidate.name; });
+        const bool passed = test != std::end(kSelfTests) && test->run();
+        std::cout << "Test " << testName << ": " << (test == std::end(kSelfTests) ? "unknown" : passed ? "passed" : "FAILED") << std::endl;
+        Logger::Instance().Shutdown();
+        return passed ? 0 : 1;
+    }
+
+    if (benchmarkEntities > 0 || animationBenchmarkEntities > 0 || skinningBenchmarkCharacters > 0 || modelFormatBenchmarkTriangles > 0
+        || spawnBenchmarkEntities > 0 || !meshStatsPath.empty() || quantizationVertices > 0
+        || !lodReportPath.empty() || !importBenchmarkPath.empty())
+    {
+        const std::uint32_t iterations = std::max<std::uint32_t>(1, frameCount / 10);
+        int benchmarkResult = 0;
+        if (benchmarkEntities > 0)
+        {
+            benchmarkResult = RunJobSystemBenchmark(benchmarkEntities, iterations);
+        }
+        if (animationBenchmarkEntities > 0 && benchmarkResult == 0)
+        {
+            benchmarkResult = RunAnimationBenchmark(animationBenchmarkEntities, iterations);
+        }
+        if (skinningBenchmarkCharacters > 0 && benchmarkResult == 0)
+        {
+            benchmarkResult = RunSkinningBenchmark(skinningBenchmarkCharacters, iterations);
+        }
+        if (modelFormatBenchmarkTriangles > 0 && benchmarkResult == 0)
+        {
+            benchmarkResult = RunModelFormatBenchmark(modelFormatBenchmarkTriangles, iterations);
+        }
+        if (spawnBenchmarkEntities > 0 && benchmarkResult == 0)
+        {
+            benchmarkResult = RunSpawnBenchmark(spawnBenchmarkEntities);
+        }
+        if (!meshStatsPath.empty() && benchmarkResult == 0)
+        {
+            benchmarkResult = RunMeshOptimizerReport(meshStatsPath);
+        }
+        if (quantizationVertices > 0 && benchmarkResult == 0)
+        {
+            benchmarkResult = RunQuantizationCheck(quantizationVertices);
+        }
+        if (!lodReportPath.empty() && benchmarkResult == 0)
+        {
+            benchmarkResult = RunLODReport(lodReportPath);
+        }
+        if (!importBenchmarkPath.empty() && benchmarkResult == 0)
+        {
+            benchmarkResult = RunImportBenchmark(importBenchmarkPath);
+        }
+        Logger::Instance().Shutdown();
+        return benchmarkResult;
+    }
+
+    LOG_INFO("Headless application start");
+
+    ConfigManager configManager;
+    if (!configManager.LoadOrCreateDefault())
+    {
+        LOG_WARN("Failed to load config, using defaults");
+    }
+
+    const AppConfig& config = configManager.GetConfig();
+    auto window = std::make_unique<HeadlessWindow>(config.window.width, config.window.height);
+
+    App app(std::move(window), std::move(configManager));
+    const int appResult = app.RunHeadless(frameCount, fixedDeltaTime);
+
+    LOG_INFO("Application exit: " + std::to_string(appResult));
+    Logger::Instance().Shutdown();
+    return appResult;
+}
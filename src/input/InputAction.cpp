@@ -9,10 +9,15 @@
 namespace OGLE {
 
 	Modifiers::Modifiers(int win32KeyState) {
+#ifdef _WIN32
 		ctrl = (win32KeyState & MK_CONTROL) != 0;
 		shift = (win32KeyState & MK_SHIFT) != 0;
 		alt = (GetAsyncKeyState(VK_MENU) & 0x8000) != 0;
 		win = (GetAsyncKeyState(VK_LWIN) & 0x8000) || (GetAsyncKeyState(VK_RWIN) & 0x8000);
+#else
+		(void)win32KeyState;
+		ctrl = shift = alt = win = false;
+#endif
 	}
 
 	InputAction::InputAction(std::string name, ActionType type)
@@ -2,10 +2,12 @@
 #pragma once
 
 #include <algorithm>
+#ifdef _WIN32
 #ifndef NOMINMAX
 #define NOMINMAX
 #endif
 #include <windows.h>
+#endif
 #include <functional>
 #include <vector>
 #include <string>
@@ -80,7 +80,8 @@ void ImGuiManager::BeginFrame()
     ImGui::NewFrame();
 }
 
-void ImGuiManager::BuildDefaultUi(const CameraManager& cameraManager, const WorldManager& worldManager, float deltaTime)
+void ImGuiManager::BuildDefaultUi(const CameraManager& cameraManager, const WorldManager& worldManager, float deltaTime,
+    const OGLE::RenderQueueStats& renderStats)
 {
     if (!m_initialized) {
         return;
@@ -150,6 +151,11 @@ void ImGuiManager::BuildDefaultUi(const CameraManager& cameraManager, const Worl
             ++entityCount;
         }
         ImGui::Text("World entities: %u", static_cast<unsigned int>(entityCount));
+        ImGui::Text("Draw items: %u", renderStats.drawItems);
+        ImGui::Text("Program switches: %u", renderStats.programSwitches);
+        ImGui::Text("Material binds: %u", renderStats.materialBinds);
+        ImGui::Text("Mesh binds: %u", renderStats.meshBinds);
+        ImGui::Text("Draw calls: %u (instanced: %u)", renderStats.drawCalls, renderStats.instanceBatches);
         ImGui::Separator();
         ImGui::Text("Controls:");
         ImGui::BulletText("W A S D / Q E move camera");
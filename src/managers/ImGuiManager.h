@@ -1,5 +1,7 @@
 #pragma once
 
+#include "render/RenderQueue.h"
+
 #include <string>
 
 class IWindow;
@@ -16,7 +18,8 @@ public:
     void Shutdown();
 
     void BeginFrame();
-    void BuildDefaultUi(const CameraManager& cameraManager, const WorldManager& worldManager, float deltaTime);
+    void BuildDefaultUi(const CameraManager& cameraManager, const WorldManager& worldManager, float deltaTime,
+        const OGLE::RenderQueueStats& renderStats = {});
     void Render();
 
     bool WantsKeyboardCapture() const;
@@ -107,3 +107,8 @@ void RenderManager::SetSceneViewport(const glm::vec2& origin, const glm::vec2& s
         m_renderer->SetSceneViewport(origin, size);
     }
 }
+
+OGLE::RenderQueueStats RenderManager::GetRenderStats() const
+{
+    return m_renderer ? m_renderer->GetRenderStats() : OGLE::RenderQueueStats{};
+}
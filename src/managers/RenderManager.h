@@ -1,5 +1,6 @@
 #pragma once
 
+#include "render/RenderQueue.h"
 #include "world/WorldComponents.h"
 
 #include <glm/vec2.hpp>
@@ -24,6 +25,7 @@ public:
     void SetHighlightedEntity(OGLE::Entity entity);
     void SetShowGrid(bool show);
     void SetSceneViewport(const glm::vec2& origin, const glm::vec2& size);
+    OGLE::RenderQueueStats GetRenderStats() const;
 
 private:
     int m_viewportWidth = 0;
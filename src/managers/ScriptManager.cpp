@@ -5,9 +5,9 @@
 #include <entt/entt.hpp>
 #include "Logger.h"
 #include "world/IWorldAccess.h"
+#include "core/FileSystem.h"
 
 #include <filesystem>
-#include <windows.h>
 
 ScriptManager::ScriptManager() = default;
 
@@ -101,6 +101,14 @@ void ScriptManager::NotifyCollision(OGLE::Entity a, OGLE::Entity b)
     m_engine->CallGlobalFunction("onCollision", first, second);
 }
 
+void ScriptManager::NotifyModelReady(OGLE::Entity entity, bool success)
+{
+    if (!m_engine) return;
+
+    unsigned int id = static_cast<unsigned int>(entt::to_integral(entity));
+    m_engine->CallGlobalFunction("__ogleModelReady", id, success);
+}
+
 bool ScriptManager::CallGlobalFunction(const char* functionName, float argument)
 {
     if (!m_engine) return false;
@@ -122,9 +130,8 @@ std::string ScriptManager::ResolveScriptPath(const std::string& scriptPath) cons
         return path.string();
     }
 
-    char moduleFileName[MAX_PATH] = {};
-    if (GetModuleFileNameA(nullptr, moduleFileName, MAX_PATH) != 0) {
-        const fs::path executableDirectory = fs::path(moduleFileName).parent_path();
+    const fs::path executableDirectory = FileSystem::GetExecutableDirectory();
+    if (!executableDirectory.empty()) {
         const fs::path candidate = executableDirectory / path;
         if (fs::exists(candidate)) {
             return candidate.string();
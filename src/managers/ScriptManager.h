@@ -27,6 +27,8 @@ public:
     bool ExecuteFile(const std::string& scriptPath);
     void Update(float deltaTime);
     void NotifyCollision(OGLE::Entity a, OGLE::Entity b);
+    // Forwards a finished async model import to the bootstrap's __ogleModelReady.
+    void NotifyModelReady(OGLE::Entity entity, bool success);
 
 private:
     bool CallGlobalFunction(const char* functionName);
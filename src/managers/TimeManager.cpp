@@ -12,12 +12,14 @@ float TimeManager::Tick()
     if (!m_initialized) {
         m_lastFrameTime = now;
         m_initialized = true;
-        m_deltaTime = 0.0f;
+        m_frameTime = 0.0f;
+        m_deltaTime = m_fixedDeltaTime;
         return m_deltaTime;
     }
 
-    m_deltaTime = std::chrono::duration<float>(now - m_lastFrameTime).count();
+    m_frameTime = std::chrono::duration<float>(now - m_lastFrameTime).count();
     m_lastFrameTime = now;
+    m_deltaTime = m_fixedDeltaTime > 0.0f ? m_fixedDeltaTime : m_frameTime;
     return m_deltaTime;
 }
 
@@ -25,3 +27,18 @@ float TimeManager::GetDeltaTime() const
 {
     return m_deltaTime;
 }
+
+float TimeManager::GetFrameTime() const
+{
+    return m_frameTime;
+}
+
+void TimeManager::SetFixedDeltaTime(float fixedDeltaTime)
+{
+    m_fixedDeltaTime = fixedDeltaTime > 0.0f ? fixedDeltaTime : 0.0f;
+}
+
+float TimeManager::GetFixedDeltaTime() const
+{
+    return m_fixedDeltaTime;
+}
@@ -9,8 +9,18 @@ public:
     float Tick();
     float GetDeltaTime() const;
 
+    // Real wall-clock duration of the last frame, independent of the fixed step.
+    float GetFrameTime() const;
+
+    // When > 0, Tick() returns this value instead of the measured frame time
+    // (deterministic stepping for headless runs). 0 restores variable step.
+    void SetFixedDeltaTime(float fixedDeltaTime);
+    float GetFixedDeltaTime() const;
+
 private:
     std::chrono::steady_clock::time_point m_lastFrameTime{};
     float m_deltaTime = 0.0f;
+    float m_frameTime = 0.0f;
+    float m_fixedDeltaTime = 0.0f;
     bool m_initialized = false;
 };
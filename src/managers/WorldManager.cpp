@@ -7,6 +7,8 @@
 
 #include <glm/vec3.hpp>
 
+#include <algorithm>
+
 WorldManager::WorldManager()
 {
     CreateWorld();
@@ -17,6 +19,9 @@ WorldManager::WorldManager()
 void WorldManager::CreateWorld()
 {
     m_activeWorld = std::make_unique<OGLE::World>();
+    for (const auto& system : m_externalSystems) {
+        m_activeWorld->GetScheduler().AddSystem(system);
+    }
 }
 
 // The original CreateDefaultWorld logic has been moved to the dedicated WorldGenerator class.
@@ -105,17 +110,33 @@ bool WorldManager::SetEntityShaderProgram(OGLE::Entity entity, const std::string
     OGLE::World& world = GetActiveWorld();
     if (OGLE::MaterialComponent* material = world.GetMaterial(entity)) {
         material->material.SetShaderProgram(shaderProgramName);
+        world.MarkRenderStateDirty(entity);
         return true;
     }
 
     if (OGLE::ModelEntity* model = world.GetModel(entity)) {
         model->GetMaterial().SetShaderProgram(shaderProgramName);
+        world.MarkRenderStateDirty(entity);
         return true;
     }
 
     return false;
 }
 
+void WorldManager::RegisterSystem(const OGLE::SystemDescriptor& system)
+{
+    auto it = std::find_if(m_externalSystems.begin(), m_externalSystems.end(), [&system](const OGLE::SystemDescriptor& existing) {
+        return existing.name == system.name;
+    });
+    if (it != m_externalSystems.end()) {
+        *it = system;
+    } else {
+        m_externalSystems.push_back(system);
+    }
+
+    GetActiveWorld().GetScheduler().AddSystem(system);
+}
+
 void WorldManager::Update(float deltaTime)
 {
     GetActiveWorld().Update(deltaTime);
@@ -150,6 +171,18 @@ OGLE::Entity WorldManager::CreateModelFromFile(const std::string& filePath, OGLE
     return GetActiveWorld().CreateModelFromFile(filePath, type, name);
 }
 
+// CreateModelHierarchyFromFile
+OGLE::Entity WorldManager::CreateModelHierarchyFromFile(const std::string& filePath, OGLE::ModelType type, const std::string& name)
+{
+    return GetActiveWorld().CreateModelHierarchyFromFile(filePath, type, name);
+}
+
+// CreateModelFromFileAsync
+OGLE::Entity WorldManager::CreateModelFromFileAsync(const std::string& filePath, OGLE::ModelType type, const std::string& name)
+{
+    return GetActiveWorld().CreateModelFromFileAsync(filePath, type, name);
+}
+
 // CreatePrimitive
 OGLE::Entity WorldManager::CreatePrimitive(const std::string& name, OGLE::PrimitiveType type, const glm::vec3& position, const glm::vec3& scale, const std::string& diffuseTexturePath)
 {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../world/IWorldAccess.h"
+#include "../world/SystemScheduler.h"
 #include "../world/World.h"
 #include "../world/WorldObject.h"
 
@@ -8,6 +9,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 /// <summary>
 /// WorldManager is responsible for creating, managing and updating the active world instance.
@@ -47,6 +49,16 @@ public:
         const std::string& filePath,
         OGLE::ModelType type = OGLE::ModelType::DYNAMIC,
         const std::string& name = "Model");
+    /// <summary>Loads the node tree of a model file as child entities that share repeated meshes.</summary>
+    OGLE::Entity CreateModelHierarchyFromFile(
+        const std::string& filePath,
+        OGLE::ModelType type = OGLE::ModelType::DYNAMIC,
+        const std::string& name = "Model");
+    /// <summary>Returns a placeholder entity at once and swaps in the model mesh when its background import is uploaded.</summary>
+    OGLE::Entity CreateModelFromFileAsync(
+        const std::string& filePath,
+        OGLE::ModelType type = OGLE::ModelType::DYNAMIC,
+        const std::string& name = "Model");
     /// <summary>Creates a primitive entity with given type, position, scale and texture.</summary>
     OGLE::Entity CreatePrimitive(
         const std::string& name,
@@ -83,7 +95,10 @@ public:
     // bool SetEntityDiffuseTexture(OGLE::Entity entity, const std::string& texturePath);
     bool SetEntityShaderProgram(OGLE::Entity entity, const std::string& shaderProgramName);
 
-    /// <summary>Updates the world state (physics, animations, etc.).</summary>
+    /// <summary>Registers a system owned outside the world (physics, scripts). It is re-added to every world created later.</summary>
+    void RegisterSystem(const OGLE::SystemDescriptor& system);
+
+    /// <summary>Updates the world state by running its scheduled systems (physics, animations, etc.).</summary>
     void Update(float deltaTime);
     /// <summary>Saves the active world to a file.</summary>
     void SaveActiveWorld(const std::string& path);
@@ -92,4 +107,5 @@ public:
 
 private:
     std::unique_ptr<OGLE::World> m_activeWorld;
+    std::vector<OGLE::SystemDescriptor> m_externalSystems;
 };
@@ -1,17 +1,35 @@
 #include "BaseModel.h"
 #include "../Logger.h"
 #include "../core/FileSystem.h"
+#include "../core/MappedFile.h"
+#include "../render/AnimationLibrary.h"
+#include "../render/TextureManager.h"
+#include "../world/systems/AnimationCompressor.h"
+#include "ImportCache.h"
+#include "MeshCache.h"
+#include "MeshOptimizer.h"
+#include "ModelBinaryFormat.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <filesystem>
 #include <nlohmann/json.hpp>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace OGLE {
     namespace
     {
+        // Общий счётчик: ревизии разных моделей не совпадают, а World по последней
+        // узнаёт, что с прошлого кадра границы какой-то модели менялись.
+        std::atomic<std::uint64_t> g_boundsRevision{ 0 };
+
         std::string ResolveDiffuseTexturePath(
             const aiScene* scene,
             const aiMesh* mesh,
@@ -44,6 +62,267 @@ namespace OGLE {
             const std::filesystem::path candidatePath = modelPath.parent_path() / rawTexturePath;
             return FileSystem::ResolvePath(candidatePath).string();
         }
+
+        // Слот материала меша; материалы нумеруются в порядке первого использования.
+        // Меш без материала получает общий слот по умолчанию.
+        int ImportMaterialSlot(
+            const aiScene* scene,
+            const aiMesh* mesh,
+            const std::filesystem::path& modelPath,
+            std::vector<int>& slotIndices,
+            std::vector<MeshMaterialSlot>& slots)
+        {
+            const unsigned int sceneIndex = mesh->mMaterialIndex < scene->mNumMaterials ? mesh->mMaterialIndex : scene->mNumMaterials;
+            slotIndices.resize(scene->mNumMaterials + 1, -1);
+            if (slotIndices[sceneIndex] >= 0) {
+                return slotIndices[sceneIndex];
+            }
+
+            MeshMaterialSlot slot;
+            if (sceneIndex < scene->mNumMaterials && scene->mMaterials[sceneIndex]) {
+                const aiMaterial* material = scene->mMaterials[sceneIndex];
+                aiString name;
+                if (material->Get(AI_MATKEY_NAME, name) == aiReturn_SUCCESS) {
+                    slot.name = name.C_Str();
+                }
+                aiColor3D diffuse(1.0f, 1.0f, 1.0f);
+                if (material->Get(AI_MATKEY_COLOR_DIFFUSE, diffuse) == aiReturn_SUCCESS) {
+                    slot.baseColor = glm::vec3(diffuse.r, diffuse.g, diffuse.b);
+                }
+                slot.diffuseTexturePath = ResolveDiffuseTexturePath(scene, mesh, modelPath);
+            }
+
+            slotIndices[sceneIndex] = static_cast<int>(slots.size());
+            slots.push_back(std::move(slot));
+            return slotIndices[sceneIndex];
+        }
+
+        // Вершины в раскладке BaseModel и треугольники меша; возвращает номер его первой вершины.
+        unsigned int AppendMeshGeometry(const aiMesh* mesh, std::vector<float>& vertices, std::vector<unsigned int>& indices)
+        {
+            const unsigned int vertexOffset = static_cast<unsigned int>(vertices.size() / 8);
+            vertices.reserve(vertices.size() + static_cast<std::size_t>(mesh->mNumVertices) * 8);
+            for (unsigned int vertexIndex = 0; vertexIndex < mesh->mNumVertices; ++vertexIndex) {
+                const aiVector3D& position = mesh->mVertices[vertexIndex];
+                const aiVector3D normal = mesh->HasNormals()
+                    ? mesh->mNormals[vertexIndex]
+                    : aiVector3D(0.0f, 1.0f, 0.0f);
+                const aiVector3D texCoord = mesh->HasTextureCoords(0)
+                    ? mesh->mTextureCoords[0][vertexIndex]
+                    : aiVector3D(0.0f, 0.0f, 0.0f);
+
+                vertices.push_back(position.x);
+                vertices.push_back(position.y);
+                vertices.push_back(position.z);
+                vertices.push_back(normal.x);
+                vertices.push_back(normal.y);
+                vertices.push_back(normal.z);
+                vertices.push_back(texCoord.x);
+                vertices.push_back(texCoord.y);
+            }
+
+            for (unsigned int faceIndex = 0; faceIndex < mesh->mNumFaces; ++faceIndex) {
+                const aiFace& face = mesh->mFaces[faceIndex];
+                if (face.mNumIndices != 3) {
+                    continue;
+                }
+
+                indices.push_back(vertexOffset + face.mIndices[0]);
+                indices.push_back(vertexOffset + face.mIndices[1]);
+                indices.push_back(vertexOffset + face.mIndices[2]);
+            }
+            return vertexOffset;
+        }
+
+        // Первый узел (в порядке обхода в глубину), у которого есть меши.
+        std::string FindMeshNodeName(const aiNode* node)
+        {
+            if (!node) {
+                return {};
+            }
+            if (node->mNumMeshes > 0) {
+                return node->mName.C_Str();
+            }
+            for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+                std::string name = FindMeshNodeName(node->mChildren[i]);
+                if (!name.empty()) {
+                    return name;
+                }
+            }
+            return {};
+        }
+
+        glm::mat4 ToGlm(const aiMatrix4x4& matrix)
+        {
+            // aiMatrix4x4 хранится по строкам, glm — по столбцам.
+            glm::mat4 result(1.0f);
+            for (int row = 0; row < 4; ++row) {
+                for (int column = 0; column < 4; ++column) {
+                    result[column][row] = matrix[row][column];
+                }
+            }
+            return result;
+        }
+
+        glm::mat4 MatrixFromJson(const nlohmann::json& values)
+        {
+            glm::mat4 matrix(1.0f);
+            if (!values.is_array() || values.size() != 16) {
+                return matrix;
+            }
+            for (int column = 0; column < 4; ++column) {
+                for (int row = 0; row < 4; ++row) {
+                    matrix[column][row] = values[column * 4 + row].get<float>();
+                }
+            }
+            return matrix;
+        }
+
+        void AddSkinJoints(const aiNode* node, int parent, const std::unordered_set<const aiNode*>& needed, SkinData& skin)
+        {
+            if (!node || needed.count(node) == 0) {
+                return;
+            }
+            const int index = static_cast<int>(skin.joints.size());
+            skin.joints.push_back(SkinJoint{node->mName.C_Str(), parent, ToGlm(node->mTransformation)});
+            for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+                AddSkinJoints(node->mChildren[i], index, needed, skin);
+            }
+        }
+
+        // Кости всех мешей объединяются по имени; у вершины остаются 4 наибольших веса.
+        // Вершины без весов (меши без костей) привязываются к единичной «кости».
+        std::shared_ptr<SkinData> ImportSkin(const aiScene* scene, const std::vector<unsigned int>& meshVertexOffsets, std::size_t vertexCount)
+        {
+            std::unordered_map<std::string, int> boneIndices;
+            std::vector<std::string> boneNames;
+            auto skin = std::make_shared<SkinData>();
+            std::vector<std::vector<std::pair<float, int>>> vertexWeights(vertexCount);
+
+            for (unsigned int meshIndex = 0; meshIndex < scene->mNumMeshes; ++meshIndex) {
+                const aiMesh* mesh = scene->mMeshes[meshIndex];
+                if (!mesh || !mesh->HasBones()) {
+                    continue;
+                }
+
+                for (unsigned int boneIndex = 0; boneIndex < mesh->mNumBones; ++boneIndex) {
+                    const aiBone* bone = mesh->mBones[boneIndex];
+                    const std::string name = bone->mName.C_Str();
+                    auto it = boneIndices.find(name);
+                    if (it == boneIndices.end()) {
+                        it = boneIndices.emplace(name, static_cast<int>(boneNames.size())).first;
+                        boneNames.push_back(name);
+                        skin->inverseBindMatrices.push_back(ToGlm(bone->mOffsetMatrix));
+                    }
+
+                    for (unsigned int weightIndex = 0; weightIndex < bone->mNumWeights; ++weightIndex) {
+                        const aiVertexWeight& weight = bone->mWeights[weightIndex];
+                        const std::size_t vertex = meshVertexOffsets[meshIndex] + weight.mVertexId;
+                        if (vertex < vertexCount && weight.mWeight > 0.0f) {
+                            vertexWeights[vertex].emplace_back(weight.mWeight, it->second);
+                        }
+                    }
+                }
+            }
+
+            if (boneNames.empty()) {
+                return nullptr;
+            }
+
+            const int identityBone = static_cast<int>(boneNames.size());
+            bool needsIdentityBone = false;
+            skin->influences.resize(vertexCount);
+            for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+                auto& weights = vertexWeights[vertex];
+                SkinInfluence& influence = skin->influences[vertex];
+                const std::size_t count = std::min<std::size_t>(4, weights.size());
+                std::partial_sort(weights.begin(), weights.begin() + count, weights.end(), [](const auto& lhs, const auto& rhs) {
+                    return lhs.first > rhs.first;
+                });
+
+                float sum = 0.0f;
+                for (std::size_t i = 0; i < count; ++i) {
+                    sum += weights[i].first;
+                }
+                if (sum <= 0.0f) {
+                    influence.bones[0] = static_cast<std::uint16_t>(identityBone);
+                    influence.weights[0] = 1.0f;
+                    needsIdentityBone = true;
+                    continue;
+                }
+                for (std::size_t i = 0; i < count; ++i) {
+                    influence.bones[i] = static_cast<std::uint16_t>(weights[i].second);
+                    influence.weights[i] = weights[i].first / sum;
+                }
+            }
+
+            // Суставы: кости и все их предки, обход в глубину от корня (родитель раньше потомка).
+            std::unordered_set<const aiNode*> needed;
+            for (const auto& name : boneNames) {
+                for (const aiNode* node = scene->mRootNode->FindNode(name.c_str()); node; node = node->mParent) {
+                    needed.insert(node);
+                }
+            }
+            AddSkinJoints(scene->mRootNode, -1, needed, *skin);
+
+            std::unordered_map<std::string, int> jointIndices;
+            for (std::size_t joint = 0; joint < skin->joints.size(); ++joint) {
+                jointIndices.emplace(skin->joints[joint].name, static_cast<int>(joint));
+            }
+            skin->boneJoints.reserve(boneNames.size() + 1);
+            for (const auto& name : boneNames) {
+                const auto it = jointIndices.find(name);
+                skin->boneJoints.push_back(it != jointIndices.end() ? it->second : -1);
+            }
+            if (needsIdentityBone) {
+                skin->boneJoints.push_back(-1);
+                skin->inverseBindMatrices.push_back(glm::mat4(1.0f));
+            }
+
+            skin->rootInverse = glm::inverse(ToGlm(scene->mRootNode->mTransformation));
+            return skin;
+        }
+        // Индексы костей и суставов в пределах массивов, родитель сустава раньше него.
+        bool IsSkinConsistent(const SkinData& skin, std::size_t vertexCount)
+        {
+            const std::size_t boneCount = skin.boneJoints.size();
+            const int jointCount = static_cast<int>(skin.joints.size());
+            if (boneCount == 0 || skin.inverseBindMatrices.size() != boneCount || skin.influences.size() != vertexCount) {
+                return false;
+            }
+            for (int joint = 0; joint < jointCount; ++joint) {
+                if (skin.joints[joint].parent >= joint) {
+                    return false;
+                }
+            }
+            const bool jointsValid = std::all_of(skin.boneJoints.begin(), skin.boneJoints.end(), [jointCount](int joint) {
+                return joint < jointCount;
+            });
+            return jointsValid && std::all_of(skin.influences.begin(), skin.influences.end(), [boneCount](const SkinInfluence& influence) {
+                return std::all_of(std::begin(influence.bones), std::end(influence.bones), [boneCount](std::uint16_t bone) {
+                    return bone < boneCount;
+                });
+            });
+        }
+
+        constexpr unsigned int kImportFlags =
+            aiProcess_Triangulate |
+            aiProcess_GenSmoothNormals |
+            aiProcess_JoinIdenticalVertices |
+            aiProcess_FlipUVs |
+            aiProcess_SortByPType;
+
+        ModelBinaryFormat::BoundsRecord ToBoundsRecord(const MeshBounds& bounds)
+        {
+            ModelBinaryFormat::BoundsRecord record;
+            for (int axis = 0; axis < 3; ++axis) {
+                record.min[axis] = bounds.min[axis];
+                record.max[axis] = bounds.max[axis];
+                record.center[axis] = bounds.center[axis];
+            }
+            record.radius = bounds.radius;
+            return record;
+        }
     }
 
     BaseModel::BaseModel() = default;
@@ -58,15 +337,24 @@ namespace OGLE {
             return LoadCustomFile(resolvedPath.string());
         }
 
+        const MeshOptimizerSettings optimizerSettings = MeshCache::Instance().GetOptimizerSettings();
+        const ImportCacheEntry cacheEntry = ImportCache::Instance().Lookup(
+            resolvedPath, kImportFlags, optimizerSettings, AnimationLibrary::Instance().GetCompressionSettings());
+        const auto importStart = std::chrono::steady_clock::now();
+        if (cacheEntry.exists) {
+            if (LoadCachedImport(cacheEntry.modelPath, resolvedPath.string())) {
+                ImportCache::Instance().RecordHit(cacheEntry, resolvedPath,
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - importStart).count());
+                return true;
+            }
+            LOG_WARN("Import cache entry is unreadable, importing again: " + cacheEntry.modelPath.string());
+        }
+
         Assimp::Importer importer;
-        const aiScene* scene = importer.ReadFile(
-            resolvedPath.string(),
-            aiProcess_Triangulate |
-            aiProcess_GenSmoothNormals |
-            aiProcess_JoinIdenticalVertices |
-            aiProcess_ImproveCacheLocality |
-            aiProcess_FlipUVs |
-            aiProcess_SortByPType);
+        // Импортёр владеет обработчиком; список открытых файлов нужен записи кэша ниже.
+        auto* dependencies = new ImportDependencyRecorder();
+        importer.SetIOHandler(dependencies);
+        const aiScene* scene = importer.ReadFile(resolvedPath.string(), kImportFlags);
 
         if (!scene || !scene->HasMeshes()) {
             LOG_ERROR("Error loading mesh from file: " + path);
@@ -76,7 +364,12 @@ namespace OGLE {
         std::vector<float> vertices;
         std::vector<unsigned int> indices;
         std::string diffuseTexturePath;
-        int boneCount = 0;
+        std::vector<unsigned int> meshVertexOffsets(scene->mNumMeshes, 0);
+        // Каждый aiMesh — свой диапазон индексов: части модели рисуются своими материалами
+        // и отсекаются по отдельности, а буфер остаётся одним.
+        MeshSubmeshList submeshes;
+        std::vector<MeshMaterialSlot> materialSlots;
+        std::vector<int> materialSlotIndices;
 
         for (unsigned int meshIndex = 0; meshIndex < scene->mNumMeshes; ++meshIndex) {
             const aiMesh* mesh = scene->mMeshes[meshIndex];
@@ -84,41 +377,18 @@ namespace OGLE {
                 continue;
             }
 
-            boneCount += static_cast<int>(mesh->mNumBones);
-
+            MeshSubmesh submesh;
+            submesh.materialIndex = ImportMaterialSlot(scene, mesh, resolvedPath, materialSlotIndices, materialSlots);
+            submesh.indexOffset = static_cast<std::uint32_t>(indices.size());
             if (diffuseTexturePath.empty()) {
-                diffuseTexturePath = ResolveDiffuseTexturePath(scene, mesh, resolvedPath);
+                diffuseTexturePath = materialSlots[submesh.materialIndex].diffuseTexturePath;
             }
 
-            const unsigned int vertexOffset = static_cast<unsigned int>(vertices.size() / 8);
-            for (unsigned int vertexIndex = 0; vertexIndex < mesh->mNumVertices; ++vertexIndex) {
-                const aiVector3D& position = mesh->mVertices[vertexIndex];
-                const aiVector3D normal = mesh->HasNormals()
-                    ? mesh->mNormals[vertexIndex]
-                    : aiVector3D(0.0f, 1.0f, 0.0f);
-                const aiVector3D texCoord = mesh->HasTextureCoords(0)
-                    ? mesh->mTextureCoords[0][vertexIndex]
-                    : aiVector3D(0.0f, 0.0f, 0.0f);
+            meshVertexOffsets[meshIndex] = AppendMeshGeometry(mesh, vertices, indices);
 
-                vertices.push_back(position.x);
-                vertices.push_back(position.y);
-                vertices.push_back(position.z);
-                vertices.push_back(normal.x);
-                vertices.push_back(normal.y);
-                vertices.push_back(normal.z);
-                vertices.push_back(texCoord.x);
-                vertices.push_back(texCoord.y);
-            }
-
-            for (unsigned int faceIndex = 0; faceIndex < mesh->mNumFaces; ++faceIndex) {
-                const aiFace& face = mesh->mFaces[faceIndex];
-                if (face.mNumIndices != 3) {
-                    continue;
-                }
-
-                indices.push_back(vertexOffset + face.mIndices[0]);
-                indices.push_back(vertexOffset + face.mIndices[1]);
-                indices.push_back(vertexOffset + face.mIndices[2]);
+            submesh.indexCount = static_cast<std::uint32_t>(indices.size()) - submesh.indexOffset;
+            if (submesh.indexCount > 0) {
+                submeshes.push_back(submesh);
             }
         }
 
@@ -127,17 +397,39 @@ namespace OGLE {
             return false;
         }
 
+        std::shared_ptr<SkinData> skin = ImportSkin(scene, meshVertexOffsets, vertices.size() / 8);
+
+        // Порядок под кэш вершин и перерисовку вместо aiProcess_ImproveCacheLocality;
+        // влияния костей переставляются вместе с вершинами.
+        const MeshOptimizerReport report = MeshOptimizer::Optimize(
+            vertices, indices, optimizerSettings, skin ? &skin->influences : nullptr, &submeshes);
+        if (report.stages.size() > 1) {
+            LOG_INFO("Mesh optimized: " + resolvedPath.string() + ", " + MeshOptimizer::FormatReport(report));
+        }
+        if (skin) {
+            skin->bindVertices = vertices;
+        }
+
         SetMeshGeometry(std::move(vertices), std::move(indices));
+        SetSubmeshes(std::move(submeshes), std::move(materialSlots));
         m_loadedDiffuseTexturePath = std::move(diffuseTexturePath);
-        m_boneCount = boneCount;
+        m_skin = std::move(skin);
+        m_boneCount = m_skin ? static_cast<int>(m_skin->boneJoints.size()) : 0;
+        m_meshNodeName = FindMeshNodeName(scene->mRootNode);
 
-        m_animationClips.clear();
-        if (scene->HasAnimations()) {
+        // Клипы уже загруженного файла берутся из AnimationLibrary, ключи не разбираются повторно.
+        const std::string clipSource = resolvedPath.string();
+        m_animationClips = AnimationLibrary::Instance().FindClips(clipSource);
+        if (m_animationClips.empty() && scene->HasAnimations()) {
+            const AnimationCompressionSettings compression = AnimationLibrary::Instance().GetCompressionSettings();
+            std::vector<AnimationClip> clips;
+            std::size_t sourceBytes = 0;
+            std::size_t compressedBytes = 0;
             for (unsigned int animIndex = 0; animIndex < scene->mNumAnimations; ++animIndex) {
                 const aiAnimation* aiAnim = scene->mAnimations[animIndex];
                 if (!aiAnim) continue;
 
-                AnimationClip clip;
+                AnimationClipSource clip;
                 clip.name = aiAnim->mName.C_Str();
                 if (clip.name.empty()) {
                     clip.name = "clip_" + std::to_string(animIndex);
@@ -149,57 +441,331 @@ namespace OGLE {
                     clip.duration = 1.0f;
                 }
 
+                // Каналы Assimp переносятся раздельно: у смещения, поворота и масштаба свои времена ключей.
                 for (unsigned int channelIndex = 0; channelIndex < aiAnim->mNumChannels; ++channelIndex) {
                     const aiNodeAnim* nodeAnim = aiAnim->mChannels[channelIndex];
                     if (!nodeAnim) continue;
 
-                    std::map<float, AnimationKeyframe> keyframesByTime;
+                    AnimationTrackSource track;
+                    track.nodeName = nodeAnim->mNodeName.C_Str();
 
+                    track.translationTimes.reserve(nodeAnim->mNumPositionKeys);
+                    track.translations.reserve(nodeAnim->mNumPositionKeys);
                     for (unsigned int i = 0; i < nodeAnim->mNumPositionKeys; ++i) {
-                        float t = static_cast<float>(nodeAnim->mPositionKeys[i].mTime / clip.ticksPerSecond);
-                        auto& frame = keyframesByTime[t];
-                        frame.time = t;
-                        frame.translation = glm::vec3(nodeAnim->mPositionKeys[i].mValue.x, nodeAnim->mPositionKeys[i].mValue.y, nodeAnim->mPositionKeys[i].mValue.z);
+                        const aiVectorKey& key = nodeAnim->mPositionKeys[i];
+                        track.translationTimes.push_back(static_cast<float>(key.mTime / clip.ticksPerSecond));
+                        track.translations.push_back(glm::vec3(key.mValue.x, key.mValue.y, key.mValue.z));
                     }
 
+                    track.rotationTimes.reserve(nodeAnim->mNumRotationKeys);
+                    track.rotations.reserve(nodeAnim->mNumRotationKeys);
                     for (unsigned int i = 0; i < nodeAnim->mNumRotationKeys; ++i) {
-                        float t = static_cast<float>(nodeAnim->mRotationKeys[i].mTime / clip.ticksPerSecond);
-                        auto& frame = keyframesByTime[t];
-                        frame.time = t;
-                        frame.rotation = glm::quat(nodeAnim->mRotationKeys[i].mValue.w, nodeAnim->mRotationKeys[i].mValue.x, nodeAnim->mRotationKeys[i].mValue.y, nodeAnim->mRotationKeys[i].mValue.z);
+                        const aiQuatKey& key = nodeAnim->mRotationKeys[i];
+                        track.rotationTimes.push_back(static_cast<float>(key.mTime / clip.ticksPerSecond));
+                        track.rotations.push_back(glm::quat(key.mValue.w, key.mValue.x, key.mValue.y, key.mValue.z));
                     }
 
+                    track.scaleTimes.reserve(nodeAnim->mNumScalingKeys);
+                    track.scales.reserve(nodeAnim->mNumScalingKeys);
                     for (unsigned int i = 0; i < nodeAnim->mNumScalingKeys; ++i) {
-                        float t = static_cast<float>(nodeAnim->mScalingKeys[i].mTime / clip.ticksPerSecond);
-                        auto& frame = keyframesByTime[t];
-                        frame.time = t;
-                        frame.scale = glm::vec3(nodeAnim->mScalingKeys[i].mValue.x, nodeAnim->mScalingKeys[i].mValue.y, nodeAnim->mScalingKeys[i].mValue.z);
+                        const aiVectorKey& key = nodeAnim->mScalingKeys[i];
+                        track.scaleTimes.push_back(static_cast<float>(key.mTime / clip.ticksPerSecond));
+                        track.scales.push_back(glm::vec3(key.mValue.x, key.mValue.y, key.mValue.z));
                     }
 
-                    AnimationTrack track;
-                    track.nodeName = nodeAnim->mNodeName.C_Str();
-                    track.keyframes.reserve(keyframesByTime.size());
-                    for (auto& kv : keyframesByTime) {
-                        track.keyframes.push_back(kv.second);
-                    }
                     clip.tracks.push_back(std::move(track));
                 }
 
-                m_animationClips.push_back(std::move(clip));
+                clips.push_back(AnimationCompressor::CompressClip(clip, compression));
+                sourceBytes += AnimationCompressor::GetSourceBytes(clip);
+                compressedBytes += AnimationCompressor::GetCompressedBytes(clips.back());
+            }
+            m_animationClips = AnimationLibrary::Instance().RegisterClips(clipSource, std::move(clips));
+
+            if (compressedBytes > 0) {
+                LOG_INFO("Animation clips compressed: " + std::to_string(sourceBytes / 1024) + " KB -> "
+                    + std::to_string(compressedBytes / 1024) + " KB (x"
+                    + std::to_string(static_cast<double>(sourceBytes) / static_cast<double>(compressedBytes)) + ") for " + clipSource);
+            }
+        }
+
+        if (!cacheEntry.modelPath.empty()) {
+            const double importMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - importStart).count();
+            if (SaveToCustomFile(ImportCache::Instance().GetTemporaryPath(cacheEntry).string())) {
+                ImportCache::Instance().Store(cacheEntry, resolvedPath, dependencies->GetOpenedFiles(), importMs);
+            } else {
+                LOG_WARN("Failed to write import cache entry: " + cacheEntry.modelPath.string());
             }
         }
 
         return true;
     }
 
+    bool BaseModel::LoadFromSceneMesh(const aiScene* scene, unsigned int meshIndex, const std::string& path) {
+        const aiMesh* mesh = scene && meshIndex < scene->mNumMeshes ? scene->mMeshes[meshIndex] : nullptr;
+        if (!mesh) {
+            return false;
+        }
+
+        std::vector<float> vertices;
+        std::vector<unsigned int> indices;
+        AppendMeshGeometry(mesh, vertices, indices);
+        if (vertices.empty() || indices.empty()) {
+            return false;
+        }
+
+        std::vector<MeshMaterialSlot> materialSlots;
+        std::vector<int> materialSlotIndices;
+        MeshSubmesh submesh;
+        submesh.materialIndex = ImportMaterialSlot(scene, mesh, FileSystem::ResolvePath(path), materialSlotIndices, materialSlots);
+
+        const MeshOptimizerReport report = MeshOptimizer::Optimize(vertices, indices, MeshCache::Instance().GetOptimizerSettings());
+        if (report.stages.size() > 1) {
+            LOG_INFO("Mesh optimized: " + path + " [" + mesh->mName.C_Str() + "], " + MeshOptimizer::FormatReport(report));
+        }
+        submesh.indexCount = static_cast<std::uint32_t>(indices.size());
+
+        SetMeshGeometry(std::move(vertices), std::move(indices));
+        m_loadedDiffuseTexturePath = materialSlots.front().diffuseTexturePath;
+        SetSubmeshes({submesh}, std::move(materialSlots));
+        m_skin.reset();
+        m_boneCount = 0;
+        m_meshNodeName.clear();
+        m_animationClips.clear();
+        return true;
+    }
+
     void BaseModel::BakeToGPU() {
+        if (m_sharedMesh) {
+            return; // Буферы общего меша уже созданы кэшем
+        }
         if (m_vertices.empty() || m_indices.empty()) {
             LOG_ERROR("Cannot bake to GPU, mesh data is missing.");
             return;
         }
 
-        m_MeshBuffer = std::make_unique<MeshBuffer>();
-        m_MeshBuffer->Create(m_vertices, m_indices);
+        // Вершины могли измениться после загрузки (UpdateGeometry, SetMeshData).
+        m_bounds = MeshBounds::FromVertices(m_vertices);
+        MarkBoundsChanged();
+        UpdateSubmeshBounds();
+        m_MeshBuffer = std::make_shared<MeshBuffer>();
+        m_MeshBuffer->Create(m_vertices, m_indices, m_skin ? VertexFormat::Float32 : m_vertexFormat);
+        if (m_lods) {
+            MeshSimplifier::CreateBuffers(*m_lods, m_vertexFormat);
+        }
+    }
+
+    void BaseModel::SetVertexFormat(VertexFormat format) {
+        m_vertexFormat = format;
+    }
+
+    const VertexLayout& BaseModel::GetVertexLayout(int lodLevel) const {
+        static const VertexLayout kFloat32Layout = VertexLayout::Create(VertexFormat::Float32);
+        const MeshBuffer* buffer = GetLODBuffer(lodLevel);
+        return buffer ? buffer->GetLayout() : kFloat32Layout;
+    }
+
+    void BaseModel::GenerateLODs(const LODSettings& settings) {
+        m_lods.reset();
+        if (m_skin) {
+            return;
+        }
+        m_lods = MeshSimplifier::GenerateLODs(GetMeshVertices(), GetMeshIndices(), settings, &GetSubmeshes());
+        if (!m_lods) {
+            return;
+        }
+        LOG_INFO("Mesh LODs generated: " + MeshSimplifier::FormatReport(*m_lods));
+        // До BakeToGPU уровни остаются на CPU: так их можно строить в фоновом потоке.
+        if (m_MeshBuffer) {
+            MeshSimplifier::CreateBuffers(*m_lods, m_vertexFormat);
+        }
+    }
+
+    const MeshLODChain* BaseModel::GetLODs() const {
+        return m_sharedMesh ? m_sharedMesh->lods.get() : m_lods.get();
+    }
+
+    const MeshBuffer* BaseModel::GetLODBuffer(int lodLevel) const {
+        const MeshLODChain* lods = GetLODs();
+        if (lodLevel <= 0 || !lods || lods->levels.empty()) {
+            return m_MeshBuffer.get();
+        }
+        const std::size_t level = std::min<std::size_t>(static_cast<std::size_t>(lodLevel), lods->levels.size());
+        return lods->levels[level - 1].buffer.get();
+    }
+
+    const MeshBuffer* BaseModel::GetFloat32LODBuffer(int lodLevel) {
+        const MeshLODChain* lods = GetLODs();
+        if (lodLevel <= 0 || !lods || lods->levels.empty()) {
+            return m_MeshBuffer ? m_MeshBuffer->GetFloat32Buffer(GetMeshVertices(), GetMeshIndices()) : nullptr;
+        }
+        const std::size_t level = std::min<std::size_t>(static_cast<std::size_t>(lodLevel), lods->levels.size());
+        const MeshLODLevel& lod = lods->levels[level - 1];
+        return lod.buffer ? lod.buffer->GetFloat32Buffer(lod.vertices, lod.indices) : nullptr;
+    }
+
+    const MeshBounds& BaseModel::GetBounds() const {
+        return m_sharedMesh ? m_sharedMesh->bounds : m_bounds;
+    }
+
+    const MeshSubmeshList& BaseModel::GetSubmeshes(int lodLevel) const {
+        const MeshLODChain* lods = GetLODs();
+        if (lodLevel > 0 && lods && !lods->levels.empty()) {
+            const std::size_t level = std::min<std::size_t>(static_cast<std::size_t>(lodLevel), lods->levels.size());
+            return lods->levels[level - 1].submeshes;
+        }
+        return m_sharedMesh ? m_sharedMesh->submeshes : m_submeshes;
+    }
+
+    const std::vector<MeshMaterialSlot>& BaseModel::GetMaterialSlots() const {
+        return m_sharedMesh ? m_sharedMesh->materialSlots : m_materialSlots;
+    }
+
+    const Texture2D* BaseModel::GetMaterialTexture(int materialIndex) const {
+        const std::vector<std::shared_ptr<Texture2D>>& textures = m_sharedMesh ? m_sharedMesh->materialTextures : m_materialTextures;
+        if (materialIndex < 0 || static_cast<std::size_t>(materialIndex) >= textures.size()) {
+            return nullptr;
+        }
+        return textures[materialIndex].get();
+    }
+
+    void BaseModel::SetSubmeshes(MeshSubmeshList submeshes, std::vector<MeshMaterialSlot> materialSlots) {
+        m_submeshes = std::move(submeshes);
+        m_materialSlots = std::move(materialSlots);
+        m_materialTextures.clear();
+        UpdateSubmeshBounds();
+    }
+
+    void BaseModel::UpdateSubmeshBounds() {
+        for (MeshSubmesh& submesh : m_submeshes) {
+            submesh.bounds = MeshBounds::FromIndexedVertices(m_vertices, m_indices, submesh.indexOffset, submesh.indexCount);
+        }
+    }
+
+    IndexFormat BaseModel::GetIndexFormat() const {
+        return m_MeshBuffer ? m_MeshBuffer->GetIndexFormat() : SelectIndexFormat(GetMeshVertices().size() / 8);
+    }
+
+    unsigned int BaseModel::GetImportFlags() {
+        return kImportFlags;
+    }
+
+    std::shared_ptr<SharedMesh> BaseModel::CreateSharedMesh(const std::string& key) {
+        if (!m_MeshBuffer) {
+            BakeToGPU();
+        }
+
+        auto mesh = std::make_shared<SharedMesh>();
+        mesh->key = key;
+        mesh->vertices = std::move(m_vertices);
+        mesh->indices = std::move(m_indices);
+        mesh->buffer = m_MeshBuffer;
+        mesh->lods = std::move(m_lods);
+        mesh->bounds = m_bounds;
+        mesh->submeshes = std::move(m_submeshes);
+        mesh->materialSlots = std::move(m_materialSlots);
+        // Текстуры слотов нужны, только если модель рисуется несколькими материалами;
+        // единственный материал задаёт материал сущности.
+        if (mesh->materialSlots.size() > 1) {
+            for (const MeshMaterialSlot& slot : mesh->materialSlots) {
+                mesh->materialTextures.push_back(slot.diffuseTexturePath.empty()
+                    ? nullptr
+                    : TextureManager::Get().GetTexture(slot.diffuseTexturePath));
+            }
+        }
+        mesh->animationClips = m_animationClips;
+        mesh->skin = m_skin;
+        mesh->meshNodeName = m_meshNodeName;
+        mesh->diffuseTexturePath = m_loadedDiffuseTexturePath;
+        mesh->boneCount = m_boneCount;
+        ShareMesh(mesh);
+        return mesh;
+    }
+
+    void BaseModel::ShareMesh(std::shared_ptr<const SharedMesh> mesh) {
+        m_vertices.clear();
+        m_vertices.shrink_to_fit();
+        m_indices.clear();
+        m_indices.shrink_to_fit();
+        m_sharedMesh = std::move(mesh);
+        // Уровни и границы общего меша читаются через m_sharedMesh, свои больше не нужны.
+        m_lods.reset();
+        m_bounds = MeshBounds();
+        MarkBoundsChanged();
+        m_submeshes.clear();
+        m_materialSlots.clear();
+        m_materialTextures.clear();
+        if (!m_sharedMesh) {
+            m_MeshBuffer.reset();
+            return;
+        }
+
+        m_MeshBuffer = m_sharedMesh->buffer;
+        m_animationClips = m_sharedMesh->animationClips;
+        m_skin = m_sharedMesh->skin;
+        m_meshNodeName = m_sharedMesh->meshNodeName;
+        m_loadedDiffuseTexturePath = m_sharedMesh->diffuseTexturePath;
+        m_boneCount = m_sharedMesh->boneCount;
+    }
+
+    bool BaseModel::DetachMesh() {
+        const bool sharedBuffer = !m_sharedMesh && m_MeshBuffer && m_MeshBuffer.use_count() > 1;
+        if ((m_sharedMesh && m_sharedMesh->vertices.empty()) || (sharedBuffer && m_vertices.empty())) {
+            LOG_ERROR("DetachMesh: no CPU geometry to copy, the model keeps its shared mesh.");
+            return false;
+        }
+
+        // Уровни упрощены из прежней геометрии, которую сейчас будут менять.
+        m_lods.reset();
+        if (m_sharedMesh) {
+            // Копирование при записи: своя CPU-копия и свои буферы GPU.
+            const std::shared_ptr<const SharedMesh> mesh = std::move(m_sharedMesh);
+            m_vertices = mesh->vertices;
+            m_indices = mesh->indices;
+            m_bounds = mesh->bounds;
+            m_submeshes = mesh->submeshes;
+            m_materialSlots = mesh->materialSlots;
+            // Те же слоты — те же текстуры: отделённая модель рисуется как раньше.
+            m_materialTextures = mesh->materialTextures;
+            m_MeshBuffer.reset();
+            BakeToGPU();
+        } else if (sharedBuffer) {
+            // Копия модели делит буфер с оригиналом.
+            BakeToGPU();
+        }
+        return true;
+    }
+
+    void BaseModel::ReleaseSharedMesh() {
+        if (m_sharedMesh) {
+            m_sharedMesh.reset();
+            m_MeshBuffer.reset();
+            MarkBoundsChanged();
+        }
+    }
+
+    void BaseModel::MarkBoundsChanged() {
+        m_boundsRevision = g_boundsRevision.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    std::uint64_t BaseModel::GetLatestBoundsRevision() {
+        return g_boundsRevision.load(std::memory_order_relaxed);
+    }
+
+    bool BaseModel::IsMeshShared() const {
+        return m_sharedMesh != nullptr;
+    }
+
+    const SharedMesh* BaseModel::GetSharedMesh() const {
+        return m_sharedMesh.get();
+    }
+
+    const std::vector<float>& BaseModel::GetMeshVertices() const {
+        return m_sharedMesh ? m_sharedMesh->vertices : m_vertices;
+    }
+
+    const std::vector<unsigned int>& BaseModel::GetMeshIndices() const {
+        return m_sharedMesh ? m_sharedMesh->indices : m_indices;
     }
 
     const std::string& BaseModel::GetLoadedDiffuseTexturePath() const
@@ -207,58 +773,108 @@ namespace OGLE {
         return m_loadedDiffuseTexturePath;
     }
 
-    const std::vector<AnimationClip>& BaseModel::GetAnimationClips() const {
+    const std::vector<AnimationClipHandle>& BaseModel::GetAnimationClips() const {
         return m_animationClips;
     }
 
-    void BaseModel::SetAnimationClips(const std::vector<AnimationClip>& clips) {
-        m_animationClips = clips;
+    void BaseModel::SetAnimationClips(std::vector<AnimationClipHandle> clips) {
+        m_animationClips = std::move(clips);
+    }
+
+    const SkinData* BaseModel::GetSkin() const {
+        return m_skin.get();
+    }
+
+    void BaseModel::SetSkin(std::shared_ptr<const SkinData> skin) {
+        m_skin = std::move(skin);
+        m_boneCount = m_skin ? static_cast<int>(m_skin->boneJoints.size()) : 0;
     }
 
     bool BaseModel::SaveToCustomFile(const std::string& path) const {
-        nlohmann::json j;
-        j["version"] = 1;
-        j["mesh"] = {
-            {"vertices", m_vertices},
-            {"indices", m_indices}
-        };
+        using namespace ModelBinaryFormat;
+        const std::vector<float>& vertices = GetMeshVertices();
+        const std::vector<unsigned int>& indices = GetMeshIndices();
+        Writer writer;
 
-        j["skeleton"] = {
-            {"boneCount", m_boneCount}
-        };
+        writer.BeginSection(SectionType::Meta);
+        writer.Write(static_cast<std::int32_t>(m_boneCount));
+        writer.WriteString(m_meshNodeName);
+        writer.WriteString(m_loadedDiffuseTexturePath);
+        writer.EndSection();
 
-        if (!m_animationClips.empty()) {
-            j["animationClips"] = nlohmann::json::array();
-            for (const auto& clip : m_animationClips) {
-                nlohmann::json clipJson;
-                clipJson["name"] = clip.name;
-                clipJson["duration"] = clip.duration;
-                clipJson["ticksPerSecond"] = clip.ticksPerSecond;
-                clipJson["tracks"] = nlohmann::json::array();
-                for (const auto& track : clip.tracks) {
-                    nlohmann::json trackJson;
-                    trackJson["nodeName"] = track.nodeName;
-                    trackJson["keyframes"] = nlohmann::json::array();
-                    for (const auto& key : track.keyframes) {
-                        trackJson["keyframes"].push_back({
-                            {"time", key.time},
-                            {"translation", {key.translation.x, key.translation.y, key.translation.z}},
-                            {"rotation", {key.rotation.w, key.rotation.x, key.rotation.y, key.rotation.z}},
-                            {"scale", {key.scale.x, key.scale.y, key.scale.z}}
-                        });
-                    }
-                    clipJson["tracks"].push_back(trackJson);
-                }
-                j["animationClips"].push_back(clipJson);
+        writer.BeginSection(SectionType::Vertices);
+        writer.WriteBytes(vertices.data(), vertices.size() * sizeof(float));
+        writer.EndSection();
+
+        // Меш до 65536 вершин хранит 16-битные индексы, как и его буфер GPU.
+        if (SelectIndexFormat(vertices.size() / 8) == IndexFormat::UInt16) {
+            const std::vector<std::uint16_t> shortIndices(indices.begin(), indices.end());
+            writer.BeginSection(SectionType::Indices16);
+            writer.WriteBytes(shortIndices.data(), shortIndices.size() * sizeof(std::uint16_t));
+        } else {
+            writer.BeginSection(SectionType::Indices);
+            writer.WriteBytes(indices.data(), indices.size() * sizeof(unsigned int));
+        }
+        writer.EndSection();
+
+        writer.BeginSection(SectionType::Bounds);
+        writer.Write(ToBoundsRecord(GetBounds().valid ? GetBounds() : MeshBounds::FromVertices(vertices)));
+        writer.EndSection();
+
+        // Модель без диапазонов пишется одним диапазоном на все индексы.
+        const MeshSubmeshList& submeshes = GetSubmeshes();
+        writer.BeginSection(SectionType::Submeshes);
+        if (submeshes.empty()) {
+            SubmeshRecord record;
+            record.indexCount = static_cast<std::uint32_t>(indices.size());
+            record.materialIndex = 0;
+            writer.Write(record);
+        }
+        for (const MeshSubmesh& submesh : submeshes) {
+            SubmeshRecord record;
+            record.indexOffset = submesh.indexOffset;
+            record.indexCount = submesh.indexCount;
+            record.materialIndex = submesh.materialIndex;
+            writer.Write(record);
+        }
+        writer.EndSection();
+
+        if (!submeshes.empty()) {
+            writer.BeginSection(SectionType::SubmeshBounds);
+            for (const MeshSubmesh& submesh : submeshes) {
+                writer.Write(ToBoundsRecord(submesh.bounds));
             }
+            writer.EndSection();
         }
 
-        std::filesystem::path filePath(path);
-        if (!FileSystem::EnsureParentDirectory(filePath)) {
-            return false;
+        const std::vector<MeshMaterialSlot>& materialSlots = GetMaterialSlots();
+        if (!materialSlots.empty()) {
+            writer.BeginSection(SectionType::Materials);
+            writer.Write(static_cast<std::uint32_t>(materialSlots.size()));
+            for (const MeshMaterialSlot& slot : materialSlots) {
+                writer.WriteString(slot.name);
+                writer.WriteString(slot.diffuseTexturePath);
+                writer.Write(slot.baseColor.x);
+                writer.Write(slot.baseColor.y);
+                writer.Write(slot.baseColor.z);
+            }
+            writer.EndSection();
+        }
+
+        if (m_skin) {
+            writer.BeginSection(SectionType::Skin);
+            WriteSkin(writer, *m_skin);
+            writer.EndSection();
         }
 
-        return FileSystem::WriteTextFile(filePath, j.dump(4));
+        if (!m_animationClips.empty()) {
+            writer.BeginSection(SectionType::Clips);
+            WriteClips(writer, m_animationClips);
+            writer.EndSection();
+        }
+
+        const std::vector<std::uint8_t>& bytes = writer.Finish();
+        return FileSystem::WriteBinaryFile(std::filesystem::path(path), bytes.data(), bytes.size());
     }
 
     bool BaseModel::LoadCustomFile(const std::string& path) {
@@ -267,14 +883,131 @@ namespace OGLE {
             return false;
         }
 
-        std::string content;
-        if (!FileSystem::ReadTextFile(filePath, content)) {
+        MappedFile file;
+        if (!file.Open(filePath)) {
+            LOG_ERROR("Failed to map custom model file: " + path);
             return false;
         }
 
+        if (ModelBinaryFormat::IsBinaryModel(file.GetData(), file.GetSize())) {
+            return LoadBinaryModel(file.GetData(), file.GetSize(), path, FileSystem::ResolvePath(path).string());
+        }
+        // .omdl v1 — JSON, оставлен для старых файлов.
+        return LoadJsonModel(file.GetData(), file.GetSize(), path);
+    }
+
+    bool BaseModel::LoadCachedImport(const std::filesystem::path& cachePath, const std::string& sourcePath) {
+        MappedFile file;
+        if (!file.Open(cachePath) || !ModelBinaryFormat::IsBinaryModel(file.GetData(), file.GetSize())) {
+            return false;
+        }
+        return LoadBinaryModel(file.GetData(), file.GetSize(), cachePath.string(), sourcePath);
+    }
+
+    bool BaseModel::LoadBinaryModel(const std::uint8_t* data, std::size_t size, const std::string& path, const std::string& clipSource) {
+        using namespace ModelBinaryFormat;
+        std::vector<SectionEntry> sections;
+        if (!ParseHeader(data, size, sections)) {
+            LOG_ERROR("Invalid binary model file: " + path);
+            return false;
+        }
+
+        const SectionEntry* vertexSection = FindSection(sections, SectionType::Vertices);
+        const SectionEntry* shortIndexSection = FindSection(sections, SectionType::Indices16);
+        const SectionEntry* indexSection = shortIndexSection ? shortIndexSection : FindSection(sections, SectionType::Indices);
+        const std::size_t indexSize = GetIndexSize(shortIndexSection ? IndexFormat::UInt16 : IndexFormat::UInt32);
+        if (!vertexSection || !indexSection
+            || vertexSection->size % (8 * sizeof(float)) != 0 || indexSection->size % indexSize != 0) {
+            LOG_ERROR("Binary model file has no valid mesh sections: " + path);
+            return false;
+        }
+
+        // Секции выровнены, а mmap начинается с границы страницы: массивы копируются как есть.
+        const auto* vertices = reinterpret_cast<const float*>(data + vertexSection->offset);
+        const std::size_t vertexCount = vertexSection->size / (8 * sizeof(float));
+        const std::size_t indexCount = indexSection->size / indexSize;
+        std::vector<unsigned int> indices;
+        if (shortIndexSection) {
+            const auto* shortIndices = reinterpret_cast<const std::uint16_t*>(data + indexSection->offset);
+            indices.assign(shortIndices, shortIndices + indexCount);
+        } else {
+            const auto* wideIndices = reinterpret_cast<const std::uint32_t*>(data + indexSection->offset);
+            indices.assign(wideIndices, wideIndices + indexCount);
+        }
+        if (std::any_of(indices.begin(), indices.end(), [vertexCount](unsigned int index) { return index >= vertexCount; })) {
+            LOG_ERROR("Binary model file has out-of-range indices: " + path);
+            return false;
+        }
+
+        ReleaseSharedMesh();
+        m_vertices.assign(vertices, vertices + vertexCount * 8);
+        m_indices = std::move(indices);
+
+        // Границы из файла экономят проход по вершинам; старые файлы без секции считают их заново.
+        m_bounds = MeshBounds();
+        if (const SectionEntry* boundsSection = FindSection(sections, SectionType::Bounds)) {
+            Reader reader(data + boundsSection->offset, static_cast<std::size_t>(boundsSection->size));
+            BoundsRecord record;
+            if (reader.Read(record)) {
+                m_bounds = MeshBounds::FromMinMax(
+                    glm::vec3(record.min[0], record.min[1], record.min[2]),
+                    glm::vec3(record.max[0], record.max[1], record.max[2]),
+                    record.radius);
+            }
+        }
+        if (!m_bounds.valid) {
+            m_bounds = MeshBounds::FromVertices(m_vertices);
+        }
+        MarkBoundsChanged();
+        ReadSubmeshes(data, sections, path);
+
+        m_boneCount = 0;
+        m_meshNodeName.clear();
+        m_loadedDiffuseTexturePath.clear();
+        if (const SectionEntry* meta = FindSection(sections, SectionType::Meta)) {
+            Reader reader(data + meta->offset, static_cast<std::size_t>(meta->size));
+            std::int32_t boneCount = 0;
+            reader.Read(boneCount);
+            reader.ReadString(m_meshNodeName);
+            // Путь к текстуре дописан в конец Meta позже; в старых файлах его нет.
+            if (!reader.ReadString(m_loadedDiffuseTexturePath)) {
+                m_loadedDiffuseTexturePath.clear();
+            }
+            m_boneCount = boneCount;
+        }
+
+        m_skin.reset();
+        if (const SectionEntry* skinSection = FindSection(sections, SectionType::Skin)) {
+            auto skin = std::make_shared<SkinData>();
+            Reader reader(data + skinSection->offset, static_cast<std::size_t>(skinSection->size));
+            if (ReadSkin(reader, *skin) && IsSkinConsistent(*skin, vertexCount)) {
+                skin->bindVertices = m_vertices;
+                m_skin = std::move(skin);
+                m_boneCount = static_cast<int>(m_skin->boneJoints.size());
+            } else {
+                LOG_WARN("Skin data does not match mesh, skinning disabled: " + path);
+            }
+        }
+
+        m_animationClips = AnimationLibrary::Instance().FindClips(clipSource);
+        const SectionEntry* clipSection = FindSection(sections, SectionType::Clips);
+        if (m_animationClips.empty() && clipSection) {
+            std::vector<AnimationClip> clips;
+            Reader reader(data + clipSection->offset, static_cast<std::size_t>(clipSection->size));
+            if (ReadClips(reader, clips)) {
+                m_animationClips = AnimationLibrary::Instance().RegisterClips(clipSource, std::move(clips));
+            } else {
+                LOG_WARN("Failed to read animation clips: " + path);
+            }
+        }
+
+        return true;
+    }
+
+    bool BaseModel::LoadJsonModel(const std::uint8_t* data, std::size_t size, const std::string& path) {
         nlohmann::json j;
         try {
-            j = nlohmann::json::parse(content);
+            j = nlohmann::json::parse(data, data + size);
         } catch (const std::exception& e) {
             LOG_ERROR("Failed to parse custom model file: " + std::string(e.what()));
             return false;
@@ -284,60 +1017,63 @@ namespace OGLE {
             return false;
         }
 
+        ReleaseSharedMesh();
         m_vertices = j["mesh"]["vertices"].get<std::vector<float>>();
         m_indices = j["mesh"]["indices"].get<std::vector<unsigned int>>();
+        m_bounds = MeshBounds::FromVertices(m_vertices);
+        MarkBoundsChanged();
+        m_submeshes.clear();
+        m_materialSlots.clear();
+        m_materialTextures.clear();
 
         m_boneCount = 0;
         if (j.contains("skeleton") && j["skeleton"].contains("boneCount")) {
             m_boneCount = j["skeleton"]["boneCount"].get<int>();
         }
+        m_meshNodeName = j.value("meshNodeName", std::string());
 
-        m_animationClips.clear();
-        if (j.contains("animationClips") && j["animationClips"].is_array()) {
-            for (const auto& clipJson : j["animationClips"]) {
-                AnimationClip clip;
-                clip.name = clipJson.value("name", std::string(""));
-                clip.duration = clipJson.value("duration", 0.0f);
-                clip.ticksPerSecond = clipJson.value("ticksPerSecond", 24.0f);
-
-                if (clipJson.contains("tracks") && clipJson["tracks"].is_array()) {
-                    for (const auto& trackJson : clipJson["tracks"]) {
-                        AnimationTrack track;
-                        track.nodeName = trackJson.value("nodeName", std::string(""));
-
-                        if (trackJson.contains("keyframes") && trackJson["keyframes"].is_array()) {
-                            for (const auto& keyJson : trackJson["keyframes"]) {
-                                AnimationKeyframe key;
-                                key.time = keyJson.value("time", 0.0f);
-                                if (keyJson.contains("translation") && keyJson["translation"].is_array() && keyJson["translation"].size() == 3) {
-                                    key.translation = glm::vec3(
-                                        keyJson["translation"][0].get<float>(),
-                                        keyJson["translation"][1].get<float>(),
-                                        keyJson["translation"][2].get<float>());
-                                }
-                                if (keyJson.contains("rotation") && keyJson["rotation"].is_array() && keyJson["rotation"].size() == 4) {
-                                    key.rotation = glm::quat(
-                                        keyJson["rotation"][0].get<float>(),
-                                        keyJson["rotation"][1].get<float>(),
-                                        keyJson["rotation"][2].get<float>(),
-                                        keyJson["rotation"][3].get<float>());
-                                }
-                                if (keyJson.contains("scale") && keyJson["scale"].is_array() && keyJson["scale"].size() == 3) {
-                                    key.scale = glm::vec3(
-                                        keyJson["scale"][0].get<float>(),
-                                        keyJson["scale"][1].get<float>(),
-                                        keyJson["scale"][2].get<float>());
-                                }
-                                track.keyframes.push_back(std::move(key));
-                            }
-                        }
-
-                        clip.tracks.push_back(std::move(track));
-                    }
+        m_skin.reset();
+        if (j.contains("skin") && j["skin"].is_object()) {
+            const auto& skinJson = j["skin"];
+            auto skin = std::make_shared<SkinData>();
+            for (const auto& jointJson : skinJson.value("joints", nlohmann::json::array())) {
+                skin->joints.push_back(SkinJoint{
+                    jointJson.value("name", std::string()),
+                    jointJson.value("parent", -1),
+                    MatrixFromJson(jointJson.value("bindLocal", nlohmann::json::array()))});
+            }
+            skin->boneJoints = skinJson.value("boneJoints", std::vector<int>());
+            for (const auto& matrixJson : skinJson.value("inverseBindMatrices", nlohmann::json::array())) {
+                skin->inverseBindMatrices.push_back(MatrixFromJson(matrixJson));
+            }
+            const auto influenceBones = skinJson.value("influenceBones", std::vector<std::uint16_t>());
+            const auto influenceWeights = skinJson.value("influenceWeights", std::vector<float>());
+            const std::size_t vertexCount = m_vertices.size() / 8;
+            if (influenceBones.size() == vertexCount * 4 && influenceWeights.size() == vertexCount * 4) {
+                skin->influences.resize(vertexCount);
+                for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+                    std::copy_n(influenceBones.begin() + vertex * 4, 4, skin->influences[vertex].bones);
+                    std::copy_n(influenceWeights.begin() + vertex * 4, 4, skin->influences[vertex].weights);
                 }
+            }
+            skin->rootInverse = MatrixFromJson(skinJson.value("rootInverse", nlohmann::json::array()));
+            if (IsSkinConsistent(*skin, vertexCount)) {
+                skin->bindVertices = m_vertices;
+                m_skin = std::move(skin);
+                m_boneCount = static_cast<int>(m_skin->boneJoints.size());
+            } else {
+                LOG_WARN("Skin data does not match mesh, skinning disabled: " + path);
+            }
+        }
 
-                m_animationClips.push_back(std::move(clip));
+        const std::string clipSource = FileSystem::ResolvePath(path).string();
+        m_animationClips = AnimationLibrary::Instance().FindClips(clipSource);
+        if (m_animationClips.empty() && j.contains("animationClips") && j["animationClips"].is_array()) {
+            std::vector<AnimationClip> clips;
+            for (const auto& clipJson : j["animationClips"]) {
+                clips.push_back(AnimationLibrary::ClipFromJson(clipJson));
             }
+            m_animationClips = AnimationLibrary::Instance().RegisterClips(clipSource, std::move(clips));
         }
 
         return true;
@@ -345,12 +1081,89 @@ namespace OGLE {
 
     void BaseModel::SetMeshGeometry(std::vector<float> vertices, std::vector<unsigned int> indices)
     {
+        ReleaseSharedMesh();
+        m_lods.reset();
         m_vertices = std::move(vertices);
         m_indices = std::move(indices);
+        m_bounds = MeshBounds::FromVertices(m_vertices);
+        MarkBoundsChanged();
+        m_submeshes.clear();
+        m_materialSlots.clear();
+        m_materialTextures.clear();
+    }
+
+    void BaseModel::ReadSubmeshes(const std::uint8_t* data, const std::vector<ModelBinaryFormat::SectionEntry>& sections, const std::string& path) {
+        using namespace ModelBinaryFormat;
+        MeshSubmeshList submeshes;
+        std::vector<MeshMaterialSlot> materialSlots;
+
+        if (const SectionEntry* materialSection = FindSection(sections, SectionType::Materials)) {
+            Reader reader(data + materialSection->offset, static_cast<std::size_t>(materialSection->size));
+            std::uint32_t count = 0;
+            reader.Read(count);
+            for (std::uint32_t i = 0; i < count && reader.IsValid(); ++i) {
+                MeshMaterialSlot slot;
+                reader.ReadString(slot.name);
+                reader.ReadString(slot.diffuseTexturePath);
+                reader.Read(slot.baseColor.x);
+                reader.Read(slot.baseColor.y);
+                reader.Read(slot.baseColor.z);
+                materialSlots.push_back(std::move(slot));
+            }
+            if (!reader.IsValid()) {
+                LOG_WARN("Failed to read model materials: " + path);
+                materialSlots.clear();
+            }
+        }
+
+        // Диапазоны должны идти подряд и покрывать все индексы, иначе модель рисуется целиком.
+        if (const SectionEntry* submeshSection = FindSection(sections, SectionType::Submeshes)) {
+            const std::size_t count = static_cast<std::size_t>(submeshSection->size) / sizeof(SubmeshRecord);
+            const auto* records = reinterpret_cast<const SubmeshRecord*>(data + submeshSection->offset);
+            std::size_t expectedOffset = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                const bool materialValid = records[i].materialIndex >= 0
+                    && (materialSlots.empty() || static_cast<std::size_t>(records[i].materialIndex) < materialSlots.size());
+                if (records[i].indexOffset != expectedOffset || records[i].indexCount % 3 != 0 || !materialValid) {
+                    break;
+                }
+                MeshSubmesh submesh;
+                submesh.indexOffset = records[i].indexOffset;
+                submesh.indexCount = records[i].indexCount;
+                submesh.materialIndex = records[i].materialIndex;
+                submeshes.push_back(submesh);
+                expectedOffset += records[i].indexCount;
+            }
+            if (expectedOffset != m_indices.size()) {
+                LOG_WARN("Submesh ranges do not cover the mesh, drawing it whole: " + path);
+                submeshes.clear();
+            }
+        }
+
+        m_submeshes = std::move(submeshes);
+        m_materialSlots = std::move(materialSlots);
+        m_materialTextures.clear();
+        const SectionEntry* boundsSection = FindSection(sections, SectionType::SubmeshBounds);
+        if (boundsSection && boundsSection->size == m_submeshes.size() * sizeof(BoundsRecord)) {
+            const auto* records = reinterpret_cast<const BoundsRecord*>(data + boundsSection->offset);
+            for (std::size_t i = 0; i < m_submeshes.size(); ++i) {
+                m_submeshes[i].bounds = MeshBounds::FromMinMax(
+                    glm::vec3(records[i].min[0], records[i].min[1], records[i].min[2]),
+                    glm::vec3(records[i].max[0], records[i].max[1], records[i].max[2]),
+                    records[i].radius);
+            }
+        } else {
+            UpdateSubmeshBounds();
+        }
     }
 
     int BaseModel::GetBoneCount() const
     {
         return m_boneCount;
     }
+
+    const std::string& BaseModel::GetMeshNodeName() const
+    {
+        return m_meshNodeName;
+    }
 }
@@ -1,34 +1,129 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
 #include <string>
 #include <memory>
 #include <vector>
+#include "MeshBounds.h"
 #include "MeshBuffer.h"
+#include "MeshSimplifier.h"
+#include "MeshSubmesh.h"
+#include "ModelBinaryFormat.h"
+#include "SharedMesh.h"
+#include "SkinData.h"
 #include "../world/WorldComponents.h"
 
+struct aiScene;
+
 namespace OGLE {
     class BaseModel {
     public:
         BaseModel();
         ~BaseModel();
 
+        // Файлы Assimp читаются через ImportCache: повторная загрузка неизменённого
+        // исходника с теми же настройками берёт готовый .omdl из каталога кэша.
         bool LoadFromFile(const std::string& path);
+        // .omdl: пишется бинарный v3 (см. ModelBinaryFormat), читаются v2, v3 и JSON v1.
         bool LoadCustomFile(const std::string& path);
+        // Один меш уже прочитанной сцены, без скина и клипов (ModelSceneImporter).
+        // Только CPU, как и LoadFromFile.
+        bool LoadFromSceneMesh(const aiScene* scene, unsigned int meshIndex, const std::string& path);
         bool SaveToCustomFile(const std::string& path) const;
         void BakeToGPU();
+        // Раскладка, в которой BakeToGPU загружает вершины. Скинированные модели
+        // всегда остаются Float32: CPU-скиннинг обновляет буфер каждый кадр.
+        void SetVertexFormat(VertexFormat format);
+        // Раскладка буфера GPU уровня lodLevel (0 — исходный меш, общий или свой).
+        const VertexLayout& GetVertexLayout(int lodLevel = 0) const;
+        // Локальные границы: свои или общего меша. Остаются после ConvertToStatic.
+        const MeshBounds& GetBounds() const;
+        // Меняется при каждой смене границ (новая геометрия, общий меш, загрузка);
+        // по ней World пересчитывает WorldBoundsComponent сущностей с этой моделью.
+        std::uint64_t GetBoundsRevision() const { return m_boundsRevision; }
+        // Последняя выданная ревизия границ среди всех моделей.
+        static std::uint64_t GetLatestBoundsRevision();
+        // Диапазоны индексов уровня lodLevel по материалам; пусто — меш рисуется целиком.
+        // Диапазон i каждого уровня — та же часть модели, что и у исходного меша.
+        const MeshSubmeshList& GetSubmeshes(int lodLevel = 0) const;
+        const std::vector<MeshMaterialSlot>& GetMaterialSlots() const;
+        // Загруженная диффузная текстура слота; nullptr без текстуры. Своя геометрия
+        // хранит текстуры, только если скопирована из общего меша (DetachMesh).
+        const Texture2D* GetMaterialTexture(int materialIndex) const;
+        // Ширина индексов в буфере GPU; до загрузки — та, что будет выбрана по числу вершин.
+        IndexFormat GetIndexFormat() const;
+        // Упрощённые уровни текущей геометрии (MeshSimplifier). Скинированные меши не
+        // упрощаются: CPU-скиннинг обновляет только буфер исходного меша. Буферы уровней
+        // создаёт BakeToGPU (или сразу, если модель уже загружена в GPU).
+        void GenerateLODs(const LODSettings& settings);
+        // nullptr, если уровней нет; изменение геометрии их сбрасывает.
+        const MeshLODChain* GetLODs() const;
+        // Буфер уровня lodLevel; уровни за концом цепочки дают самый грубый.
+        const MeshBuffer* GetLODBuffer(int lodLevel) const;
+        // Тот же уровень в раскладке Float32 (MeshBuffer::GetFloat32Buffer): для программ,
+        // которые не распаковывают сжатые вершины. Копия создаётся в главном потоке из
+        // CPU-геометрии; без неё (модель после ConvertToStatic) — исходный буфер.
+        const MeshBuffer* GetFloat32LODBuffer(int lodLevel);
+        // Флаги Assimp, с которыми импортируются файлы; входят в ключ MeshCache.
+        static unsigned int GetImportFlags();
+
+        // Общая геометрия из MeshCache. Модель с общим мешем не хранит своих вершин;
+        // DetachMesh делает копию (и свои буферы GPU) перед изменением геометрии.
+        // false — копировать нечего (модель после ConvertToStatic делит буфер с оригиналом):
+        // модель остаётся как была, менять её вершины нельзя.
+        void ShareMesh(std::shared_ptr<const SharedMesh> mesh);
+        bool DetachMesh();
+        bool IsMeshShared() const;
+        const SharedMesh* GetSharedMesh() const;
+        // Переносит загруженную геометрию в общий меш, модель становится его пользователем.
+        std::shared_ptr<SharedMesh> CreateSharedMesh(const std::string& key);
         const std::string& GetLoadedDiffuseTexturePath() const;
-        const std::vector<AnimationClip>& GetAnimationClips() const;
-        void SetAnimationClips(const std::vector<AnimationClip>& clips);
+        // Общие клипы из AnimationLibrary; копии ключей не создаются.
+        const std::vector<AnimationClipHandle>& GetAnimationClips() const;
+        void SetAnimationClips(std::vector<AnimationClipHandle> clips);
         int GetBoneCount() const;
+        // Веса костей и скелет; nullptr, если меш не скинированный. Общие для копий модели.
+        const SkinData* GetSkin() const;
+        void SetSkin(std::shared_ptr<const SkinData> skin);
+        // Имя узла сцены, к которому привязан меш: его трек анимирует саму сущность.
+        const std::string& GetMeshNodeName() const;
 
     protected:
+        // Вершины и индексы модели: свои или общего меша.
+        const std::vector<float>& GetMeshVertices() const;
+        const std::vector<unsigned int>& GetMeshIndices() const;
+        void ReleaseSharedMesh();
+        // Вызывается после смены m_bounds или m_sharedMesh.
+        void MarkBoundsChanged();
+        // clipSource — ключ клипов в AnimationLibrary: сам файл или исходник записи ImportCache.
+        bool LoadBinaryModel(const std::uint8_t* data, std::size_t size, const std::string& path, const std::string& clipSource);
+        bool LoadCachedImport(const std::filesystem::path& cachePath, const std::string& sourcePath);
+        bool LoadJsonModel(const std::uint8_t* data, std::size_t size, const std::string& path);
         void SetMeshGeometry(std::vector<float> vertices, std::vector<unsigned int> indices);
+        // Вызывается после SetMeshGeometry: геометрия сбрасывает диапазоны.
+        void SetSubmeshes(MeshSubmeshList submeshes, std::vector<MeshMaterialSlot> materialSlots);
+        void UpdateSubmeshBounds();
+        void ReadSubmeshes(const std::uint8_t* data, const std::vector<ModelBinaryFormat::SectionEntry>& sections, const std::string& path);
 
-        std::vector<AnimationClip> m_animationClips;
+        std::vector<AnimationClipHandle> m_animationClips;
         std::vector<float> m_vertices;
         std::vector<unsigned int> m_indices;
-        std::unique_ptr<MeshBuffer> m_MeshBuffer;
+        std::shared_ptr<MeshBuffer> m_MeshBuffer;
         std::string m_loadedDiffuseTexturePath;
         int m_boneCount = 0;
+        std::string m_meshNodeName;
+        std::shared_ptr<const SkinData> m_skin;
+        std::shared_ptr<const SharedMesh> m_sharedMesh;
+        // Свои уровни модели; у модели с общим мешем — пусто, уровни в m_sharedMesh.
+        std::shared_ptr<MeshLODChain> m_lods;
+        MeshBounds m_bounds;
+        std::uint64_t m_boundsRevision = 0;
+        MeshSubmeshList m_submeshes;
+        std::vector<MeshMaterialSlot> m_materialSlots;
+        // Текстуры слотов, скопированные из общего меша; сбрасываются вместе со слотами.
+        std::vector<std::shared_ptr<Texture2D>> m_materialTextures;
+        VertexFormat m_vertexFormat = VertexFormat::Float32;
     };
 }
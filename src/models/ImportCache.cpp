@@ -0,0 +1,227 @@
+#include "ImportCache.h"
+#include "ModelBinaryFormat.h"
+#include "../Logger.h"
+#include "../core/FileSystem.h"
+#include "../core/MappedFile.h"
+#include "../core/StringId.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <sstream>
+#include <system_error>
+#include <thread>
+
+namespace OGLE {
+    namespace {
+        template <typename T>
+        std::uint64_t HashValue(std::uint64_t hash, const T& value) {
+            return Fnv1aBytes(&value, sizeof(T), hash);
+        }
+
+        std::string FormatHash(std::uint64_t hash) {
+            char hex[17];
+            std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+            return hex;
+        }
+
+        // Пустой файл не отображается в память, но хэш у него есть; 0 — файла нет.
+        std::uint64_t HashFile(const std::filesystem::path& path) {
+            MappedFile file;
+            if (file.Open(path)) {
+                return Fnv1aBytes(file.GetData(), file.GetSize());
+            }
+            return FileSystem::Exists(path) ? kFnv1aOffsetBasis : 0;
+        }
+
+        // Запись действительна, только если все её зависимости не менялись.
+        // Метаданные без списка зависимостей (недописанная запись) — промах.
+        bool DependenciesMatch(const std::filesystem::path& metaPath) {
+            std::string metaText;
+            if (!FileSystem::ReadTextFile(metaPath, metaText)) {
+                return false;
+            }
+            const nlohmann::json meta = nlohmann::json::parse(metaText, nullptr, false);
+            if (!meta.is_object() || !meta.contains("dependencies") || !meta.at("dependencies").is_array()) {
+                return false;
+            }
+            for (const nlohmann::json& dependency : meta.at("dependencies")) {
+                const std::string path = dependency.value("path", std::string());
+                if (path.empty() || dependency.value("hash", std::string()) != FormatHash(HashFile(path))) {
+                    LOG_INFO("Import cache entry is stale, dependency changed: " + path);
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        std::string FormatStats(const ImportCacheStats& stats) {
+            std::ostringstream text;
+            text << "hits " << stats.hits << ", misses " << stats.misses
+                 << ", saved " << static_cast<long long>(stats.importMs - stats.loadMs) << " ms";
+            return text.str();
+        }
+    }
+
+    Assimp::IOStream* ImportDependencyRecorder::Open(const char* file, const char* mode) {
+        Assimp::IOStream* stream = Assimp::DefaultIOSystem::Open(file, mode);
+        if (stream && file) {
+            std::error_code error;
+            const std::filesystem::path path = std::filesystem::absolute(file, error);
+            m_openedFiles.push_back((error ? std::filesystem::path(file) : path).lexically_normal());
+        }
+        return stream;
+    }
+
+    ImportCache& ImportCache::Instance() {
+        static ImportCache instance;
+        return instance;
+    }
+
+    void ImportCache::SetEnabled(bool enabled) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_enabled = enabled;
+    }
+
+    bool ImportCache::IsEnabled() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_enabled;
+    }
+
+    void ImportCache::SetDirectory(const std::string& directory) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_directory = directory;
+    }
+
+    std::string ImportCache::GetDirectory() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_directory;
+    }
+
+    ImportCacheEntry ImportCache::Lookup(
+        const std::filesystem::path& sourcePath,
+        unsigned int importFlags,
+        const MeshOptimizerSettings& optimizer,
+        const AnimationCompressionSettings& compression) {
+        ImportCacheEntry entry;
+        std::string directory;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_enabled || m_directory.empty()) {
+                return entry;
+            }
+            directory = m_directory;
+        }
+
+        MappedFile source;
+        if (!source.Open(sourcePath)) {
+            return entry;
+        }
+
+        std::uint64_t hash = Fnv1aBytes(source.GetData(), source.GetSize());
+        hash = HashValue(hash, importFlags);
+        hash = HashValue(hash, optimizer.weldVertices);
+        hash = HashValue(hash, optimizer.optimizeVertexCache);
+        hash = HashValue(hash, optimizer.optimizeOverdraw);
+        hash = HashValue(hash, optimizer.optimizeVertexFetch);
+        hash = HashValue(hash, optimizer.overdrawThreshold);
+        hash = HashValue(hash, compression.translationTolerance);
+        hash = HashValue(hash, compression.rotationTolerance);
+        hash = HashValue(hash, compression.scaleTolerance);
+        hash = HashValue(hash, ModelBinaryFormat::kVersion);
+        hash = HashValue(hash, kImporterVersion);
+
+        // Имя исходника остаётся в имени записи, чтобы каталог кэша было удобно разбирать руками.
+        const std::string name = sourcePath.stem().string() + "-" + FormatHash(hash);
+        const std::filesystem::path root = FileSystem::ResolvePath(directory);
+        entry.modelPath = root / (name + ".omdl");
+        entry.metaPath = root / (name + ".json");
+        entry.exists = FileSystem::Exists(entry.modelPath) && DependenciesMatch(entry.metaPath);
+        return entry;
+    }
+
+    std::filesystem::path ImportCache::GetTemporaryPath(const ImportCacheEntry& entry) const {
+        const std::size_t thread = std::hash<std::thread::id>()(std::this_thread::get_id());
+        std::filesystem::path path = entry.modelPath;
+        path += "." + std::to_string(thread) + ".tmp";
+        return path;
+    }
+
+    bool ImportCache::Store(
+        const ImportCacheEntry& entry,
+        const std::filesystem::path& sourcePath,
+        const std::vector<std::filesystem::path>& dependencies,
+        double importMs) {
+        const std::filesystem::path temporaryPath = GetTemporaryPath(entry);
+        std::error_code error;
+        std::filesystem::rename(temporaryPath, entry.modelPath, error);
+        if (error) {
+            std::filesystem::remove(temporaryPath, error);
+            LOG_WARN("Failed to store import cache entry: " + entry.modelPath.string());
+            return false;
+        }
+
+        // Метаданные пишутся после .omdl: между этими шагами читатель видит либо запись
+        // без метаданных, либо хэши прежних зависимостей — и то и другое даёт промах.
+        const std::filesystem::path source = std::filesystem::absolute(sourcePath, error).lexically_normal();
+        nlohmann::json dependencyList = nlohmann::json::array();
+        std::vector<std::filesystem::path> listed;
+        for (const std::filesystem::path& dependency : dependencies) {
+            if (dependency == source || std::find(listed.begin(), listed.end(), dependency) != listed.end()) {
+                continue;
+            }
+            listed.push_back(dependency);
+            dependencyList.push_back({
+                { "path", dependency.string() },
+                { "hash", FormatHash(HashFile(dependency)) }
+            });
+        }
+
+        const nlohmann::json meta = {
+            { "source", sourcePath.string() },
+            { "dependencies", dependencyList },
+            { "importMs", importMs }
+        };
+        FileSystem::WriteTextFile(entry.metaPath, meta.dump(4));
+
+        ImportCacheStats stats;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_stats.misses;
+            stats = m_stats;
+        }
+        LOG_INFO("Import cache miss: " + sourcePath.string() + " imported in " + std::to_string(importMs)
+            + " ms, cached as " + entry.modelPath.filename().string() + " (" + FormatStats(stats) + ")");
+        return true;
+    }
+
+    void ImportCache::RecordHit(const ImportCacheEntry& entry, const std::filesystem::path& sourcePath, double loadMs) {
+        // Без метаданных время импорта неизвестно, экономия считается нулевой.
+        double importMs = loadMs;
+        std::string metaText;
+        if (FileSystem::ReadTextFile(entry.metaPath, metaText)) {
+            const nlohmann::json meta = nlohmann::json::parse(metaText, nullptr, false);
+            if (meta.is_object()) {
+                importMs = meta.value("importMs", loadMs);
+            }
+        }
+
+        ImportCacheStats stats;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_stats.hits;
+            m_stats.importMs += importMs;
+            m_stats.loadMs += loadMs;
+            stats = m_stats;
+        }
+        LOG_INFO("Import cache hit: " + sourcePath.string() + " loaded in " + std::to_string(loadMs)
+            + " ms instead of " + std::to_string(importMs) + " ms (" + FormatStats(stats) + ")");
+    }
+
+    ImportCacheStats ImportCache::GetStats() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+}
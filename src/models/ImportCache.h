@@ -0,0 +1,95 @@
+#pragma once
+
+#include "MeshOptimizer.h"
+#include "../world/systems/AnimationCompressor.h"
+
+#include <assimp/DefaultIOSystem.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OGLE {
+    struct ImportCacheStats {
+        std::size_t hits = 0;
+        std::size_t misses = 0;      // Импорты через Assimp, результат которых записан в кэш
+        double importMs = 0.0;       // Сколько заняли бы попадания, если бы шли через Assimp
+        double loadMs = 0.0;         // Сколько заняли попадания на самом деле
+    };
+
+    // Запись кэша для одного исходного файла и набора настроек импорта.
+    struct ImportCacheEntry {
+        std::filesystem::path modelPath; // .omdl с результатом импорта; пусто, если кэш выключен
+        std::filesystem::path metaPath;  // JSON: исходный файл, зависимости и время импорта
+        bool exists = false;
+    };
+
+    // Файловая система Assimp, которая запоминает файлы, открытые импортом помимо
+    // исходника: .mtl у OBJ, внешние буферы .bin у glTF и т. п. Передаётся в
+    // Assimp::Importer::SetIOHandler (импортёр её и удаляет); список читается до
+    // уничтожения импортёра и уходит в ImportCache::Store.
+    class ImportDependencyRecorder : public Assimp::DefaultIOSystem {
+    public:
+        Assimp::IOStream* Open(const char* file, const char* mode = "rb") override;
+        const std::vector<std::filesystem::path>& GetOpenedFiles() const { return m_openedFiles; }
+
+    private:
+        std::vector<std::filesystem::path> m_openedFiles;
+    };
+
+    // Кэш результатов импорта Assimp на диске: BaseModel::LoadFromFile сохраняет
+    // обработанный меш (после оптимизации, со скином и сжатыми клипами) в .omdl и при
+    // следующей загрузке читает его вместо исходника. Ключ — FNV-1a 64 от байтов
+    // исходного файла, флагов Assimp, настроек MeshOptimizer и сжатия анимаций, версии
+    // .omdl и kImporterVersion, так что изменённый файл или настройки дают новую запись.
+    // Файлы, которые исходник подключает (.mtl, .bin), в ключ не входят: их хэши лежат
+    // в метаданных записи, и запись с изменённой зависимостью считается промахом.
+    // Вызывается из любых потоков (фоновый импорт ModelImportQueue).
+    class ImportCache {
+    public:
+        // Увеличивается при любом изменении импорта, которое меняет результат.
+        static constexpr std::uint32_t kImporterVersion = 2;
+
+        static ImportCache& Instance();
+
+        void SetEnabled(bool enabled);
+        bool IsEnabled();
+        // Относительный путь разрешается через FileSystem::ResolvePath.
+        void SetDirectory(const std::string& directory);
+        std::string GetDirectory();
+
+        // Читает исходный файл целиком для хэша, у найденной записи — ещё и её зависимости.
+        // Пустая запись, если кэш выключен или файл не читается.
+        ImportCacheEntry Lookup(
+            const std::filesystem::path& sourcePath,
+            unsigned int importFlags,
+            const MeshOptimizerSettings& optimizer,
+            const AnimationCompressionSettings& compression);
+        // Временный файл для записи .omdl: Store переносит его на место одной операцией,
+        // поэтому параллельный читатель не увидит недописанный файл.
+        std::filesystem::path GetTemporaryPath(const ImportCacheEntry& entry) const;
+        // false, если запись не удалось перенести; временный файл тогда удаляется.
+        // dependencies — файлы, открытые импортом (ImportDependencyRecorder); исходник среди них пропускается.
+        bool Store(
+            const ImportCacheEntry& entry,
+            const std::filesystem::path& sourcePath,
+            const std::vector<std::filesystem::path>& dependencies,
+            double importMs);
+
+        void RecordHit(const ImportCacheEntry& entry, const std::filesystem::path& sourcePath, double loadMs);
+        ImportCacheStats GetStats();
+
+    private:
+        ImportCache() = default;
+        ImportCache(const ImportCache&) = delete;
+        ImportCache& operator=(const ImportCache&) = delete;
+
+        std::mutex m_mutex;
+        bool m_enabled = true;
+        std::string m_directory = "cache/imports";
+        ImportCacheStats m_stats;
+    };
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace OGLE {
+    // Ширина индексов в буфере GPU и в .omdl. На CPU индексы всегда unsigned int.
+    enum class IndexFormat : std::uint8_t {
+        UInt16,
+        UInt32
+    };
+
+    // Вершины 0..65535 адресуются 16-битными индексами.
+    constexpr std::size_t kMaxUInt16IndexedVertices = 65536;
+
+    constexpr IndexFormat SelectIndexFormat(std::size_t vertexCount) {
+        return vertexCount <= kMaxUInt16IndexedVertices ? IndexFormat::UInt16 : IndexFormat::UInt32;
+    }
+
+    constexpr std::size_t GetIndexSize(IndexFormat format) {
+        return format == IndexFormat::UInt16 ? sizeof(std::uint16_t) : sizeof(std::uint32_t);
+    }
+}
@@ -0,0 +1,87 @@
+#include "MeshBounds.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace OGLE {
+    namespace {
+        constexpr std::size_t kVertexStride = 8;
+    }
+
+    MeshBounds MeshBounds::FromVertices(const std::vector<float>& vertices) {
+        MeshBounds bounds;
+        const std::size_t vertexCount = vertices.size() / kVertexStride;
+        if (vertexCount == 0) {
+            return bounds;
+        }
+
+        glm::vec3 minimum(vertices[0], vertices[1], vertices[2]);
+        glm::vec3 maximum = minimum;
+        for (std::size_t vertex = 1; vertex < vertexCount; ++vertex) {
+            const float* position = &vertices[vertex * kVertexStride];
+            minimum = glm::min(minimum, glm::vec3(position[0], position[1], position[2]));
+            maximum = glm::max(maximum, glm::vec3(position[0], position[1], position[2]));
+        }
+
+        // Сфера вокруг центра AABB: второй проход даёт радиус точнее половины диагонали.
+        const glm::vec3 center = (minimum + maximum) * 0.5f;
+        float radiusSquared = 0.0f;
+        for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            const float* position = &vertices[vertex * kVertexStride];
+            const glm::vec3 offset = glm::vec3(position[0], position[1], position[2]) - center;
+            radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+        }
+        return FromMinMax(minimum, maximum, std::sqrt(radiusSquared));
+    }
+
+    MeshBounds MeshBounds::FromIndexedVertices(
+        const std::vector<float>& vertices,
+        const std::vector<unsigned int>& indices,
+        std::size_t indexOffset,
+        std::size_t indexCount) {
+        MeshBounds bounds;
+        const std::size_t vertexCount = vertices.size() / kVertexStride;
+        const std::size_t end = std::min(indices.size(), indexOffset + indexCount);
+        bool hasPoint = false;
+        glm::vec3 minimum(0.0f);
+        glm::vec3 maximum(0.0f);
+        for (std::size_t i = indexOffset; i < end; ++i) {
+            if (indices[i] >= vertexCount) {
+                continue;
+            }
+            const float* position = &vertices[indices[i] * kVertexStride];
+            const glm::vec3 point(position[0], position[1], position[2]);
+            minimum = hasPoint ? glm::min(minimum, point) : point;
+            maximum = hasPoint ? glm::max(maximum, point) : point;
+            hasPoint = true;
+        }
+        if (!hasPoint) {
+            return bounds;
+        }
+
+        // Вершины, общие для нескольких треугольников, проверяются повторно — на радиус это не влияет.
+        const glm::vec3 center = (minimum + maximum) * 0.5f;
+        float radiusSquared = 0.0f;
+        for (std::size_t i = indexOffset; i < end; ++i) {
+            if (indices[i] >= vertexCount) {
+                continue;
+            }
+            const float* position = &vertices[indices[i] * kVertexStride];
+            const glm::vec3 offset = glm::vec3(position[0], position[1], position[2]) - center;
+            radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+        }
+        return FromMinMax(minimum, maximum, std::sqrt(radiusSquared));
+    }
+
+    MeshBounds MeshBounds::FromMinMax(const glm::vec3& min, const glm::vec3& max, float radius) {
+        MeshBounds bounds;
+        bounds.min = min;
+        bounds.max = max;
+        bounds.center = (min + max) * 0.5f;
+        bounds.radius = radius;
+        bounds.valid = true;
+        return bounds;
+    }
+}
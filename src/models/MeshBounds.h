@@ -0,0 +1,29 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace OGLE {
+    // Локальные границы меша: AABB и описанная сфера с центром в центре AABB.
+    // Считаются один раз при загрузке или BakeToGPU и остаются после освобождения
+    // CPU-копии вершин (ConvertToStatic). У скинированных мешей — границы позы привязки.
+    struct MeshBounds {
+        glm::vec3 min{0.0f};
+        glm::vec3 max{0.0f};
+        glm::vec3 center{0.0f};
+        float radius = 0.0f;
+        bool valid = false; // false — у меша нет вершин
+
+        // Вершины в раскладке BaseModel (8 float, позиция первой).
+        static MeshBounds FromVertices(const std::vector<float>& vertices);
+        // Только вершины, на которые ссылаются indices[indexOffset, indexOffset + indexCount).
+        static MeshBounds FromIndexedVertices(
+            const std::vector<float>& vertices,
+            const std::vector<unsigned int>& indices,
+            std::size_t indexOffset,
+            std::size_t indexCount);
+        static MeshBounds FromMinMax(const glm::vec3& min, const glm::vec3& max, float radius);
+    };
+}
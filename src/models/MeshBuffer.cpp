@@ -2,6 +2,8 @@
 #include "../opengl/OpenGLUtils.h" // Для GL_CHECK
 #include "../Logger.h"
 
+#include <cstdint>
+
 namespace OGLE {
 
 MeshBuffer::MeshBuffer()
@@ -15,14 +17,81 @@ MeshBuffer::~MeshBuffer() {
     if (EBO != 0) GL_CHECK(glDeleteBuffers(1, &EBO));
 }
 
-void MeshBuffer::Create(const std::vector<float>& vertices, const std::vector<unsigned int>& indices)
+namespace {
+    // Тип компонента, число компонент и нормализация атрибута для glVertexAttribPointer.
+    void SetAttributePointer(const VertexAttributeDesc& desc, GLsizei stride)
+    {
+        GLint components = 3;
+        GLenum type = GL_FLOAT;
+        GLboolean normalized = GL_FALSE;
+        switch (desc.format) {
+        case VertexAttributeFormat::Float2:
+            components = 2;
+            break;
+        case VertexAttributeFormat::Float3:
+            break;
+        case VertexAttributeFormat::UNorm16x3:
+            type = GL_UNSIGNED_SHORT;
+            normalized = GL_TRUE;
+            break;
+        case VertexAttributeFormat::OctSNorm16x2:
+            components = 2;
+            type = GL_SHORT;
+            normalized = GL_TRUE;
+            break;
+        case VertexAttributeFormat::Half2:
+            components = 2;
+            type = GL_HALF_FLOAT;
+            break;
+        case VertexAttributeFormat::UInt8x4:
+            components = 4;
+            type = GL_UNSIGNED_BYTE;
+            break;
+        case VertexAttributeFormat::UNorm8x4:
+            components = 4;
+            type = GL_UNSIGNED_BYTE;
+            normalized = GL_TRUE;
+            break;
+        }
+
+        const GLuint location = static_cast<GLuint>(desc.attribute);
+        GL_CHECK(glEnableVertexAttribArray(location));
+        GL_CHECK(glVertexAttribPointer(location, components, type, normalized, stride, reinterpret_cast<void*>(static_cast<std::uintptr_t>(desc.offset))));
+    }
+}
+
+void MeshBuffer::Create(const std::vector<float>& vertices, const std::vector<unsigned int>& indices, VertexFormat format)
 {
     if (vertices.empty() || indices.empty()) {
         return;
     }
 
+    // Сжатая раскладка упаковывается и в headless-сборке: размеры буферов остаются честными.
+    m_layout = VertexLayout::Create(format);
+    std::vector<std::uint8_t> packedVertices;
+    if (m_layout.IsQuantized() && !VertexQuantization::PackVertices(vertices, nullptr, m_layout, packedVertices)) {
+        m_layout = VertexLayout::Create(VertexFormat::Float32);
+    }
+    const void* vertexData = m_layout.IsQuantized() ? static_cast<const void*>(packedVertices.data()) : static_cast<const void*>(vertices.data());
+
+    m_indexFormat = SelectIndexFormat(vertices.size() / 8);
     m_indexCount = static_cast<GLsizei>(indices.size());
-    m_vertexBufferSize = vertices.size() * sizeof(float);
+    m_vertexBufferSize = m_layout.IsQuantized()
+        ? static_cast<GLsizeiptr>(packedVertices.size())
+        : static_cast<GLsizeiptr>(vertices.size() * sizeof(float));
+
+#ifdef OGLE_HEADLESS
+    // Null render path: без контекста OpenGL буферы не создаются,
+    // VAO остаётся 0, поэтому Update/Draw/деструктор ничего не делают.
+    (void)vertexData;
+    return;
+#endif
+
+    std::vector<std::uint16_t> shortIndices;
+    if (m_indexFormat == IndexFormat::UInt16) {
+        shortIndices.assign(indices.begin(), indices.end());
+    }
+    const void* indexData = m_indexFormat == IndexFormat::UInt16 ? static_cast<const void*>(shortIndices.data()) : static_cast<const void*>(indices.data());
 
     GL_CHECK(glGenVertexArrays(1, &VAO));
     GL_CHECK(glGenBuffers(1, &VBO));
@@ -30,26 +99,15 @@ void MeshBuffer::Create(const std::vector<float>& vertices, const std::vector<un
 
     GL_CHECK(glBindVertexArray(VAO));
     GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, VBO));
-    GL_CHECK(glBufferData(GL_ARRAY_BUFFER, m_vertexBufferSize, vertices.data(), GL_DYNAMIC_DRAW));
+    GL_CHECK(glBufferData(GL_ARRAY_BUFFER, m_vertexBufferSize, vertexData, m_layout.IsQuantized() ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW));
 
     GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO));
-    GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW));
-
-    // Stride - это размер одной вершины в байтах. В BaseModel.cpp данные пакуются как:
-    // pos (3 float) + normal (3 float) + texCoord (2 float) = 8 floats
-    const GLsizei stride = 8 * sizeof(float);
-
-    // Атрибут 0: Позиции вершин (vec3)
-    GL_CHECK(glEnableVertexAttribArray(0));
-    GL_CHECK(glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0));
-
-    // Атрибут 1: Нормали вершин (vec3)
-    GL_CHECK(glEnableVertexAttribArray(1));
-    GL_CHECK(glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float))));
+    GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size() * GetIndexSize(m_indexFormat)), indexData, GL_STATIC_DRAW));
 
-    // Атрибут 2: Текстурные координаты вершин (UV) (vec2)
-    GL_CHECK(glEnableVertexAttribArray(2));
-    GL_CHECK(glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(6 * sizeof(float))));
+    // Атрибуты по описанию раскладки: 0 — позиция, 1 — нормаль, 2 — UV (см. VertexAttribute).
+    for (const VertexAttributeDesc& desc : m_layout.attributes) {
+        SetAttributePointer(desc, static_cast<GLsizei>(m_layout.stride));
+    }
 
     GL_CHECK(glBindVertexArray(0));
 }
@@ -57,6 +115,10 @@ void MeshBuffer::Create(const std::vector<float>& vertices, const std::vector<un
 void MeshBuffer::Update(const std::vector<float>& vertices)
 {
     if (VBO == 0) return;
+    if (m_layout.IsQuantized()) {
+        LOG_ERROR("MeshBuffer::Update error: quantized vertex buffers are immutable. Re-creation is needed.");
+        return;
+    }
 
     const GLsizeiptr newSize = vertices.size() * sizeof(float);
     if (newSize > m_vertexBufferSize) {
@@ -70,10 +132,63 @@ void MeshBuffer::Update(const std::vector<float>& vertices)
     GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, 0));
 }
 
+std::size_t MeshBuffer::GetGpuBytes() const {
+    return static_cast<std::size_t>(m_vertexBufferSize) + static_cast<std::size_t>(m_indexCount) * GetIndexSize(m_indexFormat)
+        + (m_float32Copy ? m_float32Copy->GetGpuBytes() : 0);
+}
+
+const MeshBuffer* MeshBuffer::GetFloat32Buffer(const std::vector<float>& vertices, const std::vector<unsigned int>& indices) {
+    if (!m_layout.IsQuantized() || vertices.empty() || indices.empty()) {
+        return this;
+    }
+    if (!m_float32Copy) {
+        m_float32Copy = std::make_unique<MeshBuffer>();
+        m_float32Copy->Create(vertices, indices, VertexFormat::Float32);
+    }
+    return m_float32Copy.get();
+}
+
+const VertexLayout& MeshBuffer::GetLayout() const {
+    return m_layout;
+}
+
+IndexFormat MeshBuffer::GetIndexFormat() const {
+    return m_indexFormat;
+}
+
 void MeshBuffer::Draw() const {
     if (VAO == 0 || m_indexCount == 0) return;
     GL_CHECK(glBindVertexArray(VAO));
-    GL_CHECK(glDrawElements(GL_TRIANGLES, m_indexCount, GL_UNSIGNED_INT, 0));
+    GL_CHECK(glDrawElements(GL_TRIANGLES, m_indexCount, m_indexFormat == IndexFormat::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, 0));
+    GL_CHECK(glBindVertexArray(0));
+}
+
+bool MeshBuffer::Bind() const {
+    if (VAO == 0 || m_indexCount == 0) return false;
+    GL_CHECK(glBindVertexArray(VAO));
+    return true;
+}
+
+void MeshBuffer::DrawBound() const {
+    if (VAO == 0 || m_indexCount == 0) return;
+    GL_CHECK(glDrawElements(GL_TRIANGLES, m_indexCount, m_indexFormat == IndexFormat::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, 0));
+}
+
+void MeshBuffer::DrawBoundInstanced(GLsizei instanceCount) const {
+    if (VAO == 0 || m_indexCount == 0 || instanceCount <= 0) return;
+    GL_CHECK(glDrawElementsInstanced(GL_TRIANGLES, m_indexCount, m_indexFormat == IndexFormat::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, 0, instanceCount));
+}
+
+void MeshBuffer::Unbind() {
+    GL_CHECK(glBindVertexArray(0));
+}
+
+void MeshBuffer::DrawRange(std::size_t indexOffset, std::size_t indexCount) const {
+    if (VAO == 0 || indexCount == 0 || indexOffset + indexCount > static_cast<std::size_t>(m_indexCount)) return;
+    const std::size_t byteOffset = indexOffset * GetIndexSize(m_indexFormat);
+    GL_CHECK(glBindVertexArray(VAO));
+    GL_CHECK(glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indexCount), m_indexFormat == IndexFormat::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
+        reinterpret_cast<const void*>(static_cast<std::uintptr_t>(byteOffset))));
     GL_CHECK(glBindVertexArray(0));
 }
 
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cstddef>
+#include <memory>
 #include <vector>
 #include <glm/glm.hpp>
+#include "IndexFormat.h"
+#include "VertexLayout.h"
 #include "../opengl/GLFunctions.h" // Используем ручную загрузку функций
 
 namespace OGLE {
@@ -16,14 +20,32 @@ public:
     MeshBuffer(const MeshBuffer&) = delete;
     MeshBuffer& operator=(const MeshBuffer&) = delete;
 
-    void Create(const std::vector<float>& vertices, const std::vector<unsigned int>& indices);
-    void Update(const std::vector<float>& vertices);
+    // Вершины в раскладке BaseModel (8 float); Quantized упаковывает их перед загрузкой.
+    // Ширина индексов выбирается по числу вершин (SelectIndexFormat).
+    void Create(const std::vector<float>& vertices, const std::vector<unsigned int>& indices, VertexFormat format = VertexFormat::Float32);
+    void Update(const std::vector<float>& vertices); // Только для Float32: сжатый буфер создаётся заново
     void Draw() const; // Отрисовать меш
+    void DrawRange(std::size_t indexOffset, std::size_t indexCount) const; // Часть индексов (подмеш)
+    // Для очереди отрисовки: VAO остаётся привязанным между подряд идущими мешами.
+    bool Bind() const; // false — буфер пуст, DrawBound ничего не рисует
+    void DrawBound() const; // Весь меш; VAO уже привязан через Bind
+    void DrawBoundInstanced(GLsizei instanceCount) const; // То же, instanceCount копий за один вызов
+    static void Unbind();
+    std::size_t GetGpuBytes() const; // Размер вершинного и индексного буферов (вместе с копией Float32)
+    const VertexLayout& GetLayout() const;
+    // Копия сжатого буфера в раскладке Float32 для программ, которые не распаковывают
+    // вершины (нет uQuantizedVertices). Создаётся при первом запросе из тех же вершин и
+    // индексов, что были переданы в Create; буфер Float32 возвращает сам себя.
+    const MeshBuffer* GetFloat32Buffer(const std::vector<float>& vertices, const std::vector<unsigned int>& indices);
+    IndexFormat GetIndexFormat() const;
 
 private:
     GLuint VAO = 0, VBO = 0, EBO = 0; // ID буферов OpenGL
     GLsizei m_indexCount = 0;
     GLsizeiptr m_vertexBufferSize = 0;
+    IndexFormat m_indexFormat = IndexFormat::UInt32;
+    VertexLayout m_layout = VertexLayout::Create(VertexFormat::Float32);
+    std::unique_ptr<MeshBuffer> m_float32Copy;
 };
 
 } // namespace OGLE
\ No newline at end of file
@@ -0,0 +1,339 @@
+#include "MeshCache.h"
+#include "BaseModel.h"
+#include "PrimitiveFactory.h"
+#include "../Logger.h"
+#include "../core/FileSystem.h"
+
+#include <cstdlib>
+#include <iterator>
+#include <string>
+#include <sstream>
+
+namespace OGLE {
+    namespace {
+        constexpr const char* kPrimitivePrefix = "primitive:";
+        constexpr const char* kSceneMeshPrefix = "scene:";
+
+        const char* PrimitiveName(PrimitiveType type) {
+            switch (type) {
+            case PrimitiveType::Cube:
+                return "cube";
+            case PrimitiveType::Sphere:
+                return "sphere";
+            case PrimitiveType::Plane:
+                return "plane";
+            default:
+                return nullptr;
+            }
+        }
+    }
+
+    MeshCache& MeshCache::Instance() {
+        static MeshCache instance;
+        return instance;
+    }
+
+    std::string MeshCache::MakePrimitiveKey(PrimitiveType type) {
+        const char* name = PrimitiveName(type);
+        return name ? std::string(kPrimitivePrefix) + name : std::string();
+    }
+
+    bool MeshCache::IsPrimitiveKey(const std::string& key) {
+        return key.rfind(kPrimitivePrefix, 0) == 0;
+    }
+
+    std::string MeshCache::MakeSceneMeshKey(const std::string& path, int meshIndex) {
+        // Путь относительно проекта: ключ сохраняется в сцене (ModelEntity::ToJson)
+        // и при загрузке на другой машине снова разрешается через ResolvePath.
+        return std::string(kSceneMeshPrefix) + FileSystem::MakeProjectRelative(path).generic_string() + "#" + std::to_string(meshIndex);
+    }
+
+    bool MeshCache::IsSceneMeshKey(const std::string& key) {
+        return key.rfind(kSceneMeshPrefix, 0) == 0;
+    }
+
+    std::string MeshCache::MakeModelFileKey(const std::string& path) {
+        return MakeFileKey(FileSystem::ResolvePath(path).string(), BaseModel::GetImportFlags());
+    }
+
+    std::string MeshCache::MakeFileKey(const std::string& resolvedPath, unsigned int importFlags) {
+        std::ostringstream key;
+        key << resolvedPath << "|0x" << std::hex << importFlags;
+        return key.str();
+    }
+
+    std::shared_ptr<const SharedMesh> MeshCache::GetPrimitive(PrimitiveType type) {
+        const std::string key = MakePrimitiveKey(type);
+        if (key.empty()) {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (auto mesh = FindLocked(key)) {
+            ++m_hits;
+            return mesh;
+        }
+
+        std::vector<float> vertices;
+        std::vector<unsigned int> indices;
+        if (!PrimitiveFactory::BuildPrimitiveGeometry(type, vertices, indices)) {
+            return nullptr;
+        }
+
+        auto mesh = std::make_shared<SharedMesh>();
+        mesh->key = key;
+        mesh->vertices = std::move(vertices);
+        mesh->indices = std::move(indices);
+        mesh->bounds = MeshBounds::FromVertices(mesh->vertices);
+        mesh->buffer = std::make_shared<MeshBuffer>();
+        mesh->buffer->Create(mesh->vertices, mesh->indices, m_vertexFormat);
+        if (auto lods = MeshSimplifier::GenerateLODs(mesh->vertices, mesh->indices, m_lodSettings)) {
+            MeshSimplifier::CreateBuffers(*lods, m_vertexFormat);
+            mesh->lods = std::move(lods);
+        }
+
+        ++m_misses;
+        PurgeExpiredLocked();
+        m_meshes[key] = mesh;
+        return mesh;
+    }
+
+    std::shared_ptr<const SharedMesh> MeshCache::GetModelFile(const std::string& path) {
+        if (auto mesh = FindModelFile(path)) {
+            return mesh;
+        }
+
+        // Импорт идёт без блокировки: он долгий, а кэш нужен и другим вызовам.
+        BaseModel loader;
+        if (!ImportModelFile(path, loader)) {
+            return nullptr;
+        }
+        return AddModelFile(path, loader);
+    }
+
+    std::shared_ptr<const SharedMesh> MeshCache::FindModelFile(const std::string& path) {
+        const std::string key = MakeModelFileKey(path);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto mesh = FindLocked(key);
+        if (mesh) {
+            ++m_hits;
+        }
+        return mesh;
+    }
+
+    bool MeshCache::ImportModelFile(const std::string& path, BaseModel& loader) {
+        VertexFormat vertexFormat = VertexFormat::Float32;
+        LODSettings lodSettings;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            vertexFormat = m_vertexFormat;
+            lodSettings = m_lodSettings;
+        }
+
+        if (!loader.LoadFromFile(path)) {
+            return false;
+        }
+        loader.SetVertexFormat(vertexFormat);
+        loader.GenerateLODs(lodSettings);
+        return true;
+    }
+
+    std::shared_ptr<const SharedMesh> MeshCache::AddModelFile(const std::string& path, BaseModel& loader) {
+        const std::string key = MakeModelFileKey(path);
+        {
+            // Тот же файл мог загрузиться, пока шёл импорт: лишняя копия не попадает в GPU.
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (auto mesh = FindLocked(key)) {
+                ++m_hits;
+                return mesh;
+            }
+        }
+
+        std::shared_ptr<const SharedMesh> loaded = loader.CreateSharedMesh(key);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_misses;
+        PurgeExpiredLocked();
+        m_meshes[key] = loaded;
+        return loaded;
+    }
+
+    std::shared_ptr<const ModelScene> MeshCache::GetModelScene(const std::string& path) {
+        auto scene = std::make_shared<ModelScene>();
+        scene->key = MakeModelFileKey(path);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const auto nodes = m_sceneNodes.find(scene->key);
+            if (nodes != m_sceneNodes.end()) {
+                // Сцена уже импортировалась: хватает живых мешей, дерево узлов хранится отдельно.
+                bool complete = true;
+                for (const ModelSceneNode& node : nodes->second) {
+                    for (const int meshIndex : node.meshes) {
+                        if (scene->meshes.size() <= static_cast<std::size_t>(meshIndex)) {
+                            scene->meshes.resize(meshIndex + 1);
+                        }
+                        if (!scene->meshes[meshIndex]) {
+                            scene->meshes[meshIndex] = FindLocked(MakeSceneMeshKey(path, meshIndex));
+                            complete = complete && scene->meshes[meshIndex];
+                        }
+                    }
+                }
+                if (complete) {
+                    scene->nodes = nodes->second;
+                    ++m_hits;
+                    return scene;
+                }
+                scene->meshes.clear();
+            }
+        }
+
+        ModelSceneImport import;
+        if (!ModelSceneImporter::Import(path, import)) {
+            return nullptr;
+        }
+
+        VertexFormat vertexFormat = VertexFormat::Float32;
+        LODSettings lodSettings;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            vertexFormat = m_vertexFormat;
+            lodSettings = m_lodSettings;
+        }
+
+        scene->meshes.resize(import.meshes.size());
+        std::size_t created = 0;
+        for (std::size_t i = 0; i < import.meshes.size(); ++i) {
+            if (!import.meshes[i]) {
+                continue;
+            }
+            const std::string meshKey = MakeSceneMeshKey(path, static_cast<int>(i));
+            {
+                // Меш, который ещё держат модели прошлого импорта, не создаётся повторно.
+                std::lock_guard<std::mutex> lock(m_mutex);
+                scene->meshes[i] = FindLocked(meshKey);
+            }
+            if (scene->meshes[i]) {
+                continue;
+            }
+
+            BaseModel& loader = *import.meshes[i];
+            loader.SetVertexFormat(vertexFormat);
+            loader.GenerateLODs(lodSettings);
+            scene->meshes[i] = loader.CreateSharedMesh(meshKey);
+            ++created;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_meshes[meshKey] = scene->meshes[i];
+        }
+        scene->nodes = std::move(import.nodes);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_misses;
+        PurgeExpiredLocked();
+        m_sceneNodes[scene->key] = scene->nodes;
+        LOG_INFO("Model scene imported: " + path + ", " + std::to_string(scene->nodes.size()) + " nodes, "
+            + std::to_string(created) + " of " + std::to_string(import.meshes.size()) + " meshes uploaded");
+        return scene;
+    }
+
+    std::shared_ptr<const SharedMesh> MeshCache::Find(const std::string& key) {
+        if (IsPrimitiveKey(key)) {
+            for (const PrimitiveType type : {PrimitiveType::Cube, PrimitiveType::Sphere, PrimitiveType::Plane}) {
+                if (key == MakePrimitiveKey(type)) {
+                    return GetPrimitive(type);
+                }
+            }
+            LOG_WARN("Unknown primitive mesh key: " + key);
+            return nullptr;
+        }
+        if (IsSceneMeshKey(key)) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (auto mesh = FindLocked(key)) {
+                    return mesh;
+                }
+            }
+            // "scene:<путь>#<номер меша>": меш восстанавливается импортом сцены файла.
+            const std::size_t separator = key.rfind('#');
+            const std::size_t prefixLength = std::char_traits<char>::length(kSceneMeshPrefix);
+            if (separator == std::string::npos || separator <= prefixLength) {
+                LOG_WARN("Invalid scene mesh key: " + key);
+                return nullptr;
+            }
+            const std::string path = key.substr(prefixLength, separator - prefixLength);
+            const int meshIndex = std::atoi(key.c_str() + separator + 1);
+            const auto scene = GetModelScene(path);
+            if (!scene || meshIndex < 0 || static_cast<std::size_t>(meshIndex) >= scene->meshes.size()) {
+                return nullptr;
+            }
+            return scene->meshes[meshIndex];
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return FindLocked(key);
+    }
+
+    void MeshCache::SetOptimizerSettings(const MeshOptimizerSettings& settings) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_optimizerSettings = settings;
+    }
+
+    MeshOptimizerSettings MeshCache::GetOptimizerSettings() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_optimizerSettings;
+    }
+
+    void MeshCache::SetLODSettings(const LODSettings& settings) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_lodSettings = settings;
+    }
+
+    LODSettings MeshCache::GetLODSettings() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_lodSettings;
+    }
+
+    void MeshCache::SetVertexFormat(VertexFormat format) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_vertexFormat = format;
+    }
+
+    VertexFormat MeshCache::GetVertexFormat() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_vertexFormat;
+    }
+
+    MeshCacheStats MeshCache::GetStats() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        PurgeExpiredLocked();
+
+        MeshCacheStats stats;
+        stats.hits = m_hits;
+        stats.misses = m_misses;
+        for (const auto& entry : m_meshes) {
+            if (auto mesh = entry.second.lock()) {
+                ++stats.liveMeshes;
+                stats.gpuBytes += mesh->buffer ? mesh->buffer->GetGpuBytes() : 0;
+                stats.cpuBytes += mesh->vertices.size() * sizeof(float) + mesh->indices.size() * sizeof(unsigned int);
+                if (mesh->lods) {
+                    for (const MeshLODLevel& level : mesh->lods->levels) {
+                        stats.gpuBytes += level.buffer ? level.buffer->GetGpuBytes() : 0;
+                        stats.cpuBytes += level.vertices.size() * sizeof(float) + level.indices.size() * sizeof(unsigned int);
+                    }
+                }
+            }
+        }
+        return stats;
+    }
+
+    std::shared_ptr<const SharedMesh> MeshCache::FindLocked(const std::string& key) {
+        const auto it = m_meshes.find(key);
+        return it != m_meshes.end() ? it->second.lock() : nullptr;
+    }
+
+    void MeshCache::PurgeExpiredLocked() {
+        for (auto it = m_meshes.begin(); it != m_meshes.end();) {
+            it = it->second.expired() ? m_meshes.erase(it) : std::next(it);
+        }
+    }
+}
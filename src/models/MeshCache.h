@@ -0,0 +1,89 @@
+#pragma once
+
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "ModelScene.h"
+#include "SharedMesh.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace OGLE {
+    class BaseModel;
+
+    struct MeshCacheStats {
+        std::size_t liveMeshes = 0; // Меши, на которые ещё ссылаются модели
+        std::size_t gpuBytes = 0;   // Вершинные и индексные буферы живых мешей вместе с уровнями LOD
+        std::size_t cpuBytes = 0;   // CPU-копии тех же мешей и уровней (см. SharedMesh)
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+    };
+
+    // Кэш общей геометрии по ключу: тип примитива или разрешённый путь файла вместе
+    // с флагами импорта. Записи слабые — меш и его буферы освобождаются вместе с
+    // последней моделью, которая на него ссылается. Вызывается из главного потока:
+    // промах создаёт буферы OpenGL. Исключение — ImportModelFile.
+    class MeshCache {
+    public:
+        static MeshCache& Instance();
+
+        std::shared_ptr<const SharedMesh> GetPrimitive(PrimitiveType type);
+        // nullptr, если файл не загрузился.
+        std::shared_ptr<const SharedMesh> GetModelFile(const std::string& path);
+        // GetModelFile по шагам для фонового импорта (ModelImportQueue):
+        // FindModelFile — только кэш, nullptr при промахе;
+        // ImportModelFile — Assimp, конвертация и LOD на CPU, из любого потока;
+        // AddModelFile — буферы GPU и запись в кэш, только из главного потока.
+        std::shared_ptr<const SharedMesh> FindModelFile(const std::string& path);
+        bool ImportModelFile(const std::string& path, BaseModel& loader);
+        std::shared_ptr<const SharedMesh> AddModelFile(const std::string& path, BaseModel& loader);
+        // Файл модели деревом узлов над общими мешами (ModelSceneImporter). Меши сцены
+        // лежат в кэше под ключами MakeSceneMeshKey; повторный вызов для того же файла
+        // возвращает те же меши, пока на них ссылаются модели. nullptr — файл не загрузился
+        // или его нужно импортировать целиком (кости, анимации).
+        std::shared_ptr<const ModelScene> GetModelScene(const std::string& path);
+        // Меш по ключу из сцены; примитивы и меши сцен файлов создаются заново, если их уже нет в кэше.
+        std::shared_ptr<const SharedMesh> Find(const std::string& key);
+
+        MeshCacheStats GetStats();
+
+        // Стадии оптимизации, которые BaseModel::LoadFromFile применяет к импортированному мешу.
+        void SetOptimizerSettings(const MeshOptimizerSettings& settings);
+        MeshOptimizerSettings GetOptimizerSettings();
+        // Цепочка LOD, которая строится для новых общих мешей (MeshSimplifier).
+        void SetLODSettings(const LODSettings& settings);
+        LODSettings GetLODSettings();
+        // Раскладка буферов GPU общих мешей. Они неизменяемы, поэтому их можно хранить сжатыми;
+        // модель, отделившая меш (DetachMesh), получает свой буфер Float32.
+        void SetVertexFormat(VertexFormat format);
+        VertexFormat GetVertexFormat();
+
+        static std::string MakePrimitiveKey(PrimitiveType type);
+        // Меши с такими ключами Find создаёт заново, их можно сохранять в сцене ключом.
+        static bool IsPrimitiveKey(const std::string& key);
+        // "scene:<путь относительно проекта>#<номер меша>"; файлы вне проекта — с абсолютным путём.
+        static std::string MakeSceneMeshKey(const std::string& path, int meshIndex);
+        static bool IsSceneMeshKey(const std::string& key);
+        static std::string MakeFileKey(const std::string& resolvedPath, unsigned int importFlags);
+        // Ключ файла модели с текущими флагами импорта BaseModel.
+        static std::string MakeModelFileKey(const std::string& path);
+
+    private:
+        MeshCache() = default;
+        std::shared_ptr<const SharedMesh> FindLocked(const std::string& key);
+        void PurgeExpiredLocked();
+
+        std::mutex m_mutex;
+        std::unordered_map<std::string, std::weak_ptr<const SharedMesh>> m_meshes;
+        // Деревья узлов импортированных сцен; сами меши — слабые записи m_meshes.
+        std::unordered_map<std::string, std::vector<ModelSceneNode>> m_sceneNodes;
+        std::size_t m_hits = 0;
+        std::size_t m_misses = 0;
+        MeshOptimizerSettings m_optimizerSettings;
+        LODSettings m_lodSettings;
+        VertexFormat m_vertexFormat = VertexFormat::Float32;
+    };
+}
@@ -0,0 +1,497 @@
+#include "MeshOptimizer.h"
+#include "../core/StringId.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+
+namespace OGLE {
+    namespace {
+        constexpr std::size_t kVertexStride = 8;
+
+        std::size_t CountUsedVertices(const std::vector<unsigned int>& indices, std::size_t vertexCount) {
+            std::vector<bool> used(vertexCount, false);
+            std::size_t count = 0;
+            for (const unsigned int index : indices) {
+                if (index < vertexCount && !used[index]) {
+                    used[index] = true;
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        // FIFO-кэш на отметках времени: вершина в кэше, пока после неё вставлено меньше cacheSize вершин.
+        // Сброс кэша — сдвиг отметки на cacheSize + 1.
+        class FifoCache {
+        public:
+            FifoCache(std::size_t vertexCount, unsigned int cacheSize)
+                : m_stamps(vertexCount, 0), m_cacheSize(cacheSize), m_time(cacheSize + 1) {
+            }
+
+            bool Access(unsigned int vertex) {
+                if (m_time - m_stamps[vertex] > m_cacheSize) {
+                    m_stamps[vertex] = m_time++;
+                    return false;
+                }
+                return true;
+            }
+
+            void Reset() { m_time += m_cacheSize + 1; }
+
+        private:
+            std::vector<std::size_t> m_stamps;
+            std::size_t m_cacheSize;
+            std::size_t m_time;
+        };
+
+        glm::vec3 Position(const std::vector<float>& vertices, unsigned int vertex) {
+            const float* data = vertices.data() + static_cast<std::size_t>(vertex) * kVertexStride;
+            return glm::vec3(data[0], data[1], data[2]);
+        }
+
+        // Диапазон подмеша как отдельный меш: вершины в плотной локальной нумерации,
+        // чтобы стадии не заводили массивы на все вершины модели ради каждого диапазона.
+        struct LocalRange {
+            std::size_t indexOffset = 0;
+            std::vector<unsigned int> indices;
+            std::vector<float> vertices;
+            std::vector<unsigned int> globalVertices; // Локальный индекс -> индекс в модели
+            std::vector<std::size_t> clusters;
+        };
+
+        // Пустой результат — диапазоны не покрывают индексы подряд и без пропусков.
+        std::vector<LocalRange> BuildLocalRanges(const std::vector<unsigned int>& indices, const std::vector<float>& vertices,
+            std::size_t vertexCount, const MeshSubmeshList& submeshes) {
+            std::vector<LocalRange> ranges;
+            std::size_t expectedOffset = 0;
+            for (const MeshSubmesh& submesh : submeshes) {
+                if (submesh.indexOffset != expectedOffset || submesh.indexCount % 3 != 0) {
+                    return {};
+                }
+                expectedOffset += submesh.indexCount;
+            }
+            if (expectedOffset != indices.size()) {
+                return {};
+            }
+
+            std::vector<unsigned int> localIndex(vertexCount, MeshOptimizer::kUnusedVertex);
+            ranges.resize(submeshes.size());
+            for (std::size_t r = 0; r < submeshes.size(); ++r) {
+                LocalRange& range = ranges[r];
+                range.indexOffset = submeshes[r].indexOffset;
+                range.indices.reserve(submeshes[r].indexCount);
+                for (std::size_t i = range.indexOffset; i < range.indexOffset + submeshes[r].indexCount; ++i) {
+                    const unsigned int vertex = indices[i];
+                    if (localIndex[vertex] == MeshOptimizer::kUnusedVertex) {
+                        localIndex[vertex] = static_cast<unsigned int>(range.globalVertices.size());
+                        range.globalVertices.push_back(vertex);
+                        const float* data = vertices.data() + static_cast<std::size_t>(vertex) * kVertexStride;
+                        range.vertices.insert(range.vertices.end(), data, data + kVertexStride);
+                    }
+                    range.indices.push_back(localIndex[vertex]);
+                }
+                for (const unsigned int vertex : range.globalVertices) {
+                    localIndex[vertex] = MeshOptimizer::kUnusedVertex;
+                }
+            }
+            return ranges;
+        }
+
+        void StoreLocalRanges(const std::vector<LocalRange>& ranges, std::vector<unsigned int>& indices) {
+            for (const LocalRange& range : ranges) {
+                for (std::size_t i = 0; i < range.indices.size(); ++i) {
+                    indices[range.indexOffset + i] = range.globalVertices[range.indices[i]];
+                }
+            }
+        }
+
+        void AddStage(MeshOptimizerReport& report, const char* name, const std::vector<unsigned int>& indices, std::size_t vertexCount) {
+            MeshOptimizerStage stage;
+            stage.name = name;
+            stage.vertexCount = vertexCount;
+            stage.cache = MeshOptimizer::AnalyzeVertexCache(indices, vertexCount);
+            report.stages.push_back(std::move(stage));
+        }
+    }
+
+    MeshOptimizerReport MeshOptimizer::Optimize(
+        std::vector<float>& vertices,
+        std::vector<unsigned int>& indices,
+        const MeshOptimizerSettings& settings,
+        std::vector<SkinInfluence>* influences,
+        const MeshSubmeshList* submeshes) {
+        MeshOptimizerReport report;
+        std::size_t vertexCount = vertices.size() / kVertexStride;
+        report.triangleCount = indices.size() / 3;
+        if (influences && influences->size() != vertexCount) {
+            influences = nullptr;
+        }
+        if (vertexCount == 0 || report.triangleCount == 0
+            || std::any_of(indices.begin(), indices.end(), [vertexCount](unsigned int index) { return index >= vertexCount; })) {
+            return report;
+        }
+        indices.resize(report.triangleCount * 3);
+        AddStage(report, "source", indices, vertexCount);
+
+        if (settings.weldVertices) {
+            std::size_t weldedCount = 0;
+            const std::vector<unsigned int> remap = WeldVertices(vertices, influences, weldedCount);
+            RemapVertices(vertices, indices, influences, remap, weldedCount);
+            vertexCount = weldedCount;
+            AddStage(report, "weld", indices, vertexCount);
+        }
+
+        if (submeshes && submeshes->size() > 1) {
+            // Слияние и порядок выборки меняют только номера вершин, диапазоны им не мешают.
+            std::vector<LocalRange> ranges = BuildLocalRanges(indices, vertices, vertexCount, *submeshes);
+            if (!ranges.empty() && settings.optimizeVertexCache) {
+                for (LocalRange& range : ranges) {
+                    OptimizeVertexCache(range.indices, range.globalVertices.size(), &range.clusters);
+                }
+                StoreLocalRanges(ranges, indices);
+                AddStage(report, "vertex cache", indices, vertexCount);
+            }
+            if (!ranges.empty() && settings.optimizeOverdraw) {
+                for (LocalRange& range : ranges) {
+                    OptimizeOverdraw(range.indices, range.vertices, range.clusters, settings.overdrawThreshold);
+                }
+                StoreLocalRanges(ranges, indices);
+                AddStage(report, "overdraw", indices, vertexCount);
+            }
+        } else {
+            std::vector<std::size_t> clusters;
+            if (settings.optimizeVertexCache) {
+                OptimizeVertexCache(indices, vertexCount, &clusters);
+                AddStage(report, "vertex cache", indices, vertexCount);
+            }
+
+            if (settings.optimizeOverdraw) {
+                OptimizeOverdraw(indices, vertices, clusters, settings.overdrawThreshold);
+                AddStage(report, "overdraw", indices, vertexCount);
+            }
+        }
+
+        if (settings.optimizeVertexFetch) {
+            std::size_t fetchCount = 0;
+            const std::vector<unsigned int> remap = OptimizeVertexFetch(indices, vertexCount, fetchCount);
+            RemapVertices(vertices, indices, influences, remap, fetchCount);
+            vertexCount = fetchCount;
+            AddStage(report, "vertex fetch", indices, vertexCount);
+        }
+        return report;
+    }
+
+    std::string MeshOptimizer::FormatReport(const MeshOptimizerReport& report) {
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(3);
+        text << report.triangleCount << " triangles";
+        for (const MeshOptimizerStage& stage : report.stages) {
+            text << "\n  " << std::left << std::setw(13) << stage.name << std::right
+                 << " vertices " << stage.vertexCount << ", ACMR " << stage.cache.acmr << ", ATVR " << stage.cache.atvr;
+        }
+        return text.str();
+    }
+
+    VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const std::vector<unsigned int>& indices, std::size_t vertexCount, unsigned int cacheSize) {
+        VertexCacheStats stats;
+        const std::size_t triangleCount = indices.size() / 3;
+        const std::size_t usedVertices = CountUsedVertices(indices, vertexCount);
+        if (triangleCount == 0 || usedVertices == 0) {
+            return stats;
+        }
+
+        FifoCache cache(vertexCount, cacheSize);
+        std::size_t misses = 0;
+        for (std::size_t i = 0; i < triangleCount * 3; ++i) {
+            if (indices[i] < vertexCount && !cache.Access(indices[i])) {
+                ++misses;
+            }
+        }
+        stats.acmr = static_cast<float>(misses) / static_cast<float>(triangleCount);
+        stats.atvr = static_cast<float>(misses) / static_cast<float>(usedVertices);
+        return stats;
+    }
+
+    std::vector<unsigned int> MeshOptimizer::WeldVertices(const std::vector<float>& vertices, const std::vector<SkinInfluence>* influences, std::size_t& outVertexCount) {
+        const std::size_t vertexCount = vertices.size() / kVertexStride;
+        const std::size_t vertexBytes = kVertexStride * sizeof(float);
+        const std::size_t keyBytes = vertexBytes + (influences ? sizeof(SkinInfluence) : 0);
+
+        // Ключ вершины — её байты вместе с влияниями костей: вершины с разными весами не сливаются.
+        std::vector<std::uint8_t> keys(vertexCount * keyBytes);
+        for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            std::uint8_t* key = keys.data() + vertex * keyBytes;
+            std::memcpy(key, vertices.data() + vertex * kVertexStride, vertexBytes);
+            if (influences) {
+                std::memcpy(key + vertexBytes, &(*influences)[vertex], sizeof(SkinInfluence));
+            }
+        }
+
+        // Открытая адресация: в таблице лежат исходные индексы первых вхождений.
+        std::size_t tableSize = 1;
+        while (tableSize < vertexCount * 2) {
+            tableSize *= 2;
+        }
+        std::vector<unsigned int> table(tableSize, kUnusedVertex);
+        std::vector<unsigned int> remap(vertexCount, kUnusedVertex);
+        outVertexCount = 0;
+        for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            const std::uint8_t* key = keys.data() + vertex * keyBytes;
+            std::size_t slot = static_cast<std::size_t>(Fnv1aBytes(key, keyBytes)) & (tableSize - 1);
+            while (table[slot] != kUnusedVertex
+                && std::memcmp(keys.data() + static_cast<std::size_t>(table[slot]) * keyBytes, key, keyBytes) != 0) {
+                slot = (slot + 1) & (tableSize - 1);
+            }
+            if (table[slot] == kUnusedVertex) {
+                table[slot] = static_cast<unsigned int>(vertex);
+                remap[vertex] = static_cast<unsigned int>(outVertexCount++);
+            } else {
+                remap[vertex] = remap[table[slot]];
+            }
+        }
+        return remap;
+    }
+
+    std::vector<unsigned int> MeshOptimizer::OptimizeVertexFetch(const std::vector<unsigned int>& indices, std::size_t vertexCount, std::size_t& outVertexCount) {
+        std::vector<unsigned int> remap(vertexCount, kUnusedVertex);
+        outVertexCount = 0;
+        for (const unsigned int index : indices) {
+            if (index < vertexCount && remap[index] == kUnusedVertex) {
+                remap[index] = static_cast<unsigned int>(outVertexCount++);
+            }
+        }
+        return remap;
+    }
+
+    void MeshOptimizer::RemapVertices(std::vector<float>& vertices, std::vector<unsigned int>& indices, std::vector<SkinInfluence>* influences,
+        const std::vector<unsigned int>& remap, std::size_t newVertexCount) {
+        std::vector<float> remappedVertices(newVertexCount * kVertexStride);
+        std::vector<SkinInfluence> remappedInfluences(influences ? newVertexCount : 0);
+        for (std::size_t vertex = 0; vertex < remap.size(); ++vertex) {
+            const unsigned int target = remap[vertex];
+            if (target == kUnusedVertex) {
+                continue;
+            }
+            std::copy_n(vertices.begin() + vertex * kVertexStride, kVertexStride, remappedVertices.begin() + static_cast<std::size_t>(target) * kVertexStride);
+            if (influences) {
+                remappedInfluences[target] = (*influences)[vertex];
+            }
+        }
+
+        for (unsigned int& index : indices) {
+            index = remap[index];
+        }
+        vertices = std::move(remappedVertices);
+        if (influences) {
+            *influences = std::move(remappedInfluences);
+        }
+    }
+
+    void MeshOptimizer::OptimizeVertexCache(std::vector<unsigned int>& indices, std::size_t vertexCount, std::vector<std::size_t>* outClusters) {
+        // Sander, Nehab, Barczak, "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw" (2007).
+        const std::size_t triangleCount = indices.size() / 3;
+        if (outClusters) {
+            outClusters->clear();
+        }
+        if (triangleCount == 0) {
+            return;
+        }
+
+        // Треугольники каждой вершины подряд (CSR).
+        std::vector<unsigned int> liveTriangles(vertexCount, 0);
+        for (const unsigned int index : indices) {
+            ++liveTriangles[index];
+        }
+        std::vector<std::size_t> adjacencyOffsets(vertexCount + 1, 0);
+        for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            adjacencyOffsets[vertex + 1] = adjacencyOffsets[vertex] + liveTriangles[vertex];
+        }
+        std::vector<unsigned int> adjacency(indices.size());
+        std::vector<std::size_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (std::size_t i = 0; i < indices.size(); ++i) {
+            adjacency[fill[indices[i]]++] = static_cast<unsigned int>(i / 3);
+        }
+
+        const std::size_t cacheSize = kCacheSize;
+        std::vector<std::size_t> cacheStamps(vertexCount, 0);
+        std::size_t time = cacheSize + 1;
+        std::vector<bool> emitted(triangleCount, false);
+        std::vector<unsigned int> deadEnds;
+        std::vector<unsigned int> candidates;
+        std::vector<unsigned int> output;
+        output.reserve(indices.size());
+        std::size_t cursor = 0;
+
+        // Тупик: последняя вершина из стека, у которой остались треугольники, иначе следующая по порядку.
+        const auto skipDeadEnd = [&]() -> long long {
+            while (!deadEnds.empty()) {
+                const unsigned int vertex = deadEnds.back();
+                deadEnds.pop_back();
+                if (liveTriangles[vertex] > 0) {
+                    return vertex;
+                }
+            }
+            for (; cursor < vertexCount; ++cursor) {
+                if (liveTriangles[cursor] > 0) {
+                    return static_cast<long long>(cursor);
+                }
+            }
+            return -1;
+        };
+
+        long long fan = skipDeadEnd();
+        while (fan >= 0) {
+            candidates.clear();
+            const auto fanVertex = static_cast<std::size_t>(fan);
+            for (std::size_t a = adjacencyOffsets[fanVertex]; a < adjacencyOffsets[fanVertex + 1]; ++a) {
+                const unsigned int triangle = adjacency[a];
+                if (emitted[triangle]) {
+                    continue;
+                }
+                emitted[triangle] = true;
+                for (std::size_t corner = 0; corner < 3; ++corner) {
+                    const unsigned int vertex = indices[triangle * 3 + corner];
+                    output.push_back(vertex);
+                    deadEnds.push_back(vertex);
+                    candidates.push_back(vertex);
+                    --liveTriangles[vertex];
+                    if (time - cacheStamps[vertex] > cacheSize) {
+                        cacheStamps[vertex] = time++;
+                    }
+                }
+            }
+
+            // Следующий веер: вершина, которая останется в кэше после обхода всех своих треугольников
+            // и дольше всех в нём пробыла.
+            long long next = -1;
+            long long bestPriority = -1;
+            for (const unsigned int vertex : candidates) {
+                if (liveTriangles[vertex] == 0) {
+                    continue;
+                }
+                long long priority = 0;
+                if (time - cacheStamps[vertex] + 2 * static_cast<std::size_t>(liveTriangles[vertex]) <= cacheSize) {
+                    priority = static_cast<long long>(time - cacheStamps[vertex]);
+                }
+                if (priority > bestPriority) {
+                    bestPriority = priority;
+                    next = vertex;
+                }
+            }
+            if (next < 0) {
+                next = skipDeadEnd();
+                if (outClusters && next >= 0) {
+                    outClusters->push_back(output.size() / 3);
+                }
+            }
+            fan = next;
+        }
+
+        if (outClusters) {
+            outClusters->insert(outClusters->begin(), 0);
+        }
+        indices = std::move(output);
+    }
+
+    void MeshOptimizer::OptimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<float>& vertices,
+        const std::vector<std::size_t>& hardClusters, float threshold) {
+        const std::size_t triangleCount = indices.size() / 3;
+        const std::size_t vertexCount = vertices.size() / kVertexStride;
+        if (triangleCount == 0) {
+            return;
+        }
+
+        std::vector<std::size_t> hard = hardClusters;
+        if (hard.empty() || hard.front() != 0) {
+            hard.insert(hard.begin(), 0);
+        }
+        hard.push_back(triangleCount);
+
+        // Мягкие границы внутри жёстких кластеров: кластер режется, как только его ACMR
+        // с холодного кэша не хуже ACMR всего жёсткого кластера, умноженного на порог.
+        std::vector<std::size_t> clusters;
+        FifoCache cache(vertexCount, kCacheSize);
+        for (std::size_t h = 0; h + 1 < hard.size(); ++h) {
+            const std::size_t begin = hard[h];
+            const std::size_t end = hard[h + 1];
+            if (begin >= end) {
+                continue;
+            }
+
+            cache.Reset();
+            std::size_t clusterMisses = 0;
+            for (std::size_t i = begin * 3; i < end * 3; ++i) {
+                clusterMisses += cache.Access(indices[i]) ? 0 : 1;
+            }
+            const float limit = static_cast<float>(clusterMisses) / static_cast<float>(end - begin) * threshold;
+
+            cache.Reset();
+            clusters.push_back(begin);
+            std::size_t start = begin;
+            std::size_t misses = 0;
+            for (std::size_t triangle = begin; triangle < end; ++triangle) {
+                for (std::size_t corner = 0; corner < 3; ++corner) {
+                    misses += cache.Access(indices[triangle * 3 + corner]) ? 0 : 1;
+                }
+                if (triangle + 1 < end && static_cast<float>(misses) <= limit * static_cast<float>(triangle + 1 - start)) {
+                    clusters.push_back(triangle + 1);
+                    start = triangle + 1;
+                    misses = 0;
+                    cache.Reset();
+                }
+            }
+        }
+        clusters.push_back(triangleCount);
+
+        // Центр и нормаль кластера взвешены по площади; центр меша — по всем треугольникам.
+        const std::size_t clusterCount = clusters.size() - 1;
+        std::vector<glm::vec3> centroids(clusterCount, glm::vec3(0.0f));
+        std::vector<glm::vec3> normals(clusterCount, glm::vec3(0.0f));
+        glm::vec3 meshCentroid(0.0f);
+        float meshArea = 0.0f;
+        for (std::size_t cluster = 0; cluster < clusterCount; ++cluster) {
+            float clusterArea = 0.0f;
+            for (std::size_t triangle = clusters[cluster]; triangle < clusters[cluster + 1]; ++triangle) {
+                const glm::vec3 p0 = Position(vertices, indices[triangle * 3 + 0]);
+                const glm::vec3 p1 = Position(vertices, indices[triangle * 3 + 1]);
+                const glm::vec3 p2 = Position(vertices, indices[triangle * 3 + 2]);
+                const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+                const float area = glm::length(normal);
+                centroids[cluster] += (p0 + p1 + p2) * (area / 3.0f);
+                normals[cluster] += normal;
+                clusterArea += area;
+            }
+            meshCentroid += centroids[cluster];
+            meshArea += clusterArea;
+            centroids[cluster] = clusterArea > 0.0f ? centroids[cluster] / clusterArea : Position(vertices, indices[clusters[cluster] * 3]);
+            const float normalLength = glm::length(normals[cluster]);
+            normals[cluster] = normalLength > 0.0f ? normals[cluster] / normalLength : glm::vec3(0.0f);
+        }
+        if (meshArea > 0.0f) {
+            meshCentroid /= meshArea;
+        }
+
+        std::vector<float> sortKeys(clusterCount);
+        for (std::size_t cluster = 0; cluster < clusterCount; ++cluster) {
+            sortKeys[cluster] = glm::dot(centroids[cluster] - meshCentroid, normals[cluster]);
+        }
+        std::vector<std::size_t> order(clusterCount);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&sortKeys](std::size_t lhs, std::size_t rhs) {
+            return sortKeys[lhs] > sortKeys[rhs];
+        });
+
+        std::vector<unsigned int> output;
+        output.reserve(indices.size());
+        for (const std::size_t cluster : order) {
+            output.insert(output.end(), indices.begin() + clusters[cluster] * 3, indices.begin() + clusters[cluster + 1] * 3);
+        }
+        indices = std::move(output);
+    }
+}
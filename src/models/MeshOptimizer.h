@@ -0,0 +1,70 @@
+#pragma once
+
+#include "MeshSubmesh.h"
+#include "SkinData.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace OGLE {
+    // Стадии оптимизации меша после импорта; каждая включается отдельно.
+    struct MeshOptimizerSettings {
+        bool weldVertices = true;        // Слияние побитово одинаковых вершин
+        bool optimizeVertexCache = true; // Порядок треугольников под кэш вершин (Tipsify)
+        bool optimizeOverdraw = true;    // Порядок кластеров против перерисовки
+        bool optimizeVertexFetch = true; // Вершины в порядке первого использования
+        float overdrawThreshold = 1.05f; // Во сколько раз ACMR может вырасти ради порядка кластеров
+    };
+
+    // ACMR — промахи кэша на треугольник, ATVR — промахи на используемую вершину (идеал 1.0).
+    struct VertexCacheStats {
+        float acmr = 0.0f;
+        float atvr = 0.0f;
+    };
+
+    struct MeshOptimizerStage {
+        std::string name;
+        std::size_t vertexCount = 0;
+        VertexCacheStats cache;
+    };
+
+    struct MeshOptimizerReport {
+        std::size_t triangleCount = 0;
+        std::vector<MeshOptimizerStage> stages; // Первая запись — исходный меш
+    };
+
+    // Оптимизация вершин и индексов в раскладке BaseModel (8 float на вершину).
+    // Работает только на CPU. Влияния костей, если переданы, переставляются вместе
+    // с вершинами и участвуют в сравнении при слиянии. Если переданы подмеши, треугольники
+    // переставляются только внутри своих диапазонов, и диапазоны остаются верными.
+    class MeshOptimizer {
+    public:
+        static constexpr unsigned int kCacheSize = 16; // FIFO-кэш пост-трансформа для метрик и Tipsify
+        static constexpr unsigned int kUnusedVertex = ~0u;
+
+        static MeshOptimizerReport Optimize(
+            std::vector<float>& vertices,
+            std::vector<unsigned int>& indices,
+            const MeshOptimizerSettings& settings,
+            std::vector<SkinInfluence>* influences = nullptr,
+            const MeshSubmeshList* submeshes = nullptr);
+
+        // Одна строка на стадию: число вершин, ACMR, ATVR.
+        static std::string FormatReport(const MeshOptimizerReport& report);
+
+        static VertexCacheStats AnalyzeVertexCache(const std::vector<unsigned int>& indices, std::size_t vertexCount, unsigned int cacheSize = kCacheSize);
+
+        // Возвращают таблицу перестановки: новый индекс для каждой старой вершины или kUnusedVertex.
+        static std::vector<unsigned int> WeldVertices(const std::vector<float>& vertices, const std::vector<SkinInfluence>* influences, std::size_t& outVertexCount);
+        static std::vector<unsigned int> OptimizeVertexFetch(const std::vector<unsigned int>& indices, std::size_t vertexCount, std::size_t& outVertexCount);
+        static void RemapVertices(std::vector<float>& vertices, std::vector<unsigned int>& indices, std::vector<SkinInfluence>* influences,
+            const std::vector<unsigned int>& remap, std::size_t newVertexCount);
+
+        // Tipsify; outClusters получает начала кластеров (в треугольниках) на тупиках обхода.
+        static void OptimizeVertexCache(std::vector<unsigned int>& indices, std::size_t vertexCount, std::vector<std::size_t>* outClusters = nullptr);
+        // Кластеры, смотрящие наружу, рисуются раньше и закрывают внутренние.
+        static void OptimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<float>& vertices,
+            const std::vector<std::size_t>& hardClusters, float threshold);
+    };
+}
@@ -0,0 +1,233 @@
+#include "MeshSimplifier.h"
+#include "MeshBounds.h"
+#include "MeshOptimizer.h"
+#include "../Logger.h"
+
+#include <OpenMesh/Core/Mesh/TriMesh_ArrayKernelT.hh>
+#include <OpenMesh/Tools/Decimater/DecimaterT.hh>
+#include <OpenMesh/Tools/Decimater/ModNormalFlippingT.hh>
+#include <OpenMesh/Tools/Decimater/ModQuadricT.hh>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace OGLE {
+    namespace {
+        constexpr std::size_t kVertexStride = 8;
+        // Уровень, потерявший меньше 10% треугольников, упирается в заблокированные вершины.
+        constexpr float kMinLevelReduction = 0.9f;
+
+        using DecimationMesh = OpenMesh::TriMesh_ArrayKernelT<>;
+        using Decimater = OpenMesh::Decimater::DecimaterT<DecimationMesh>;
+        using QuadricModule = OpenMesh::Decimater::ModQuadricT<DecimationMesh>;
+        using NormalFlippingModule = OpenMesh::Decimater::ModNormalFlippingT<DecimationMesh>;
+
+        // Треугольники, которые OpenMesh не принял (неманифолдные рёбра), переходят
+        // во все уровни без изменений, их вершины заблокированы.
+        struct DecimationInput {
+            DecimationMesh mesh;
+            OpenMesh::VPropHandleT<unsigned int> sourceIndex;
+            OpenMesh::FPropHandleT<unsigned int> submesh;
+            std::vector<std::vector<unsigned int>> passthroughIndices; // По подмешам
+        };
+
+        // Номер подмеша для каждого треугольника; без диапазонов все в нулевом.
+        std::vector<unsigned int> MapTriangleSubmeshes(std::size_t triangleCount, const MeshSubmeshList* submeshes) {
+            std::vector<unsigned int> triangleSubmeshes(triangleCount, 0);
+            if (!submeshes) {
+                return triangleSubmeshes;
+            }
+            for (std::size_t s = 0; s < submeshes->size(); ++s) {
+                const MeshSubmesh& submesh = (*submeshes)[s];
+                const std::size_t end = std::min<std::size_t>(triangleCount, (submesh.indexOffset + submesh.indexCount) / 3);
+                for (std::size_t triangle = submesh.indexOffset / 3; triangle < end; ++triangle) {
+                    triangleSubmeshes[triangle] = static_cast<unsigned int>(s);
+                }
+            }
+            return triangleSubmeshes;
+        }
+
+        void BuildDecimationMesh(const std::vector<float>& vertices, const std::vector<unsigned int>& indices,
+            const std::vector<unsigned int>& triangleSubmeshes, std::size_t submeshCount, DecimationInput& input) {
+            DecimationMesh& mesh = input.mesh;
+            mesh.request_vertex_status();
+            mesh.request_edge_status();
+            mesh.request_face_status();
+            mesh.request_face_normals();
+            mesh.add_property(input.sourceIndex);
+            mesh.add_property(input.submesh);
+            input.passthroughIndices.resize(submeshCount);
+
+            const std::size_t vertexCount = vertices.size() / kVertexStride;
+            std::vector<DecimationMesh::VertexHandle> handles(vertexCount);
+            for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+                const float* position = &vertices[vertex * kVertexStride];
+                handles[vertex] = mesh.add_vertex(DecimationMesh::Point(position[0], position[1], position[2]));
+                mesh.property(input.sourceIndex, handles[vertex]) = static_cast<unsigned int>(vertex);
+            }
+
+            for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+                const unsigned int a = indices[i];
+                const unsigned int b = indices[i + 1];
+                const unsigned int c = indices[i + 2];
+                if (a == b || b == c || a == c) {
+                    continue;
+                }
+                const unsigned int submesh = triangleSubmeshes[i / 3];
+                const auto face = mesh.add_face(handles[a], handles[b], handles[c]);
+                if (face.is_valid()) {
+                    mesh.property(input.submesh, face) = submesh;
+                } else {
+                    input.passthroughIndices[submesh].insert(input.passthroughIndices[submesh].end(), {a, b, c});
+                }
+            }
+
+            for (const auto vertex : mesh.vertices()) {
+                if (mesh.is_boundary(vertex)) {
+                    mesh.status(vertex).set_locked(true);
+                    continue;
+                }
+                // Вершина на стыке двух подмешей: схлопывание сдвинуло бы границу материалов.
+                bool hasSubmesh = false;
+                unsigned int vertexSubmesh = 0;
+                for (const auto face : mesh.vf_range(vertex)) {
+                    const unsigned int faceSubmesh = mesh.property(input.submesh, face);
+                    if (hasSubmesh && faceSubmesh != vertexSubmesh) {
+                        mesh.status(vertex).set_locked(true);
+                        break;
+                    }
+                    vertexSubmesh = faceSubmesh;
+                    hasSubmesh = true;
+                }
+            }
+            for (const auto& submeshIndices : input.passthroughIndices) {
+                for (const unsigned int vertex : submeshIndices) {
+                    mesh.status(handles[vertex]).set_locked(true);
+                }
+            }
+            mesh.update_face_normals();
+        }
+
+        // Вершины уровня сжимаются и переупорядочиваются под кэш, как и исходный меш при импорте;
+        // треугольники собираются по подмешам, чтобы диапазоны уровня шли в порядке исходных.
+        void ExtractLevel(const DecimationInput& input, const std::vector<float>& sourceVertices,
+            const MeshSubmeshList* sourceSubmeshes, MeshLODLevel& level) {
+            const DecimationMesh& mesh = input.mesh;
+            std::vector<std::vector<unsigned int>> submeshIndices = input.passthroughIndices;
+            for (const auto face : mesh.faces()) {
+                std::vector<unsigned int>& target = submeshIndices[mesh.property(input.submesh, face)];
+                for (const auto vertex : mesh.fv_range(face)) {
+                    target.push_back(mesh.property(input.sourceIndex, vertex));
+                }
+            }
+
+            level.vertices = sourceVertices;
+            level.indices.clear();
+            level.submeshes.clear();
+            for (std::size_t s = 0; s < submeshIndices.size(); ++s) {
+                if (sourceSubmeshes && sourceSubmeshes->size() > 1) {
+                    MeshSubmesh submesh = (*sourceSubmeshes)[s];
+                    submesh.indexOffset = static_cast<std::uint32_t>(level.indices.size());
+                    submesh.indexCount = static_cast<std::uint32_t>(submeshIndices[s].size());
+                    level.submeshes.push_back(submesh);
+                }
+                level.indices.insert(level.indices.end(), submeshIndices[s].begin(), submeshIndices[s].end());
+            }
+
+            MeshOptimizerSettings settings;
+            settings.weldVertices = false;
+            settings.optimizeOverdraw = false;
+            MeshOptimizer::Optimize(level.vertices, level.indices, settings, nullptr, &level.submeshes);
+        }
+    }
+
+    std::shared_ptr<MeshLODChain> MeshSimplifier::GenerateLODs(
+        const std::vector<float>& vertices,
+        const std::vector<unsigned int>& indices,
+        const LODSettings& settings,
+        const MeshSubmeshList* submeshes) {
+        const std::size_t baseTriangles = indices.size() / 3;
+        if (!settings.enabled || settings.levelCount <= 0 || baseTriangles < std::max<std::size_t>(settings.minTriangles, 1)) {
+            return nullptr;
+        }
+
+        const std::size_t submeshCount = submeshes && !submeshes->empty() ? submeshes->size() : 1;
+        DecimationInput input;
+        BuildDecimationMesh(vertices, indices, MapTriangleSubmeshes(baseTriangles, submeshes), submeshCount, input);
+
+        Decimater decimater(input.mesh);
+        QuadricModule::Handle quadric;
+        NormalFlippingModule::Handle normalFlipping;
+        decimater.add(quadric);
+        decimater.module(quadric).unset_max_err();
+        decimater.add(normalFlipping);
+        decimater.module(normalFlipping).set_max_normal_deviation(settings.maxNormalDeviation);
+        if (!decimater.initialize()) {
+            LOG_WARN("Mesh decimater failed to initialize, LODs are skipped");
+            return nullptr;
+        }
+
+        auto chain = std::make_shared<MeshLODChain>();
+        chain->baseTriangles = baseTriangles;
+        const MeshBounds bounds = MeshBounds::FromVertices(vertices);
+        chain->center = bounds.center;
+        chain->radius = bounds.radius;
+
+        // Уровни строятся последовательно из одного меша: каждый упрощает предыдущий.
+        std::size_t passthroughTriangles = 0;
+        for (const auto& submeshIndices : input.passthroughIndices) {
+            passthroughTriangles += submeshIndices.size() / 3;
+        }
+        std::size_t previousTriangles = baseTriangles;
+        for (int levelIndex = 0; levelIndex < settings.levelCount; ++levelIndex) {
+            const auto target = static_cast<std::size_t>(static_cast<float>(previousTriangles) * settings.reductionPerLevel);
+            if (target <= passthroughTriangles) {
+                break;
+            }
+            decimater.decimate_to_faces(0, target - passthroughTriangles);
+
+            MeshLODLevel level;
+            ExtractLevel(input, vertices, submeshes, level);
+            const std::size_t triangles = level.indices.size() / 3;
+            if (triangles == 0 || static_cast<float>(triangles) > static_cast<float>(previousTriangles) * kMinLevelReduction) {
+                break;
+            }
+
+            // Плотность треугольников на площадь экрана одинакова для всех уровней.
+            const float firstTriangles = chain->levels.empty() ? static_cast<float>(triangles) : static_cast<float>(chain->levels.front().indices.size() / 3);
+            level.screenSize = settings.firstScreenSize * std::sqrt(static_cast<float>(triangles) / firstTriangles);
+            previousTriangles = triangles;
+            chain->levels.push_back(std::move(level));
+        }
+
+        if (chain->levels.empty()) {
+            return nullptr;
+        }
+        return chain;
+    }
+
+    void MeshSimplifier::CreateBuffers(MeshLODChain& chain, VertexFormat format) {
+        for (MeshLODLevel& level : chain.levels) {
+            level.buffer = std::make_shared<MeshBuffer>();
+            level.buffer->Create(level.vertices, level.indices, format);
+        }
+    }
+
+    std::string MeshSimplifier::FormatReport(const MeshLODChain& chain) {
+        std::ostringstream report;
+        report << std::fixed << std::setprecision(3);
+        report << "LOD0: " << chain.baseTriangles << " triangles";
+        for (std::size_t i = 0; i < chain.levels.size(); ++i) {
+            const MeshLODLevel& level = chain.levels[i];
+            const std::size_t triangles = level.indices.size() / 3;
+            report << "; LOD" << i + 1 << ": " << triangles << " triangles ("
+                   << (chain.baseTriangles > 0 ? 100.0 * static_cast<double>(triangles) / static_cast<double>(chain.baseTriangles) : 0.0)
+                   << "%), " << level.vertices.size() / kVertexStride << " vertices, screen < " << level.screenSize;
+        }
+        return report.str();
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "MeshBuffer.h"
+#include "MeshSubmesh.h"
+
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OGLE {
+    // Цепочка LOD, которую MeshCache строит для импортированных мешей и примитивов.
+    struct LODSettings {
+        bool enabled = true;
+        int levelCount = 3;               // Упрощённых уровней, кроме исходного меша
+        float reductionPerLevel = 0.5f;   // Доля треугольников предыдущего уровня
+        float maxNormalDeviation = 45.0f; // Градусы: схлопывания, сильнее поворачивающие грани, запрещены
+        float firstScreenSize = 0.5f;     // Доля высоты экрана, ниже которой рисуется первый уровень
+        std::size_t minTriangles = 512;   // Меньшие меши не упрощаются
+    };
+
+    struct MeshLODLevel {
+        std::vector<float> vertices;        // Подмножество вершин исходного меша, та же раскладка
+        std::vector<unsigned int> indices;
+        std::shared_ptr<MeshBuffer> buffer;
+        // Диапазоны тех же подмешей, что у исходного меша, в том же порядке (могут быть пустыми);
+        // пусто, если у исходного меша один диапазон.
+        MeshSubmeshList submeshes;
+        float screenSize = 0.0f;            // Уровень рисуется, если меш занимает меньше этой доли экрана
+    };
+
+    // Уровни неизменяемы и общие для всех копий модели (как SharedMesh).
+    struct MeshLODChain {
+        glm::vec3 center{0.0f};  // Описанная сфера исходного меша в локальных координатах
+        float radius = 0.0f;
+        std::size_t baseTriangles = 0;
+        std::vector<MeshLODLevel> levels; // От детального к грубому, без исходного меша
+    };
+
+    // Упрощение схлопыванием рёбер по квадрикам ошибки (OpenMesh Decimater).
+    // Вершины на швах UV/нормалей и краях меша заблокированы: шов в раскладке BaseModel —
+    // это разные вершины в одной точке, то есть край. Схлопывание половины ребра не
+    // двигает оставшуюся вершину, поэтому позиции, нормали и UV берутся из исходного меша.
+    // Границы между подмешами тоже заблокированы, а треугольники уровня остаются в своих
+    // диапазонах: каждый уровень рисуется теми же материалами.
+    class MeshSimplifier {
+    public:
+        // nullptr, если меш меньше settings.minTriangles или упростить его не удалось.
+        // Только CPU: можно вызывать из фонового потока, буферы создаёт CreateBuffers.
+        static std::shared_ptr<MeshLODChain> GenerateLODs(
+            const std::vector<float>& vertices,
+            const std::vector<unsigned int>& indices,
+            const LODSettings& settings,
+            const MeshSubmeshList* submeshes = nullptr);
+
+        // Буферы GPU уровней в раскладке format. Только в потоке с контекстом OpenGL.
+        static void CreateBuffers(MeshLODChain& chain, VertexFormat format);
+
+        // Одна строка на уровень: треугольники, доля от исходного, порог размера на экране.
+        static std::string FormatReport(const MeshLODChain& chain);
+    };
+}
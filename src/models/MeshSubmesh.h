@@ -0,0 +1,30 @@
+#pragma once
+
+#include "MeshBounds.h"
+
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OGLE {
+    // Диапазон индексов меша, рисуемый одним материалом. Все диапазоны лежат в одном
+    // буфере индексов: модель загружается в GPU одним VBO/EBO, а рисуется по частям.
+    struct MeshSubmesh {
+        std::uint32_t indexOffset = 0;
+        std::uint32_t indexCount = 0;
+        int materialIndex = 0; // Индекс в слотах материалов модели (BaseModel::GetMaterialSlots)
+        MeshBounds bounds;     // Локальные границы вершин диапазона: отсечение части модели
+    };
+
+    // Материал файла модели, как его описал импорт (aiMaterial).
+    struct MeshMaterialSlot {
+        std::string name;
+        std::string diffuseTexturePath; // Разрешённый путь; пусто, если текстуры нет
+        glm::vec3 baseColor{1.0f};
+    };
+
+    // Диапазоны пусты — меш рисуется целиком одним материалом.
+    using MeshSubmeshList = std::vector<MeshSubmesh>;
+}
@@ -0,0 +1,223 @@
+#include "ModelBinaryFormat.h"
+
+#include <algorithm>
+
+namespace OGLE {
+    namespace ModelBinaryFormat {
+        namespace {
+            // Имена длиннее считаются повреждёнными данными.
+            constexpr std::uint32_t kMaxStringLength = 1u << 16;
+
+            template <typename T>
+            void WriteChannel(Writer& writer, const AnimationChannel<T>& channel) {
+                writer.WriteArray(channel.times);
+                writer.WriteArray(channel.values);
+            }
+
+            template <typename T>
+            bool ReadChannel(Reader& reader, AnimationChannel<T>& channel) {
+                return reader.ReadArray(channel.times)
+                    && reader.ReadArray(channel.values)
+                    && channel.times.size() == channel.values.size();
+            }
+        }
+
+        Writer::Writer() {
+            m_buffer.resize(sizeof(FileHeader), 0);
+        }
+
+        void Writer::Align() {
+            m_buffer.resize((m_buffer.size() + kSectionAlignment - 1) / kSectionAlignment * kSectionAlignment, 0);
+        }
+
+        void Writer::BeginSection(SectionType type) {
+            Align();
+            SectionEntry entry;
+            entry.type = static_cast<std::uint32_t>(type);
+            entry.offset = m_buffer.size();
+            m_sections.push_back(entry);
+        }
+
+        void Writer::EndSection() {
+            if (!m_sections.empty()) {
+                m_sections.back().size = m_buffer.size() - m_sections.back().offset;
+            }
+        }
+
+        void Writer::WriteBytes(const void* data, std::size_t size) {
+            if (size == 0) {
+                return;
+            }
+            const auto* bytes = static_cast<const std::uint8_t*>(data);
+            m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+        }
+
+        void Writer::WriteString(const std::string& value) {
+            const auto length = static_cast<std::uint32_t>(std::min<std::size_t>(value.size(), kMaxStringLength));
+            Write(length);
+            WriteBytes(value.data(), length);
+        }
+
+        const std::vector<std::uint8_t>& Writer::Finish() {
+            Align();
+            FileHeader header;
+            header.sectionCount = static_cast<std::uint32_t>(m_sections.size());
+            header.sectionTableOffset = m_buffer.size();
+            WriteBytes(m_sections.data(), m_sections.size() * sizeof(SectionEntry));
+            header.fileSize = m_buffer.size();
+            std::memcpy(m_buffer.data(), &header, sizeof(header));
+            return m_buffer;
+        }
+
+        Reader::Reader(const std::uint8_t* data, std::size_t size)
+            : m_data(data), m_size(size) {
+        }
+
+        bool Reader::ReadBytes(void* data, std::size_t size) {
+            if (!m_valid || size > m_size - m_offset) {
+                m_valid = false;
+                return false;
+            }
+            if (size > 0) {
+                std::memcpy(data, m_data + m_offset, size);
+                m_offset += size;
+            }
+            return true;
+        }
+
+        bool Reader::ReadString(std::string& value) {
+            std::uint32_t length = 0;
+            if (!Read(length) || length > kMaxStringLength || length > m_size - m_offset) {
+                m_valid = false;
+                return false;
+            }
+            value.assign(reinterpret_cast<const char*>(m_data + m_offset), length);
+            m_offset += length;
+            return true;
+        }
+
+        bool IsBinaryModel(const std::uint8_t* data, std::size_t size) {
+            std::uint32_t magic = 0;
+            if (!data || size < sizeof(magic)) {
+                return false;
+            }
+            std::memcpy(&magic, data, sizeof(magic));
+            return magic == kMagic;
+        }
+
+        bool ParseHeader(const std::uint8_t* data, std::size_t size, std::vector<SectionEntry>& sections) {
+            sections.clear();
+            if (!data || size < sizeof(FileHeader)) {
+                return false;
+            }
+
+            FileHeader header;
+            std::memcpy(&header, data, sizeof(header));
+            if (header.magic != kMagic || header.version < kMinVersion || header.version > kVersion || header.fileSize != size) {
+                return false;
+            }
+            if (header.sectionTableOffset > size
+                || header.sectionCount > (size - header.sectionTableOffset) / sizeof(SectionEntry)) {
+                return false;
+            }
+
+            sections.resize(header.sectionCount);
+            std::memcpy(sections.data(), data + header.sectionTableOffset, header.sectionCount * sizeof(SectionEntry));
+            for (const auto& section : sections) {
+                if (section.offset % kSectionAlignment != 0 || section.offset > size || section.size > size - section.offset) {
+                    sections.clear();
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        const SectionEntry* FindSection(const std::vector<SectionEntry>& sections, SectionType type) {
+            const auto it = std::find_if(sections.begin(), sections.end(), [type](const SectionEntry& section) {
+                return section.type == static_cast<std::uint32_t>(type);
+            });
+            return it != sections.end() ? &*it : nullptr;
+        }
+
+        void WriteSkin(Writer& writer, const SkinData& skin) {
+            writer.Write(static_cast<std::uint32_t>(skin.joints.size()));
+            for (const auto& joint : skin.joints) {
+                writer.WriteString(joint.name);
+                writer.Write(static_cast<std::int32_t>(joint.parent));
+                writer.Write(joint.bindLocal);
+            }
+            writer.WriteArray(skin.boneJoints);
+            writer.WriteArray(skin.inverseBindMatrices);
+            writer.WriteArray(skin.influences);
+            writer.Write(skin.rootInverse);
+        }
+
+        bool ReadSkin(Reader& reader, SkinData& skin) {
+            std::uint32_t jointCount = 0;
+            if (!reader.Read(jointCount)) {
+                return false;
+            }
+            skin.joints.clear();
+            for (std::uint32_t joint = 0; joint < jointCount && reader.IsValid(); ++joint) {
+                SkinJoint value;
+                std::int32_t parent = -1;
+                reader.ReadString(value.name);
+                reader.Read(parent);
+                reader.Read(value.bindLocal);
+                value.parent = parent;
+                skin.joints.push_back(std::move(value));
+            }
+            reader.ReadArray(skin.boneJoints);
+            reader.ReadArray(skin.inverseBindMatrices);
+            reader.ReadArray(skin.influences);
+            reader.Read(skin.rootInverse);
+            return reader.IsValid();
+        }
+
+        void WriteClips(Writer& writer, const std::vector<AnimationClipHandle>& clips) {
+            const auto count = std::count_if(clips.begin(), clips.end(), [](const AnimationClipHandle& clip) { return clip != nullptr; });
+            writer.Write(static_cast<std::uint32_t>(count));
+            for (const auto& clip : clips) {
+                if (!clip) {
+                    continue;
+                }
+                writer.WriteString(clip->name);
+                writer.Write(clip->duration);
+                writer.Write(clip->ticksPerSecond);
+                writer.Write(static_cast<std::uint32_t>(clip->tracks.size()));
+                for (const auto& track : clip->tracks) {
+                    writer.WriteString(track.nodeName);
+                    WriteChannel(writer, track.translation);
+                    WriteChannel(writer, track.rotation);
+                    WriteChannel(writer, track.scale);
+                }
+            }
+        }
+
+        bool ReadClips(Reader& reader, std::vector<AnimationClip>& clips) {
+            std::uint32_t clipCount = 0;
+            if (!reader.Read(clipCount)) {
+                return false;
+            }
+            clips.clear();
+            for (std::uint32_t clipIndex = 0; clipIndex < clipCount && reader.IsValid(); ++clipIndex) {
+                AnimationClip clip;
+                std::uint32_t trackCount = 0;
+                reader.ReadString(clip.name);
+                reader.Read(clip.duration);
+                reader.Read(clip.ticksPerSecond);
+                reader.Read(trackCount);
+                for (std::uint32_t trackIndex = 0; trackIndex < trackCount && reader.IsValid(); ++trackIndex) {
+                    AnimationTrack track;
+                    reader.ReadString(track.nodeName);
+                    if (!ReadChannel(reader, track.translation) || !ReadChannel(reader, track.rotation) || !ReadChannel(reader, track.scale)) {
+                        return false;
+                    }
+                    clip.tracks.push_back(std::move(track));
+                }
+                clips.push_back(std::move(clip));
+            }
+            return reader.IsValid();
+        }
+    }
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "IndexFormat.h"
+#include "SkinData.h"
+#include "../world/WorldComponents.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace OGLE {
+    // Бинарный .omdl v3. Файл: заголовок, секции, выровненные по 16 байт, и таблица
+    // секций в конце. Вершины и индексы лежат в файле в том же виде, что и в памяти,
+    // поэтому после mmap они копируются в модель без разбора. Порядок байтов — little-endian.
+    namespace ModelBinaryFormat {
+        constexpr std::uint32_t kMagic = 0x4C444D4Fu; // "OMDL"
+        constexpr std::uint32_t kVersion = 3;
+        constexpr std::uint32_t kMinVersion = 2; // v2 отличается только отсутствием Indices16
+        constexpr std::size_t kSectionAlignment = 16;
+
+        enum class SectionType : std::uint32_t {
+            Meta = 1,      // boneCount, имя узла меша, путь к диффузной текстуре (может отсутствовать)
+            Vertices = 2,  // float[8 * N], раскладка как у BaseModel
+            Indices = 3,   // uint32[M]
+            Bounds = 4,    // BoundsRecord
+            Submeshes = 5, // SubmeshRecord[K]
+            Skin = 6,      // SkinData без bindVertices (это копия секции Vertices)
+            Clips = 7,     // Сжатые клипы AnimationClip
+            Indices16 = 8, // uint16[M] вместо Indices, если вершин не больше 65536
+            SubmeshBounds = 9, // BoundsRecord[K], по одному на запись Submeshes
+            Materials = 10     // uint32 K, затем K слотов: имя, путь к диффузной текстуре, float[3] цвет
+        };
+
+        struct FileHeader {
+            std::uint32_t magic = kMagic;
+            std::uint32_t version = kVersion;
+            std::uint32_t sectionCount = 0;
+            std::uint32_t reserved = 0;
+            std::uint64_t sectionTableOffset = 0;
+            std::uint64_t fileSize = 0;
+        };
+
+        struct SectionEntry {
+            std::uint32_t type = 0;
+            std::uint32_t reserved = 0;
+            std::uint64_t offset = 0;
+            std::uint64_t size = 0;
+        };
+
+        // Локальные границы меша: AABB и описанная сфера с центром в центре AABB.
+        struct BoundsRecord {
+            float min[3] = {0.0f, 0.0f, 0.0f};
+            float max[3] = {0.0f, 0.0f, 0.0f};
+            float center[3] = {0.0f, 0.0f, 0.0f};
+            float radius = 0.0f;
+        };
+
+        // Диапазон индексов, рисуемый одним материалом.
+        struct SubmeshRecord {
+            std::uint32_t indexOffset = 0;
+            std::uint32_t indexCount = 0;
+            std::int32_t materialIndex = -1;
+            std::uint32_t reserved = 0;
+        };
+
+        static_assert(sizeof(FileHeader) == 32, "FileHeader layout is part of the file format");
+        static_assert(sizeof(SectionEntry) == 24, "SectionEntry layout is part of the file format");
+        static_assert(sizeof(BoundsRecord) == 40, "BoundsRecord layout is part of the file format");
+        static_assert(sizeof(SubmeshRecord) == 16, "SubmeshRecord layout is part of the file format");
+        static_assert(sizeof(SkinInfluence) == 24, "SkinInfluence layout is part of the file format");
+
+        // Собирает файл в памяти: секции по очереди, таблица и заголовок в Finish().
+        class Writer {
+        public:
+            Writer();
+
+            void BeginSection(SectionType type);
+            void EndSection();
+
+            void WriteBytes(const void* data, std::size_t size);
+            void WriteString(const std::string& value);
+
+            template <typename T>
+            void Write(const T& value) {
+                static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be written");
+                WriteBytes(&value, sizeof(T));
+            }
+
+            // Число элементов (uint32) и сами элементы подряд.
+            template <typename T>
+            void WriteArray(const std::vector<T>& values) {
+                static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be written");
+                Write(static_cast<std::uint32_t>(values.size()));
+                WriteBytes(values.data(), values.size() * sizeof(T));
+            }
+
+            const std::vector<std::uint8_t>& Finish();
+
+        private:
+            void Align();
+
+            std::vector<std::uint8_t> m_buffer;
+            std::vector<SectionEntry> m_sections;
+        };
+
+        // Последовательное чтение секции с проверкой границ: после первой ошибки IsValid() == false.
+        class Reader {
+        public:
+            Reader(const std::uint8_t* data, std::size_t size);
+
+            bool ReadBytes(void* data, std::size_t size);
+            bool ReadString(std::string& value);
+
+            template <typename T>
+            bool Read(T& value) {
+                static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be read");
+                return ReadBytes(&value, sizeof(T));
+            }
+
+            template <typename T>
+            bool ReadArray(std::vector<T>& values) {
+                static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be read");
+                std::uint32_t count = 0;
+                if (!Read(count) || count > (m_size - m_offset) / sizeof(T)) {
+                    m_valid = false;
+                    return false;
+                }
+                values.resize(count);
+                return ReadBytes(values.data(), count * sizeof(T));
+            }
+
+            bool IsValid() const { return m_valid; }
+
+        private:
+            const std::uint8_t* m_data = nullptr;
+            std::size_t m_size = 0;
+            std::size_t m_offset = 0;
+            bool m_valid = true;
+        };
+
+        bool IsBinaryModel(const std::uint8_t* data, std::size_t size);
+        // Проверяет заголовок и таблицу секций; все секции гарантированно лежат внутри файла.
+        bool ParseHeader(const std::uint8_t* data, std::size_t size, std::vector<SectionEntry>& sections);
+        const SectionEntry* FindSection(const std::vector<SectionEntry>& sections, SectionType type);
+
+        void WriteSkin(Writer& writer, const SkinData& skin);
+        bool ReadSkin(Reader& reader, SkinData& skin);
+        void WriteClips(Writer& writer, const std::vector<AnimationClipHandle>& clips);
+        bool ReadClips(Reader& reader, std::vector<AnimationClip>& clips);
+    }
+}
@@ -1,5 +1,7 @@
 #include "ModelEntity.h"
 #include "../Logger.h"
+#include "../render/AnimationLibrary.h"
+#include "MeshCache.h"
 
 namespace glm {
     void to_json(nlohmann::json& j, const vec2& v) {
@@ -30,9 +32,15 @@ namespace OGLE {
 
     ModelEntity::~ModelEntity() {}
 
-    void ModelEntity::Draw() {
-        if (m_MeshBuffer) {
-            m_MeshBuffer->Draw();
+    void ModelEntity::Draw(int lodLevel) {
+        if (const MeshBuffer* buffer = GetLODBuffer(lodLevel)) {
+            buffer->Draw();
+        }
+    }
+
+    void ModelEntity::DrawSubmesh(int lodLevel, const MeshSubmesh& submesh) {
+        if (const MeshBuffer* buffer = GetLODBuffer(lodLevel)) {
+            buffer->DrawRange(submesh.indexOffset, submesh.indexCount);
         }
     }
 
@@ -43,15 +51,21 @@ namespace OGLE {
 
     void ModelEntity::ConvertToStatic() {
         if (m_Type == ModelType::DYNAMIC) {
-            BakeToGPU();
-            m_vertices.clear();
-            m_indices.clear();
+            // У общего меша своих CPU-данных нет, копия вершин остаётся в MeshCache.
+            if (!IsMeshShared()) {
+                BakeToGPU();
+                m_vertices.clear();
+                m_indices.clear();
+            }
             m_Type = ModelType::STATIC;
             LOG_INFO("Model converted to STATIC.");
         }
     }
 
     void ModelEntity::UpdateGeometry() {
+        if (IsMeshShared()) {
+            return; // Общий меш не менялся: изменение вершин отделяет модель от него
+        }
         if (m_Type == ModelType::DYNAMIC && !m_vertices.empty() && !m_indices.empty()) {
             BakeToGPU();
             LOG_INFO("Model geometry updated.");
@@ -69,22 +83,28 @@ namespace OGLE {
 
     void ModelEntity::UpdateGpuData()
     {
-        if (m_MeshBuffer) {
+        if (!m_MeshBuffer || IsMeshShared()) {
+            return;
+        }
+        // Сжатый буфер неизменяем: вершины упаковываются заново.
+        if (m_MeshBuffer->GetLayout().IsQuantized()) {
+            BakeToGPU();
+        } else {
             m_MeshBuffer->Update(m_vertices);
         }
     }
 
-    std::vector<float>& ModelEntity::GetVertices() {
+    std::vector<float>& ModelEntity::GetMutableVertices() {
         return m_vertices;
     }
 
     const std::vector<float>& ModelEntity::GetVertices() const {
-        return m_vertices;
+        return GetMeshVertices();
     }
 
     const std::vector<unsigned int>& ModelEntity::GetIndices() const
     {
-        return m_indices;
+        return GetMeshIndices();
     }
 
     void ModelEntity::AddTexture(const std::string& slotName, const std::string& texturePath)
@@ -92,14 +112,6 @@ namespace OGLE {
         m_material.AddTexture(slotName, texturePath);
     }
 
-    const std::vector<AnimationClip>& ModelEntity::GetAnimationClips() const {
-        return m_animationClips;
-    }
-
-    void ModelEntity::SetAnimationClips(std::vector<AnimationClip> clips) {
-        m_animationClips = std::move(clips);
-    }
-
     Material& ModelEntity::GetMaterial()
     {
         return m_material;
@@ -130,6 +142,13 @@ namespace OGLE {
         UpdateModelMatrix();
     }
 
+    void ModelEntity::SetWorldTransform(const glm::vec3& position, const glm::vec3& rotation, const glm::vec3& scale, const glm::mat4& modelMatrix) {
+        m_Position = position;
+        m_Rotation = rotation;
+        m_Scale = scale;
+        m_ModelMatrix = modelMatrix;
+    }
+
     const glm::vec3& ModelEntity::GetPosition() const {
         return m_Position;
     }
@@ -161,41 +180,27 @@ namespace OGLE {
             {"material", m_material.ToJson()}
         };
 
-        if (!m_animationClips.empty()) {
+        // Клипы модели из файла восстанавливаются при загрузке файла через AnimationLibrary;
+        // данные ключей пишутся только для моделей без файла, как и геометрия.
+        if (m_FilePath.empty() && !m_animationClips.empty()) {
             nlohmann::json clipsJson = nlohmann::json::array();
             for (const auto& clip : m_animationClips) {
-                nlohmann::json clipJson;
-                clipJson["name"] = clip.name;
-                clipJson["duration"] = clip.duration;
-                clipJson["ticksPerSecond"] = clip.ticksPerSecond;
-                clipJson["tracks"] = nlohmann::json::array();
-
-                for (const auto& track : clip.tracks) {
-                    nlohmann::json trackJson;
-                    trackJson["nodeName"] = track.nodeName;
-                    trackJson["keyframes"] = nlohmann::json::array();
-
-                    for (const auto& key : track.keyframes) {
-                        trackJson["keyframes"].push_back({
-                            {"time", key.time},
-                            {"translation", {key.translation.x, key.translation.y, key.translation.z}},
-                            {"rotation", {key.rotation.w, key.rotation.x, key.rotation.y, key.rotation.z}},
-                            {"scale", {key.scale.x, key.scale.y, key.scale.z}}
-                        });
-                    }
-
-                    clipJson["tracks"].push_back(trackJson);
+                if (clip) {
+                    clipsJson.push_back(AnimationLibrary::ClipToJson(*clip));
                 }
-
-                clipsJson.push_back(clipJson);
             }
             j["animationClips"] = clipsJson;
         }
 
-        if (m_FilePath.empty() && !m_vertices.empty() && !m_indices.empty()) {
+        // Примитивы и меши сцен файлов пишутся ключом и при загрузке снова берутся из кэша.
+        const SharedMesh* sharedMesh = GetSharedMesh();
+        if (m_FilePath.empty() && sharedMesh
+            && (MeshCache::IsPrimitiveKey(sharedMesh->key) || MeshCache::IsSceneMeshKey(sharedMesh->key))) {
+            j["meshKey"] = sharedMesh->key;
+        } else if (m_FilePath.empty() && !GetMeshVertices().empty() && !GetMeshIndices().empty()) {
             j["geometry"] = {
-                {"vertices", m_vertices},
-                {"indices", m_indices}
+                {"vertices", GetMeshVertices()},
+                {"indices", GetMeshIndices()}
             };
         }
     }
@@ -209,9 +214,15 @@ namespace OGLE {
         j.at("rotation").get_to(m_Rotation);
         j.at("scale").get_to(m_Scale);
 
+        std::shared_ptr<const SharedMesh> sharedMesh;
         if (!m_FilePath.empty()) {
-            LoadFromFile(m_FilePath);
-            BakeToGPU();
+            sharedMesh = MeshCache::Instance().GetModelFile(m_FilePath);
+        } else if (j.contains("meshKey")) {
+            sharedMesh = MeshCache::Instance().Find(j.at("meshKey").get<std::string>());
+        }
+
+        if (sharedMesh) {
+            ShareMesh(std::move(sharedMesh));
         } else if (j.contains("geometry")) {
             const auto& geometryJson = j.at("geometry");
             SetMeshGeometry(
@@ -224,51 +235,15 @@ namespace OGLE {
             m_material.FromJson(j.at("material"));
         }
 
-        if (j.contains("animationClips")) {
-            m_animationClips.clear();
+        // Старые сцены хранили клипы целиком и для моделей из файла — их данные
+        // игнорируются, клипы уже получены из файла и общие для всех экземпляров.
+        if (m_FilePath.empty() && j.contains("animationClips") && j.at("animationClips").is_array()) {
+            std::vector<AnimationClip> clips;
             for (const auto& clipJson : j.at("animationClips")) {
-                AnimationClip clip;
-                clip.name = clipJson.value("name", std::string(""));
-                clip.duration = clipJson.value("duration", 1.0f);
-                clip.ticksPerSecond = clipJson.value("ticksPerSecond", 24.0f);
-
-                if (clipJson.contains("tracks") && clipJson["tracks"].is_array()) {
-                    for (const auto& trackJson : clipJson["tracks"]) {
-                        AnimationTrack track;
-                        track.nodeName = trackJson.value("nodeName", std::string(""));
-                        if (trackJson.contains("keyframes") && trackJson["keyframes"].is_array()) {
-                            for (const auto& keyJson : trackJson["keyframes"]) {
-                                AnimationKeyframe key;
-                                key.time = keyJson.value("time", 0.0f);
-                                if (keyJson.contains("translation") && keyJson["translation"].is_array() && keyJson["translation"].size() == 3) {
-                                    key.translation = glm::vec3(
-                                        keyJson["translation"][0].get<float>(),
-                                        keyJson["translation"][1].get<float>(),
-                                        keyJson["translation"][2].get<float>());
-                                }
-                                if (keyJson.contains("rotation") && keyJson["rotation"].is_array() && keyJson["rotation"].size() == 4) {
-                                    key.rotation = glm::quat(
-                                        keyJson["rotation"][0].get<float>(),
-                                        keyJson["rotation"][1].get<float>(),
-                                        keyJson["rotation"][2].get<float>(),
-                                        keyJson["rotation"][3].get<float>());
-                                }
-                                if (keyJson.contains("scale") && keyJson["scale"].is_array() && keyJson["scale"].size() == 3) {
-                                    key.scale = glm::vec3(
-                                        keyJson["scale"][0].get<float>(),
-                                        keyJson["scale"][1].get<float>(),
-                                        keyJson["scale"][2].get<float>());
-                                }
-                                track.keyframes.push_back(std::move(key));
-                            }
-                        }
-                        clip.tracks.push_back(std::move(track));
-                    }
-                }
-
-                m_animationClips.push_back(std::move(clip));
+                clips.push_back(AnimationLibrary::ClipFromJson(clipJson));
             }
-        } 
+            m_animationClips = AnimationLibrary::Instance().RegisterClips(std::string(), std::move(clips));
+        }
         // else if (!GetLoadedDiffuseTexturePath().empty()) {
         //     m_material.AddTexture("diffuse", GetLoadedDiffuseTexturePath());
         // }
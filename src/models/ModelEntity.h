@@ -18,15 +18,22 @@ namespace OGLE {
         ModelEntity(ModelType type = ModelType::DYNAMIC, std::string filePath = "");
         ~ModelEntity();
 
-        void Draw();
+        void Draw(int lodLevel = 0); // 0 — исходный меш, см. BaseModel::GetLODBuffer
+        void DrawSubmesh(int lodLevel, const MeshSubmesh& submesh); // Диапазон из GetSubmeshes(lodLevel)
         void BindMaterial(GLuint program) const;
         void ConvertToStatic();
+        // Обе пересчитывают локальные границы; мировые границы сущностей с этой
+        // моделью World обновит в следующем UpdateTransforms (BaseModel::GetBoundsRevision).
         void UpdateGeometry();
         void SetMeshData(const std::vector<float>& vertices, const std::vector<unsigned int>& indices);
         void UpdateGpuData(); // Добавлено для обновления GPU буфера
-        std::vector<float>& GetVertices(); // Добавлено для доступа к изменяемым вершинам
-        const std::vector<float>& GetVertices() const; // Добавлено для чтения вершин
-        const std::vector<unsigned int>& GetIndices() const; // Добавлено для чтения индексов
+        // Свои вершины модели без копирования при записи: у общего меша пусто,
+        // поэтому сначала DetachMesh (в главном потоке — он создаёт буферы GPU).
+        std::vector<float>& GetMutableVertices();
+        // Вершины и индексы для чтения: свои или CPU-копия общего меша.
+        // Пусто только у модели со своим мешем после ConvertToStatic.
+        const std::vector<float>& GetVertices() const;
+        const std::vector<unsigned int>& GetIndices() const;
         void AddTexture(const std::string& slotName, const std::string& texturePath);
         Material& GetMaterial();
         const Material& GetMaterial() const;
@@ -35,9 +42,9 @@ namespace OGLE {
         void SetPosition(const glm::vec3& position);
         void SetRotation(const glm::vec3& rotation);
         void SetScale(const glm::vec3& scale);
+        // Принимает уже посчитанную TransformSystem матрицу, без повторного пересчёта.
+        void SetWorldTransform(const glm::vec3& position, const glm::vec3& rotation, const glm::vec3& scale, const glm::mat4& modelMatrix);
 
-        const std::vector<AnimationClip>& GetAnimationClips() const; // Клипы, загруженные из FBX/Assimp
-        void SetAnimationClips(std::vector<AnimationClip> clips);
         const glm::vec3& GetPosition() const;
         const glm::vec3& GetRotation() const;
         const glm::vec3& GetScale() const;
@@ -58,6 +65,5 @@ namespace OGLE {
         glm::mat4 m_ModelMatrix;
         std::string m_FilePath;
         Material m_material;
-        std::vector<AnimationClip> m_animationClips;
     };
 }
@@ -0,0 +1,111 @@
+#include "ModelImportQueue.h"
+#include "BaseModel.h"
+#include "MeshCache.h"
+#include "../Logger.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace OGLE {
+    ModelImportQueue& ModelImportQueue::Instance() {
+        static ModelImportQueue instance;
+        return instance;
+    }
+
+    ModelImportTicket ModelImportQueue::ImportAsync(const std::string& path, Callback callback) {
+        const ModelImportTicket ticket = m_nextTicket++;
+        MeshCache& cache = MeshCache::Instance();
+        const std::string key = MeshCache::MakeModelFileKey(path);
+
+        const auto inFlight = m_inFlight.find(key);
+        if (inFlight != m_inFlight.end()) {
+            inFlight->second->waiters.push_back({ticket, std::move(callback)});
+            return ticket;
+        }
+
+        auto request = std::make_shared<Request>();
+        request->path = path;
+        request->key = key;
+        request->waiters.push_back({ticket, std::move(callback)});
+        request->cachedMesh = cache.FindModelFile(path);
+        if (!request->cachedMesh) {
+            request->loader = std::make_unique<BaseModel>();
+            // Задача держит только сам запрос: очередь может не дожить до её конца.
+            request->job = JobSystem::Instance().ScheduleBackground([request]() {
+                request->succeeded = MeshCache::Instance().ImportModelFile(request->path, *request->loader);
+            });
+        }
+
+        m_inFlight[key] = request;
+        m_requests.push_back(std::move(request));
+        return ticket;
+    }
+
+    void ModelImportQueue::Cancel(ModelImportTicket ticket) {
+        if (ticket == kInvalidModelImportTicket) {
+            return;
+        }
+        for (const auto& request : m_requests) {
+            auto& waiters = request->waiters;
+            const auto waiter = std::find_if(waiters.begin(), waiters.end(), [ticket](const Waiter& candidate) {
+                return candidate.ticket == ticket;
+            });
+            if (waiter != waiters.end()) {
+                waiters.erase(waiter);
+                return;
+            }
+        }
+    }
+
+    std::size_t ModelImportQueue::ProcessUploads(double budgetMs) {
+        const auto start = std::chrono::steady_clock::now();
+        std::size_t uploaded = 0;
+
+        // Порядок запросов сохраняется: следующий ждёт, пока не будет готов первый.
+        while (!m_requests.empty() && m_requests.front()->job.IsDone()) {
+            if (uploaded > 0) {
+                const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                if (elapsedMs >= budgetMs) {
+                    break;
+                }
+            }
+
+            const std::shared_ptr<Request> request = std::move(m_requests.front());
+            m_requests.pop_front();
+            m_inFlight.erase(request->key);
+
+            std::shared_ptr<const SharedMesh> mesh;
+            if (!request->waiters.empty()) {
+                mesh = Upload(*request);
+                ++uploaded;
+            }
+            // Обратный вызов может запросить новый импорт, поэтому список забирается целиком.
+            const std::vector<Waiter> waiters = std::move(request->waiters);
+            for (const Waiter& waiter : waiters) {
+                if (waiter.callback) {
+                    waiter.callback(mesh);
+                }
+            }
+        }
+
+        return uploaded;
+    }
+
+    std::size_t ModelImportQueue::GetPendingCount() const {
+        return m_requests.size();
+    }
+
+    std::shared_ptr<const SharedMesh> ModelImportQueue::Upload(Request& request) {
+        if (request.cachedMesh) {
+            return request.cachedMesh;
+        }
+        if (!request.succeeded || !request.loader) {
+            LOG_ERROR("Async model import failed: " + request.path);
+            return nullptr;
+        }
+
+        std::shared_ptr<const SharedMesh> mesh = MeshCache::Instance().AddModelFile(request.path, *request.loader);
+        request.loader.reset();
+        return mesh;
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "SharedMesh.h"
+#include "../core/JobSystem.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OGLE {
+    class BaseModel;
+
+    using ModelImportTicket = std::uint64_t;
+    constexpr ModelImportTicket kInvalidModelImportTicket = 0;
+
+    // Фоновый импорт файлов моделей. Assimp, конвертация вершин и LOD идут в
+    // JobSystem::ScheduleBackground (главный поток такие задачи не подхватывает),
+    // а буферы GPU создаёт ProcessUploads в главном потоке с бюджетом времени на кадр.
+    // Все методы вызываются только из главного потока, обратные вызовы — из ProcessUploads.
+    class ModelImportQueue {
+    public:
+        // mesh == nullptr, если файл не загрузился.
+        using Callback = std::function<void(std::shared_ptr<const SharedMesh> mesh)>;
+
+        static ModelImportQueue& Instance();
+
+        // Один импорт на ключ MeshCache: повторные запросы того же файла ждут его же.
+        // Меш из кэша отдаётся в ближайшем ProcessUploads, а не прямо из вызова.
+        ModelImportTicket ImportAsync(const std::string& path, Callback callback);
+        // Обратный вызов не будет вызван. Импорт, который больше никому не нужен,
+        // доводится в фоне, но в GPU не загружается.
+        void Cancel(ModelImportTicket ticket);
+
+        // Загружает готовые импорты в порядке запросов, пока не истечёт budgetMs;
+        // хотя бы один готовый импорт загружается всегда. Возвращает число загруженных.
+        std::size_t ProcessUploads(double budgetMs);
+
+        // Импорты, ещё не отданные обратным вызовам (в фоне или в очереди загрузки).
+        std::size_t GetPendingCount() const;
+
+    private:
+        struct Waiter {
+            ModelImportTicket ticket = kInvalidModelImportTicket;
+            Callback callback;
+        };
+
+        // loader и succeeded пишет фоновая задача; главный поток читает их после job.IsDone().
+        struct Request {
+            std::string path;
+            std::string key;
+            std::shared_ptr<const SharedMesh> cachedMesh;
+            std::unique_ptr<BaseModel> loader;
+            bool succeeded = false;
+            JobSystem::JobHandle job;
+            std::vector<Waiter> waiters;
+        };
+
+        ModelImportQueue() = default;
+        ModelImportQueue(const ModelImportQueue&) = delete;
+        ModelImportQueue& operator=(const ModelImportQueue&) = delete;
+
+        std::shared_ptr<const SharedMesh> Upload(Request& request);
+
+        std::deque<std::shared_ptr<Request>> m_requests;
+        std::unordered_map<std::string, std::shared_ptr<Request>> m_inFlight;
+        ModelImportTicket m_nextTicket = 1;
+    };
+}
@@ -0,0 +1,100 @@
+#include "ModelScene.h"
+#include "BaseModel.h"
+#include "../Logger.h"
+#include "../core/FileSystem.h"
+#include "../world/systems/TransformSystem.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+#include <glm/gtc/quaternion.hpp>
+
+namespace OGLE {
+    namespace {
+        // Узлы без мешей во всём поддереве не попадают в сцену.
+        bool HasMeshes(const aiNode* node) {
+            if (!node) {
+                return false;
+            }
+            if (node->mNumMeshes > 0) {
+                return true;
+            }
+            for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+                if (HasMeshes(node->mChildren[i])) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void AddNodes(const aiNode* node, int parent, const ModelSceneImport& result, std::vector<ModelSceneNode>& nodes) {
+            if (!HasMeshes(node)) {
+                return;
+            }
+
+            aiVector3D scaling;
+            aiQuaternion rotation;
+            aiVector3D position;
+            node->mTransformation.Decompose(scaling, rotation, position);
+
+            ModelSceneNode sceneNode;
+            sceneNode.name = node->mName.C_Str();
+            sceneNode.parent = parent;
+            sceneNode.position = glm::vec3(position.x, position.y, position.z);
+            sceneNode.rotation = TransformSystem::ExtractRotation(
+                glm::mat3_cast(glm::quat(rotation.w, rotation.x, rotation.y, rotation.z)));
+            sceneNode.scale = glm::vec3(scaling.x, scaling.y, scaling.z);
+            for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
+                const unsigned int mesh = node->mMeshes[i];
+                if (mesh < result.meshes.size() && result.meshes[mesh]) {
+                    sceneNode.meshes.push_back(static_cast<int>(mesh));
+                }
+            }
+
+            const int index = static_cast<int>(nodes.size());
+            nodes.push_back(std::move(sceneNode));
+            for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+                AddNodes(node->mChildren[i], index, result, nodes);
+            }
+        }
+    }
+
+    bool ModelSceneImporter::Import(const std::string& path, ModelSceneImport& result) {
+        const std::string resolvedPath = FileSystem::ResolvePath(path).string();
+        // Вершины остаются в системе координат своего меша: aiProcess_PreTransformVertices
+        // и подобные флаги здесь не нужны, трансформ несёт узел.
+        Assimp::Importer importer;
+        const aiScene* scene = importer.ReadFile(resolvedPath, BaseModel::GetImportFlags());
+        if (!scene || !scene->HasMeshes() || !scene->mRootNode) {
+            LOG_ERROR("Error loading model scene from file: " + path);
+            return false;
+        }
+        if (scene->HasAnimations()) {
+            LOG_WARN("Model scene has animations, importing it as one mesh: " + path);
+            return false;
+        }
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            if (scene->mMeshes[i] && scene->mMeshes[i]->HasBones()) {
+                LOG_WARN("Model scene has skinned meshes, importing it as one mesh: " + path);
+                return false;
+            }
+        }
+
+        result.meshes.clear();
+        result.meshes.resize(scene->mNumMeshes);
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            auto loader = std::make_unique<BaseModel>();
+            if (loader->LoadFromSceneMesh(scene, i, resolvedPath)) {
+                result.meshes[i] = std::move(loader);
+            }
+        }
+
+        result.nodes.clear();
+        AddNodes(scene->mRootNode, -1, result, result.nodes);
+        if (result.nodes.empty()) {
+            LOG_ERROR("Model scene contains no renderable geometry: " + path);
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "SharedMesh.h"
+
+#include <glm/vec3.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OGLE {
+    class BaseModel;
+
+    // Узел дерева aiNode. Трансформ локальный, в тех же единицах, что TransformComponent.
+    struct ModelSceneNode {
+        std::string name;
+        int parent = -1;          // Индекс в ModelScene::nodes; родитель всегда раньше потомков
+        glm::vec3 position{0.0f};
+        glm::vec3 rotation{0.0f}; // Градусы, порядок как в TransformSystem::ComposeMatrix
+        glm::vec3 scale{1.0f};
+        std::vector<int> meshes;  // Индексы в ModelScene::meshes
+    };
+
+    // Файл модели как дерево узлов над общими мешами: меш, на который ссылаются
+    // несколько узлов, импортируется и загружается в GPU один раз.
+    struct ModelScene {
+        std::string key;                                       // Ключ в MeshCache
+        std::vector<std::shared_ptr<const SharedMesh>> meshes; // По одному на aiMesh; nullptr — пропущен
+        std::vector<ModelSceneNode> nodes;                     // Поддеревья без мешей отброшены
+    };
+
+    // CPU-часть импорта: геометрия каждого aiMesh и дерево узлов.
+    struct ModelSceneImport {
+        std::vector<std::unique_ptr<BaseModel>> meshes; // nullptr — меш без треугольников
+        std::vector<ModelSceneNode> nodes;
+    };
+
+    class ModelSceneImporter {
+    public:
+        // false, если файл не читается или в нём есть кости либо анимации: скинированные
+        // модели импортируются целиком (BaseModel::LoadFromFile), их узлы — это скелет.
+        static bool Import(const std::string& path, ModelSceneImport& result);
+    };
+}
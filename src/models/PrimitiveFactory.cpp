@@ -1,5 +1,6 @@
 #include "models/PrimitiveFactory.h"
 
+#include "models/MeshCache.h"
 #include "models/ModelEntity.h"
 #include "../render/Material.h"
 
@@ -7,20 +8,7 @@
 #include <vector>
 
 namespace {
-    std::shared_ptr<OGLE::ModelEntity> MakeStaticModel(
-        const std::vector<float>& vertices,
-        const std::vector<unsigned int>& indices,
-        const OGLE::Material* material)
-    {
-        auto model = std::make_shared<OGLE::ModelEntity>(OGLE::ModelType::STATIC);
-        model->SetMeshData(vertices, indices);
-        if (material) {
-            model->GetMaterial() = *material;
-        }
-        return model;
-    }
-
-    std::shared_ptr<OGLE::ModelEntity> CreateCube(const OGLE::Material* material)
+    void BuildCube(std::vector<float>& outVertices, std::vector<unsigned int>& outIndices)
     {
         static const std::vector<float> vertices = {
             -0.5f, -0.5f,  0.5f,   0.0f,  0.0f,  1.0f,   0.0f, 0.0f,
@@ -63,10 +51,11 @@ namespace {
             20, 22, 21,  22, 20, 23
         };
 
-        return MakeStaticModel(vertices, indices, material);
+        outVertices = vertices;
+        outIndices = indices;
     }
 
-    std::shared_ptr<OGLE::ModelEntity> CreatePlane(const OGLE::Material* material)
+    void BuildPlane(std::vector<float>& outVertices, std::vector<unsigned int>& outIndices)
     {
         static const std::vector<float> vertices = {
             -0.5f, 0.0f, -0.5f,   0.0f, 1.0f, 0.0f,    0.0f, 0.0f,
@@ -80,10 +69,11 @@ namespace {
             2, 3, 0
         };
 
-        return MakeStaticModel(vertices, indices, material);
+        outVertices = vertices;
+        outIndices = indices;
     }
 
-    std::shared_ptr<OGLE::ModelEntity> CreateSphere(const OGLE::Material* material)
+    void BuildSphere(std::vector<float>& outVertices, std::vector<unsigned int>& outIndices)
     {
         constexpr unsigned int rings = 16;
         constexpr unsigned int sectors = 32;
@@ -139,22 +129,45 @@ namespace {
             }
         }
 
-        return MakeStaticModel(vertices, indices, material);
+        outVertices = std::move(vertices);
+        outIndices = std::move(indices);
     }
 }
 
-std::shared_ptr<OGLE::ModelEntity> PrimitiveFactory::CreatePrimitiveModel(
+bool PrimitiveFactory::BuildPrimitiveGeometry(
     OGLE::PrimitiveType type,
-    const OGLE::Material* material)
+    std::vector<float>& vertices,
+    std::vector<unsigned int>& indices)
 {
     switch (type) {
     case OGLE::PrimitiveType::Cube:
-        return CreateCube(material);
+        BuildCube(vertices, indices);
+        return true;
     case OGLE::PrimitiveType::Sphere:
-        return CreateSphere(material);
+        BuildSphere(vertices, indices);
+        return true;
     case OGLE::PrimitiveType::Plane:
-        return CreatePlane(material);
+        BuildPlane(vertices, indices);
+        return true;
     default:
+        return false;
+    }
+}
+
+std::shared_ptr<OGLE::ModelEntity> PrimitiveFactory::CreatePrimitiveModel(
+    OGLE::PrimitiveType type,
+    const OGLE::Material* material)
+{
+    // Геометрия и буферы GPU общие для всех примитивов одного типа (MeshCache).
+    auto mesh = OGLE::MeshCache::Instance().GetPrimitive(type);
+    if (!mesh) {
         return nullptr;
     }
+
+    auto model = std::make_shared<OGLE::ModelEntity>(OGLE::ModelType::STATIC);
+    model->ShareMesh(std::move(mesh));
+    if (material) {
+        model->GetMaterial() = *material;
+    }
+    return model;
 }
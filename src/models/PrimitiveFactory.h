@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "world/WorldComponents.h"
 
@@ -16,4 +17,8 @@ public:
     static std::shared_ptr<OGLE::ModelEntity> CreatePrimitiveModel(
         OGLE::PrimitiveType type,
         const OGLE::Material* material = nullptr);
+    static bool BuildPrimitiveGeometry(
+        OGLE::PrimitiveType type,
+        std::vector<float>& vertices,
+        std::vector<unsigned int>& indices);
 };
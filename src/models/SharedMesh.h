@@ -0,0 +1,37 @@
+#pragma once
+
+#include "MeshBounds.h"
+#include "MeshBuffer.h"
+#include "MeshSimplifier.h"
+#include "MeshSubmesh.h"
+#include "SkinData.h"
+#include "../world/WorldComponents.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OGLE {
+    // Неизменяемая геометрия, общая для всех моделей с одним ключом MeshCache:
+    // CPU-копия, буферы GPU и данные файла. Модели держат её через shared_ptr и
+    // копируют себе (BaseModel::DetachMesh) только перед изменением вершин.
+    // CPU-копия живёт, пока жив меш: из неё читают DetachMesh, SaveToCustomFile и
+    // сцена (ModelEntity::ToJson), без повторного чтения файла.
+    struct SharedMesh {
+        std::string key;                               // Ключ в MeshCache
+        std::vector<float> vertices;
+        std::vector<unsigned int> indices;
+        std::shared_ptr<MeshBuffer> buffer;
+        std::shared_ptr<const MeshLODChain> lods;      // nullptr, если меш не упрощался
+        MeshBounds bounds;
+        MeshSubmeshList submeshes;
+        std::vector<MeshMaterialSlot> materialSlots;
+        // Диффузные текстуры слотов; заполняются, только если слотов больше одного.
+        std::vector<std::shared_ptr<Texture2D>> materialTextures;
+        std::vector<AnimationClipHandle> animationClips;
+        std::shared_ptr<const SkinData> skin;
+        std::string meshNodeName;
+        std::string diffuseTexturePath;
+        int boneCount = 0;
+    };
+}
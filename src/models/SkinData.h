@@ -0,0 +1,35 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OGLE {
+    // Влияние костей на вершину: до 4 костей с наибольшими весами, сумма весов — 1.
+    struct SkinInfluence {
+        std::uint16_t bones[4] = {0, 0, 0, 0};
+        float weights[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    };
+
+    // Узел иерархии скелета. Суставы упорядочены так, что родитель всегда раньше потомка.
+    struct SkinJoint {
+        std::string name;
+        int parent = -1;
+        glm::mat4 bindLocal{1.0f}; // Локальная трансформация узла из файла, если клип её не анимирует
+    };
+
+    // Данные скиннинга модели, общие для всех её экземпляров.
+    // Палитра кости: rootInverse * global(сустав кости) * inverseBindMatrices[кость].
+    struct SkinData {
+        std::vector<SkinJoint> joints;             // Кости и все их предки до корня сцены
+        std::vector<int> boneJoints;               // Сустав каждой кости
+        std::vector<glm::mat4> inverseBindMatrices; // По костям (из пространства меша в пространство кости)
+        std::vector<SkinInfluence> influences;     // По вершинам
+        std::vector<float> bindVertices;           // Вершины в bind-позе, раскладка как у BaseModel
+        glm::mat4 rootInverse{1.0f};               // Обратная трансформация корня сцены
+
+        bool IsValid() const { return !boneJoints.empty() && !influences.empty(); }
+    };
+}
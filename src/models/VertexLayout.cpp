@@ -0,0 +1,367 @@
+#include "VertexLayout.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace OGLE {
+    namespace {
+        constexpr std::size_t kVertexStride = 8;
+        constexpr float kUnorm16Max = 65535.0f;
+        constexpr float kSnorm16Max = 32767.0f;
+
+        glm::vec2 OctahedralProject(const glm::vec3& normal) {
+            const float sum = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+            if (sum <= 0.0f) {
+                return glm::vec2(0.0f);
+            }
+            glm::vec2 projected(normal.x / sum, normal.y / sum);
+            if (normal.z < 0.0f) {
+                // Нижняя полусфера отражается в углы квадрата.
+                projected = glm::vec2(
+                    (1.0f - std::abs(projected.y)) * (projected.x >= 0.0f ? 1.0f : -1.0f),
+                    (1.0f - std::abs(projected.x)) * (projected.y >= 0.0f ? 1.0f : -1.0f));
+            }
+            return projected;
+        }
+
+        template <typename T>
+        void WriteValue(std::uint8_t* target, const T& value) {
+            std::memcpy(target, &value, sizeof(T));
+        }
+
+        template <typename T>
+        T ReadValue(const std::uint8_t* source) {
+            T value;
+            std::memcpy(&value, source, sizeof(T));
+            return value;
+        }
+    }
+
+    VertexLayout VertexLayout::Create(VertexFormat format, bool withBones) {
+        VertexLayout layout;
+        layout.format = format;
+        const auto add = [&layout](VertexAttribute attribute, VertexAttributeFormat attributeFormat) {
+            layout.attributes.push_back(VertexAttributeDesc{attribute, attributeFormat, layout.stride});
+            layout.stride += GetAttributeSize(attributeFormat);
+        };
+
+        if (format == VertexFormat::Quantized) {
+            add(VertexAttribute::Position, VertexAttributeFormat::UNorm16x3);
+            add(VertexAttribute::Normal, VertexAttributeFormat::OctSNorm16x2);
+            add(VertexAttribute::TexCoord, VertexAttributeFormat::Half2);
+        } else {
+            add(VertexAttribute::Position, VertexAttributeFormat::Float3);
+            add(VertexAttribute::Normal, VertexAttributeFormat::Float3);
+            add(VertexAttribute::TexCoord, VertexAttributeFormat::Float2);
+        }
+        if (withBones) {
+            add(VertexAttribute::BoneIndices, VertexAttributeFormat::UInt8x4);
+            add(VertexAttribute::BoneWeights, VertexAttributeFormat::UNorm8x4);
+        }
+        return layout;
+    }
+
+    std::uint32_t VertexLayout::GetAttributeSize(VertexAttributeFormat format) {
+        switch (format) {
+        case VertexAttributeFormat::Float2:
+            return 8;
+        case VertexAttributeFormat::Float3:
+            return 12;
+        case VertexAttributeFormat::UNorm16x3:
+            return 8;
+        case VertexAttributeFormat::OctSNorm16x2:
+        case VertexAttributeFormat::Half2:
+        case VertexAttributeFormat::UInt8x4:
+        case VertexAttributeFormat::UNorm8x4:
+            return 4;
+        }
+        return 0;
+    }
+
+    const VertexAttributeDesc* VertexLayout::Find(VertexAttribute attribute) const {
+        const auto it = std::find_if(attributes.begin(), attributes.end(), [attribute](const VertexAttributeDesc& desc) {
+            return desc.attribute == attribute;
+        });
+        return it != attributes.end() ? &*it : nullptr;
+    }
+
+    namespace VertexQuantization {
+        std::uint16_t QuantizeUnorm16(float value, float offset, float scale) {
+            if (scale <= 0.0f) {
+                return 0;
+            }
+            const float normalized = std::clamp((value - offset) / scale, 0.0f, 1.0f);
+            return static_cast<std::uint16_t>(std::lround(normalized * kUnorm16Max));
+        }
+
+        float DequantizeUnorm16(std::uint16_t value, float offset, float scale) {
+            return offset + static_cast<float>(value) / kUnorm16Max * scale;
+        }
+
+        void EncodeOctahedral(const glm::vec3& normal, std::int16_t out[2]) {
+            const glm::vec2 projected = OctahedralProject(normal);
+            const float length = glm::length(normal);
+            const glm::vec3 unit = length > 0.0f ? normal / length : glm::vec3(0.0f, 0.0f, 1.0f);
+
+            // Из четырёх соседних узлов сетки берётся тот, что точнее восстанавливает нормаль.
+            const float baseX = std::floor(std::clamp(projected.x, -1.0f, 1.0f) * kSnorm16Max);
+            const float baseY = std::floor(std::clamp(projected.y, -1.0f, 1.0f) * kSnorm16Max);
+            float bestDot = -2.0f;
+            for (int dx = 0; dx < 2; ++dx) {
+                for (int dy = 0; dy < 2; ++dy) {
+                    const std::int16_t candidate[2] = {
+                        static_cast<std::int16_t>(std::clamp(baseX + dx, -kSnorm16Max, kSnorm16Max)),
+                        static_cast<std::int16_t>(std::clamp(baseY + dy, -kSnorm16Max, kSnorm16Max))
+                    };
+                    const float dot = glm::dot(DecodeOctahedral(candidate), unit);
+                    if (dot > bestDot) {
+                        bestDot = dot;
+                        out[0] = candidate[0];
+                        out[1] = candidate[1];
+                    }
+                }
+            }
+        }
+
+        glm::vec3 DecodeOctahedral(const std::int16_t encoded[2]) {
+            const float x = std::max(static_cast<float>(encoded[0]) / kSnorm16Max, -1.0f);
+            const float y = std::max(static_cast<float>(encoded[1]) / kSnorm16Max, -1.0f);
+            glm::vec3 normal(x, y, 1.0f - std::abs(x) - std::abs(y));
+            const float fold = std::max(-normal.z, 0.0f);
+            normal.x += normal.x >= 0.0f ? -fold : fold;
+            normal.y += normal.y >= 0.0f ? -fold : fold;
+            return glm::normalize(normal);
+        }
+
+        std::uint16_t FloatToHalf(float value) {
+            std::uint32_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(bits));
+            const auto sign = static_cast<std::uint16_t>((bits >> 16) & 0x8000u);
+            const std::uint32_t magnitude = bits & 0x7FFFFFFFu;
+
+            if (magnitude >= 0x7F800000u) {
+                return static_cast<std::uint16_t>(sign | 0x7C00u | (magnitude > 0x7F800000u ? 0x200u : 0u));
+            }
+            if (magnitude >= 0x477FF000u) {
+                return static_cast<std::uint16_t>(sign | 0x7C00u); // Округляется в бесконечность
+            }
+            if (magnitude < 0x38800000u) {
+                // Денормализованный half: значение * 2^24, округление к ближайшему чётному.
+                if (magnitude < 0x33000000u) {
+                    return sign;
+                }
+                const std::uint32_t shift = 126u - (magnitude >> 23);
+                const std::uint32_t mantissa = (magnitude & 0x7FFFFFu) | 0x800000u;
+                std::uint32_t half = mantissa >> shift;
+                const std::uint32_t remainder = mantissa & ((1u << shift) - 1u);
+                const std::uint32_t halfway = 1u << (shift - 1u);
+                if (remainder > halfway || (remainder == halfway && (half & 1u))) {
+                    ++half;
+                }
+                return static_cast<std::uint16_t>(sign | half);
+            }
+
+            std::uint32_t half = (magnitude - 0x38000000u) >> 13;
+            const std::uint32_t remainder = magnitude & 0x1FFFu;
+            if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+                ++half; // Перенос в экспоненту корректен
+            }
+            return static_cast<std::uint16_t>(sign | half);
+        }
+
+        float HalfToFloat(std::uint16_t value) {
+            const std::uint32_t sign = static_cast<std::uint32_t>(value & 0x8000u) << 16;
+            const std::uint32_t exponent = (value >> 10) & 0x1Fu;
+            const std::uint32_t mantissa = value & 0x3FFu;
+
+            std::uint32_t bits = 0;
+            if (exponent == 0) {
+                const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+                return sign ? -magnitude : magnitude;
+            }
+            if (exponent == 0x1Fu) {
+                bits = sign | 0x7F800000u | (mantissa << 13);
+            } else {
+                bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+            }
+            float result = 0.0f;
+            std::memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+
+        void QuantizeWeights(const float weights[4], std::uint8_t out[4]) {
+            float total = 0.0f;
+            for (int i = 0; i < 4; ++i) {
+                total += std::max(weights[i], 0.0f);
+            }
+            if (total <= 0.0f) {
+                out[0] = 255;
+                out[1] = out[2] = out[3] = 0;
+                return;
+            }
+
+            int sum = 0;
+            float remainders[4];
+            for (int i = 0; i < 4; ++i) {
+                const float scaled = std::max(weights[i], 0.0f) / total * 255.0f;
+                const float whole = std::floor(scaled);
+                out[i] = static_cast<std::uint8_t>(whole);
+                remainders[i] = scaled - whole;
+                sum += out[i];
+            }
+            // Недостающие до 255 единицы получают веса с наибольшей дробной частью.
+            while (sum < 255) {
+                const int best = static_cast<int>(std::max_element(remainders, remainders + 4) - remainders);
+                ++out[best];
+                remainders[best] = -1.0f;
+                ++sum;
+            }
+        }
+
+        glm::vec3 GetPositionTolerance(const VertexLayout& layout) {
+            const VertexAttributeDesc* position = layout.Find(VertexAttribute::Position);
+            if (!position || position->format != VertexAttributeFormat::UNorm16x3) {
+                return glm::vec3(0.0f);
+            }
+            // Половина шага сетки плюс ошибка округления float при распаковке.
+            const glm::vec3 rounding = (glm::abs(layout.positionOffset) + glm::abs(layout.positionScale)) * std::numeric_limits<float>::epsilon();
+            return layout.positionScale * (0.5f / kUnorm16Max) + rounding;
+        }
+
+        bool PackVertices(const std::vector<float>& vertices, const std::vector<SkinInfluence>* influences,
+            VertexLayout& layout, std::vector<std::uint8_t>& outData) {
+            const std::size_t vertexCount = vertices.size() / kVertexStride;
+            const bool needsBones = layout.Find(VertexAttribute::BoneIndices) || layout.Find(VertexAttribute::BoneWeights);
+            if (needsBones) {
+                if (!influences || influences->size() != vertexCount) {
+                    return false;
+                }
+                for (const SkinInfluence& influence : *influences) {
+                    for (int i = 0; i < 4; ++i) {
+                        if (influence.bones[i] > std::numeric_limits<std::uint8_t>::max()) {
+                            return false;
+                        }
+                    }
+                }
+            }
+
+            const VertexAttributeDesc* position = layout.Find(VertexAttribute::Position);
+            if (position && position->format == VertexAttributeFormat::UNorm16x3) {
+                glm::vec3 minimum(std::numeric_limits<float>::max());
+                glm::vec3 maximum(std::numeric_limits<float>::lowest());
+                for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+                    const glm::vec3 value(vertices[vertex * kVertexStride], vertices[vertex * kVertexStride + 1], vertices[vertex * kVertexStride + 2]);
+                    minimum = glm::min(minimum, value);
+                    maximum = glm::max(maximum, value);
+                }
+                layout.positionOffset = vertexCount > 0 ? minimum : glm::vec3(0.0f);
+                layout.positionScale = vertexCount > 0 ? maximum - minimum : glm::vec3(0.0f);
+            }
+
+            outData.assign(vertexCount * layout.stride, 0);
+            for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+                const float* source = vertices.data() + vertex * kVertexStride;
+                std::uint8_t* target = outData.data() + vertex * layout.stride;
+                for (const VertexAttributeDesc& desc : layout.attributes) {
+                    std::uint8_t* field = target + desc.offset;
+                    const float* values = desc.attribute == VertexAttribute::Normal ? source + 3
+                        : desc.attribute == VertexAttribute::TexCoord ? source + 6
+                        : source;
+                    switch (desc.format) {
+                    case VertexAttributeFormat::Float2:
+                        std::memcpy(field, values, 2 * sizeof(float));
+                        break;
+                    case VertexAttributeFormat::Float3:
+                        std::memcpy(field, values, 3 * sizeof(float));
+                        break;
+                    case VertexAttributeFormat::UNorm16x3:
+                        for (int i = 0; i < 3; ++i) {
+                            WriteValue(field + i * 2, QuantizeUnorm16(values[i], layout.positionOffset[i], layout.positionScale[i]));
+                        }
+                        break;
+                    case VertexAttributeFormat::OctSNorm16x2: {
+                        std::int16_t encoded[2];
+                        EncodeOctahedral(glm::vec3(values[0], values[1], values[2]), encoded);
+                        std::memcpy(field, encoded, sizeof(encoded));
+                        break;
+                    }
+                    case VertexAttributeFormat::Half2:
+                        WriteValue(field, FloatToHalf(values[0]));
+                        WriteValue(field + 2, FloatToHalf(values[1]));
+                        break;
+                    case VertexAttributeFormat::UInt8x4:
+                        for (int i = 0; i < 4; ++i) {
+                            field[i] = static_cast<std::uint8_t>((*influences)[vertex].bones[i]);
+                        }
+                        break;
+                    case VertexAttributeFormat::UNorm8x4:
+                        QuantizeWeights((*influences)[vertex].weights, field);
+                        break;
+                    }
+                }
+            }
+            return true;
+        }
+
+        void UnpackVertices(const std::uint8_t* data, std::size_t vertexCount, const VertexLayout& layout,
+            std::vector<float>& outVertices, std::vector<SkinInfluence>* outInfluences) {
+            outVertices.assign(vertexCount * kVertexStride, 0.0f);
+            if (outInfluences) {
+                outInfluences->assign(vertexCount, SkinInfluence{});
+            }
+
+            for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+                const std::uint8_t* source = data + vertex * layout.stride;
+                float* target = outVertices.data() + vertex * kVertexStride;
+                for (const VertexAttributeDesc& desc : layout.attributes) {
+                    const std::uint8_t* field = source + desc.offset;
+                    float* values = desc.attribute == VertexAttribute::Normal ? target + 3
+                        : desc.attribute == VertexAttribute::TexCoord ? target + 6
+                        : target;
+                    switch (desc.format) {
+                    case VertexAttributeFormat::Float2:
+                        std::memcpy(values, field, 2 * sizeof(float));
+                        break;
+                    case VertexAttributeFormat::Float3:
+                        std::memcpy(values, field, 3 * sizeof(float));
+                        break;
+                    case VertexAttributeFormat::UNorm16x3:
+                        for (int i = 0; i < 3; ++i) {
+                            values[i] = DequantizeUnorm16(ReadValue<std::uint16_t>(field + i * 2), layout.positionOffset[i], layout.positionScale[i]);
+                        }
+                        break;
+                    case VertexAttributeFormat::OctSNorm16x2: {
+                        std::int16_t encoded[2];
+                        std::memcpy(encoded, field, sizeof(encoded));
+                        const glm::vec3 normal = DecodeOctahedral(encoded);
+                        values[0] = normal.x;
+                        values[1] = normal.y;
+                        values[2] = normal.z;
+                        break;
+                    }
+                    case VertexAttributeFormat::Half2:
+                        values[0] = HalfToFloat(ReadValue<std::uint16_t>(field));
+                        values[1] = HalfToFloat(ReadValue<std::uint16_t>(field + 2));
+                        break;
+                    case VertexAttributeFormat::UInt8x4:
+                        if (outInfluences) {
+                            for (int i = 0; i < 4; ++i) {
+                                (*outInfluences)[vertex].bones[i] = field[i];
+                            }
+                        }
+                        break;
+                    case VertexAttributeFormat::UNorm8x4:
+                        if (outInfluences) {
+                            for (int i = 0; i < 4; ++i) {
+                                (*outInfluences)[vertex].weights[i] = static_cast<float>(field[i]) / 255.0f;
+                            }
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
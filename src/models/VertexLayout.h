@@ -0,0 +1,87 @@
+#pragma once
+
+#include "SkinData.h"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace OGLE {
+    // Раскладка вершины в буфере GPU. На CPU вершины всегда хранятся как 8 float
+    // (позиция, нормаль, UV), сжатая раскладка получается упаковкой при загрузке в GPU.
+    enum class VertexFormat : std::uint8_t {
+        Float32,  // 32 байта: float3 позиция, float3 нормаль, float2 UV
+        Quantized // 16 байт: unorm16 позиция в границах меша, октаэдрическая нормаль, half UV
+    };
+
+    // Номер атрибута совпадает с location в шейдере.
+    enum class VertexAttribute : std::uint8_t {
+        Position = 0,
+        Normal = 1,
+        TexCoord = 2,
+        BoneIndices = 3,
+        BoneWeights = 4
+    };
+
+    enum class VertexAttributeFormat : std::uint8_t {
+        Float2,
+        Float3,
+        UNorm16x3,    // Позиция в долях AABB меша, 2 байта выравнивания
+        OctSNorm16x2, // Октаэдрическая нормаль, распаковывается в шейдере
+        Half2,
+        UInt8x4,      // Индексы костей (до 256 костей)
+        UNorm8x4      // Веса костей, сумма ровно 255
+    };
+
+    struct VertexAttributeDesc {
+        VertexAttribute attribute = VertexAttribute::Position;
+        VertexAttributeFormat format = VertexAttributeFormat::Float3;
+        std::uint32_t offset = 0;
+    };
+
+    struct VertexLayout {
+        VertexFormat format = VertexFormat::Float32;
+        std::vector<VertexAttributeDesc> attributes;
+        std::uint32_t stride = 0;
+        // Распаковка позиции UNorm16x3: position = positionOffset + q * positionScale.
+        glm::vec3 positionOffset{0.0f};
+        glm::vec3 positionScale{1.0f};
+
+        // Кости добавляются только по запросу: CPU-скиннинг их в буфере не читает.
+        static VertexLayout Create(VertexFormat format, bool withBones = false);
+        static std::uint32_t GetAttributeSize(VertexAttributeFormat format);
+
+        const VertexAttributeDesc* Find(VertexAttribute attribute) const;
+        bool IsQuantized() const { return format == VertexFormat::Quantized; }
+    };
+
+    // Квантование атрибутов и упаковка вершин BaseModel в раскладку VertexLayout.
+    // Допуски: позиция — половина шага сетки (GetPositionTolerance), нормаль —
+    // kOctNormalMaxAngle, UV — относительная ошибка half (2^-11), вес — 1/255.
+    namespace VertexQuantization {
+        constexpr float kOctNormalMaxAngle = 2.0e-4f; // Радианы, с точным подбором округления oct16
+
+        std::uint16_t QuantizeUnorm16(float value, float offset, float scale);
+        float DequantizeUnorm16(std::uint16_t value, float offset, float scale);
+
+        void EncodeOctahedral(const glm::vec3& normal, std::int16_t out[2]);
+        glm::vec3 DecodeOctahedral(const std::int16_t encoded[2]);
+
+        std::uint16_t FloatToHalf(float value);
+        float HalfToFloat(std::uint16_t value);
+
+        // Сумма весов после квантования — ровно 255 (метод наибольших остатков).
+        void QuantizeWeights(const float weights[4], std::uint8_t out[4]);
+
+        glm::vec3 GetPositionTolerance(const VertexLayout& layout);
+
+        // Для раскладки с UNorm16x3 по вершинам вычисляются positionOffset/positionScale.
+        // false, если раскладке нужны кости, а их нет или индекс кости не помещается в 8 бит.
+        bool PackVertices(const std::vector<float>& vertices, const std::vector<SkinInfluence>* influences,
+            VertexLayout& layout, std::vector<std::uint8_t>& outData);
+        void UnpackVertices(const std::uint8_t* data, std::size_t vertexCount, const VertexLayout& layout,
+            std::vector<float>& outVertices, std::vector<SkinInfluence>* outInfluences = nullptr);
+    }
+}
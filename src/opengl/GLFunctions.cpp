@@ -1,4 +1,5 @@
 #include "GLFunctions.h"
+#include <cstdlib>
 #include <sstream>
 
 // Объявление указателей на функции
@@ -49,6 +50,8 @@ PFNGLGETBUFFERSUBDATAPROC glGetBufferSubData = nullptr;
 PFNGLUNIFORM1IPROC glUniform1i = nullptr;
 PFNGLGETSTRINGIPROC glGetStringi = nullptr;
 PFNGLDRAWELEMENTSINSTANCEDPROC glDrawElementsInstanced = nullptr;
+PFNGLGETUNIFORMBLOCKINDEXPROC glGetUniformBlockIndex = nullptr;
+PFNGLUNIFORMBLOCKBINDINGPROC glUniformBlockBinding = nullptr;
 
 PFNGLDEBUGMESSAGECALLBACKPROC glDebugMessageCallback = nullptr;
 PFNGLDEBUGMESSAGECONTROLPROC glDebugMessageControl = nullptr;
@@ -79,6 +82,10 @@ PFNGLFRAMEBUFFERTEXTURE2DPROC glFramebufferTexture2D = nullptr;
 PFNGLCHECKFRAMEBUFFERSTATUSPROC glCheckFramebufferStatus = nullptr;
 
 void LoadOpenGLFunctions() {
+#ifdef OGLE_HEADLESS
+    // В headless-сборке нет контекста OpenGL: указатели остаются nullptr.
+    LOG_INFO("Headless build: OpenGL functions are not loaded");
+#else
         // Загрузка функций для работы с буферами
     glGenBuffers = (PFNGLGENBUFFERSPROC)wglGetProcAddress("glGenBuffers");
     CHECK_LOAD_FUNCTION(glGenBuffers);
@@ -177,6 +184,10 @@ void LoadOpenGLFunctions() {
     CHECK_LOAD_FUNCTION(glGetStringi);
     glDrawElementsInstanced = (PFNGLDRAWELEMENTSINSTANCEDPROC)wglGetProcAddress("glDrawElementsInstanced");
     CHECK_LOAD_FUNCTION(glDrawElementsInstanced);
+    glGetUniformBlockIndex = (PFNGLGETUNIFORMBLOCKINDEXPROC)wglGetProcAddress("glGetUniformBlockIndex");
+    CHECK_LOAD_FUNCTION(glGetUniformBlockIndex);
+    glUniformBlockBinding = (PFNGLUNIFORMBLOCKBINDINGPROC)wglGetProcAddress("glUniformBlockBinding");
+    CHECK_LOAD_FUNCTION(glUniformBlockBinding);
 
     glDebugMessageCallback = (PFNGLDEBUGMESSAGECALLBACKPROC)wglGetProcAddress("glDebugMessageCallback");
     CHECK_LOAD_FUNCTION(glDebugMessageCallback);
@@ -233,6 +244,7 @@ void LoadOpenGLFunctions() {
 
 
 
+#endif
 }
 
 void CheckOpenGLError(const char* stmt, const char* fname, int line)
@@ -252,9 +264,11 @@ void CheckOpenGLError(const char* stmt, const char* fname, int line)
         if (errorCount >= 50)
         {
             LOG_ERROR("Достигнуто максимальное количество ошибок. Завершение программы.");
+#ifndef OGLE_HEADLESS
             WCHAR errorMsg[256];
             swprintf_s(errorMsg, L"OpenGL error %08X, at %S:%d - for %S", err, fname, line, stmt);
             MessageBoxW(NULL, errorMsg, L"OpenGL Error", MB_OK | MB_ICONERROR);
+#endif
             exit(EXIT_FAILURE); // Завершаем программу
         }
     }
@@ -2,9 +2,13 @@
 #ifndef GLFUNC_H
 #define GLFUNC_H
 
+#ifdef OGLE_HEADLESS
+#include "HeadlessGL.h"
+#else
 #include <windows.h>
 #include <gl/GL.h>
 #include <GL/glu.h>
+#endif
 
 #include "../Logger.h"
 #include <cstdio> // For swprintf and swprintf_s
@@ -69,6 +73,12 @@
 #ifndef GL_SHADER_STORAGE_BUFFER
 #define GL_SHADER_STORAGE_BUFFER 0x90D2
 #endif
+#ifndef GL_UNIFORM_BUFFER
+#define GL_UNIFORM_BUFFER 0x8A11
+#endif
+#ifndef GL_INVALID_INDEX
+#define GL_INVALID_INDEX 0xFFFFFFFFu
+#endif
 #ifndef GL_DYNAMIC_COPY
 #define GL_DYNAMIC_COPY 0x88EA
 #endif
@@ -139,6 +149,14 @@
 #define GL_ELEMENT_ARRAY_BUFFER 0x8893
 #endif
 
+#ifndef GL_SHORT
+#define GL_SHORT 0x1402
+#endif
+
+#ifndef GL_HALF_FLOAT
+#define GL_HALF_FLOAT 0x140B
+#endif
+
 #ifndef GL_DEBUG_SOURCE_API
 #define GL_DEBUG_SOURCE_API 0x8246
 #endif
@@ -550,6 +568,8 @@ typedef void (APIENTRY* PFNGLGETBUFFERSUBDATAPROC)(GLenum target, GLintptr offse
 typedef void (APIENTRY* PFNGLUNIFORM1IPROC)(GLint location, GLint v0);
 typedef const GLubyte* (APIENTRY* PFNGLGETSTRINGIPROC)(GLenum name, GLuint index);
 typedef void (APIENTRY* PFNGLDRAWELEMENTSINSTANCEDPROC)(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount);
+typedef GLuint (APIENTRY* PFNGLGETUNIFORMBLOCKINDEXPROC)(GLuint program, const GLchar* uniformBlockName);
+typedef void (APIENTRY* PFNGLUNIFORMBLOCKBINDINGPROC)(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding);
 
 // Определение типов для указателей на функции отладки
 typedef void (APIENTRY* GLDEBUGPROC)(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* userParam);
@@ -629,6 +649,8 @@ extern PFNGLGETBUFFERSUBDATAPROC glGetBufferSubData;
 extern PFNGLUNIFORM1IPROC glUniform1i;
 extern PFNGLGETSTRINGIPROC glGetStringi;
 extern PFNGLDRAWELEMENTSINSTANCEDPROC glDrawElementsInstanced;
+extern PFNGLGETUNIFORMBLOCKINDEXPROC glGetUniformBlockIndex;
+extern PFNGLUNIFORMBLOCKBINDINGPROC glUniformBlockBinding;
 
 extern PFNGLDEBUGMESSAGECALLBACKPROC glDebugMessageCallback;
 extern PFNGLDEBUGMESSAGECONTROLPROC glDebugMessageControl;
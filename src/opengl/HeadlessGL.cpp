@@ -0,0 +1,33 @@
+#include "HeadlessGL.h"
+
+GLenum APIENTRY glGetError()
+{
+    return GL_NO_ERROR;
+}
+
+void APIENTRY glDrawElements(GLenum, GLsizei, GLenum, const GLvoid*)
+{
+}
+
+void APIENTRY glGenTextures(GLsizei n, GLuint* textures)
+{
+    for (GLsizei i = 0; i < n; ++i) {
+        textures[i] = 0;
+    }
+}
+
+void APIENTRY glDeleteTextures(GLsizei, const GLuint*)
+{
+}
+
+void APIENTRY glBindTexture(GLenum, GLuint)
+{
+}
+
+void APIENTRY glTexImage2D(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const GLvoid*)
+{
+}
+
+void APIENTRY glTexParameteri(GLenum, GLenum, GLint)
+{
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+// Null OpenGL 1.1 surface for the headless build (OGLE_HEADLESS).
+// Provides the core GL types, the handful of enums the engine uses outside
+// GLFunctions.h and no-op definitions of the GL 1.1 entry points, so the
+// resource classes link without a driver. Extension entry points stay as
+// null pointers in GLFunctions.cpp and must not be called in headless runs.
+
+#include <cstddef>
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+typedef unsigned int GLenum;
+typedef unsigned char GLboolean;
+typedef unsigned int GLbitfield;
+typedef void GLvoid;
+typedef signed char GLbyte;
+typedef short GLshort;
+typedef int GLint;
+typedef unsigned char GLubyte;
+typedef unsigned short GLushort;
+typedef unsigned int GLuint;
+typedef int GLsizei;
+typedef float GLfloat;
+typedef float GLclampf;
+typedef double GLdouble;
+
+#define GL_FALSE 0
+#define GL_TRUE 1
+#define GL_NO_ERROR 0
+#define GL_TRIANGLES 0x0004
+#define GL_UNSIGNED_BYTE 0x1401
+#define GL_UNSIGNED_SHORT 0x1403
+#define GL_UNSIGNED_INT 0x1405
+#define GL_FLOAT 0x1406
+#define GL_TEXTURE_2D 0x0DE1
+#define GL_RED 0x1903
+#define GL_RGB 0x1907
+#define GL_RGBA 0x1908
+#define GL_NEAREST 0x2600
+#define GL_LINEAR 0x2601
+#define GL_LINEAR_MIPMAP_LINEAR 0x2703
+#define GL_TEXTURE_MAG_FILTER 0x2800
+#define GL_TEXTURE_MIN_FILTER 0x2801
+#define GL_TEXTURE_WRAP_S 0x2802
+#define GL_TEXTURE_WRAP_T 0x2803
+#define GL_REPEAT 0x2901
+
+GLenum APIENTRY glGetError();
+void APIENTRY glDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices);
+void APIENTRY glGenTextures(GLsizei n, GLuint* textures);
+void APIENTRY glDeleteTextures(GLsizei n, const GLuint* textures);
+void APIENTRY glBindTexture(GLenum target, GLuint texture);
+void APIENTRY glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid* pixels);
+void APIENTRY glTexParameteri(GLenum target, GLenum pname, GLint param);
@@ -3,15 +3,46 @@
 #include "../managers/WorldManager.h"
 #include "../world/WorldComponents.h"
 #include "../Logger.h"
+#include "../core/JobSystem.h"
+#include "../models/ModelEntity.h"
 #include "../render/ProceduralTexture.h"
+#include "../world/systems/LODSystem.h"
+#include "../world/systems/RenderSystem.h"
 
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <cmath>
+#include <cstddef>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <Windows.h>
 
+namespace {
+    // Hashed at compile time, so the per-frame lookups below never touch a string.
+    constexpr StringId kProgramDefault("default");
+    constexpr StringId kProgramShadowDepth("shadow_depth");
+
+    constexpr StringId kUniformDiffuseTexture("uTexture_diffuse");
+    constexpr StringId kUniformHasDiffuseTexture("uHasTexture_diffuse");
+    constexpr StringId kUniformInstanced("uInstanced");
+    constexpr StringId kUniformLightMVP("uLightMVP");
+    constexpr StringId kUniformMVP("uMVP");
+    constexpr StringId kUniformModel("uModel");
+    constexpr StringId kUniformPositionOffset("uPositionOffset");
+    constexpr StringId kUniformPositionScale("uPositionScale");
+    constexpr StringId kUniformQuantizedVertices("uQuantizedVertices");
+    constexpr StringId kUniformSelectionMix("uSelectionMix");
+    constexpr StringId kUniformShadowMap("uShadowMap");
+    constexpr StringId kUniformSlotBaseColor("uSlotBaseColor");
+
+    // Instance attribute locations; must match default.vs and shadow.vs.
+    constexpr GLuint kInstanceModelLocation = 8; // mat4: 8..11
+    constexpr GLuint kInstanceParamsLocation = 12;
+    // Shorter runs are drawn one by one: a single instance gains nothing.
+    constexpr std::size_t kMinInstanceRun = 2;
+}
+
 OpenGLRenderer::OpenGLRenderer(int width, int height, OGLE::Camera& camera, WorldManager& worldManager)
     : m_shaderManager()
     , m_camera(camera)
@@ -44,6 +75,7 @@ OpenGLRenderer::~OpenGLRenderer()
     if (m_gridIBO != 0) { glDeleteBuffers(1, &m_gridIBO); m_gridIBO = 0; }
     if (m_gizmoVAO != 0) { glDeleteVertexArrays(1, &m_gizmoVAO); m_gizmoVAO = 0; }
     if (m_gizmoVBO != 0) { glDeleteBuffers(1, &m_gizmoVBO); m_gizmoVBO = 0; }
+    if (m_instanceBuffer != 0) { glDeleteBuffers(1, &m_instanceBuffer); m_instanceBuffer = 0; }
 }
 
 bool OpenGLRenderer::Initialize()
@@ -315,6 +347,12 @@ void OpenGLRenderer::Render()
         LOG_ERROR("Pre-clear error");
     }
 
+    // Правки трансформов после World::Update (гизмо, инспектор) попадают в этот же кадр.
+    m_worldManager.GetActiveWorld().UpdateTransforms();
+
+    const glm::mat4 viewProjection = m_camera.GetProjectionMatrix() * m_camera.GetViewMatrix();
+    BuildDrawList(viewProjection);
+
     LightingState lightingState;
     CollectLightingState(lightingState);
     if (lightingState.hasDirectionalLight && lightingState.castsShadows) {
@@ -330,238 +368,397 @@ void OpenGLRenderer::Render()
         RenderGrid();
     }
 
-    if (!m_shaderManager.useProgram("default")) {
-        return;
-    }
-
-    const GLint lightSpaceMatrixLocation = m_shaderManager.getUniformLocation("default", "uLightSpaceMatrix");
-    const GLint viewPositionLocation = m_shaderManager.getUniformLocation("default", "uViewPosition");
-    const GLint hasDirectionalLightLocation = m_shaderManager.getUniformLocation("default", "uHasDirectionalLight");
-    const GLint directionalLightDirectionLocation = m_shaderManager.getUniformLocation("default", "uDirectionalLightDirection");
-    const GLint directionalLightColorLocation = m_shaderManager.getUniformLocation("default", "uDirectionalLightColor");
-    const GLint directionalLightIntensityLocation = m_shaderManager.getUniformLocation("default", "uDirectionalLightIntensity");
-    const GLint directionalLightCastsShadowsLocation = m_shaderManager.getUniformLocation("default", "uDirectionalLightCastsShadows");
-    const GLint pointLightCountLocation = m_shaderManager.getUniformLocation("default", "uPointLightCount");
-    const GLint pointLightPositionsLocation = m_shaderManager.getUniformLocation("default", "uPointLightPositions[0]");
-    const GLint pointLightColorsLocation = m_shaderManager.getUniformLocation("default", "uPointLightColors[0]");
-    const GLint pointLightIntensitiesLocation = m_shaderManager.getUniformLocation("default", "uPointLightIntensities[0]");
-    const GLint pointLightRangesLocation = m_shaderManager.getUniformLocation("default", "uPointLightRanges[0]");
-    const GLint shadowMapLocation = m_shaderManager.getUniformLocation("default", "uShadowMap");
-    const GLint selectionTintLocation = m_shaderManager.getUniformLocation("default", "uSelectionTint");
-    const glm::mat4 viewProjection = m_camera.GetProjectionMatrix() * m_camera.GetViewMatrix();
+    // Lighting and camera state live in uniform blocks shared by every program:
+    // filled once here, they survive the program switches below.
+    UploadFrameUniforms(lightingState, viewProjection);
 
-    if (lightSpaceMatrixLocation >= 0) {
-        glUniformMatrix4fv(lightSpaceMatrixLocation, 1, GL_FALSE, glm::value_ptr(lightingState.lightSpaceMatrix));
-    }
-    if (viewPositionLocation >= 0) {
-        const glm::vec3 cameraPosition = m_camera.GetPosition();
-        glUniform3f(viewPositionLocation, cameraPosition.x, cameraPosition.y, cameraPosition.z);
-    }
-    if (hasDirectionalLightLocation >= 0) {
-        glUniform1i(hasDirectionalLightLocation, lightingState.hasDirectionalLight ? 1 : 0);
-    }
-    if (directionalLightDirectionLocation >= 0) {
-        glUniform3f(
-            directionalLightDirectionLocation,
-            lightingState.directionalDirection.x,
-            lightingState.directionalDirection.y,
-            lightingState.directionalDirection.z);
-    }
-    if (directionalLightColorLocation >= 0) {
-        glUniform3f(
-            directionalLightColorLocation,
-            lightingState.directionalColor.x,
-            lightingState.directionalColor.y,
-            lightingState.directionalColor.z);
-    }
-    if (directionalLightIntensityLocation >= 0) {
-        glUniform1f(directionalLightIntensityLocation, lightingState.directionalIntensity);
-    }
-    if (directionalLightCastsShadowsLocation >= 0) {
-        glUniform1i(directionalLightCastsShadowsLocation, lightingState.castsShadows ? 1 : 0);
-    }
-    if (shadowMapLocation >= 0) {
-        glUniform1i(shadowMapLocation, 2);
+    if (!m_shaderManager.useProgram(kProgramDefault)) {
+        return;
     }
 
     glActiveTexture(GL_TEXTURE2);
     glBindTexture(GL_TEXTURE_2D, m_shadowDepthTexture);
     glActiveTexture(GL_TEXTURE0);
 
-    std::array<glm::vec3, 4> pointLightPositions{};
-    std::array<glm::vec3, 4> pointLightColors{};
-    std::array<float, 4> pointLightIntensities{};
-    std::array<float, 4> pointLightRanges{};
-    int pointLightCount = 0;
-
-    auto SetProgramGlobalUniforms = [&](const std::string& programName) {
-        const GLint hasDirectionalLightLocation = m_shaderManager.getUniformLocation(programName, "uHasDirectionalLight");
-        const GLint directionalLightDirectionLocation = m_shaderManager.getUniformLocation(programName, "uDirectionalLightDirection");
-        const GLint directionalLightColorLocation = m_shaderManager.getUniformLocation(programName, "uDirectionalLightColor");
-        const GLint directionalLightIntensityLocation = m_shaderManager.getUniformLocation(programName, "uDirectionalLightIntensity");
-        const GLint directionalLightCastsShadowsLocation = m_shaderManager.getUniformLocation(programName, "uDirectionalLightCastsShadows");
-        const GLint pointLightCountLocation = m_shaderManager.getUniformLocation(programName, "uPointLightCount");
-        const GLint pointLightPositionsLocation = m_shaderManager.getUniformLocation(programName, "uPointLightPositions[0]");
-        const GLint pointLightColorsLocation = m_shaderManager.getUniformLocation(programName, "uPointLightColors[0]");
-        const GLint pointLightIntensitiesLocation = m_shaderManager.getUniformLocation(programName, "uPointLightIntensities[0]");
-        const GLint pointLightRangesLocation = m_shaderManager.getUniformLocation(programName, "uPointLightRanges[0]");
-        const GLint shadowMapLocationLocal = m_shaderManager.getUniformLocation(programName, "uShadowMap");
-        const GLint viewPositionLocationLocal = m_shaderManager.getUniformLocation(programName, "uViewPosition");
-
-        if (shadowMapLocationLocal >= 0) {
-            glUniform1i(shadowMapLocationLocal, 2);
-        }
-        if (viewPositionLocationLocal >= 0) {
-            const glm::vec3 cameraPosition = m_camera.GetPosition();
-            glUniform3f(viewPositionLocationLocal, cameraPosition.x, cameraPosition.y, cameraPosition.z);
-        }
-        if (hasDirectionalLightLocation >= 0) {
-            glUniform1i(hasDirectionalLightLocation, lightingState.hasDirectionalLight ? 1 : 0);
-        }
-        if (directionalLightDirectionLocation >= 0) {
-            glUniform3f(
-                directionalLightDirectionLocation,
-                lightingState.directionalDirection.x,
-                lightingState.directionalDirection.y,
-                lightingState.directionalDirection.z);
-        }
-        if (directionalLightColorLocation >= 0) {
-            glUniform3f(
-                directionalLightColorLocation,
-                lightingState.directionalColor.x,
-                lightingState.directionalColor.y,
-                lightingState.directionalColor.z);
-        }
-        if (directionalLightIntensityLocation >= 0) {
-            glUniform1f(directionalLightIntensityLocation, lightingState.directionalIntensity);
-        }
-        if (directionalLightCastsShadowsLocation >= 0) {
-            glUniform1i(directionalLightCastsShadowsLocation, lightingState.castsShadows ? 1 : 0);
-        }
-        if (pointLightCountLocation >= 0) {
-            glUniform1i(pointLightCountLocation, pointLightCount);
-        }
-        if (pointLightPositionsLocation >= 0 && pointLightCount > 0) {
-            glUniform3fv(pointLightPositionsLocation, pointLightCount, glm::value_ptr(pointLightPositions[0]));
-        }
-        if (pointLightColorsLocation >= 0 && pointLightCount > 0) {
-            glUniform3fv(pointLightColorsLocation, pointLightCount, glm::value_ptr(pointLightColors[0]));
-        }
-        if (pointLightIntensitiesLocation >= 0 && pointLightCount > 0) {
-            glUniform1fv(pointLightIntensitiesLocation, pointLightCount, pointLightIntensities.data());
-        }
-        if (pointLightRangesLocation >= 0 && pointLightCount > 0) {
-            glUniform1fv(pointLightRangesLocation, pointLightCount, pointLightRanges.data());
+    // Samplers cannot live in a uniform block: point uShadowMap at unit 2 per program.
+    auto SetProgramGlobalUniforms = [&](StringId programId) {
+        const GLint shadowMapLocation = m_shaderManager.getUniformLocation(programId, kUniformShadowMap);
+        if (shadowMapLocation >= 0) {
+            glUniform1i(shadowMapLocation, 2);
         }
     };
 
-    auto lightView = m_worldManager.GetActiveWorld().GetRegistry().view<OGLE::WorldObjectComponent, OGLE::TransformComponent, OGLE::LightComponent>();
-    for (auto entity : lightView) {
-        const auto& worldObject = lightView.get<OGLE::WorldObjectComponent>(entity);
-        const auto& transform = lightView.get<OGLE::TransformComponent>(entity);
-        const auto& light = lightView.get<OGLE::LightComponent>(entity);
-        if (!worldObject.enabled || light.type != OGLE::LightType::Point) {
-            continue;
+    StringId currentProgram = kProgramDefault;
+    SetProgramGlobalUniforms(currentProgram);
+
+    // The queue is sorted by program, material, mesh and depth: state is only
+    // changed when it differs from the previous item. Uniforms are per program,
+    // so a program switch invalidates the bound material and layout uniforms.
+    // Runs sharing program, material state and mesh are drawn as one instanced
+    // call when the program declares uInstanced.
+    m_renderStats = OGLE::RenderQueueStats{};
+    m_renderStats.drawItems = static_cast<std::uint32_t>(m_renderQueue.GetSize());
+    std::uint64_t boundMaterialHash = 0;
+    const OGLE::MeshBuffer* boundMesh = nullptr;
+    const OGLE::MeshBuffer* layoutMesh = nullptr;
+    // Per-item uniform locations, looked up once per program (-2: not looked up yet).
+    GLint locationMVP = -2;
+    GLint locationModel = -1;
+    GLint locationSelectionMix = -1;
+    GLint locationInstanced = -1;
+    bool instancedMode = false;
+    const std::vector<OGLE::RenderQueue::Entry>& entries = m_renderQueue.GetEntries();
+    for (std::size_t index = 0; index < entries.size();) {
+        const DrawItem& item = m_drawItems[entries[index].item];
+
+        if (item.program != currentProgram) {
+            if (m_shaderManager.useProgram(item.program)) {
+                currentProgram = item.program;
+            } else {
+                m_shaderManager.useProgram(kProgramDefault);
+                currentProgram = kProgramDefault;
+            }
+            SetProgramGlobalUniforms(currentProgram);
+            ++m_renderStats.programSwitches;
+            boundMaterialHash = 0;
+            layoutMesh = nullptr;
+            locationMVP = -2;
         }
-        if (pointLightCount >= static_cast<int>(pointLightPositions.size())) {
-            break;
+
+        if (locationMVP == -2) {
+            locationMVP = m_shaderManager.getUniformLocation(currentProgram, kUniformMVP);
+            locationModel = m_shaderManager.getUniformLocation(currentProgram, kUniformModel);
+            locationSelectionMix = m_shaderManager.getUniformLocation(currentProgram, kUniformSelectionMix);
+            locationInstanced = m_shaderManager.getUniformLocation(currentProgram, kUniformInstanced);
+            if (locationInstanced >= 0) {
+                glUniform1i(locationInstanced, 0);
+            }
+            instancedMode = false;
         }
 
-        pointLightPositions[pointLightCount] = transform.position;
-        pointLightColors[pointLightCount] = light.color;
-        pointLightIntensities[pointLightCount] = light.intensity;
-        pointLightRanges[pointLightCount] = light.range;
-        ++pointLightCount;
-    }
+        if (item.mesh && item.mesh != layoutMesh) {
+            SetVertexLayoutUniforms(currentProgram, item.mesh->GetLayout());
+            layoutMesh = item.mesh;
+        }
+
+        if (item.material && item.materialHash != 0 && item.materialHash != boundMaterialHash) {
+            item.material->Bind();
+            boundMaterialHash = item.materialHash;
+            ++m_renderStats.materialBinds;
+        }
 
-    if (pointLightCountLocation >= 0) {
-        glUniform1i(pointLightCountLocation, pointLightCount);
+        const std::size_t runEnd = locationInstanced >= 0 ? FindInstanceRun(index, true) : index + 1;
+        if (runEnd - index >= kMinInstanceRun) {
+            if (item.mesh != boundMesh) {
+                if (!item.mesh->Bind()) {
+                    index = runEnd;
+                    continue;
+                }
+                boundMesh = item.mesh;
+                ++m_renderStats.meshBinds;
+            }
+            if (!instancedMode) {
+                glUniform1i(locationInstanced, 1);
+                instancedMode = true;
+            }
+            SetInstanceAttributes(index);
+            item.mesh->DrawBoundInstanced(static_cast<GLsizei>(runEnd - index));
+            ClearInstanceAttributes();
+            ++m_renderStats.drawCalls;
+            ++m_renderStats.instanceBatches;
+            index = runEnd;
+            continue;
+        }
+        ++index;
+
+        if (instancedMode) {
+            glUniform1i(locationInstanced, 0);
+            instancedMode = false;
+        }
+        if (locationMVP >= 0) {
+            glUniformMatrix4fv(locationMVP, 1, GL_FALSE, glm::value_ptr(item.mvp));
+        }
+        if (locationModel >= 0) {
+            glUniformMatrix4fv(locationModel, 1, GL_FALSE, glm::value_ptr(*item.world));
+        }
+        if (locationSelectionMix >= 0) {
+            glUniform1f(locationSelectionMix, item.entity == m_highlightedEntity ? 0.45f : 0.0f);
+        }
+
+        if (item.mesh && item.model->GetSubmeshes(item.lodLevel).size() > 1) {
+            // DrawRange binds and unbinds the VAO itself.
+            if (boundMesh) {
+                OGLE::MeshBuffer::Unbind();
+                boundMesh = nullptr;
+            }
+            DrawSubmeshes(item, currentProgram);
+            ++m_renderStats.meshBinds;
+        } else if (item.mesh) {
+            if (item.mesh != boundMesh) {
+                if (!item.mesh->Bind()) {
+                    continue;
+                }
+                boundMesh = item.mesh;
+                ++m_renderStats.meshBinds;
+            }
+            item.mesh->DrawBound();
+            ++m_renderStats.drawCalls;
+        }
     }
-    if (pointLightPositionsLocation >= 0 && pointLightCount > 0) {
-        glUniform3fv(pointLightPositionsLocation, pointLightCount, glm::value_ptr(pointLightPositions[0]));
+    if (boundMesh) {
+        OGLE::MeshBuffer::Unbind();
     }
-    if (pointLightColorsLocation >= 0 && pointLightCount > 0) {
-        glUniform3fv(pointLightColorsLocation, pointLightCount, glm::value_ptr(pointLightColors[0]));
+
+    if (m_showGrid) {
+        RenderGizmo();
     }
-    if (pointLightIntensitiesLocation >= 0 && pointLightCount > 0) {
-        glUniform1fv(pointLightIntensitiesLocation, pointLightCount, pointLightIntensities.data());
+
+    // Viewport уже установлен в начале метода Render
+
+    if (glGetError() != GL_NO_ERROR) {
+        LOG_ERROR("Post-draw error");
     }
-    if (pointLightRangesLocation >= 0 && pointLightCount > 0) {
-        glUniform1fv(pointLightRangesLocation, pointLightCount, pointLightRanges.data());
+}
+
+void OpenGLRenderer::SetVertexLayoutUniforms(StringId programId, const OGLE::VertexLayout& layout)
+{
+    // Programs without these uniforms never see a quantized buffer: BuildDrawList gives
+    // their items the mesh's Float32 copy (MeshBuffer::GetFloat32Buffer).
+    const GLint quantizedLocation = m_shaderManager.getUniformLocation(programId, kUniformQuantizedVertices);
+    if (quantizedLocation < 0) {
+        return;
     }
-    if (selectionTintLocation >= 0) {
-        glUniform3f(selectionTintLocation, 1.0f, 0.85f, 0.2f);
+    glUniform1i(quantizedLocation, layout.IsQuantized() ? 1 : 0);
+    if (layout.IsQuantized()) {
+        const GLint offsetLocation = m_shaderManager.getUniformLocation(programId, kUniformPositionOffset);
+        const GLint scaleLocation = m_shaderManager.getUniformLocation(programId, kUniformPositionScale);
+        if (offsetLocation >= 0) {
+            glUniform3fv(offsetLocation, 1, glm::value_ptr(layout.positionOffset));
+        }
+        if (scaleLocation >= 0) {
+            glUniform3fv(scaleLocation, 1, glm::value_ptr(layout.positionScale));
+        }
     }
+}
 
-    // Default program gets initial lighting and scene uniforms.
-    std::string currentProgramName = "default";
-    SetProgramGlobalUniforms(currentProgramName);
-
-    auto worldView = m_worldManager.GetActiveWorld().GetRegistry().view<OGLE::WorldObjectComponent, OGLE::ModelComponent>();
-    for (auto entity : worldView) {
-        auto& worldObjectComponent = worldView.get<OGLE::WorldObjectComponent>(entity);
-        auto& modelComponent = worldView.get<OGLE::ModelComponent>(entity);
-        if (!worldObjectComponent.enabled || !worldObjectComponent.visible || !modelComponent.model) {
+void OpenGLRenderer::DrawSubmeshes(const DrawItem& item, StringId programId)
+{
+    // Material slots tint the entity material's color (uSlotBaseColor, outside the
+    // material block) and override its diffuse texture on a dedicated unit, so the
+    // entity material still selects the program and the rest.
+    constexpr GLint kSubmeshTextureUnit = 3;
+    const GLint slotColorLocation = m_shaderManager.getUniformLocation(programId, kUniformSlotBaseColor);
+    const GLint diffuseLocation = m_shaderManager.getUniformLocation(programId, kUniformDiffuseTexture);
+    const GLint hasDiffuseLocation = m_shaderManager.getUniformLocation(programId, kUniformHasDiffuseTexture);
+    const std::vector<OGLE::MeshMaterialSlot>& slots = item.model->GetMaterialSlots();
+
+    const glm::mat4& modelMatrix = *item.world;
+    const float maxScale = std::sqrt(std::max({
+        glm::dot(glm::vec3(modelMatrix[0]), glm::vec3(modelMatrix[0])),
+        glm::dot(glm::vec3(modelMatrix[1]), glm::vec3(modelMatrix[1])),
+        glm::dot(glm::vec3(modelMatrix[2]), glm::vec3(modelMatrix[2]))}));
+
+    int boundSlot = -1;
+    for (const OGLE::MeshSubmesh& submesh : item.model->GetSubmeshes(item.lodLevel)) {
+        if (submesh.indexCount == 0) {
             continue;
         }
-
-        const OGLE::Material* materialForRender = nullptr;
-        if (const OGLE::MaterialComponent* materialComponent = m_worldManager.GetActiveWorld().GetMaterial(entity)) {
-            materialForRender = &materialComponent->material;
-        } else {
-            materialForRender = &modelComponent.model->GetMaterial();
+        if (submesh.bounds.valid) {
+            const glm::vec3 center = glm::vec3(modelMatrix * glm::vec4(submesh.bounds.center, 1.0f));
+            if (!m_camera.IsInFrustum(center, submesh.bounds.radius * maxScale)) {
+                continue;
+            }
         }
 
-        std::string requestedProgramName = "default";
-        if (const OGLE::ShaderComponent* shaderComp = m_worldManager.GetActiveWorld().GetShader(entity)) {
-            requestedProgramName = shaderComp->programName.empty() ? "default" : shaderComp->programName;
-        } else if (materialForRender && !materialForRender->GetShaderProgram().empty()) {
-            requestedProgramName = materialForRender->GetShaderProgram();
+        // Submeshes of one material are usually adjacent: rebind only on change.
+        if (submesh.materialIndex != boundSlot && submesh.materialIndex >= 0
+            && static_cast<std::size_t>(submesh.materialIndex) < slots.size()) {
+            boundSlot = submesh.materialIndex;
+            if (slotColorLocation >= 0) {
+                glUniform3fv(slotColorLocation, 1, glm::value_ptr(slots[boundSlot].baseColor));
+            }
+            const OGLE::Texture2D* texture = item.model->GetMaterialTexture(boundSlot);
+            const bool hasTexture = texture && texture->IsValid();
+            if (hasTexture) {
+                glActiveTexture(GL_TEXTURE0 + kSubmeshTextureUnit);
+                glBindTexture(GL_TEXTURE_2D, texture->GetTextureId());
+                glActiveTexture(GL_TEXTURE0);
+                if (diffuseLocation >= 0) {
+                    glUniform1i(diffuseLocation, kSubmeshTextureUnit);
+                }
+            }
+            if (hasDiffuseLocation >= 0) {
+                glUniform1i(hasDiffuseLocation, hasTexture ? 1 : 0);
+            }
         }
+        // item.mesh, not the model's buffer: it may be the Float32 copy for this program.
+        item.mesh->DrawRange(submesh.indexOffset, submesh.indexCount);
+        ++m_renderStats.drawCalls;
+    }
 
-        if (!m_shaderManager.hasProgram(requestedProgramName)) {
-            requestedProgramName = "default";
+    // The next item must not inherit the slot overrides.
+    if (boundSlot >= 0) {
+        if (item.material) {
+            item.material->Bind();
+            ++m_renderStats.materialBinds;
+        }
+        if (slotColorLocation >= 0) {
+            glUniform3f(slotColorLocation, 1.0f, 1.0f, 1.0f);
         }
+        if (hasDiffuseLocation >= 0 && !(item.material && item.material->GetTexture("diffuse"))) {
+            glUniform1i(hasDiffuseLocation, 0);
+        }
+    }
+}
 
-        if (requestedProgramName != currentProgramName) {
-            if (!m_shaderManager.useProgram(requestedProgramName)) {
-                m_shaderManager.useProgram("default");
-                requestedProgramName = "default";
-            }
-            currentProgramName = requestedProgramName;
-            SetProgramGlobalUniforms(currentProgramName);
+void OpenGLRenderer::BuildDrawList(const glm::mat4& viewProjection)
+{
+    const OGLE::RenderProxies& proxies = m_worldManager.GetActiveWorld().GetRenderProxies();
+    const glm::vec3 cameraPosition = m_camera.GetPosition();
+    const float projectionScaleY = m_camera.GetProjectionMatrix()[1][1];
+
+    // Proxies name their program by string: hash and resolve it only when a model,
+    // material or program binding changed, not per item per frame.
+    if (proxies.bindingRevision != m_proxyProgramRevision || m_proxyPrograms.size() != proxies.size()) {
+        const GLuint defaultProgram = m_shaderManager.getProgram(kProgramDefault);
+        m_proxyProgramIds.resize(proxies.size());
+        m_proxyPrograms.resize(proxies.size());
+        m_proxyDecodesQuantized.resize(proxies.size());
+        for (std::size_t i = 0; i < proxies.size(); ++i) {
+            const std::string* programName = proxies.programNames[i];
+            const StringId programId = programName ? StringId(*programName) : kProgramDefault;
+            const GLuint program = m_shaderManager.getProgram(programId);
+            m_proxyProgramIds[i] = program != 0 ? programId : kProgramDefault;
+            m_proxyPrograms[i] = program != 0 ? program : defaultProgram;
+            m_proxyDecodesQuantized[i] = m_shaderManager.getUniformLocation(m_proxyProgramIds[i], kUniformQuantizedVertices) >= 0 ? 1 : 0;
         }
+        m_proxyProgramRevision = proxies.bindingRevision;
+    }
+
+    // One slot per proxy; the passes only read the proxy arrays, never the registry.
+    m_drawItems.resize(proxies.size());
+    JobSystem::Instance().ParallelFor(proxies.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            DrawItem& item = m_drawItems[i];
+            item = DrawItem{};
+            item.entity = proxies.entities[i];
+            if (!(proxies.flags[i] & OGLE::RenderProxies::Visible)) {
+                continue;
+            }
 
-        const GLint locationMVP = m_shaderManager.getUniformLocation(currentProgramName, "uMVP");
-        const GLint locationModel = m_shaderManager.getUniformLocation(currentProgramName, "uModel");
-        const GLint locationSelectionMix = m_shaderManager.getUniformLocation(currentProgramName, "uSelectionMix");
+            item.model = proxies.models[i];
+            item.material = proxies.materials[i];
+            item.program = m_proxyProgramIds[i];
+            item.world = &proxies.worldMatrices[i];
+            item.mvp = viewProjection * proxies.worldMatrices[i];
+
+            // Each entity owns its LODComponent, so the parallel write is race-free.
+            const OGLE::MeshLODChain* lodChain = item.model->GetLODs();
+            if (lodChain && proxies.lods[i]) {
+                item.lodLevel = OGLE::LODSystem::Update(
+                    *proxies.lods[i], *lodChain, proxies.worldMatrices[i], cameraPosition, projectionScaleY);
+            }
+            item.mesh = item.model->GetLODBuffer(item.lodLevel);
 
-        if (locationMVP >= 0) {
-            const glm::mat4 mvp = viewProjection * modelComponent.model->GetModelMatrix();
-            glUniformMatrix4fv(locationMVP, 1, GL_FALSE, glm::value_ptr(mvp));
+            // Clip-space w of the bounds center is its distance along the view axis.
+            const glm::vec4& bounds = proxies.bounds[i];
+            item.viewDepth = (viewProjection * glm::vec4(glm::vec3(bounds), 1.0f)).w;
         }
-        if (locationModel >= 0) {
-            glUniformMatrix4fv(locationModel, 1, GL_FALSE, glm::value_ptr(modelComponent.model->GetModelMatrix()));
+    }, JobSystem::ChunkSizeFor(sizeof(DrawItem)));
+
+    // Serial: materials may be shared between items and cache their hash on first use,
+    // and Float32 copies of quantized meshes are created here, on the GL thread.
+    m_renderQueue.Clear();
+    m_renderQueue.Reserve(m_drawItems.size());
+    for (std::size_t i = 0; i < m_drawItems.size(); ++i) {
+        DrawItem& item = m_drawItems[i];
+        if (!item.model) {
+            continue;
         }
-        if (locationSelectionMix >= 0) {
-            glUniform1f(locationSelectionMix, entity == m_highlightedEntity ? 0.45f : 0.0f);
+        // Programs without uQuantizedVertices (ShaderComponent, custom materials) read
+        // positions and normals as floats and get the mesh's Float32 copy instead.
+        if (item.mesh && item.mesh->GetLayout().IsQuantized() && !m_proxyDecodesQuantized[i]) {
+            item.mesh = item.model->GetFloat32LODBuffer(item.lodLevel);
         }
+        item.materialHash = item.material->GetStateHash();
+        m_renderQueue.Push(
+            OGLE::RenderQueue::MakeKey(
+                m_proxyPrograms[i], item.materialHash, reinterpret_cast<std::uintptr_t>(item.mesh) >> 4, item.viewDepth),
+            static_cast<std::uint32_t>(i));
+    }
+    m_renderQueue.Sort();
+    UploadInstanceData();
+}
 
-        if (materialForRender) {
-            materialForRender->Bind();// materialForRender->Bind(programHandle);
-        }
+void OpenGLRenderer::UploadInstanceData()
+{
+    const std::vector<OGLE::RenderQueue::Entry>& entries = m_renderQueue.GetEntries();
+    m_instanceData.resize(entries.size());
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        const DrawItem& item = m_drawItems[entries[i].item];
+        m_instanceData[i].model = *item.world;
+        m_instanceData[i].params = glm::vec4(item.entity == m_highlightedEntity ? 0.45f : 0.0f, 0.0f, 0.0f, 0.0f);
+    }
+    if (m_instanceData.empty()) {
+        return;
+    }
 
-        modelComponent.model->Draw();
+    if (m_instanceBuffer == 0) {
+        glGenBuffers(1, &m_instanceBuffer);
     }
+    // Respecifying the whole store orphans last frame's data instead of waiting for it.
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_instanceData.size() * sizeof(InstanceData)), m_instanceData.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
 
-    if (m_showGrid) {
-        RenderGizmo();
+std::size_t OpenGLRenderer::FindInstanceRun(std::size_t begin, bool matchMaterial) const
+{
+    const std::vector<OGLE::RenderQueue::Entry>& entries = m_renderQueue.GetEntries();
+    const DrawItem& first = m_drawItems[entries[begin].item];
+    // Multi-range meshes swap slot materials between ranges and stay on DrawSubmeshes.
+    if (!first.mesh || first.model->GetSubmeshes(first.lodLevel).size() > 1) {
+        return begin + 1;
     }
 
-    // Viewport уже установлен в начале метода Render
+    std::size_t end = begin + 1;
+    while (end < entries.size()) {
+        const DrawItem& next = m_drawItems[entries[end].item];
+        if (next.mesh != first.mesh) {
+            break;
+        }
+        if (matchMaterial && (next.program != first.program || next.materialHash != first.materialHash)) {
+            break;
+        }
+        ++end;
+    }
+    return end;
+}
 
-    if (glGetError() != GL_NO_ERROR) {
-        LOG_ERROR("Post-draw error");
+void OpenGLRenderer::SetInstanceAttributes(std::size_t firstInstance)
+{
+    // Attribute pointers are VAO state: set on the bound mesh VAO for this run only,
+    // then disabled again so plain draws of the same VAO never read the instance buffer.
+    const std::uintptr_t base = firstInstance * sizeof(InstanceData);
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+    for (GLuint column = 0; column < 4; ++column) {
+        const GLuint location = kInstanceModelLocation + column;
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+            reinterpret_cast<const void*>(base + column * sizeof(glm::vec4)));
+        glVertexAttribDivisor(location, 1);
+    }
+    glEnableVertexAttribArray(kInstanceParamsLocation);
+    glVertexAttribPointer(kInstanceParamsLocation, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+        reinterpret_cast<const void*>(base + offsetof(InstanceData, params)));
+    glVertexAttribDivisor(kInstanceParamsLocation, 1);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void OpenGLRenderer::ClearInstanceAttributes()
+{
+    for (GLuint location = kInstanceModelLocation; location <= kInstanceParamsLocation; ++location) {
+        glDisableVertexAttribArray(location);
     }
 }
 
@@ -612,24 +809,35 @@ glm::vec3 OpenGLRenderer::RotationToDirection(const glm::vec3& rotationDegrees)
 
 void OpenGLRenderer::CollectLightingState(LightingState& lightingState)
 {
+    // Point lights are collected in the same walk, so the loop no longer stops at the primary light.
+    bool primaryFound = false;
     auto lightView = m_worldManager.GetActiveWorld().GetRegistry().view<OGLE::WorldObjectComponent, OGLE::TransformComponent, OGLE::LightComponent>();
     for (auto entity : lightView) {
         const auto& worldObject = lightView.get<OGLE::WorldObjectComponent>(entity);
         const auto& transform = lightView.get<OGLE::TransformComponent>(entity);
         const auto& light = lightView.get<OGLE::LightComponent>(entity);
-        if (!worldObject.enabled || light.type != OGLE::LightType::Directional) {
+        if (!worldObject.enabled) {
+            continue;
+        }
+        if (light.type == OGLE::LightType::Point) {
+            if (lightingState.pointLightCount < LightingState::kMaxPointLights) {
+                const int index = lightingState.pointLightCount++;
+                lightingState.pointLightPositionRange[index] = glm::vec4(transform.position, light.range);
+                lightingState.pointLightColorIntensity[index] = glm::vec4(light.color, light.intensity);
+            }
+            continue;
+        }
+        if (light.type != OGLE::LightType::Directional) {
             continue;
         }
 
-        if (!lightingState.hasDirectionalLight || light.primary) {
+        if (!primaryFound && (!lightingState.hasDirectionalLight || light.primary)) {
             lightingState.hasDirectionalLight = true;
             lightingState.directionalDirection = RotationToDirection(transform.rotation);
             lightingState.directionalColor = light.color;
             lightingState.directionalIntensity = light.intensity;
             lightingState.castsShadows = light.castShadows;
-            if (light.primary) {
-                break;
-            }
+            primaryFound = light.primary;
         }
     }
 
@@ -648,37 +856,92 @@ void OpenGLRenderer::CollectLightingState(LightingState& lightingState)
     lightingState.lightSpaceMatrix = lightProjectionMatrix * lightViewMatrix;
 }
 
+void OpenGLRenderer::UploadFrameUniforms(const LightingState& lightingState, const glm::mat4& viewProjection)
+{
+    // Member order and types must match FrameBlock and LightBlock in default.vs/default.fs.
+    m_uniformWriter.Clear();
+    m_uniformWriter.Write(lightingState.lightSpaceMatrix);
+    m_uniformWriter.Write(m_camera.GetPosition());
+    m_uniformWriter.Write(lightingState.hasDirectionalLight);
+    m_uniformWriter.Write(lightingState.directionalDirection);
+    m_uniformWriter.Write(lightingState.directionalIntensity);
+    m_uniformWriter.Write(lightingState.directionalColor);
+    m_uniformWriter.Write(lightingState.castsShadows);
+    m_uniformWriter.Write(glm::vec3(1.0f, 0.85f, 0.2f)); // uSelectionTint
+    m_uniformWriter.Write(viewProjection);
+    m_frameUniforms.Upload(m_uniformWriter);
+    m_frameUniforms.Bind(OGLE::UniformBlockBinding::Frame);
+
+    m_uniformWriter.Clear();
+    m_uniformWriter.WriteArray(lightingState.pointLightPositionRange.data(), lightingState.pointLightPositionRange.size());
+    m_uniformWriter.WriteArray(lightingState.pointLightColorIntensity.data(), lightingState.pointLightColorIntensity.size());
+    m_uniformWriter.Write(static_cast<std::int32_t>(lightingState.pointLightCount));
+    m_lightUniforms.Upload(m_uniformWriter);
+    m_lightUniforms.Bind(OGLE::UniformBlockBinding::Lights);
+}
+
 void OpenGLRenderer::RenderShadowPass(const LightingState& lightingState)
 {
-    if (m_shadowFramebuffer == 0 || !m_shaderManager.useProgram("shadow_depth")) {
+    if (m_shadowFramebuffer == 0 || !m_shaderManager.useProgram(kProgramShadowDepth)) {
         return;
     }
 
-    const GLuint program = m_shaderManager.getProgram("shadow_depth");
-    const GLint lightMvpLocation = m_shaderManager.getUniformLocation("shadow_depth", "uLightMVP");
-    const GLint modelLocation = m_shaderManager.getUniformLocation("shadow_depth", "uModel");
+    const GLint lightMvpLocation = m_shaderManager.getUniformLocation(kProgramShadowDepth, kUniformLightMVP);
+    const GLint modelLocation = m_shaderManager.getUniformLocation(kProgramShadowDepth, kUniformModel);
+    const GLint instancedLocation = m_shaderManager.getUniformLocation(kProgramShadowDepth, kUniformInstanced);
 
     glViewport(0, 0, m_shadowMapSize, m_shadowMapSize);
     glBindFramebuffer(GL_FRAMEBUFFER, m_shadowFramebuffer);
     glClear(GL_DEPTH_BUFFER_BIT);
     glCullFace(GL_FRONT);
 
-    auto worldView = m_worldManager.GetActiveWorld().GetRegistry().view<OGLE::WorldObjectComponent, OGLE::ModelComponent>();
-    for (auto entity : worldView) {
-        const auto& worldObjectComponent = worldView.get<OGLE::WorldObjectComponent>(entity);
-        const auto& modelComponent = worldView.get<OGLE::ModelComponent>(entity);
-        if (!worldObjectComponent.enabled || !worldObjectComponent.visible || !modelComponent.model) {
+    if (lightMvpLocation >= 0) {
+        glUniformMatrix4fv(lightMvpLocation, 1, GL_FALSE, glm::value_ptr(lightingState.lightSpaceMatrix));
+    }
+    if (instancedLocation >= 0) {
+        glUniform1i(instancedLocation, 0);
+    }
+
+    // Queue order keeps items of one mesh adjacent. The depth pass binds no
+    // material, so a run only needs the same mesh.
+    bool instancedMode = false;
+    const std::vector<OGLE::RenderQueue::Entry>& entries = m_renderQueue.GetEntries();
+    for (std::size_t index = 0; index < entries.size();) {
+        const DrawItem& item = m_drawItems[entries[index].item];
+        if (!item.mesh) {
+            ++index;
             continue;
         }
+        SetVertexLayoutUniforms(kProgramShadowDepth, item.mesh->GetLayout());
+
+        const std::size_t runEnd = instancedLocation >= 0 ? FindInstanceRun(index, false) : index + 1;
+        if (runEnd - index >= kMinInstanceRun) {
+            if (item.mesh->Bind()) {
+                if (!instancedMode) {
+                    glUniform1i(instancedLocation, 1);
+                    instancedMode = true;
+                }
+                SetInstanceAttributes(index);
+                item.mesh->DrawBoundInstanced(static_cast<GLsizei>(runEnd - index));
+                ClearInstanceAttributes();
+                OGLE::MeshBuffer::Unbind();
+            }
+            index = runEnd;
+            continue;
+        }
+        ++index;
 
-        if (lightMvpLocation >= 0) {
-            glUniformMatrix4fv(lightMvpLocation, 1, GL_FALSE, glm::value_ptr(lightingState.lightSpaceMatrix));
+        if (instancedMode) {
+            glUniform1i(instancedLocation, 0);
+            instancedMode = false;
         }
         if (modelLocation >= 0) {
-            glUniformMatrix4fv(modelLocation, 1, GL_FALSE, glm::value_ptr(modelComponent.model->GetModelMatrix()));
+            glUniformMatrix4fv(modelLocation, 1, GL_FALSE, glm::value_ptr(*item.world));
         }
-
-        modelComponent.model->Draw();
+        item.mesh->Draw();
+    }
+    if (instancedMode) {
+        glUniform1i(instancedLocation, 0);
     }
 
     glCullFace(GL_BACK);
@@ -4,11 +4,18 @@
 
 #include "GLFunctions.h"
 #include "ShaderManager.h"
+#include "UniformBuffer.h"
+#include "../render/RenderQueue.h"
 #include "../world/WorldComponents.h"
 #include <glm/mat4x4.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 // Needed for std::chrono::steady_clock used in the implementation
 #include <chrono>
 
@@ -18,6 +25,9 @@ namespace OGLE {
 
 namespace OGLE {
     class World;
+    class MeshBuffer;
+    class ModelEntity;
+    struct VertexLayout;
     using Entity = entt::entity;
 }
 
@@ -35,6 +45,8 @@ public:
     void SetShowGrid(bool show) { m_showGrid = show; }
     bool IsGridVisible() const { return m_showGrid; }
     void SetSceneViewport(const glm::vec2& origin, const glm::vec2& size);
+    // State changes of the last main pass (program switches, material and mesh binds).
+    const OGLE::RenderQueueStats& GetRenderStats() const { return m_renderStats; }
 
 private:
     struct LightingState {
@@ -44,11 +56,47 @@ private:
         float directionalIntensity = 1.5f;
         bool castsShadows = false;
         glm::mat4 lightSpaceMatrix{ 1.0f };
+
+        static constexpr int kMaxPointLights = 4; // uPointLight* array size in default.fs
+        int pointLightCount = 0;
+        std::array<glm::vec4, kMaxPointLights> pointLightPositionRange{};  // xyz: position, w: range
+        std::array<glm::vec4, kMaxPointLights> pointLightColorIntensity{}; // rgb: color, a: intensity
+    };
+
+    // A visible model of the current frame, built in parallel from the world's
+    // RenderProxies (one slot per proxy). The main pass submits the list in
+    // m_renderQueue order, and so does the shadow pass.
+    struct DrawItem {
+        OGLE::Entity entity = entt::null;
+        OGLE::ModelEntity* model = nullptr;           // nullptr: skipped this frame
+        const OGLE::Material* material = nullptr;
+        StringId program;                             // Linked program; unknown names resolve to "default"
+        const OGLE::MeshBuffer* mesh = nullptr;       // Buffer of lodLevel, Float32 copy if program can't decode it
+        const glm::mat4* world = nullptr;             // RenderProxies::worldMatrices
+        std::uint64_t materialHash = 0;               // Material::GetStateHash, 0: Bind is a no-op
+        float viewDepth = 0.0f;                       // Bounds center along the view axis
+        int lodLevel = 0;                             // 0: full mesh, see LODSystem
+        glm::mat4 mvp{ 1.0f };
+    };
+
+    // Per-instance vertex attributes (locations 8-12 in default.vs and shadow.vs),
+    // one per queue entry, streamed to m_instanceBuffer in queue order.
+    struct InstanceData {
+        glm::mat4 model{ 1.0f };
+        glm::vec4 params{ 0.0f }; // x: selection mix
     };
 
+    void BuildDrawList(const glm::mat4& viewProjection);
+    void UploadInstanceData();
+    // End of the run of queue entries from begin that can share one instanced draw:
+    // same single-range mesh and, if matchMaterial, same program and material state.
+    std::size_t FindInstanceRun(std::size_t begin, bool matchMaterial) const;
+    void SetInstanceAttributes(std::size_t firstInstance);
+    static void ClearInstanceAttributes();
     bool InitializeShadowResources();
     void DestroyShadowResources();
     void CollectLightingState(LightingState& lightingState);
+    void UploadFrameUniforms(const LightingState& lightingState, const glm::mat4& viewProjection);
     void RenderShadowPass(const LightingState& lightingState);
     glm::vec3 RotationToDirection(const glm::vec3& rotationDegrees) const;
     bool InitializeGrid();
@@ -56,6 +104,8 @@ private:
     void RenderGrid();
     void RenderGizmo();
     void UpdateSceneViewportState();
+    void SetVertexLayoutUniforms(StringId programId, const OGLE::VertexLayout& layout);
+    void DrawSubmeshes(const DrawItem& item, StringId programId);
 
     ShaderManager m_shaderManager;
     OGLE::Camera& m_camera;
@@ -75,6 +125,20 @@ private:
     GLuint m_gizmoProgram = 0;
     bool m_showGrid = true;
     bool m_gridInitialized = false;
+    std::vector<DrawItem> m_drawItems;
+    // Program of every proxy, resolved again only when RenderProxies::bindingRevision changes.
+    std::vector<StringId> m_proxyProgramIds;
+    std::vector<GLuint> m_proxyPrograms;
+    // 1 if the proxy's program declares uQuantizedVertices and decodes quantized buffers.
+    std::vector<std::uint8_t> m_proxyDecodesQuantized;
+    std::uint64_t m_proxyProgramRevision = ~0ull;
+    OGLE::RenderQueue m_renderQueue;
+    OGLE::RenderQueueStats m_renderStats;
+    OGLE::Std140Writer m_uniformWriter;
+    OGLE::UniformBuffer m_frameUniforms; // FrameBlock
+    OGLE::UniformBuffer m_lightUniforms; // LightBlock
+    std::vector<InstanceData> m_instanceData;
+    GLuint m_instanceBuffer = 0;
 
     // std::unique_ptr<DomoScene> m_scene;
     // Time point marking when the renderer was created, used for delta time calculation
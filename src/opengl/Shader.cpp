@@ -27,46 +27,64 @@ void Shader::Unbind() const {
     glUseProgram(0);
 }
 
-GLint Shader::GetUniformLocation(const std::string& name) {
-    auto it = m_uniformCache.find(name);
+GLint Shader::FindUniform(const std::string& name) {
+    const StringId id(name);
+    auto it = m_uniformCache.find(id);
     if (it != m_uniformCache.end()) {
         return it->second;
     }
-    GLint location = glGetUniformLocation(m_programId, name.c_str());
-    if (location != -1) {
-        m_uniformCache[name] = location;
-    }
+    // Misses are cached too: a uniform the program does not use stays -1.
+    const GLint location = glGetUniformLocation(m_programId, name.c_str());
+    m_uniformCache.emplace(id, location);
     return location;
 }
 
+void Shader::SetUniform(GLint location, int value) {
+    if (location != -1) glUniform1i(location, value);
+}
+
+void Shader::SetUniform(GLint location, float value) {
+    if (location != -1) glUniform1f(location, value);
+}
+
+void Shader::SetUniform(GLint location, const glm::vec2& value) {
+    if (location != -1) glUniform2f(location, value.x, value.y);
+}
+
+void Shader::SetUniform(GLint location, const glm::vec3& value) {
+    if (location != -1) glUniform3f(location, value.x, value.y, value.z);
+}
+
+void Shader::SetUniform(GLint location, const glm::vec4& value) {
+    if (location != -1) glUniform4f(location, value.x, value.y, value.z, value.w);
+}
+
+void Shader::SetUniform(GLint location, const glm::mat4& value) {
+    if (location != -1) glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
 void Shader::SetUniform(const std::string& name, int value) {
-    GLint loc = GetUniformLocation(name);
-    if (loc != -1) glUniform1i(loc, value);
+    SetUniform(FindUniform(name), value);
 }
 
 void Shader::SetUniform(const std::string& name, float value) {
-    GLint loc = GetUniformLocation(name);
-    if (loc != -1) glUniform1f(loc, value);
+    SetUniform(FindUniform(name), value);
 }
 
 void Shader::SetUniform(const std::string& name, const glm::vec2& value) {
-    GLint loc = GetUniformLocation(name);
-    if (loc != -1) glUniform2f(loc, value.x, value.y);
+    SetUniform(FindUniform(name), value);
 }
 
 void Shader::SetUniform(const std::string& name, const glm::vec3& value) {
-    GLint loc = GetUniformLocation(name);
-    if (loc != -1) glUniform3f(loc, value.x, value.y, value.z);
+    SetUniform(FindUniform(name), value);
 }
 
 void Shader::SetUniform(const std::string& name, const glm::vec4& value) {
-    GLint loc = GetUniformLocation(name);
-    if (loc != -1) glUniform4f(loc, value.x, value.y, value.z, value.w);
+    SetUniform(FindUniform(name), value);
 }
 
 void Shader::SetUniform(const std::string& name, const glm::mat4& value) {
-    GLint loc = GetUniformLocation(name);
-    if (loc != -1) glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(value));
+    SetUniform(FindUniform(name), value);
 }
 
 } // namespace OGLE
@@ -1,5 +1,6 @@
 #pragma once
 #include "GLFunctions.h"
+#include "../core/StringId.h"
 
 #include <string>
 #include <unordered_map>
@@ -10,9 +11,8 @@
 namespace OGLE {
 class Shader {
 private:
-    GLint GetUniformLocation(const std::string& name);
     GLuint m_programId;
-    std::unordered_map<std::string, GLint> m_uniformCache; // name -> location
+    std::unordered_map<StringId, GLint> m_uniformCache; // hashed name -> location
 public:
     explicit Shader(GLuint programId);
     ~Shader();
@@ -26,6 +26,17 @@ public:
     void Unbind() const;
     bool IsValid() const { return m_programId != 0; }
 
+    // Location of a uniform, -1 if the program does not use it. Meant for load
+    // time: callers keep the result and set it with the location overloads below.
+    GLint FindUniform(const std::string& name);
+
+    static void SetUniform(GLint location, int value);
+    static void SetUniform(GLint location, float value);
+    static void SetUniform(GLint location, const glm::vec2& value);
+    static void SetUniform(GLint location, const glm::vec3& value);
+    static void SetUniform(GLint location, const glm::vec4& value);
+    static void SetUniform(GLint location, const glm::mat4& value);
+
     void SetUniform(const std::string& name, int value);
     void SetUniform(const std::string& name, float value);
     void SetUniform(const std::string& name, const glm::vec2& value);
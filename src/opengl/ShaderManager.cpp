@@ -1,6 +1,9 @@
 #include "ShaderManager.h"
+#include "UniformBuffer.h"
 #include "core/FileSystem.h"
+#include <algorithm>
 #include <filesystem>
+#include <utility>
 
 
 ShaderManager::ShaderManager() {}
@@ -16,8 +19,8 @@ ShaderManager::~ShaderManager() {
         }
     }
     for (auto& pair : programs) {
-        if (pair.second != 0) { // Проверяем, что программа существует
-            GL_CHECK(glDeleteProgram(pair.second));
+        if (pair.second.id != 0) { // Проверяем, что программа существует
+            GL_CHECK(glDeleteProgram(pair.second.id));
         }
     }
 }
@@ -102,8 +105,7 @@ bool ShaderManager::linkProgram(const std::string& programName, const std::strin
         GL_CHECK(glDeleteProgram(program));
         return false;
     }
-    cacheUniforms(programName, program);
-    programs[programName] = program;
+    registerProgram(programName, program);
     LOG_INFO(std::string("[ShaderManager::linkProgram] Компиляция шейдерной программы programName=") + programName + " завершена ей присвоен ID=" + std::to_string(program));
     
     m_shaderPrograms[programName] = std::make_shared<OGLE::Shader>(program);
@@ -124,8 +126,7 @@ std::shared_ptr<OGLE::Shader> ShaderManager::GetShaderProgram(const std::string&
         return m_shaderPrograms[programName];
     }
 
-    if (programs.find(programName) != programs.end()) {
-        GLuint programId = programs[programName];
+    if (const GLuint programId = getProgram(programName)) {
         auto shader = std::make_shared<OGLE::Shader>(programId);
         m_shaderPrograms[programName] = shader;
         return shader;
@@ -152,8 +153,7 @@ bool ShaderManager::linkGeometryProgram(const std::string& programName, const st
         GL_CHECK(glDeleteProgram(program));
         return false;
     }
-    cacheUniforms(programName, program);
-    programs[programName] = program;
+    registerProgram(programName, program);
     LOG_INFO(std::string("[ShaderManager::linkGeometryProgram] Компиляция шейдерной программы programName=") + programName + " завершена ей присвоен ID=" + std::to_string(program));
     return true;
 }
@@ -177,8 +177,7 @@ bool ShaderManager::linkTessellationProgram(const std::string& programName, cons
         GL_CHECK(glDeleteProgram(program));
         return false;
     }
-    cacheUniforms(programName, program);
-    programs[programName] = program;
+    registerProgram(programName, program);
     LOG_INFO(std::string("[ShaderManager::linkTessellationProgram] Компиляция шейдерной программы programName=") + programName + " завершена ей присвоен ID=" + std::to_string(program));
     return true;
 }
@@ -188,9 +187,10 @@ bool ShaderManager::linkComputeProgram(const std::string& programName, const std
     LOG_INFO(std::string("[ShaderManager::linkComputeProgram] Начинаю компиляцию шейдерной программы programName=") + programName
         + " computeShaderName=" + computeShaderName);
     // Удаляем старую программу, если она есть
-    if (programs.find(programName) != programs.end()) {
-        GL_CHECK(glDeleteProgram(programs[programName]));
-        programs.erase(programName);
+    auto existing = programs.find(programName);
+    if (existing != programs.end()) {
+        GL_CHECK(glDeleteProgram(existing->second.id));
+        programs.erase(existing);
     }
 
     GLuint program = glCreateProgram();
@@ -200,26 +200,26 @@ bool ShaderManager::linkComputeProgram(const std::string& programName, const std
         GL_CHECK(glDeleteProgram(program));
         return false;
     }
-    cacheUniforms(programName, program);
-    programs[programName] = program;
+    registerProgram(programName, program);
     LOG_INFO(std::string("[ShaderManager::linkComputeProgram] Компиляция шейдерной программы programName=") + programName + " завершена ей присвоен ID=" + std::to_string(program));
     return true;
 }
 
 ShaderManager* ShaderManager::s_globalInstance = nullptr;
 
-bool ShaderManager::useProgram(const std::string& programName) {
-    auto it = programs.find(programName);
+bool ShaderManager::useProgram(StringId programId) {
+    auto it = programs.find(programId);
     if (it == programs.end()) {
-        LOG_ERROR("ShaderManager::useProgram: program not found: " + programName);
+        LOG_ERROR("ShaderManager::useProgram: program not found: id=" + std::to_string(programId.GetValue()));
         return false;
     }
-    glUseProgram(it->second);
+    glUseProgram(it->second.id);
     return true;
 }
 
-GLuint ShaderManager::getProgram(const std::string& programName) const {
-    return programs.at(programName);
+GLuint ShaderManager::getProgram(StringId programId) const {
+    auto it = programs.find(programId);
+    return it != programs.end() ? it->second.id : 0;
 }
 
 void ShaderManager::SetGlobalInstance(ShaderManager* instance)
@@ -237,37 +237,32 @@ std::vector<std::string> ShaderManager::GetProgramNames() const
     std::vector<std::string> names;
     names.reserve(programs.size());
     for (const auto& kv : programs) {
-        names.push_back(kv.first);
+        names.push_back(kv.second.name);
     }
+    std::sort(names.begin(), names.end());
     return names;
 }
 
-bool ShaderManager::hasProgram(const std::string& programName) const {
-    return programs.find(programName) != programs.end();
+bool ShaderManager::hasProgram(StringId programId) const {
+    return programs.find(programId) != programs.end();
 }
 
-GLint ShaderManager::getUniformLocation(const std::string& programName, const std::string& uniformName)
+GLint ShaderManager::getUniformLocation(StringId programId, StringId uniformId) const
 {
-    auto progIt = m_uniformLocations.find(programName);
-    if (progIt != m_uniformLocations.end()) {
-        auto uniformIt = progIt->second.find(uniformName);
-        if (uniformIt != progIt->second.end()) {
-            return uniformIt->second;
-        }
-    }
-
-    // Если в кэше нет, получаем и сохраняем.
-    // Это может произойти, если introspection не нашел все (например, в uniform-блоках)
-    // или для отладки. В релизе можно логировать как предупреждение.
-    GLint location = glGetUniformLocation(getProgram(programName), uniformName.c_str());
-    if (location != -1) {
-        m_uniformLocations[programName][uniformName] = location;
+    auto progIt = programs.find(programId);
+    if (progIt == programs.end()) {
+        return -1;
     }
-    return location;
+    auto uniformIt = progIt->second.uniforms.find(uniformId);
+    return uniformIt != progIt->second.uniforms.end() ? uniformIt->second : -1;
 }
 
-void ShaderManager::cacheUniforms(const std::string& programName, GLuint programId)
+void ShaderManager::registerProgram(const std::string& programName, GLuint programId)
 {
+    ProgramEntry entry;
+    entry.name = programName;
+    entry.id = programId;
+
     GLint numUniforms = 0;
     glGetProgramiv(programId, GL_ACTIVE_UNIFORMS, &numUniforms);
 
@@ -275,12 +270,36 @@ void ShaderManager::cacheUniforms(const std::string& programName, GLuint program
     for (GLint i = 0; i < numUniforms; ++i) {
         GLint size;
         GLenum type;
-        glGetActiveUniform(programId, i, 256, NULL, &size, &type, uniformName);
+        GLsizei length = 0;
+        glGetActiveUniform(programId, i, 256, &length, &size, &type, uniformName);
         GLint location = glGetUniformLocation(programId, uniformName);
-        if (location != -1) {
-            m_uniformLocations[programName][uniformName] = location;
+        if (location == -1) {
+            continue; // Член uniform-блока: у него нет location
+        }
+        const std::string_view name(uniformName, static_cast<std::size_t>(length));
+        entry.uniforms[StringId(name)] = location;
+        // Массивы драйвер отдаёт как "name[0]"; регистрируем и короткое имя.
+        constexpr std::string_view kArraySuffix = "[0]";
+        if (name.size() > kArraySuffix.size() && name.substr(name.size() - kArraySuffix.size()) == kArraySuffix) {
+            entry.uniforms[StringId(name.substr(0, name.size() - kArraySuffix.size()))] = location;
         }
     }
+
+    // Общие uniform-блоки всегда на своих точках привязки, чтобы буферы,
+    // привязанные один раз за кадр, подходили любой программе.
+    const std::pair<const char*, OGLE::UniformBlockBinding> blocks[] = {
+        { OGLE::kFrameBlockName, OGLE::UniformBlockBinding::Frame },
+        { OGLE::kLightBlockName, OGLE::UniformBlockBinding::Lights },
+        { OGLE::kMaterialBlockName, OGLE::UniformBlockBinding::Material },
+    };
+    for (const auto& block : blocks) {
+        const GLuint blockIndex = glGetUniformBlockIndex(programId, block.first);
+        if (blockIndex != GL_INVALID_INDEX) {
+            glUniformBlockBinding(programId, blockIndex, static_cast<GLuint>(block.second));
+        }
+    }
+
+    programs[StringId(programName)] = std::move(entry);
 }
 
 bool ShaderManager::compileShader(const char* source, GLenum type, GLuint& shader) {
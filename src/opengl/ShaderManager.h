@@ -2,9 +2,11 @@
 
 #include "GLFunctions.h"
 #include "Shader.h"
+#include "../core/StringId.h"
 #include "../Logger.h"
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <fstream>
 #include <streambuf>
@@ -26,11 +28,15 @@ public:
     bool linkTessellationProgram(const std::string& programName, const std::string& vertexShaderName, const std::string& tessControlShaderName, const std::string& tessEvaluationShaderName, const std::string& fragmentShaderName);
     bool linkComputeProgram(const std::string& programName, const std::string& computeShaderName);
 
-    bool useProgram(const std::string& programName);
-    GLuint getProgram(const std::string& programName) const;
-    bool hasProgram(const std::string& programName) const;
+    // Program and uniform lookups take hashed names. Strings still convert
+    // implicitly; per-draw callers pass constexpr StringId constants instead.
+    bool useProgram(StringId programId);
+    GLuint getProgram(StringId programId) const; // 0 if the program is not linked
+    bool hasProgram(StringId programId) const;
     std::vector<std::string> GetProgramNames() const;
-    GLint getUniformLocation(const std::string& programName, const std::string& uniformName);
+    // Locations come from introspection at link time; -1 if the program has no
+    // such active uniform. Arrays are registered both as "name" and "name[0]".
+    GLint getUniformLocation(StringId programId, StringId uniformId) const;
 
     std::shared_ptr<OGLE::Shader> GetShader(const std::string& programName);
     std::shared_ptr<OGLE::Shader> GetShaderProgram(const std::string& programName);
@@ -49,12 +55,17 @@ private:
     bool compileShader(const char* source, GLenum type, GLuint& shader);
     bool checkShaderCompilation(GLuint shader, const std::string& name);
     bool checkProgramLinking(GLuint program);
-    void cacheUniforms(const std::string& programName, GLuint programId);
+    void registerProgram(const std::string& programName, GLuint programId);
+
+    struct ProgramEntry {
+        std::string name;
+        GLuint id = 0;
+        std::unordered_map<StringId, GLint> uniforms; // Active uniforms by hashed name
+    };
 
     std::map<std::string, GLuint> shaders; // individual compiled shaders
-    // Raw program IDs used only for glUseProgram
-    std::map<std::string, GLuint> programs;
+    // Linked programs by hashed name, with their uniform locations
+    std::unordered_map<StringId, ProgramEntry> programs;
     // Shared Shader objects encapsulating program and uniform cache
     std::map<std::string, std::shared_ptr<OGLE::Shader>> m_shaderPrograms;
-    std::map<std::string, std::map<std::string, GLint>> m_uniformLocations;
 };
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "UniformBuffer.h"
+
+namespace OGLE {
+
+UniformBuffer::~UniformBuffer() {
+    Release();
+}
+
+UniformBuffer& UniformBuffer::operator=(const UniformBuffer& other) {
+    // The contents are re-uploaded by the owner; keep nothing of either buffer.
+    if (this != &other) {
+        Release();
+    }
+    return *this;
+}
+
+void UniformBuffer::Upload(const Std140Writer& writer) {
+    const std::size_t size = writer.GetSize();
+    if (size == 0) {
+        return;
+    }
+
+    if (m_buffer == 0) {
+        glGenBuffers(1, &m_buffer);
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, m_buffer);
+    if (size != m_size) {
+        // Allocated at the padded block size; only the packed bytes are copied below.
+        glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_DYNAMIC_DRAW);
+        m_size = size;
+    }
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, static_cast<GLsizeiptr>(writer.GetOffset()), writer.GetData());
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void UniformBuffer::Bind(UniformBlockBinding binding) const {
+    if (m_buffer != 0) {
+        glBindBufferBase(GL_UNIFORM_BUFFER, static_cast<GLuint>(binding), m_buffer);
+    }
+}
+
+void UniformBuffer::Release() {
+    if (m_buffer != 0) {
+        glDeleteBuffers(1, &m_buffer);
+        m_buffer = 0;
+        m_size = 0;
+    }
+}
+
+} // namespace OGLE
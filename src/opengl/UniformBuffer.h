@@ -0,0 +1,100 @@
+#pragma once
+#include "GLFunctions.h"
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace OGLE {
+
+// Binding points shared by every program. ShaderManager attaches blocks with
+// these names to their binding point at link time (GLSL 330 has no binding
+// layout qualifier), so buffers bound once stay valid across program switches.
+enum class UniformBlockBinding : GLuint {
+    Frame = 0,    // FrameBlock: camera, directional light, shadow matrix
+    Lights = 1,   // LightBlock: point lights
+    Material = 2  // MaterialBlock: surface parameters of the bound material
+};
+
+constexpr const char* kFrameBlockName = "FrameBlock";
+constexpr const char* kLightBlockName = "LightBlock";
+constexpr const char* kMaterialBlockName = "MaterialBlock";
+
+// Packs values with the std140 rules, in declaration order of the GLSL block:
+// scalars align to 4 bytes, vec2 to 8, vec3/vec4 and matrix columns to 16, and
+// every array element to 16. bool is stored as a 4-byte int.
+class Std140Writer {
+public:
+    void Clear() { m_data.clear(); }
+
+    void Write(float value) { Append(&value, sizeof(value), 4); }
+    void Write(std::int32_t value) { Append(&value, sizeof(value), 4); }
+    void Write(bool value) { Write(static_cast<std::int32_t>(value ? 1 : 0)); }
+    void Write(const glm::vec2& value) { Append(&value[0], sizeof(float) * 2, 8); }
+    void Write(const glm::vec3& value) { Append(&value[0], sizeof(float) * 3, 16); }
+    void Write(const glm::vec4& value) { Append(&value[0], sizeof(float) * 4, 16); }
+    void Write(const glm::mat4& value) {
+        for (int column = 0; column < 4; ++column) {
+            Write(value[column]);
+        }
+    }
+
+    // Array of count elements; the stride of every element is rounded up to 16.
+    template <typename T>
+    void WriteArray(const T* values, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            Align(16);
+            Write(values[i]);
+        }
+        Align(16);
+    }
+
+    // Block size is a multiple of 16, like the GL_UNIFORM_BLOCK_DATA_SIZE drivers report.
+    std::size_t GetSize() const { return (m_data.size() + 15) & ~std::size_t(15); }
+    const std::uint8_t* GetData() const { return m_data.data(); }
+    std::size_t GetOffset() const { return m_data.size(); }
+
+private:
+    void Align(std::size_t alignment) {
+        m_data.resize((m_data.size() + alignment - 1) & ~(alignment - 1), 0);
+    }
+
+    void Append(const void* data, std::size_t size, std::size_t alignment) {
+        Align(alignment);
+        const std::size_t offset = m_data.size();
+        m_data.resize(offset + size);
+        std::memcpy(m_data.data() + offset, data, size);
+    }
+
+    std::vector<std::uint8_t> m_data;
+};
+
+// GL_UNIFORM_BUFFER owned by one object. Copies do not share GPU storage: a copy
+// starts without a buffer and gets its own on the first Upload, so copied
+// materials never overwrite each other's parameters.
+class UniformBuffer {
+public:
+    UniformBuffer() = default;
+    ~UniformBuffer();
+    UniformBuffer(const UniformBuffer&) {}
+    UniformBuffer& operator=(const UniformBuffer& other);
+
+    // Creates the buffer on first use and reallocates it only when the size changes.
+    void Upload(const Std140Writer& writer);
+    void Bind(UniformBlockBinding binding) const;
+    bool IsCreated() const { return m_buffer != 0; }
+
+private:
+    void Release();
+
+    GLuint m_buffer = 0;
+    std::size_t m_size = 0;
+};
+
+} // namespace OGLE
@@ -1,6 +1,7 @@
 #include "BulletPhysicsEngine.h"
 
 #include "../Logger.h"
+#include "../core/JobSystem.h"
 #include "../world/World.h"
 
 #include <btBulletDynamicsCommon.h>
@@ -407,13 +408,7 @@ void BulletPhysicsEngine::Update(float deltaTime)
     m_dynamicsWorld->stepSimulation(deltaTime, 10);
     ProcessCollisions();
 
-    for (auto& [id, entry] : m_bodies) {
-        if (!entry.body) {
-            continue;
-        }
-
-        SyncEntityFromBody(static_cast<OGLE::Entity>(id), *entry.body);
-    }
+    SyncEntitiesFromBodies();
 }
 
 std::size_t BulletPhysicsEngine::GetBodyCount() const
@@ -450,27 +445,52 @@ void BulletPhysicsEngine::PruneInvalidBodies()
     }
 }
 
-void BulletPhysicsEngine::SyncEntityFromBody(OGLE::Entity entity, const btRigidBody& body)
+void BulletPhysicsEngine::SyncEntitiesFromBodies()
 {
-    if (!m_worldAccess || !m_worldAccess->IsEntityValid(entity)) {
-        return;
-    }
-
-    btTransform worldTransform;
-    if (body.getMotionState()) {
-        body.getMotionState()->getWorldTransform(worldTransform);
-    } else {
-        worldTransform = body.getWorldTransform();
+    // Only dynamic bodies that are awake, or fell asleep during this step, moved:
+    // the rest keep their transform and are not marked dirty every step.
+    m_syncBodies.clear();
+    for (auto& [id, entry] : m_bodies) {
+        if (!entry.body || entry.body->isStaticOrKinematicObject()) {
+            continue;
+        }
+        const bool active = entry.body->isActive();
+        if (active || entry.syncedActive) {
+            m_syncBodies.emplace_back(static_cast<OGLE::Entity>(id), entry.body.get());
+        }
+        entry.syncedActive = active;
     }
 
     OGLE::World& world = m_worldAccess->GetActiveWorld();
-    OGLE::TransformComponent* transform = world.GetTransform(entity);
-    if (!transform) {
-        return;
-    }
+    auto& transforms = world.GetRegistry().storage<OGLE::TransformComponent>();
+
+    // Each body writes only its own entity's TransformComponent, so the copy-out
+    // runs in parallel; dirty marking touches registry storage and stays serial.
+    JobSystem::Instance().ParallelFor(m_syncBodies.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const auto& [entity, body] = m_syncBodies[i];
+            if (!transforms.contains(entity)) {
+                continue;
+            }
+
+            btTransform worldTransform;
+            if (body->getMotionState()) {
+                body->getMotionState()->getWorldTransform(worldTransform);
+            } else {
+                worldTransform = body->getWorldTransform();
+            }
+
+            OGLE::TransformComponent& transform = transforms.get(entity);
+            transform.position = ToGlmVector(worldTransform.getOrigin());
+            transform.rotation = ToEulerDegrees(worldTransform.getRotation());
+        }
+    }, JobSystem::ChunkSizeFor(sizeof(OGLE::TransformComponent) + sizeof(btTransform)));
 
-    transform->position = ToGlmVector(worldTransform.getOrigin());
-    transform->rotation = ToEulerDegrees(worldTransform.getRotation());
+    for (const auto& [entity, body] : m_syncBodies) {
+        if (transforms.contains(entity)) {
+            world.MarkTransformDirty(entity);
+        }
+    }
 }
 
 } // namespace OGLE
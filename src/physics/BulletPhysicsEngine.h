@@ -7,6 +7,8 @@
 #include <glm/vec3.hpp>
 #include <memory>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include <functional>
 
 class btBroadphaseInterface;
@@ -61,10 +63,13 @@ private:
         std::unique_ptr<btCollisionShape> shape;
         std::unique_ptr<btDefaultMotionState> motionState;
         std::unique_ptr<btRigidBody> body;
+        bool syncedActive = false; // Was active at the last sync: its final pose before sleeping is still copied out
     };
 
     void PruneInvalidBodies();
-    void SyncEntityFromBody(OGLE::Entity entity, const btRigidBody& body);
+    // Copies transforms of moving bodies back into TransformComponent (in parallel).
+    // Static, kinematic and sleeping bodies are skipped.
+    void SyncEntitiesFromBodies();
     void ProcessCollisions();
 
     IWorldAccess* m_worldAccess = nullptr;
@@ -74,6 +79,8 @@ private:
     std::unique_ptr<btConstraintSolver> m_solver;
     std::unique_ptr<btDiscreteDynamicsWorld> m_dynamicsWorld;
     std::unordered_map<unsigned int, RigidBodyEntry> m_bodies;
+    // Reused each step to give the sync pass random access to the moving bodies.
+    std::vector<std::pair<OGLE::Entity, const btRigidBody*>> m_syncBodies;
     std::function<void(OGLE::Entity, OGLE::Entity)> m_collisionCallback;
 };
 
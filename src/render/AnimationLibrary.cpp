@@ -1,7 +1,9 @@
 #include "render/AnimationLibrary.h"
 #include "core/FileSystem.h"
 #include <nlohmann/json.hpp>
+#include <algorithm>
 #include <filesystem>
+#include <iterator>
 #include "Logger.h"
 
 namespace OGLE {
@@ -111,4 +113,232 @@ namespace OGLE {
 
         return true;
     }
+
+    std::string AnimationLibrary::MakeClipKey(const std::string& source, const std::string& clipName) {
+        return source + "#" + clipName;
+    }
+
+    std::vector<AnimationClipHandle> AnimationLibrary::RegisterClips(const std::string& source, std::vector<AnimationClip> clips) {
+        std::lock_guard<std::mutex> lock(m_clipMutex);
+        PurgeExpiredClipsLocked();
+
+        const std::string resolvedSource = source.empty()
+            ? "memory/" + std::to_string(++m_anonymousSourceCounter)
+            : source;
+
+        std::vector<AnimationClipHandle> handles;
+        std::vector<std::string> keys;
+        handles.reserve(clips.size());
+        keys.reserve(clips.size());
+        for (auto& clip : clips) {
+            std::string key = MakeClipKey(resolvedSource, clip.name);
+            for (int suffix = 1; std::find(keys.begin(), keys.end(), key) != keys.end(); ++suffix) {
+                key = MakeClipKey(resolvedSource, clip.name + "_" + std::to_string(suffix));
+            }
+
+            // Клип, который ещё кто-то держит, не пересоздаётся: все получают один экземпляр.
+            AnimationClipHandle handle;
+            auto existing = m_clips.find(key);
+            if (existing != m_clips.end()) {
+                handle = existing->second.lock();
+            }
+            if (!handle) {
+                clip.key = key;
+                handle = std::make_shared<const AnimationClip>(std::move(clip));
+                m_clips[key] = handle;
+            }
+
+            keys.push_back(key);
+            handles.push_back(std::move(handle));
+        }
+
+        m_clipKeysBySource[resolvedSource] = std::move(keys);
+        return handles;
+    }
+
+    std::vector<AnimationClipHandle> AnimationLibrary::FindClips(const std::string& source) {
+        std::lock_guard<std::mutex> lock(m_clipMutex);
+        auto sourceIt = m_clipKeysBySource.find(source);
+        if (sourceIt == m_clipKeysBySource.end()) {
+            return {};
+        }
+
+        std::vector<AnimationClipHandle> handles;
+        handles.reserve(sourceIt->second.size());
+        for (const auto& key : sourceIt->second) {
+            auto it = m_clips.find(key);
+            AnimationClipHandle handle = it != m_clips.end() ? it->second.lock() : nullptr;
+            if (!handle) {
+                return {};
+            }
+            handles.push_back(std::move(handle));
+        }
+        return handles;
+    }
+
+    AnimationClipHandle AnimationLibrary::FindClip(const std::string& key) {
+        std::lock_guard<std::mutex> lock(m_clipMutex);
+        auto it = m_clips.find(key);
+        return it != m_clips.end() ? it->second.lock() : nullptr;
+    }
+
+    std::size_t AnimationLibrary::GetLiveClipCount() {
+        std::lock_guard<std::mutex> lock(m_clipMutex);
+        PurgeExpiredClipsLocked();
+        return m_clips.size();
+    }
+
+    void AnimationLibrary::PurgeExpiredClipsLocked() {
+        for (auto it = m_clips.begin(); it != m_clips.end();) {
+            it = it->second.expired() ? m_clips.erase(it) : std::next(it);
+        }
+        for (auto it = m_clipKeysBySource.begin(); it != m_clipKeysBySource.end();) {
+            const bool alive = std::any_of(it->second.begin(), it->second.end(), [this](const std::string& key) {
+                return m_clips.count(key) > 0;
+            });
+            it = alive ? std::next(it) : m_clipKeysBySource.erase(it);
+        }
+    }
+
+    void AnimationLibrary::SetCompressionSettings(const AnimationCompressionSettings& settings) {
+        std::lock_guard<std::mutex> lock(m_clipMutex);
+        m_compressionSettings = settings;
+    }
+
+    AnimationCompressionSettings AnimationLibrary::GetCompressionSettings() {
+        std::lock_guard<std::mutex> lock(m_clipMutex);
+        return m_compressionSettings;
+    }
+
+    namespace {
+        nlohmann::json Vec3ChannelToJson(const AnimationChannel<glm::vec3>& channel) {
+            nlohmann::json values = nlohmann::json::array();
+            for (const auto& value : channel.values) {
+                values.push_back(value.x);
+                values.push_back(value.y);
+                values.push_back(value.z);
+            }
+            return {{"times", channel.times}, {"values", values}};
+        }
+
+        AnimationChannel<glm::vec3> Vec3ChannelFromJson(const nlohmann::json& channelJson) {
+            AnimationChannel<glm::vec3> channel;
+            if (!channelJson.is_object()) {
+                return channel;
+            }
+            channel.times = channelJson.value("times", std::vector<float>());
+            const auto values = channelJson.value("values", std::vector<float>());
+            const std::size_t count = std::min(channel.times.size(), values.size() / 3);
+            channel.times.resize(count);
+            channel.values.reserve(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                channel.values.push_back(glm::vec3(values[i * 3], values[i * 3 + 1], values[i * 3 + 2]));
+            }
+            return channel;
+        }
+
+        // Прежний формат: общий таймлайн, в каждом ключе все три свойства.
+        AnimationTrackSource TrackSourceFromKeyframesJson(const nlohmann::json& trackJson) {
+            AnimationTrackSource track;
+            track.nodeName = trackJson.value("nodeName", std::string(""));
+            if (!trackJson.contains("keyframes") || !trackJson["keyframes"].is_array()) {
+                return track;
+            }
+
+            for (const auto& keyJson : trackJson["keyframes"]) {
+                const float time = keyJson.value("time", 0.0f);
+                if (keyJson.contains("translation") && keyJson["translation"].is_array() && keyJson["translation"].size() == 3) {
+                    track.translationTimes.push_back(time);
+                    track.translations.push_back(glm::vec3(
+                        keyJson["translation"][0].get<float>(),
+                        keyJson["translation"][1].get<float>(),
+                        keyJson["translation"][2].get<float>()));
+                }
+                if (keyJson.contains("rotation") && keyJson["rotation"].is_array() && keyJson["rotation"].size() == 4) {
+                    track.rotationTimes.push_back(time);
+                    track.rotations.push_back(glm::quat(
+                        keyJson["rotation"][0].get<float>(),
+                        keyJson["rotation"][1].get<float>(),
+                        keyJson["rotation"][2].get<float>(),
+                        keyJson["rotation"][3].get<float>()));
+                }
+                if (keyJson.contains("scale") && keyJson["scale"].is_array() && keyJson["scale"].size() == 3) {
+                    track.scaleTimes.push_back(time);
+                    track.scales.push_back(glm::vec3(
+                        keyJson["scale"][0].get<float>(),
+                        keyJson["scale"][1].get<float>(),
+                        keyJson["scale"][2].get<float>()));
+                }
+            }
+            return track;
+        }
+    }
+
+    nlohmann::json AnimationLibrary::ClipToJson(const AnimationClip& clip) {
+        nlohmann::json clipJson;
+        clipJson["name"] = clip.name;
+        clipJson["duration"] = clip.duration;
+        clipJson["ticksPerSecond"] = clip.ticksPerSecond;
+        clipJson["tracks"] = nlohmann::json::array();
+        for (const auto& track : clip.tracks) {
+            nlohmann::json packed = nlohmann::json::array();
+            for (const auto& rotation : track.rotation.values) {
+                packed.push_back(rotation.bits[0]);
+                packed.push_back(rotation.bits[1]);
+                packed.push_back(rotation.bits[2]);
+            }
+
+            nlohmann::json trackJson;
+            trackJson["nodeName"] = track.nodeName;
+            trackJson["translation"] = Vec3ChannelToJson(track.translation);
+            trackJson["rotation"] = {{"times", track.rotation.times}, {"packed", packed}};
+            trackJson["scale"] = Vec3ChannelToJson(track.scale);
+            clipJson["tracks"].push_back(trackJson);
+        }
+        return clipJson;
+    }
+
+    AnimationClip AnimationLibrary::ClipFromJson(const nlohmann::json& clipJson) {
+        AnimationClip clip;
+        clip.name = clipJson.value("name", std::string(""));
+        clip.duration = clipJson.value("duration", 1.0f);
+        clip.ticksPerSecond = clipJson.value("ticksPerSecond", 24.0f);
+
+        if (!clipJson.contains("tracks") || !clipJson["tracks"].is_array()) {
+            return clip;
+        }
+
+        const AnimationCompressionSettings compression = Instance().GetCompressionSettings();
+        for (const auto& trackJson : clipJson["tracks"]) {
+            if (trackJson.contains("keyframes")) {
+                clip.tracks.push_back(AnimationCompressor::CompressTrack(TrackSourceFromKeyframesJson(trackJson), compression));
+                continue;
+            }
+
+            AnimationTrack track;
+            track.nodeName = trackJson.value("nodeName", std::string(""));
+            if (trackJson.contains("translation")) {
+                track.translation = Vec3ChannelFromJson(trackJson["translation"]);
+            }
+            if (trackJson.contains("scale")) {
+                track.scale = Vec3ChannelFromJson(trackJson["scale"]);
+            }
+            if (trackJson.contains("rotation") && trackJson["rotation"].is_object()) {
+                const auto& rotationJson = trackJson["rotation"];
+                track.rotation.times = rotationJson.value("times", std::vector<float>());
+                const auto packed = rotationJson.value("packed", std::vector<std::uint16_t>());
+                const std::size_t count = std::min(track.rotation.times.size(), packed.size() / 3);
+                track.rotation.times.resize(count);
+                track.rotation.values.resize(count);
+                for (std::size_t i = 0; i < count; ++i) {
+                    track.rotation.values[i].bits[0] = packed[i * 3];
+                    track.rotation.values[i].bits[1] = packed[i * 3 + 1];
+                    track.rotation.values[i].bits[2] = packed[i * 3 + 2];
+                }
+            }
+            clip.tracks.push_back(std::move(track));
+        }
+
+        return clip;
+    }
 }
@@ -1,7 +1,12 @@
 #pragma once
 
 #include "../world/WorldComponents.h"
+#include "../world/systems/AnimationCompressor.h"
 
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -20,8 +25,35 @@ namespace OGLE {
         bool SaveToFile(const std::string& path) const;
         bool LoadFromFile(const std::string& path);
 
+        // Общее хранилище клипов. Клипы одного источника (файла модели) создаются
+        // один раз и раздаются как AnimationClipHandle; запись в библиотеке слабая,
+        // клип освобождается вместе с последней моделью/сущностью, которая на него ссылается.
+        // Пустой source — клипы без файла, им выдаётся уникальный источник.
+        std::vector<AnimationClipHandle> RegisterClips(const std::string& source, std::vector<AnimationClip> clips);
+        // Живые клипы источника в порядке регистрации; пусто, если их нет или часть уже освобождена.
+        std::vector<AnimationClipHandle> FindClips(const std::string& source);
+        AnimationClipHandle FindClip(const std::string& key);
+        std::size_t GetLiveClipCount();
+
+        // Допуски сжатия для клипов, импортируемых после вызова (из AppConfig).
+        void SetCompressionSettings(const AnimationCompressionSettings& settings);
+        AnimationCompressionSettings GetCompressionSettings();
+
+        static std::string MakeClipKey(const std::string& source, const std::string& clipName);
+        static nlohmann::json ClipToJson(const AnimationClip& clip);
+        // Читает и сжатый формат, и прежний со списком "keyframes" (он сжимается при чтении).
+        static AnimationClip ClipFromJson(const nlohmann::json& clipJson);
+
     private:
         AnimationLibrary() = default;
+        void PurgeExpiredClipsLocked();
+
         std::unordered_map<std::string, AnimationComponent> m_animations;
+
+        std::mutex m_clipMutex;
+        std::unordered_map<std::string, std::weak_ptr<const AnimationClip>> m_clips;
+        std::unordered_map<std::string, std::vector<std::string>> m_clipKeysBySource;
+        std::size_t m_anonymousSourceCounter = 0;
+        AnimationCompressionSettings m_compressionSettings;
     };
 }
@@ -2,44 +2,84 @@
 #include "opengl/ShaderManager.h"
 #include "Logger.h"
 #include "render/TextureManager.h"
+#include "core/StringId.h"
 
 #include <algorithm>
 
 namespace OGLE {
+    namespace {
+        template <typename T>
+        std::uint64_t HashValue(std::uint64_t hash, const T& value)
+        {
+            return Fnv1aBytes(&value, sizeof(T), hash);
+        }
+    }
+
     void Material::Bind() const
     {
-        // Use the stored shader object to set uniforms via its cache
+        // Use the stored shader object and the locations resolved in ResolveUniforms
         if (!m_shader) return;
         m_shader->Bind();
+
         // Basic material properties
-        m_shader->SetUniform("uBaseColor", m_baseColor);
-        m_shader->SetUniform("uEmissiveColor", m_emissiveColor);
-        m_shader->SetUniform("uUvTiling", m_uvTiling);
-        m_shader->SetUniform("uUvOffset", m_uvOffset);
-        m_shader->SetUniform("uRoughness", m_roughness);
-        m_shader->SetUniform("uMetallic", m_metallic);
-        m_shader->SetUniform("uAlphaCutoff", m_alphaCutoff);
+        const std::uint64_t parameterHash = GetParameterHash();
+        if (parameterHash != m_uploadedHash || !m_parameterBuffer.IsCreated()) {
+            Std140Writer writer;
+            WriteParameterBlock(writer);
+            m_parameterBuffer.Upload(writer);
+            m_uploadedHash = parameterHash;
+        }
+        m_parameterBuffer.Bind(UniformBlockBinding::Material);
 
         // Texture handling
         int textureUnit = 0;
-        for (const auto& pair : m_textureSlots) {
-            const std::string& slotName = pair.first;
-            const std::shared_ptr<Texture2D>& texture = pair.second;
+        for (const TextureBinding& binding : m_textureBindings) {
+            const std::shared_ptr<Texture2D>& texture = binding.texture;
 
             if (texture && texture->IsValid()) {
                 glActiveTexture(GL_TEXTURE0 + textureUnit);
                 glBindTexture(GL_TEXTURE_2D, texture->GetTextureId());
-                m_shader->SetUniform("uTexture_" + slotName, textureUnit);
-                m_shader->SetUniform("uHasTexture_" + slotName, 1);
+                Shader::SetUniform(binding.sampler, textureUnit);
+                Shader::SetUniform(binding.hasTexture, 1);
                 textureUnit++;
             } else {
-                m_shader->SetUniform("uHasTexture_" + slotName, 0);
+                Shader::SetUniform(binding.hasTexture, 0);
             }
         }
     }
 
+    void Material::WriteParameterBlock(Std140Writer& writer) const
+    {
+        // Member order matches MaterialBlock in the shaders
+        writer.Write(m_baseColor);
+        writer.Write(m_roughness);
+        writer.Write(m_emissiveColor);
+        writer.Write(m_metallic);
+        writer.Write(m_uvTiling);
+        writer.Write(m_uvOffset);
+        writer.Write(m_alphaCutoff);
+    }
+
+    void Material::ResolveUniforms()
+    {
+        m_textureBindings.clear();
+        if (!m_shader) {
+            return;
+        }
+
+        m_textureBindings.reserve(m_textureSlots.size());
+        for (const auto& pair : m_textureSlots) {
+            TextureBinding binding;
+            binding.texture = pair.second;
+            binding.sampler = m_shader->FindUniform("uTexture_" + pair.first);
+            binding.hasTexture = m_shader->FindUniform("uHasTexture_" + pair.first);
+            m_textureBindings.push_back(std::move(binding));
+        }
+    }
+
     void Material::SetBaseColor(const glm::vec3& color)
     {
+        m_parameterHash = 0;
         m_baseColor = color;
     }
 
@@ -50,6 +90,7 @@ namespace OGLE {
 
     void Material::SetEmissiveColor(const glm::vec3& color)
     {
+        m_parameterHash = 0;
         m_emissiveColor = color;
     }
 
@@ -60,6 +101,7 @@ namespace OGLE {
 
     void Material::SetUvTiling(const glm::vec2& tiling)
     {
+        m_parameterHash = 0;
         m_uvTiling = tiling;
     }
 
@@ -70,6 +112,7 @@ namespace OGLE {
 
     void Material::SetUvOffset(const glm::vec2& offset)
     {
+        m_parameterHash = 0;
         m_uvOffset = offset;
     }
 
@@ -80,6 +123,7 @@ namespace OGLE {
 
     void Material::SetRoughness(float roughness)
     {
+        m_parameterHash = 0;
         m_roughness = std::clamp(roughness, 0.0f, 1.0f);
     }
 
@@ -90,6 +134,7 @@ namespace OGLE {
 
     void Material::SetMetallic(float metallic)
     {
+        m_parameterHash = 0;
         m_metallic = std::clamp(metallic, 0.0f, 1.0f);
     }
 
@@ -100,6 +145,7 @@ namespace OGLE {
 
     void Material::SetAlphaCutoff(float alphaCutoff)
     {
+        m_parameterHash = 0;
         m_alphaCutoff = std::clamp(alphaCutoff, 0.0f, 1.0f);
     }
 
@@ -110,6 +156,7 @@ namespace OGLE {
 
     void Material::AddTexture(const std::string& slotName, const std::string& texturePath)
     {
+        m_parameterHash = 0;
         if (texturePath.empty()) {
             RemoveTexture(slotName);
             return;
@@ -121,17 +168,21 @@ namespace OGLE {
             // Even if it fails, we store the path so it can be fixed in the editor
             m_textureSlotPaths[slotName] = texturePath;
             m_textureSlots.erase(slotName);
+            ResolveUniforms();
             return;
         }
 
         m_textureSlots[slotName] = texture;
         m_textureSlotPaths[slotName] = texture->GetPath(); // Use resolved path
+        ResolveUniforms();
     }
 
     void Material::RemoveTexture(const std::string& slotName)
     {
+        m_parameterHash = 0;
         m_textureSlots.erase(slotName);
         m_textureSlotPaths.erase(slotName);
+        ResolveUniforms();
     }
 
     std::shared_ptr<Texture2D> Material::GetTexture(const std::string& slotName) const
@@ -200,6 +251,8 @@ namespace OGLE {
         if (j.contains("textureSlots")) {
             m_textureSlotPaths.clear();
             m_textureSlots.clear();
+            m_parameterHash = 0;
+            ResolveUniforms();
             const auto& texturesJson = j.at("textureSlots");
             for (auto it = texturesJson.begin(); it != texturesJson.end(); ++it) {
                 AddTexture(it.key(), it.value().get<std::string>());
@@ -215,14 +268,54 @@ namespace OGLE {
 
     void Material::SetShaderProgram(const std::string& shaderProgramName)
     {
+        m_parameterHash = 0;
         m_shaderProgramName = shaderProgramName;
         if (ShaderManager::GetGlobalInstance()) {
             m_shader = ShaderManager::GetGlobalInstance()->GetShaderProgram(shaderProgramName);
         }
+        ResolveUniforms();
     }
 
     const std::string& Material::GetShaderProgram() const
     {
         return m_shaderProgramName;
     }
+
+    std::uint64_t Material::GetStateHash() const
+    {
+        // A material without a shader binds nothing; all of them hash alike.
+        if (!m_shader) {
+            return 0;
+        }
+
+        // Texture ids are not cached: a texture can be (re)loaded or fail after it
+        // was assigned to a slot, without any setter of this material running.
+        std::uint64_t hash = GetParameterHash();
+        for (const TextureBinding& binding : m_textureBindings) {
+            const GLuint textureId = binding.texture && binding.texture->IsValid() ? binding.texture->GetTextureId() : 0;
+            hash = HashValue(hash, textureId);
+        }
+        return hash == 0 ? 1 : hash;
+    }
+
+    std::uint64_t Material::GetParameterHash() const
+    {
+        if (m_parameterHash != 0) {
+            return m_parameterHash;
+        }
+
+        std::uint64_t hash = HashValue(kFnv1aOffsetBasis, m_shader.get());
+        hash = Fnv1aBytes(&m_baseColor[0], sizeof(float) * 3, hash);
+        hash = Fnv1aBytes(&m_emissiveColor[0], sizeof(float) * 3, hash);
+        hash = Fnv1aBytes(&m_uvTiling[0], sizeof(float) * 2, hash);
+        hash = Fnv1aBytes(&m_uvOffset[0], sizeof(float) * 2, hash);
+        hash = HashValue(hash, m_roughness);
+        hash = HashValue(hash, m_metallic);
+        hash = HashValue(hash, m_alphaCutoff);
+        for (const auto& pair : m_textureSlots) {
+            hash = Fnv1a(pair.first, hash);
+        }
+        m_parameterHash = hash == 0 ? 1 : hash;
+        return m_parameterHash;
+    }
 }
@@ -2,13 +2,16 @@
 
 #include "Texture2D.h"
 #include "../opengl/Shader.h"
+#include "../opengl/UniformBuffer.h"
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 
 #include <nlohmann/json.hpp>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <map>
+#include <vector>
 
 namespace OGLE {
     class Material {
@@ -41,12 +44,37 @@ namespace OGLE {
         void SetShaderProgram(const std::string& shaderProgramName);
         const std::string& GetShaderProgram() const;
 
+        // Hash of everything Bind() uploads (shader, parameters, bound textures).
+        // Two materials with equal hashes leave the GL state identical, so the
+        // renderer may skip the second Bind(). The shader and parameter part is
+        // cached until the next setter call; texture ids are read on every call.
+        std::uint64_t GetStateHash() const;
+        // Surface parameters in MaterialBlock member order (64 bytes with std140).
+        void WriteParameterBlock(Std140Writer& writer) const;
+
         nlohmann::json ToJson() const;
         bool FromJson(const nlohmann::json& j);
 
     private:
+        // Sampler locations are looked up once, when the shader or the texture set
+        // changes, so Bind() neither builds nor hashes uniform names.
+        struct TextureBinding {
+            std::shared_ptr<Texture2D> texture;
+            GLint sampler = -1;    // uTexture_<slot>
+            GLint hasTexture = -1; // uHasTexture_<slot>
+        };
+
+        void ResolveUniforms();
+        // Shader, surface parameters and texture slot names; cached in m_parameterHash.
+        std::uint64_t GetParameterHash() const;
+
         // Shader object will be set via SetShader; keep as private
         std::shared_ptr<OGLE::Shader> m_shader;
+        std::vector<TextureBinding> m_textureBindings; // In m_textureSlots order
+        // MaterialBlock (std140) of this material; re-uploaded by Bind() only when
+        // GetParameterHash() differs from the hash of the last upload.
+        mutable UniformBuffer m_parameterBuffer;
+        mutable std::uint64_t m_uploadedHash = 0;
         // Editable surface parameters live here so the editor, serializer, and renderer share one source of truth.
         glm::vec3 m_baseColor{ 1.0f, 1.0f, 1.0f };
         glm::vec3 m_emissiveColor{ 0.0f, 0.0f, 0.0f };
@@ -60,6 +88,7 @@ namespace OGLE {
         std::map<std::string, std::shared_ptr<Texture2D>> m_textureSlots;
 
         std::string m_shaderProgramName;
+        mutable std::uint64_t m_parameterHash = 0; // 0: not computed yet
 
     };
 }
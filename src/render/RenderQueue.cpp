@@ -0,0 +1,93 @@
+#include "render/RenderQueue.h"
+
+#include <array>
+#include <cstring>
+
+namespace OGLE {
+    namespace {
+        std::uint64_t FoldTo16(std::uint64_t value)
+        {
+            value ^= value >> 32;
+            value ^= value >> 16;
+            return value & 0xFFFFull;
+        }
+
+        std::uint64_t QuantizeDepth(float viewDepth)
+        {
+            if (!(viewDepth > 0.0f)) {
+                return 0;
+            }
+            // The bit pattern of a positive float grows with its value: dropping the sign
+            // and the low mantissa bits keeps the order over the whole range, so no far
+            // plane is needed to normalize.
+            std::uint32_t bits = 0;
+            std::memcpy(&bits, &viewDepth, sizeof(bits));
+            return (bits >> (31 - RenderQueue::kDepthBits)) & ((1u << RenderQueue::kDepthBits) - 1u);
+        }
+    }
+
+    std::uint64_t RenderQueue::MakeKey(std::uint32_t program, std::uint64_t material, std::uint64_t mesh, float viewDepth)
+    {
+        constexpr unsigned int kMeshShift = kDepthBits;
+        constexpr unsigned int kMaterialShift = kMeshShift + kMeshBits;
+        constexpr unsigned int kProgramShift = kMaterialShift + kMaterialBits;
+        static_assert(kProgramShift + kProgramBits == 64, "sort key fields must fill 64 bits");
+
+        return (static_cast<std::uint64_t>(program & ((1u << kProgramBits) - 1u)) << kProgramShift)
+            | (FoldTo16(material) << kMaterialShift)
+            | (FoldTo16(mesh) << kMeshShift)
+            | QuantizeDepth(viewDepth);
+    }
+
+    void RenderQueue::Clear()
+    {
+        m_entries.clear();
+    }
+
+    void RenderQueue::Reserve(std::size_t count)
+    {
+        m_entries.reserve(count);
+    }
+
+    void RenderQueue::Push(std::uint64_t key, std::uint32_t item)
+    {
+        m_entries.push_back(Entry{ key, item });
+    }
+
+    void RenderQueue::Sort()
+    {
+        const std::size_t count = m_entries.size();
+        if (count < 2) {
+            return;
+        }
+
+        // All eight histograms in one read of the keys.
+        std::array<std::array<std::uint32_t, 256>, 8> histograms{};
+        for (const Entry& entry : m_entries) {
+            for (unsigned int pass = 0; pass < 8; ++pass) {
+                ++histograms[pass][(entry.key >> (pass * 8)) & 0xFFu];
+            }
+        }
+
+        m_scratch.resize(count);
+        for (unsigned int pass = 0; pass < 8; ++pass) {
+            std::array<std::uint32_t, 256>& histogram = histograms[pass];
+            const unsigned int shift = pass * 8;
+            if (histogram[(m_entries.front().key >> shift) & 0xFFu] == count) {
+                continue;
+            }
+
+            std::uint32_t offset = 0;
+            for (std::uint32_t& bucket : histogram) {
+                const std::uint32_t bucketCount = bucket;
+                bucket = offset;
+                offset += bucketCount;
+            }
+            for (const Entry& entry : m_entries) {
+                m_scratch[histogram[(entry.key >> shift) & 0xFFu]++] = entry;
+            }
+            m_entries.swap(m_scratch);
+        }
+    }
+
+} // namespace OGLE
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace OGLE {
+
+    // State changes issued by one submission of a RenderQueue.
+    struct RenderQueueStats {
+        std::uint32_t drawItems = 0;
+        std::uint32_t programSwitches = 0;
+        std::uint32_t materialBinds = 0;
+        std::uint32_t meshBinds = 0;
+        std::uint32_t drawCalls = 0;
+        std::uint32_t instanceBatches = 0; // Instanced draws among drawCalls
+    };
+
+    // Draw order of a pass. Every visible item gets a 64-bit key
+    //   [63..52] program | [51..36] material | [35..20] mesh | [19..0] depth
+    // so that after sorting, items sharing a program, then a material, then a mesh
+    // are adjacent and each group is drawn front to back. The submitter walks the
+    // sorted entries and only changes state when the corresponding key field (or
+    // the object behind it) differs from the previous entry.
+    class RenderQueue {
+    public:
+        struct Entry {
+            std::uint64_t key = 0;
+            std::uint32_t item = 0; // Index into the caller's draw list
+        };
+
+        static constexpr unsigned int kDepthBits = 20;
+        static constexpr unsigned int kMeshBits = 16;
+        static constexpr unsigned int kMaterialBits = 16;
+        static constexpr unsigned int kProgramBits = 12;
+
+        // Fields wider than their slot are folded (hashed ids) or truncated (program);
+        // a collision only weakens grouping, the submitter still compares real state.
+        // viewDepth is the distance along the view axis; negative values sort first.
+        static std::uint64_t MakeKey(std::uint32_t program, std::uint64_t material, std::uint64_t mesh, float viewDepth);
+
+        void Clear();
+        void Reserve(std::size_t count);
+        void Push(std::uint64_t key, std::uint32_t item);
+        // LSD radix sort, 8 bits per pass. Passes where every key has the same digit are
+        // skipped, so a frame with one program and few materials costs ~4 passes.
+        void Sort();
+
+        const std::vector<Entry>& GetEntries() const { return m_entries; }
+        std::size_t GetSize() const { return m_entries.size(); }
+
+    private:
+        std::vector<Entry> m_entries;
+        std::vector<Entry> m_scratch;
+    };
+
+} // namespace OGLE
@@ -57,6 +57,14 @@ namespace OGLE {
                 return false;
             }
 
+#ifdef OGLE_HEADLESS
+            // Null render path: pixels are decoded (so missing/broken files still
+            // surface), but nothing is uploaded without a GL context.
+            stbi_image_free(data);
+            LOG_INFO("Texture decoded (headless, not uploaded): " + filePath);
+            return true;
+#endif
+
             GL_CHECK(glGenTextures(1, &m_textureID));
             GL_CHECK(glBindTexture(GL_TEXTURE_2D, m_textureID));
             GL_CHECK(glTexImage2D(GL_TEXTURE_2D, 0, format, m_width, m_height, 0, format, GL_UNSIGNED_BYTE, data));
@@ -80,6 +80,36 @@ namespace OGLE
         }
 
 
+        unsigned int WorldApi::createModel(const std::string& name, const std::string& path)
+        {
+            if (!m_worldAccess) {
+                return 0;
+            }
+
+            const auto entity = m_worldAccess->GetActiveWorld().CreateModelFromFile(path, ModelType::DYNAMIC, name);
+            return static_cast<unsigned int>(entt::to_integral(entity));
+        }
+
+        unsigned int WorldApi::createModelHierarchy(const std::string& name, const std::string& path)
+        {
+            if (!m_worldAccess) {
+                return 0;
+            }
+
+            const auto entity = m_worldAccess->GetActiveWorld().CreateModelHierarchyFromFile(path, ModelType::DYNAMIC, name);
+            return static_cast<unsigned int>(entt::to_integral(entity));
+        }
+
+        unsigned int WorldApi::createModelAsync(const std::string& name, const std::string& path)
+        {
+            if (!m_worldAccess) {
+                return 0;
+            }
+
+            const auto entity = m_worldAccess->GetActiveWorld().CreateModelFromFileAsync(path, ModelType::DYNAMIC, name);
+            return static_cast<unsigned int>(entt::to_integral(entity));
+        }
+
         unsigned int WorldApi::createDirectionalLight(const std::string& name, const std::vector<float>& rotation, const std::vector<float>& color, float intensity, bool castShadows, bool primary)
         {
             if (!m_worldAccess) {
@@ -202,6 +232,34 @@ namespace OGLE
             return name->value;
         }
 
+        bool EntityApi::setParent(unsigned int entityId, int parentId)
+        {
+            if (!m_worldAccess) {
+                return false;
+            }
+
+            const auto entity = static_cast<OGLE::Entity>(entityId);
+            const auto parent = parentId < 0
+                ? static_cast<OGLE::Entity>(entt::null)
+                : static_cast<OGLE::Entity>(static_cast<unsigned int>(parentId));
+            return m_worldAccess->GetActiveWorld().SetParent(entity, parent);
+        }
+
+        int EntityApi::getParent(unsigned int entityId) const
+        {
+            if (!m_worldAccess) {
+                return -1;
+            }
+
+            const auto entity = static_cast<OGLE::Entity>(entityId);
+            const auto parent = m_worldAccess->GetActiveWorld().GetParent(entity);
+            if (parent == entt::null) {
+                return -1;
+            }
+
+            return static_cast<int>(entt::to_integral(parent));
+        }
+
         PhysicsApi::PhysicsApi(PhysicsManager* physicsManager, IWorldAccess* worldAccess)
             : m_physicsManager(physicsManager)
             , m_worldAccess(worldAccess)
@@ -21,6 +21,12 @@ namespace OGLE
             void clear();
             unsigned int createCube(const std::string& name, const std::vector<float>& position, const std::vector<float>& scale);
             unsigned int createSphere(const std::string& name, const std::vector<float>& position, float radius);
+            // Синхронный импорт: кадр ждёт Assimp и загрузку в GPU.
+            unsigned int createModel(const std::string& name, const std::string& path);
+            // Корень с дочерними сущностями по узлам файла.
+            unsigned int createModelHierarchy(const std::string& name, const std::string& path);
+            // Сразу возвращает сущность с заглушкой; о готовности сообщает __ogleModelReady.
+            unsigned int createModelAsync(const std::string& name, const std::string& path);
             unsigned int createDirectionalLight(const std::string& name, const std::vector<float>& rotation, const std::vector<float>& color, float intensity, bool castShadows, bool primary);
             unsigned int createPointLight(const std::string& name, const std::vector<float>& position, const std::vector<float>& color, float intensity, float range);
 
@@ -39,6 +45,10 @@ namespace OGLE
             std::vector<float> getRotation(unsigned int entityId) const;
             void setRotation(unsigned int entityId, const std::vector<float>& rotation);
             std::string getName(unsigned int entityId) const;
+            // parentId < 0 отсоединяет сущность от родителя.
+            bool setParent(unsigned int entityId, int parentId);
+            // Возвращает -1, если родителя нет.
+            int getParent(unsigned int entityId) const;
 
         private:
             IWorldAccess* m_worldAccess;
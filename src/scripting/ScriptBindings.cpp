@@ -26,6 +26,9 @@ namespace OGLE
             dukglue_register_method(ctx, &WorldApi::clear, "clear");
             dukglue_register_method(ctx, &WorldApi::createCube, "createCube");
             dukglue_register_method(ctx, &WorldApi::createSphere, "createSphere");
+            dukglue_register_method(ctx, &WorldApi::createModel, "createModel");
+            dukglue_register_method(ctx, &WorldApi::createModelHierarchy, "createModelHierarchy");
+            dukglue_register_method(ctx, &WorldApi::createModelAsync, "createModelAsync");
             dukglue_register_method(ctx, &WorldApi::createDirectionalLight, "createDirectionalLight");
             dukglue_register_method(ctx, &WorldApi::createPointLight, "createPointLight");
 
@@ -35,6 +38,8 @@ namespace OGLE
             dukglue_register_method(ctx, &EntityApi::getRotation, "getRotation");
             dukglue_register_method(ctx, &EntityApi::setRotation, "setRotation");
             dukglue_register_method(ctx, &EntityApi::getName, "getName");
+            dukglue_register_method(ctx, &EntityApi::setParent, "setParent");
+            dukglue_register_method(ctx, &EntityApi::getParent, "getParent");
 
             dukglue_register_method(ctx, &PhysicsApi::addBox, "addBox");
 
@@ -0,0 +1,54 @@
+#include "HeadlessWindow.h"
+
+#include "Logger.h"
+
+HeadlessWindow::HeadlessWindow(int width, int height)
+    : m_width(width)
+    , m_height(height)
+{
+}
+
+bool HeadlessWindow::Create(HINSTANCE hInstance, HWND hParent)
+{
+    (void)hInstance;
+    (void)hParent;
+
+    LOG_INFO("Headless window created (" + std::to_string(m_width) + "x" + std::to_string(m_height) + ")");
+    return true;
+}
+
+void HeadlessWindow::Show(int nCmdShow)
+{
+    (void)nCmdShow;
+}
+
+HWND HeadlessWindow::Handle() const
+{
+    return nullptr;
+}
+
+int HeadlessWindow::Width() const
+{
+    return m_width;
+}
+
+int HeadlessWindow::Height() const
+{
+    return m_height;
+}
+
+void HeadlessWindow::SetSize(int width, int height)
+{
+    m_width = width;
+    m_height = height;
+}
+
+std::wstring HeadlessWindow::Title() const
+{
+    return m_title;
+}
+
+void HeadlessWindow::SetTitle(const std::wstring& title)
+{
+    m_title = title;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "IWindow.h"
+
+// Window stand-in for simulation-only runs: no native handle, no device
+// context and no GL context. Only keeps the logical size and title so code
+// that queries the window (camera aspect, config save) keeps working.
+class HeadlessWindow : public IWindow
+{
+public:
+    HeadlessWindow() = default;
+    HeadlessWindow(int width, int height);
+
+    bool Create(HINSTANCE hInstance, HWND hParent = nullptr) override;
+    void Show(int nCmdShow) override;
+    HWND Handle() const override;
+
+    int Width() const override;
+    int Height() const override;
+    void SetSize(int width, int height) override;
+
+    std::wstring Title() const override;
+    void SetTitle(const std::wstring& title) override;
+
+private:
+    int m_width = 800;
+    int m_height = 600;
+    std::wstring m_title = L"OGLE3D (headless)";
+};
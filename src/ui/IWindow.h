@@ -3,7 +3,8 @@
 #include <functional>
 #include <string>
 #include <utility>
-#include <windows.h>
+
+#include "ui/WindowTypes.h"
 
 class IWindow
 {
@@ -0,0 +1,19 @@
+#pragma once
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cstdint>
+
+// Minimal stand-ins for the Win32 handle types used by IWindow, so that the
+// headless build can compile the window interface without windows.h.
+using HINSTANCE = void*;
+using HWND = void*;
+using HDC = void*;
+using HGLRC = void*;
+using DWORD = unsigned long;
+using UINT = unsigned int;
+using WPARAM = std::uintptr_t;
+using LPARAM = std::intptr_t;
+using LRESULT = std::intptr_t;
+#endif
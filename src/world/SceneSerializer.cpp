@@ -1,9 +1,13 @@
 #include "SceneSerializer.h"
 #include "World.h"
 #include "core/FileSystem.h"
+#include "render/AnimationLibrary.h"
 
 #include <fstream>
 #include <nlohmann/json.hpp>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace OGLE {
     namespace {
@@ -73,6 +77,7 @@ namespace OGLE {
             auto& worldObject = view.get<WorldObjectComponent>(entity);
 
             nlohmann::json entityJson;
+            entityJson["id"] = entt::to_integral(entity);
             entityJson["name"] = name.value;
             entityJson["kind"] = static_cast<int>(worldObject.kind);
             entityJson["enabled"] = worldObject.enabled;
@@ -81,6 +86,11 @@ namespace OGLE {
             entityJson["rotation"] = { transform.rotation.x, transform.rotation.y, transform.rotation.z };
             entityJson["scale"] = { transform.scale.x, transform.scale.y, transform.scale.z };
 
+            if (const auto* hierarchy = registry.try_get<HierarchyComponent>(entity);
+                hierarchy && hierarchy->parent != entt::null) {
+                entityJson["parent"] = entt::to_integral(hierarchy->parent);
+            }
+
             if (registry.all_of<ModelComponent>(entity)) {
                 auto& model = registry.get<ModelComponent>(entity);
                 if (model.model) {
@@ -98,6 +108,14 @@ namespace OGLE {
                 };
             }
 
+            if (registry.all_of<LODComponent>(entity)) {
+                const auto& lod = registry.get<LODComponent>(entity);
+                entityJson["lod"] = {
+                    {"screenSizeBias", lod.screenSizeBias},
+                    {"forcedLevel", lod.forcedLevel}
+                };
+            }
+
             if (registry.all_of<MaterialComponent>(entity)) {
                 entityJson["materialComponent"] = MaterialToJson(registry.get<MaterialComponent>(entity).material);
             }
@@ -141,6 +159,13 @@ namespace OGLE {
                     {"duration", animation.duration},
                     {"currentClip", animation.currentClip}
                 };
+
+                // Только ссылка на клип в AnimationLibrary, ключи кадров остаются в файле модели.
+                if (animation.currentClipIndex >= 0
+                    && static_cast<size_t>(animation.currentClipIndex) < animation.clips.size()
+                    && animation.clips[animation.currentClipIndex]) {
+                    entityJson["animation"]["clip"] = animation.clips[animation.currentClipIndex]->key;
+                }
             }
 
             if (registry.all_of<ScriptComponent>(entity)) {
@@ -177,14 +202,27 @@ namespace OGLE {
             return;
         }
 
+        // Связи родитель-потомок восстанавливаются после создания всех сущностей:
+        // id в файле — это идентификаторы на момент сохранения, а не текущие.
+        std::unordered_map<std::uint32_t, Entity> savedIdToEntity;
+        std::vector<std::pair<Entity, std::uint32_t>> pendingParents;
+
         for (const auto& entityJson : j["entities"]) {
             const std::string name = entityJson.value("name", "Model");
             const WorldObjectKind kind = static_cast<WorldObjectKind>(entityJson.value("kind", static_cast<int>(WorldObjectKind::Generic)));
             const Entity entity = m_world.CreateWorldObject(name, kind).GetEntity();
+            if (entityJson.contains("id")) {
+                savedIdToEntity[entityJson.at("id").get<std::uint32_t>()] = entity;
+            }
+            if (entityJson.contains("parent")) {
+                pendingParents.emplace_back(entity, entityJson.at("parent").get<std::uint32_t>());
+            }
 
-            auto& worldObject = registry.get<WorldObjectComponent>(entity);
-            worldObject.enabled = entityJson.value("enabled", true);
-            worldObject.visible = entityJson.value("visible", true);
+            // patch: флаги видимости читает RenderSystem по on_update.
+            registry.patch<WorldObjectComponent>(entity, [&](WorldObjectComponent& worldObject) {
+                worldObject.enabled = entityJson.value("enabled", true);
+                worldObject.visible = entityJson.value("visible", true);
+            });
 
             auto& transform = registry.get<TransformComponent>(entity);
             const auto& positionJson = entityJson.at("position");
@@ -201,6 +239,14 @@ namespace OGLE {
                 registry.emplace<MaterialComponent>(entity, model->GetMaterial());
             }
 
+            if (entityJson.contains("lod") || (registry.all_of<ModelComponent>(entity) && registry.get<ModelComponent>(entity).model->GetLODs())) {
+                const nlohmann::json lodJson = entityJson.value("lod", nlohmann::json::object());
+                LODComponent lod;
+                lod.screenSizeBias = lodJson.value("screenSizeBias", 1.0f);
+                lod.forcedLevel = lodJson.value("forcedLevel", -1);
+                registry.emplace<LODComponent>(entity, lod);
+            }
+
             if (entityJson.contains("primitive")) {
                 const auto& primitiveJson = entityJson.at("primitive");
                 PrimitiveComponent primitive;
@@ -258,18 +304,38 @@ namespace OGLE {
                 animation.playbackSpeed = animationJson.value("playbackSpeed", 1.0f);
                 animation.duration = animationJson.value("duration", 1.0f);
                 animation.currentClip = animationJson.value("currentClip", std::string());
+                const std::string clipKey = animationJson.value("clip", std::string());
 
                 if (registry.all_of<ModelComponent>(entity)) {
                     const ModelEntity* model = registry.get<ModelComponent>(entity).model.get();
                     if (model) {
                         animation.clips = model->GetAnimationClips();
-                        if (!animation.clips.empty() && animation.currentClip.empty()) {
-                            animation.currentClipIndex = 0;
-                            animation.currentClip = animation.clips[0].name;
-                            animation.duration = animation.clips[0].duration;
-                        }
                     }
                 }
+                if (animation.clips.empty() && !clipKey.empty()) {
+                    if (AnimationClipHandle clip = AnimationLibrary::Instance().FindClip(clipKey)) {
+                        animation.clips.push_back(std::move(clip));
+                    }
+                }
+
+                // Текущий клип ищется по ключу, затем по имени (старые сцены, другой путь к файлу), иначе первый.
+                int keyIndex = -1;
+                int nameIndex = -1;
+                for (size_t clipIndex = 0; clipIndex < animation.clips.size(); ++clipIndex) {
+                    const AnimationClip& clip = *animation.clips[clipIndex];
+                    if (!clipKey.empty() && clip.key == clipKey) {
+                        keyIndex = static_cast<int>(clipIndex);
+                        break;
+                    }
+                    if (nameIndex < 0 && clip.name == animation.currentClip) {
+                        nameIndex = static_cast<int>(clipIndex);
+                    }
+                }
+                animation.currentClipIndex = keyIndex >= 0 ? keyIndex : (nameIndex >= 0 ? nameIndex : 0);
+                if (!animation.clips.empty() && animation.currentClip.empty()) {
+                    animation.currentClip = animation.clips[0]->name;
+                    animation.duration = animation.clips[0]->duration;
+                }
 
                 registry.emplace<AnimationComponent>(entity, animation);
             }
@@ -285,5 +351,17 @@ namespace OGLE {
 
             m_world.SyncModelTransform(entity);
         }
+
+        if (pendingParents.empty()) {
+            return;
+        }
+
+        for (const auto& [child, savedParentId] : pendingParents) {
+            const auto it = savedIdToEntity.find(savedParentId);
+            if (it != savedIdToEntity.end()) {
+                m_world.SetParent(child, it->second);
+            }
+        }
+        m_world.UpdateTransforms();
     }
 }
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include "SystemScheduler.h"
+
+#include "Logger.h"
+#include "core/JobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace OGLE {
+    bool SystemAccess::Intersects(const std::vector<ComponentAccess>& lhs, const std::vector<ComponentAccess>& rhs) {
+        for (const auto& left : lhs) {
+            for (const auto& right : rhs) {
+                if (left.id == right.id) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    bool SystemAccess::ConflictsWith(const SystemAccess& other) const {
+        if (m_exclusive || other.m_exclusive) {
+            return true;
+        }
+
+        return Intersects(m_writes, other.m_writes)
+            || Intersects(m_writes, other.m_reads)
+            || Intersects(m_reads, other.m_writes);
+    }
+
+    void SystemAccess::AssureStorages(entt::registry& registry) const {
+        for (const auto& component : m_reads) {
+            component.assure(registry);
+        }
+        for (const auto& component : m_writes) {
+            component.assure(registry);
+        }
+    }
+
+    std::string SystemAccess::Describe() const {
+        std::ostringstream stream;
+        if (m_exclusive) {
+            stream << "exclusive";
+        } else {
+            auto list = [&stream](const char* label, const std::vector<ComponentAccess>& components) {
+                stream << label << '{';
+                for (std::size_t i = 0; i < components.size(); ++i) {
+                    stream << (i > 0 ? ", " : "") << components[i].name;
+                }
+                stream << '}';
+            };
+            list("R", m_reads);
+            stream << ' ';
+            list("W", m_writes);
+        }
+
+        if (m_mainThread) {
+            stream << " [main thread]";
+        }
+        return stream.str();
+    }
+
+    SystemScheduler::SystemScheduler(entt::registry& registry) : m_registry(registry) {}
+
+    void SystemScheduler::AddSystem(SystemDescriptor system) {
+        RemoveSystem(system.name);
+        system.access.AssureStorages(m_registry);
+
+        Node node;
+        node.system = std::move(system);
+        m_nodes.push_back(std::move(node));
+        m_scheduleDirty = true;
+    }
+
+    bool SystemScheduler::RemoveSystem(const std::string& name) {
+        const auto it = std::find_if(m_nodes.begin(), m_nodes.end(), [&name](const Node& node) {
+            return node.system.name == name;
+        });
+        if (it == m_nodes.end()) {
+            return false;
+        }
+
+        m_nodes.erase(it);
+        m_scheduleDirty = true;
+        return true;
+    }
+
+    bool SystemScheduler::HasSystem(const std::string& name) const {
+        return std::any_of(m_nodes.begin(), m_nodes.end(), [&name](const Node& node) {
+            return node.system.name == name;
+        });
+    }
+
+    void SystemScheduler::BuildSchedule() {
+        std::stable_sort(m_nodes.begin(), m_nodes.end(), [](const Node& lhs, const Node& rhs) {
+            return lhs.system.order < rhs.system.order;
+        });
+
+        // Ребро j -> i для каждой более ранней конфликтующей системы; стадия узла —
+        // на единицу больше самой поздней из его зависимостей.
+        m_stages.clear();
+        for (std::size_t i = 0; i < m_nodes.size(); ++i) {
+            Node& node = m_nodes[i];
+            node.dependencies.clear();
+            node.stage = 0;
+            for (std::size_t j = 0; j < i; ++j) {
+                if (node.system.access.ConflictsWith(m_nodes[j].system.access)) {
+                    node.dependencies.push_back(j);
+                    node.stage = std::max(node.stage, m_nodes[j].stage + 1);
+                }
+            }
+
+            if (m_stages.size() <= node.stage) {
+                m_stages.resize(node.stage + 1);
+            }
+            m_stages[node.stage].push_back(i);
+        }
+
+        m_scheduleDirty = false;
+        LOG_INFO(DumpSchedule());
+    }
+
+    void SystemScheduler::RunNode(Node& node, float deltaTime) {
+        const auto start = std::chrono::steady_clock::now();
+        if (node.system.update) {
+            node.system.update(deltaTime);
+        }
+        node.lastMilliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        node.totalMilliseconds += node.lastMilliseconds;
+        ++node.runCount;
+    }
+
+    void SystemScheduler::Run(float deltaTime) {
+        if (m_scheduleDirty) {
+            BuildSchedule();
+        }
+
+        JobSystem& jobSystem = JobSystem::Instance();
+        std::vector<JobSystem::JobHandle> handles;
+        for (const auto& stage : m_stages) {
+            if (stage.size() == 1) {
+                RunNode(m_nodes[stage.front()], deltaTime);
+                continue;
+            }
+
+            handles.clear();
+            for (const std::size_t index : stage) {
+                if (!m_nodes[index].system.access.IsMainThread()) {
+                    Node* node = &m_nodes[index];
+                    handles.push_back(jobSystem.Schedule([this, node, deltaTime]() { RunNode(*node, deltaTime); }));
+                }
+            }
+            for (const std::size_t index : stage) {
+                if (m_nodes[index].system.access.IsMainThread()) {
+                    RunNode(m_nodes[index], deltaTime);
+                }
+            }
+            for (const auto& handle : handles) {
+                jobSystem.Wait(handle);
+            }
+        }
+    }
+
+    std::vector<SystemScheduler::SystemTiming> SystemScheduler::GetTimings() const {
+        std::vector<SystemTiming> timings;
+        timings.reserve(m_nodes.size());
+        for (const Node& node : m_nodes) {
+            SystemTiming timing;
+            timing.name = node.system.name;
+            timing.stage = node.stage;
+            timing.lastMilliseconds = node.lastMilliseconds;
+            timing.averageMilliseconds = node.runCount > 0
+                ? static_cast<float>(node.totalMilliseconds / static_cast<double>(node.runCount))
+                : 0.0f;
+            timings.push_back(timing);
+        }
+        return timings;
+    }
+
+    std::string SystemScheduler::DumpSchedule() const {
+        std::ostringstream stream;
+        stream << "System schedule: " << m_nodes.size() << " systems, " << m_stages.size() << " stages";
+        stream << std::fixed << std::setprecision(3);
+
+        for (std::size_t stageIndex = 0; stageIndex < m_stages.size(); ++stageIndex) {
+            stream << "\n  stage " << stageIndex << ':';
+            for (const std::size_t index : m_stages[stageIndex]) {
+                const Node& node = m_nodes[index];
+                stream << "\n    " << node.system.name << " (order " << node.system.order << ") "
+                       << node.system.access.Describe();
+
+                if (!node.dependencies.empty()) {
+                    stream << " after ";
+                    for (std::size_t i = 0; i < node.dependencies.size(); ++i) {
+                        stream << (i > 0 ? ", " : "") << m_nodes[node.dependencies[i]].system.name;
+                    }
+                }
+
+                if (node.runCount > 0) {
+                    stream << " | last " << node.lastMilliseconds << " ms, avg "
+                           << node.totalMilliseconds / static_cast<double>(node.runCount) << " ms";
+                }
+            }
+        }
+        return stream.str();
+    }
+}
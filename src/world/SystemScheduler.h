@@ -0,0 +1,134 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace OGLE {
+    // Порядок среди конфликтующих систем: меньшее значение выполняется раньше.
+    // Системы без общих компонентов выполняются параллельно независимо от порядка.
+    namespace SystemOrder {
+        constexpr int AssetUploads = -100;
+        constexpr int Scripts = 0;
+        constexpr int Physics = 100;
+        constexpr int Animation = 200;
+        constexpr int Skinning = 300;
+        constexpr int Transforms = 1000;
+        // Обработчики столкновений вызывают скрипты — после всех систем кадра.
+        constexpr int CollisionEvents = 1100;
+    }
+
+    // Какие компоненты система читает и пишет.
+    class SystemAccess {
+    public:
+        template<typename... Components>
+        SystemAccess& Reads() {
+            (Add<Components>(m_reads), ...);
+            return *this;
+        }
+
+        template<typename... Components>
+        SystemAccess& Writes() {
+            (Add<Components>(m_writes), ...);
+            return *this;
+        }
+
+        // Система меняет состояние вне реестра (скрипты) — конфликтует со всеми.
+        SystemAccess& Exclusive() {
+            m_exclusive = true;
+            return *this;
+        }
+
+        // Система обязана выполняться в вызывающем потоке (GL-контекст, колбэки скриптов).
+        SystemAccess& MainThread() {
+            m_mainThread = true;
+            return *this;
+        }
+
+        bool IsExclusive() const { return m_exclusive; }
+        bool IsMainThread() const { return m_mainThread; }
+
+        bool ConflictsWith(const SystemAccess& other) const;
+        // Создаёт хранилища заранее: во время параллельного кадра структура реестра не меняется.
+        void AssureStorages(entt::registry& registry) const;
+        std::string Describe() const;
+
+    private:
+        struct ComponentAccess {
+            entt::id_type id;
+            std::string_view name;
+            void (*assure)(entt::registry&);
+        };
+
+        template<typename Component>
+        static void Add(std::vector<ComponentAccess>& target) {
+            target.push_back({
+                entt::type_hash<Component>::value(),
+                entt::type_name<Component>::value(),
+                [](entt::registry& registry) { registry.storage<Component>(); }
+            });
+        }
+
+        static bool Intersects(const std::vector<ComponentAccess>& lhs, const std::vector<ComponentAccess>& rhs);
+
+        std::vector<ComponentAccess> m_reads;
+        std::vector<ComponentAccess> m_writes;
+        bool m_exclusive = false;
+        bool m_mainThread = false;
+    };
+
+    struct SystemDescriptor {
+        std::string name;
+        int order = 0;
+        SystemAccess access;
+        std::function<void(float)> update;
+    };
+
+    // Строит по объявленным read/write-наборам граф зависимостей и раскладывает
+    // системы по стадиям: внутри стадии конфликтов нет, и системы идут параллельно
+    // через JobSystem. Граф перестраивается только при добавлении/удалении систем.
+    class SystemScheduler {
+    public:
+        struct SystemTiming {
+            std::string name;
+            std::size_t stage = 0;
+            float lastMilliseconds = 0.0f;
+            float averageMilliseconds = 0.0f;
+        };
+
+        explicit SystemScheduler(entt::registry& registry);
+
+        void AddSystem(SystemDescriptor system);
+        bool RemoveSystem(const std::string& name);
+        bool HasSystem(const std::string& name) const;
+
+        void Run(float deltaTime);
+
+        std::vector<SystemTiming> GetTimings() const;
+        // Стадии, зависимости, read/write-наборы и замеры времени в текстовом виде.
+        std::string DumpSchedule() const;
+
+    private:
+        struct Node {
+            SystemDescriptor system;
+            std::vector<std::size_t> dependencies;
+            std::size_t stage = 0;
+            float lastMilliseconds = 0.0f;
+            double totalMilliseconds = 0.0;
+            std::uint64_t runCount = 0;
+        };
+
+        void BuildSchedule();
+        void RunNode(Node& node, float deltaTime);
+
+        entt::registry& m_registry;
+        std::vector<Node> m_nodes;
+        std::vector<std::vector<std::size_t>> m_stages;
+        bool m_scheduleDirty = true;
+    };
+}
@@ -1,11 +1,15 @@
 #include "World.h"
 
 #include "core/FileSystem.h"
+#include "models/MeshCache.h"
 #include "SceneSerializer.h"
+#include "SystemScheduler.h"
 #include "systems/AnimationSystem.h"
 #include "systems/RenderSystem.h"
+#include "systems/SkinningSystem.h"
 #include "systems/TransformSystem.h"
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 
@@ -14,10 +18,39 @@ namespace OGLE {
         m_serializer = std::make_unique<SceneSerializer>(*this);
         m_transformSystem = std::make_unique<TransformSystem>(m_registry);
         m_animationSystem = std::make_unique<AnimationSystem>(m_registry);
+        m_skinningSystem = std::make_unique<SkinningSystem>(m_registry);
         m_renderSystem = std::make_unique<RenderSystem>(m_registry);
-    }
 
-    World::~World() = default;
+        m_scheduler = std::make_unique<SystemScheduler>(m_registry);
+        m_scheduler->AddSystem({
+            "Animation",
+            SystemOrder::Animation,
+            SystemAccess().Reads<WorldObjectComponent, ModelComponent>().Writes<AnimationComponent, AnimationPoseComponent>(),
+            [this](float deltaTime) { m_animationSystem->Update(deltaTime); }
+        });
+        // Скиннинг сам распараллеливает работу, но загружает вершинные буферы — нужен GL-контекст.
+        m_scheduler->AddSystem({
+            "Skinning",
+            SystemOrder::Skinning,
+            SystemAccess()
+                .Reads<WorldObjectComponent, AnimationComponent, AnimationPoseComponent, SkeletonComponent>()
+                .Writes<ModelComponent, SkinningStateComponent>()
+                .MainThread(),
+            [this](float) { m_skinningSystem->Update(); }
+        });
+        m_scheduler->AddSystem({
+            "Transforms",
+            SystemOrder::Transforms,
+            SystemAccess()
+                .Reads<TransformComponent>()
+                .Writes<WorldMatrixComponent, TransformDirtyTag, HierarchyComponent, ModelComponent, AnimationPoseComponent, WorldBoundsComponent>(),
+            [this](float) { m_transformSystem->UpdateDirtyTransforms(); }
+        });
+    }
+
+    World::~World() {
+        CancelPendingImports();
+    }
 
     WorldObject World::CreateWorldObject(const std::string& name, WorldObjectKind kind) {
         const Entity entity = m_registry.create();
@@ -47,13 +80,24 @@ namespace OGLE {
     }
 
     void World::DestroyEntity(Entity entity) {
-        if (IsValid(entity)) {
-            if (const auto* nameComponent = m_registry.try_get<NameComponent>(entity)) {
+        if (!IsValid(entity)) {
+            return;
+        }
+
+        // Потомки уничтожаются вместе с родителем (от листьев к корню),
+        // чтобы в иерархии не оставалось висячих ссылок.
+        std::vector<Entity> subtree;
+        m_transformSystem->CollectDescendants(entity, subtree);
+        subtree.push_back(entity);
+        m_transformSystem->SetParent(entity, entt::null);
+
+        for (const Entity current : subtree) {
+            if (const auto* nameComponent = m_registry.try_get<NameComponent>(current)) {
                 if (!nameComponent->value.empty()) {
                     m_nameToEntityMap.erase(nameComponent->value);
                 }
             }
-            m_registry.destroy(entity);
+            m_registry.destroy(current);
         }
     }
 
@@ -75,16 +119,21 @@ namespace OGLE {
         m_registry.emplace<ModelComponent>(entity, std::move(model));
         m_registry.emplace<MaterialComponent>(entity, m_registry.get<ModelComponent>(entity).model ? m_registry.get<ModelComponent>(entity).model->GetMaterial() : Material{ });
         m_registry.emplace<PrimitiveComponent>(entity);
+        if (m_registry.get<ModelComponent>(entity).model && m_registry.get<ModelComponent>(entity).model->GetLODs()) {
+            m_registry.emplace<LODComponent>(entity);
+        }
         SyncModelTransform(entity);
         return entity;
     }
 
     Entity World::CreateModelFromFile(const std::string& filePath, ModelType type, const std::string& name) {
-        auto model = std::make_shared<ModelEntity>(type, filePath);
-        if (!model->LoadFromFile(filePath)) {
+        // Повторные экземпляры файла не импортируются заново и делят буферы GPU.
+        auto mesh = MeshCache::Instance().GetModelFile(filePath);
+        if (!mesh) {
             return entt::null;
         }
-        model->BakeToGPU();
+        auto model = std::make_shared<ModelEntity>(type, filePath);
+        model->ShareMesh(std::move(mesh));
         // if (!model->GetLoadedDiffuseTexturePath().empty()) {
         //     model->SetDiffuseTexturePath(model->GetLoadedDiffuseTexturePath());
         // }
@@ -95,6 +144,84 @@ namespace OGLE {
             primitive.sourcePath = filePath;
         }
 
+        ApplyModelFileComponents(entity, filePath);
+        return entity;
+    }
+
+    Entity World::CreateModelHierarchyFromFile(const std::string& filePath, ModelType type, const std::string& name) {
+        const auto scene = MeshCache::Instance().GetModelScene(filePath);
+        if (!scene) {
+            return CreateModelFromFile(filePath, type, name);
+        }
+
+        // Корень — точка размещения модели; корневой узел файла становится его потомком,
+        // чтобы трансформ сущности не затирал трансформ узла.
+        const Entity root = CreateEntity(name);
+        std::vector<Entity> nodeEntities(scene->nodes.size(), entt::null);
+        for (std::size_t i = 0; i < scene->nodes.size(); ++i) {
+            const ModelSceneNode& node = scene->nodes[i];
+            const std::string nodeName = name + "/" + (node.name.empty() ? "node_" + std::to_string(i) : node.name);
+
+            // Узел с одним мешем сам рисует его; несколько мешей — дочерние сущности узла.
+            Entity entity = entt::null;
+            if (node.meshes.size() == 1) {
+                auto model = std::make_shared<ModelEntity>(type);
+                model->ShareMesh(scene->meshes[node.meshes.front()]);
+                entity = AddModel(std::move(model), nodeName);
+            } else {
+                entity = CreateEntity(nodeName);
+                for (std::size_t m = 0; m < node.meshes.size(); ++m) {
+                    auto model = std::make_shared<ModelEntity>(type);
+                    model->ShareMesh(scene->meshes[node.meshes[m]]);
+                    const Entity meshEntity = AddModel(std::move(model), nodeName + "#" + std::to_string(m));
+                    SetParent(meshEntity, entity);
+                }
+            }
+
+            SetTransform(entity, node.position, node.rotation, node.scale);
+            SetParent(entity, node.parent >= 0 ? nodeEntities[node.parent] : root);
+            nodeEntities[i] = entity;
+        }
+        return root;
+    }
+
+    Entity World::CreateModelFromFileAsync(const std::string& filePath, ModelType type, const std::string& name) {
+        auto model = std::make_shared<ModelEntity>(type, filePath);
+        model->ShareMesh(MeshCache::Instance().GetPrimitive(PrimitiveType::Cube));
+        const Entity entity = AddModel(std::move(model), name);
+        // Сцена, сохранённая до конца импорта, всё равно ссылается на файл.
+        auto& primitive = m_registry.get<PrimitiveComponent>(entity);
+        primitive.type = PrimitiveType::ModelFile;
+        primitive.sourcePath = filePath;
+
+        auto ticket = std::make_shared<ModelImportTicket>(kInvalidModelImportTicket);
+        *ticket = ModelImportQueue::Instance().ImportAsync(filePath, [this, entity, filePath, ticket](std::shared_ptr<const SharedMesh> mesh) {
+            m_pendingImports.erase(std::remove(m_pendingImports.begin(), m_pendingImports.end(), *ticket), m_pendingImports.end());
+
+            ModelEntity* placeholder = GetModel(entity);
+            if (!placeholder) {
+                return; // Сущность удалили, пока шёл импорт
+            }
+            const bool loaded = mesh != nullptr;
+            if (loaded) {
+                placeholder->ShareMesh(std::move(mesh));
+                ApplyModelFileComponents(entity, filePath);
+                // Границы заглушки заменены границами файла.
+                MarkTransformDirty(entity);
+            }
+            m_readyModels.push_back(ModelReadyEvent{entity, filePath, loaded});
+        });
+        m_pendingImports.push_back(*ticket);
+        return entity;
+    }
+
+    std::vector<ModelReadyEvent> World::TakeReadyModels() {
+        std::vector<ModelReadyEvent> ready;
+        ready.swap(m_readyModels);
+        return ready;
+    }
+
+    void World::ApplyModelFileComponents(Entity entity, const std::string& filePath) {
         const ModelEntity* loadedModel = GetModel(entity);
         if (loadedModel) {
             const auto& modelClips = loadedModel->GetAnimationClips();
@@ -103,10 +230,11 @@ namespace OGLE {
                     m_registry.emplace<AnimationComponent>(entity);
                 }
                 auto& animation = m_registry.get<AnimationComponent>(entity);
+                // Копируются только ссылки: ключи клипов общие для всех экземпляров модели.
                 animation.clips = modelClips;
                 animation.currentClipIndex = 0;
-                animation.currentClip = modelClips[0].name;
-                animation.duration = modelClips[0].duration;
+                animation.currentClip = modelClips[0]->name;
+                animation.duration = modelClips[0]->duration;
                 animation.currentTime = 0.0f;
                 animation.enabled = true;
             }
@@ -116,16 +244,17 @@ namespace OGLE {
                 skeleton.enabled = true;
                 skeleton.boneCount = loadedModel->GetBoneCount();
                 skeleton.sourcePath = filePath;
-                m_registry.emplace<SkeletonComponent>(entity, skeleton);
+                m_registry.emplace_or_replace<SkeletonComponent>(entity, skeleton);
             }
-        }
 
-        return entity;
+            if (loadedModel->GetLODs() && !m_registry.all_of<LODComponent>(entity)) {
+                m_registry.emplace<LODComponent>(entity);
+            }
+        }
     }
 
     void World::Update(float deltaTime) {
-        m_transformSystem->SyncAllModels();
-        m_animationSystem->Update(deltaTime);
+        m_scheduler->Run(deltaTime);
     }
 
     void World::Draw() {
@@ -133,9 +262,18 @@ namespace OGLE {
     }
 
     void World::Clear() {
+        CancelPendingImports();
         m_registry.clear();
         m_nameToEntityMap.clear();
     }
+
+    void World::CancelPendingImports() {
+        for (const ModelImportTicket ticket : m_pendingImports) {
+            ModelImportQueue::Instance().Cancel(ticket);
+        }
+        m_pendingImports.clear();
+        m_readyModels.clear();
+    }
     
     void World::Save(const std::string& path) {
         m_serializer->Save(path);
@@ -221,6 +359,56 @@ namespace OGLE {
 
     void World::SyncModelTransform(Entity entity) {
         m_transformSystem->SyncModelTransform(entity);
+        m_renderSystem->MarkTransformDirty(entity);
+    }
+
+    bool World::SetParent(Entity child, Entity parent) {
+        return m_transformSystem->SetParent(child, parent);
+    }
+
+    Entity World::GetParent(Entity entity) const {
+        return m_transformSystem->GetParent(entity);
+    }
+
+    std::vector<Entity> World::GetChildren(Entity entity) const {
+        std::vector<Entity> children;
+        if (const auto* node = GetComponent<HierarchyComponent>(entity)) {
+            children.reserve(node->childCount);
+            for (Entity child = node->firstChild; child != entt::null;
+                 child = m_registry.get<HierarchyComponent>(child).nextSibling) {
+                children.push_back(child);
+            }
+        }
+        return children;
+    }
+
+    void World::MarkTransformDirty(Entity entity) {
+        m_transformSystem->MarkDirty(entity);
+    }
+
+    void World::UpdateTransforms() {
+        m_transformSystem->UpdateDirtyTransforms();
+        m_renderSystem->Sync();
+    }
+
+    const RenderProxies& World::GetRenderProxies() const {
+        return m_renderSystem->GetProxies();
+    }
+
+    void World::MarkRenderStateDirty(Entity entity) {
+        m_renderSystem->MarkBindingDirty(entity);
+    }
+
+    const glm::mat4* World::GetWorldMatrix(Entity entity) const {
+        if (const auto* worldMatrix = GetComponent<WorldMatrixComponent>(entity)) {
+            return &worldMatrix->matrix;
+        }
+        return nullptr;
+    }
+
+    const WorldBoundsComponent* World::GetWorldBounds(Entity entity) const {
+        const auto* bounds = GetComponent<WorldBoundsComponent>(entity);
+        return bounds && bounds->valid ? bounds : nullptr;
     }
 
     void World::SetTransform(
@@ -229,38 +417,37 @@ namespace OGLE {
         const glm::vec3& rotation,
         const glm::vec3& scale) {
 
-        if (auto* transform = GetComponent<TransformComponent>(entity)) {
-            transform->position = position;
-            transform->rotation = rotation;
-            transform->scale = scale;
-            SyncModelTransform(entity);
+        if (!IsValid(entity) || !m_registry.all_of<TransformComponent>(entity)) {
+            return;
         }
+
+        // patch() поднимает on_update, TransformSystem помечает сущность как изменённую.
+        m_registry.patch<TransformComponent>(entity, [&](TransformComponent& transform) {
+            transform.position = position;
+            transform.rotation = rotation;
+            transform.scale = scale;
+        });
     }
 
-    void World::MakeModelUnique(Entity entity)
+    bool World::MakeModelUnique(Entity entity)
     {
         auto* modelComp = m_registry.try_get<ModelComponent>(entity);
         if (!modelComp || !modelComp->model) {
-            return;
+            return false;
         }
 
-        if (modelComp->model.use_count() <= 1) {
-            return; // Already unique
+        // Копирование при записи: своя ModelEntity, только если её делят несколько сущностей,
+        // и своя геометрия, только если меш общий (MeshCache) — иначе ничего не копируется.
+        if (modelComp->model.use_count() > 1) {
+            // patch: прокси отрисовки должен увидеть новую модель.
+            m_registry.patch<ModelComponent>(entity, [](ModelComponent& component) {
+                component.model = std::make_shared<ModelEntity>(*component.model);
+            });
         }
-
-        // Create a deep copy of the ModelEntity
-        auto originalModel = modelComp->model;
-
-        // Create a new model. The file path is made unique to indicate it's a copy.
-        auto newModel = std::make_shared<ModelEntity>(originalModel->GetType(), originalModel->GetFilePath() + " (Unique)");
-
-        // Copy geometry data. SetMeshData will create a new MeshBuffer.
-        newModel->SetMeshData(originalModel->GetVertices(), originalModel->GetIndices());
-
-        // Copy material
-        newModel->GetMaterial() = originalModel->GetMaterial();
-
-        // Replace the shared_ptr in the component
-        modelComp->model = newModel;
+        if (!modelComp->model->DetachMesh()) {
+            return false;
+        }
+        SyncModelTransform(entity);
+        return true;
     }
 }
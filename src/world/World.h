@@ -3,13 +3,18 @@
 #include "WorldComponents.h"
 #include "WorldObject.h"
 
+#include "../core/Events.h"
 #include "../models/ModelEntity.h"
+#include "../models/ModelImportQueue.h"
 
 namespace OGLE {
     class SceneSerializer;
     class TransformSystem;
     class AnimationSystem;
+    class SkinningSystem;
     class RenderSystem;
+    class SystemScheduler;
+    struct RenderProxies;
 
 
     class World {
@@ -33,15 +38,33 @@ namespace OGLE {
             const std::string& filePath,
             ModelType type = ModelType::DYNAMIC,
             const std::string& name = "Model");
+        // Сразу возвращает сущность с кубом-заглушкой; меш файла подставляется, когда
+        // ModelImportQueue импортирует его в фоне и загрузит в GPU. Итог — в TakeReadyModels.
+        Entity CreateModelFromFileAsync(
+            const std::string& filePath,
+            ModelType type = ModelType::DYNAMIC,
+            const std::string& name = "Model");
+        // Дерево узлов файла: корневая сущность с именем name и потомки с трансформами
+        // узлов. Меш, на который ссылаются несколько узлов, у всех один (MeshCache::GetModelScene).
+        // Модели с костями или анимациями создаются целиком, как в CreateModelFromFile.
+        Entity CreateModelHierarchyFromFile(
+            const std::string& filePath,
+            ModelType type = ModelType::DYNAMIC,
+            const std::string& name = "Model");
+        // Фоновые импорты, завершившиеся с прошлого вызова (успешно или нет).
+        std::vector<ModelReadyEvent> TakeReadyModels();
 
         void Clear();
 
+        // Выполняет зарегистрированные системы через SystemScheduler.
         void Update(float deltaTime);
         void Draw();
         void Save(const std::string& path);
         void Load(const std::string& path);
 
-        void MakeModelUnique(Entity entity);
+        // Даёт сущности собственные модель и геометрию перед их изменением;
+        // false — геометрию скопировать нельзя (см. BaseModel::DetachMesh).
+        bool MakeModelUnique(Entity entity);
 
         bool IsValid(Entity entity) const;
         bool HasModel(Entity entity) const;
@@ -73,6 +96,8 @@ namespace OGLE {
         PhysicsBodyComponent* GetPhysicsBody(Entity entity);
         const PhysicsBodyComponent* GetPhysicsBody(Entity entity) const;
 
+        // После смены программы или видимости через эти указатели вызывайте
+        // MarkRenderStateDirty (patch/emplace_or_replace делают это сами).
         MaterialComponent* GetMaterial(Entity entity);
         const MaterialComponent* GetMaterial(Entity entity) const;
 
@@ -82,7 +107,27 @@ namespace OGLE {
         PrimitiveComponent* GetPrimitive(Entity entity);
         const PrimitiveComponent* GetPrimitive(Entity entity) const;
 
+        // Иерархия трансформов: мировая матрица потомка = мировая матрица родителя * локальная.
+        // parent == entt::null отсоединяет сущность; циклы отклоняются (возвращается false).
+        bool SetParent(Entity child, Entity parent);
+        Entity GetParent(Entity entity) const;
+        std::vector<Entity> GetChildren(Entity entity) const;
+
         void SyncModelTransform(Entity entity);
+        // Помечает трансформ изменённым после прямой записи в TransformComponent
+        // (SetTransform и registry.patch делают это сами).
+        void MarkTransformDirty(Entity entity);
+        // Пересчитывает мировые матрицы помеченных сущностей. Вызывается из Update,
+        // а также рендером перед кадром, чтобы правки после Update не запаздывали.
+        // Заодно переносит изменения в RenderProxies.
+        void UpdateTransforms();
+        // Данные моделей для отрисовки на момент последнего UpdateTransforms (RenderSystem).
+        const RenderProxies& GetRenderProxies() const;
+        // Модель, материал, программа или видимость сущности изменены на месте.
+        void MarkRenderStateDirty(Entity entity);
+        const glm::mat4* GetWorldMatrix(Entity entity) const;
+        // Мировые границы меша на момент последнего UpdateTransforms; nullptr без меша.
+        const WorldBoundsComponent* GetWorldBounds(Entity entity) const;
 
         void SetTransform(
             Entity entity,
@@ -90,12 +135,19 @@ namespace OGLE {
             const glm::vec3& rotation,
             const glm::vec3& scale);
 
+        SystemScheduler& GetScheduler() { return *m_scheduler; }
+        const SystemScheduler& GetScheduler() const { return *m_scheduler; }
+
         entt::registry& GetRegistry() { return m_registry; }
         const entt::registry& GetRegistry() const { return m_registry; }
 
     private:
         friend class SceneSerializer;
 
+        // Анимация, скелет и LOD сущности по мешу файла, уже переданному её модели.
+        void ApplyModelFileComponents(Entity entity, const std::string& filePath);
+        void CancelPendingImports();
+
         entt::registry m_registry;
         // Ускоряет поиск сущностей по имени. Заполняется при создании/загрузке/переименовании.
         std::unordered_map<std::string, Entity> m_nameToEntityMap;
@@ -103,6 +155,11 @@ namespace OGLE {
         std::unique_ptr<SceneSerializer> m_serializer;
         std::unique_ptr<TransformSystem> m_transformSystem;
         std::unique_ptr<AnimationSystem> m_animationSystem;
+        std::unique_ptr<SkinningSystem> m_skinningSystem;
         std::unique_ptr<RenderSystem> m_renderSystem;
+        std::unique_ptr<SystemScheduler> m_scheduler;
+
+        std::vector<ModelImportTicket> m_pendingImports;
+        std::vector<ModelReadyEvent> m_readyModels;
     };
 }
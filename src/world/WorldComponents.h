@@ -2,12 +2,15 @@
 
 #include <entt/entt.hpp>
 #include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
 #include <glm/gtc/quaternion.hpp>
 
 #include "../render/Material.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace OGLE {
     class ModelEntity;
@@ -40,11 +43,59 @@ namespace OGLE {
         glm::vec3 scale{ 1.0f, 1.0f, 1.0f };    // Масштаб
     };
 
+    // Связь родитель/потомки. Потомки хранятся интрузивным двусвязным списком
+    // (без выделения памяти на узел). TransformComponent потомка задаётся
+    // относительно родителя. Компонент есть только у сущностей, участвующих в иерархии.
+    struct HierarchyComponent {
+        entt::entity parent = entt::null;      // Родитель (entt::null — корень)
+        entt::entity firstChild = entt::null;  // Первый прямой потомок
+        entt::entity prevSibling = entt::null; // Предыдущий потомок того же родителя
+        entt::entity nextSibling = entt::null; // Следующий потомок того же родителя
+        std::uint32_t childCount = 0;          // Количество прямых потомков
+        std::uint32_t depth = 0;               // Глубина в дереве (0 — корень)
+    };
+
+    // Кэшированная мировая матрица объекта. Пересчитывается TransformSystem
+    // один раз за кадр и только для сущностей с TransformDirtyTag.
+    struct WorldMatrixComponent {
+        glm::mat4 matrix{ 1.0f }; // parentWorld * (translate * rotX * rotY * rotZ * scale)
+    };
+
+    // Мировые границы меша сущности: AABB, охватывающий повёрнутый локальный AABB,
+    // и сфера. Есть у каждой сущности с ModelComponent; пересчитываются TransformSystem
+    // вместе с мировой матрицей (BoundsSystem), то есть только при изменении трансформа
+    // или локальных границ модели (новая геометрия, общий меш).
+    struct WorldBoundsComponent {
+        glm::vec3 min{ 0.0f };
+        glm::vec3 max{ 0.0f };
+        glm::vec3 center{ 0.0f };
+        float radius = 0.0f;
+        bool valid = false; // false — у модели нет меша
+        std::uint64_t modelRevision = 0; // BaseModel::GetBoundsRevision, из которой посчитаны границы
+    };
+
+    // Тег "трансформ изменился". Ставится при создании/patch TransformComponent
+    // (сигналы entt), через World::SetTransform или World::MarkTransformDirty.
+    // Снимается после пересчёта WorldMatrixComponent.
+    struct TransformDirtyTag {};
+
     // Компонент, содержащий ссылку на 3D-модель (меш) объекта.
     struct ModelComponent {
         std::shared_ptr<ModelEntity> model; // Умный указатель на ресурс модели
     };
 
+    // Выбор уровня детализации по размеру на экране (LODSystem). Сами уровни лежат
+    // в модели (BaseModel::GetLODs); компонент есть у сущностей, модели которых их имеют.
+    struct LODComponent {
+        // Удаление на месте: RenderProxies держит указатели на компонент (RenderSystem).
+        static constexpr auto in_place_delete = true;
+
+        float screenSizeBias = 1.0f; // Множитель размера на экране: больше 1 — детальные уровни дольше
+        int forcedLevel = -1;        // >= 0 — уровень зафиксирован (отладка)
+        int level = 0;               // Выбранный в последнем кадре уровень, 0 — исходный меш. Не сериализуется.
+        float screenSize = 0.0f;     // Доля высоты экрана в последнем кадре. Не сериализуется.
+    };
+
     // Перечисление для определения исходного типа геометрии объекта.
     enum class PrimitiveType {
         None,           // Нет примитива
@@ -67,6 +118,8 @@ namespace OGLE {
     // Компонент, содержащий данные о материале объекта.
     // Вынесен отдельно от модели, чтобы материалы можно было переиспользовать.
     struct MaterialComponent {
+        static constexpr auto in_place_delete = true; // См. LODComponent
+
         // Старый вариант для обратной совместимости
         Material material; 
 
@@ -75,6 +128,7 @@ namespace OGLE {
     };
 
     struct ShaderComponent {
+        static constexpr auto in_place_delete = true; // См. LODComponent
         std::string programName = "default"; // Имя шейдерной программы, выбранной для объекта
     };
 
@@ -95,32 +149,47 @@ namespace OGLE {
     };
 
     // Компонент для хранения данных о скелете модели.
-    // Пока что заготовка для будущей поддержки скиннинга и анимации.
+    // Сами кости и веса лежат в модели (BaseModel::GetSkin), здесь — включение скиннинга.
     struct SkeletonComponent {
         bool enabled = false;      // Включен ли скелет
         int boneCount = 0;         // Количество костей
         std::string sourcePath;    // Путь к файлу, откуда был загружен скелет
     };
 
-    struct AnimationKeyframe {
-        float time = 0.0f;
-        glm::vec3 translation{0.0f, 0.0f, 0.0f};
-        glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
-        glm::vec3 scale{1.0f, 1.0f, 1.0f};
+    // Поворот, сжатый по схеме smallest three (48 бит вместо 128): индекс наибольшей
+    // по модулю компоненты в порядке w, x, y, z (2 бита) и три остальные по 15 бит со знаком.
+    // Нулевые биты — единичный кватернион. Упаковка/распаковка — AnimationCompressor.
+    struct PackedQuat {
+        std::uint16_t bits[3] = {0, 0, 0};
+    };
+
+    // Ключи одного свойства узла. Каналы трека независимы: у каждого свои времена,
+    // неизменный канал хранится одним ключом, пустой — значение по умолчанию.
+    template <typename T>
+    struct AnimationChannel {
+        std::vector<float> times;
+        std::vector<T> values;
     };
 
     struct AnimationTrack {
         std::string nodeName;
-        std::vector<AnimationKeyframe> keyframes;
+        AnimationChannel<glm::vec3> translation;
+        AnimationChannel<PackedQuat> rotation;
+        AnimationChannel<glm::vec3> scale;
     };
 
     struct AnimationClip {
         std::string name;
+        std::string key;             // Ключ в AnimationLibrary ("источник#имя"); в сцены пишется только он
         float duration = 1.0f;
         float ticksPerSecond = 24.0f;
         std::vector<AnimationTrack> tracks;
     };
 
+    // Клипы неизменяемы и хранятся в AnimationLibrary в одном экземпляре;
+    // модели и сущности держат только ссылку, клип живёт, пока на него ссылаются.
+    using AnimationClipHandle = std::shared_ptr<const AnimationClip>;
+
     // Компонент для управления состоянием анимации.
     // Хранится отдельно от модели, чтобы можно было гибко управлять проигрыванием.
     struct AnimationComponent {
@@ -131,10 +200,31 @@ namespace OGLE {
         float playbackSpeed = 1.0f;  // Скорость воспроизведения
         float duration = 1.0f;       // Длительность клипа в секундах
         std::string currentClip;     // Название текущего анимационного клипа
-        std::vector<AnimationClip> clips; // Список доступных клипов для сущности
+        std::vector<AnimationClipHandle> clips; // Доступные клипы (общие с моделью, не копии)
         int currentClipIndex = 0;    // Индекс текущего клипа
     };
 
+    // Результат сэмплирования клипа (буфер позы). Заполняется AnimationSystem,
+    // читается TransformSystem (корневой трек) и скиннингом. Не сериализуется.
+    struct AnimationPoseComponent {
+        int clipIndex = -1;                   // Клип, под который подготовлены курсоры
+        int rootTrack = -1;                   // Трек узла с мешем; -1 — трансформ сущности не меняется
+        bool changed = false;                 // Поза пересчитана в текущем кадре
+        std::vector<std::uint32_t> cursors;   // Ключ слева от текущего времени: по 3 на трек (смещение, поворот, масштаб)
+        std::vector<glm::vec3> translations;  // Локальные смещения узлов, по трекам
+        std::vector<glm::quat> rotations;     // Локальные повороты узлов, по трекам
+        std::vector<glm::vec3> scales;        // Локальные масштабы узлов, по трекам
+    };
+
+    // Состояние CPU-скиннинга сущности (SkinningSystem). Не сериализуется.
+    struct SkinningStateComponent {
+        int clipIndex = -1;                  // Клип, под который построено соответствие суставов трекам
+        bool skinned = false;                // Вершины модели уже не в bind-позе
+        std::vector<int> jointTracks;        // Трек позы для каждого сустава; -1 — bind-поза сустава
+        std::vector<glm::mat4> jointGlobals; // Глобальные матрицы суставов текущего кадра
+        std::vector<glm::mat4> palette;      // Матрицы костей для скиннинга вершин
+    };
+
     // Компонент для привязки скрипта к сущности.
     // Хранит только информацию о том, какой скрипт использовать.
     struct ScriptComponent {
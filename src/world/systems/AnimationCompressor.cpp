@@ -0,0 +1,226 @@
+#include "AnimationCompressor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace OGLE {
+    namespace {
+        // Три меньшие компоненты единичного кватерниона лежат в [-1/sqrt(2), 1/sqrt(2)].
+        constexpr float kSmallestThreeRange = 0.70710678f;
+        constexpr int kComponentBits = 15;
+        constexpr int kComponentMax = (1 << (kComponentBits - 1)) - 1;
+        constexpr std::uint64_t kComponentMask = (1ull << kComponentBits) - 1;
+
+        // Размер ключа прежнего формата: время, смещение, поворот, масштаб.
+        constexpr std::size_t kSourceKeyBytes = sizeof(float) + sizeof(glm::vec3) * 2 + sizeof(glm::quat);
+
+        glm::vec3 LerpVec3(const glm::vec3& a, const glm::vec3& b, float t) {
+            return a + (b - a) * t;
+        }
+
+        float Vec3Error(const glm::vec3& a, const glm::vec3& b) {
+            const glm::vec3 d = a - b;
+            return std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z);
+        }
+
+        glm::quat NlerpQuat(const glm::quat& a, glm::quat b, float t) {
+            if (glm::dot(a, b) < 0.0f) {
+                b = -b;
+            }
+            return glm::normalize(glm::quat(
+                a.w + (b.w - a.w) * t,
+                a.x + (b.x - a.x) * t,
+                a.y + (b.y - a.y) * t,
+                a.z + (b.z - a.z) * t));
+        }
+
+        // Угол между поворотами в радианах. Через длину хорды |a - b| = 2 sin(angle / 4):
+        // acos от скалярного произведения в float не различает углы меньше ~1e-3.
+        float QuatError(const glm::quat& a, glm::quat b) {
+            if (glm::dot(a, b) < 0.0f) {
+                b = -b;
+            }
+            const float dx = a.x - b.x;
+            const float dy = a.y - b.y;
+            const float dz = a.z - b.z;
+            const float dw = a.w - b.w;
+            const float chord = std::sqrt(dx * dx + dy * dy + dz * dz + dw * dw);
+            return 4.0f * std::asin(std::min(1.0f, chord * 0.5f));
+        }
+
+        // Жадное прореживание: ключ i остаётся, только если отрезок от последнего
+        // оставленного ключа до i + 1 не описывает все промежуточные ключи в пределах допуска.
+        template <typename T, typename Lerp, typename Error>
+        std::vector<std::size_t> ReduceKeys(const std::vector<float>& times, const std::vector<T>& values, float tolerance, Lerp lerp, Error error) {
+            const std::size_t count = std::min(times.size(), values.size());
+            std::vector<std::size_t> kept;
+            if (count == 0) {
+                return kept;
+            }
+
+            const bool constant = std::all_of(values.begin(), values.begin() + count, [&](const T& value) {
+                return error(value, values[0]) <= tolerance;
+            });
+            kept.push_back(0);
+            if (constant || count == 1) {
+                return kept;
+            }
+
+            for (std::size_t i = 1; i + 1 < count; ++i) {
+                const std::size_t anchor = kept.back();
+                const std::size_t next = i + 1;
+                const float span = times[next] - times[anchor];
+                bool fits = true;
+                for (std::size_t k = anchor + 1; k <= i && fits; ++k) {
+                    const float alpha = span > 0.0f ? (times[k] - times[anchor]) / span : 0.0f;
+                    fits = error(lerp(values[anchor], values[next], alpha), values[k]) <= tolerance;
+                }
+                if (!fits) {
+                    kept.push_back(i);
+                }
+            }
+            kept.push_back(count - 1);
+            return kept;
+        }
+
+        AnimationChannel<glm::vec3> CompressVec3Channel(const std::vector<float>& times, const std::vector<glm::vec3>& values, float tolerance) {
+            AnimationChannel<glm::vec3> channel;
+            const auto kept = ReduceKeys(times, values, tolerance, LerpVec3, Vec3Error);
+            channel.times.reserve(kept.size());
+            channel.values.reserve(kept.size());
+            for (const std::size_t index : kept) {
+                channel.times.push_back(times[index]);
+                channel.values.push_back(values[index]);
+            }
+            return channel;
+        }
+
+        std::uint64_t QuantizeComponent(float value) {
+            const float normalized = std::clamp(value / kSmallestThreeRange, -1.0f, 1.0f);
+            const auto quantized = static_cast<std::int32_t>(std::lround(normalized * kComponentMax));
+            return static_cast<std::uint64_t>(quantized) & kComponentMask;
+        }
+
+        float DequantizeComponent(std::uint64_t bits) {
+            // Расширение знака 15-битного числа.
+            std::int32_t value = static_cast<std::int32_t>(bits & kComponentMask);
+            if (value > kComponentMax) {
+                value -= static_cast<std::int32_t>(kComponentMask + 1);
+            }
+            return static_cast<float>(value) / kComponentMax * kSmallestThreeRange;
+        }
+    }
+
+    PackedQuat AnimationCompressor::PackQuat(const glm::quat& rotation) {
+        const glm::quat q = glm::normalize(rotation);
+        float components[4] = {q.w, q.x, q.y, q.z};
+
+        std::uint64_t largest = 0;
+        for (std::uint64_t i = 1; i < 4; ++i) {
+            if (std::fabs(components[i]) > std::fabs(components[largest])) {
+                largest = i;
+            }
+        }
+        // q и -q — один поворот: наибольшая компонента всегда положительна и восстанавливается по модулю.
+        const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+
+        std::uint64_t packed = largest << (kComponentBits * 3);
+        int shift = kComponentBits * 2;
+        for (std::uint64_t i = 0; i < 4; ++i) {
+            if (i != largest) {
+                packed |= QuantizeComponent(components[i] * sign) << shift;
+                shift -= kComponentBits;
+            }
+        }
+
+        PackedQuat result;
+        result.bits[0] = static_cast<std::uint16_t>(packed >> 32);
+        result.bits[1] = static_cast<std::uint16_t>(packed >> 16);
+        result.bits[2] = static_cast<std::uint16_t>(packed);
+        return result;
+    }
+
+    glm::quat AnimationCompressor::UnpackQuat(const PackedQuat& packed) {
+        const std::uint64_t bits =
+            (static_cast<std::uint64_t>(packed.bits[0]) << 32) |
+            (static_cast<std::uint64_t>(packed.bits[1]) << 16) |
+            static_cast<std::uint64_t>(packed.bits[2]);
+
+        const std::uint64_t largest = (bits >> (kComponentBits * 3)) & 3u;
+        float components[4];
+        float sumSquares = 0.0f;
+        int shift = kComponentBits * 2;
+        for (std::uint64_t i = 0; i < 4; ++i) {
+            if (i != largest) {
+                components[i] = DequantizeComponent(bits >> shift);
+                sumSquares += components[i] * components[i];
+                shift -= kComponentBits;
+            }
+        }
+        components[largest] = std::sqrt(std::max(0.0f, 1.0f - sumSquares));
+        return glm::quat(components[0], components[1], components[2], components[3]);
+    }
+
+    AnimationTrack AnimationCompressor::CompressTrack(const AnimationTrackSource& source, const AnimationCompressionSettings& settings) {
+        AnimationTrack track;
+        track.nodeName = source.nodeName;
+        track.translation = CompressVec3Channel(source.translationTimes, source.translations, settings.translationTolerance);
+        track.scale = CompressVec3Channel(source.scaleTimes, source.scales, settings.scaleTolerance);
+
+        // Повороты приводятся к одной полусфере, чтобы ошибка считалась по кратчайшей дуге.
+        std::vector<glm::quat> rotations(source.rotations.size());
+        for (std::size_t i = 0; i < rotations.size(); ++i) {
+            rotations[i] = glm::normalize(source.rotations[i]);
+            if (i > 0 && glm::dot(rotations[i - 1], rotations[i]) < 0.0f) {
+                rotations[i] = -rotations[i];
+            }
+        }
+
+        const auto kept = ReduceKeys(source.rotationTimes, rotations, settings.rotationTolerance, NlerpQuat, QuatError);
+        track.rotation.times.reserve(kept.size());
+        track.rotation.values.reserve(kept.size());
+        for (const std::size_t index : kept) {
+            track.rotation.times.push_back(source.rotationTimes[index]);
+            track.rotation.values.push_back(PackQuat(rotations[index]));
+        }
+        return track;
+    }
+
+    AnimationClip AnimationCompressor::CompressClip(const AnimationClipSource& source, const AnimationCompressionSettings& settings) {
+        AnimationClip clip;
+        clip.name = source.name;
+        clip.duration = source.duration;
+        clip.ticksPerSecond = source.ticksPerSecond;
+        clip.tracks.reserve(source.tracks.size());
+        for (const auto& track : source.tracks) {
+            clip.tracks.push_back(CompressTrack(track, settings));
+        }
+        return clip;
+    }
+
+    std::size_t AnimationCompressor::GetSourceBytes(const AnimationClipSource& source) {
+        std::size_t bytes = 0;
+        std::vector<float> timeline;
+        for (const auto& track : source.tracks) {
+            timeline.clear();
+            timeline.insert(timeline.end(), track.translationTimes.begin(), track.translationTimes.end());
+            timeline.insert(timeline.end(), track.rotationTimes.begin(), track.rotationTimes.end());
+            timeline.insert(timeline.end(), track.scaleTimes.begin(), track.scaleTimes.end());
+            std::sort(timeline.begin(), timeline.end());
+            const auto keyCount = static_cast<std::size_t>(std::unique(timeline.begin(), timeline.end()) - timeline.begin());
+            bytes += keyCount * kSourceKeyBytes;
+        }
+        return bytes;
+    }
+
+    std::size_t AnimationCompressor::GetCompressedBytes(const AnimationClip& clip) {
+        std::size_t bytes = 0;
+        for (const auto& track : clip.tracks) {
+            bytes += track.translation.times.size() * sizeof(float) + track.translation.values.size() * sizeof(glm::vec3);
+            bytes += track.rotation.times.size() * sizeof(float) + track.rotation.values.size() * sizeof(PackedQuat);
+            bytes += track.scale.times.size() * sizeof(float) + track.scale.values.size() * sizeof(glm::vec3);
+        }
+        return bytes;
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "world/WorldComponents.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace OGLE {
+    // Допуски прореживания ключей: ключ выбрасывается, если интерполяция соседних
+    // оставшихся ключей воспроизводит его с ошибкой не больше допуска.
+    struct AnimationCompressionSettings {
+        float translationTolerance = 0.0005f; // Единицы сцены
+        float rotationTolerance = 0.001f;     // Радианы
+        float scaleTolerance = 0.0005f;
+    };
+
+    // Несжатый трек в том виде, как его отдаёт импорт (Assimp, старые .omdl).
+    struct AnimationTrackSource {
+        std::string nodeName;
+        std::vector<float> translationTimes;
+        std::vector<glm::vec3> translations;
+        std::vector<float> rotationTimes;
+        std::vector<glm::quat> rotations;
+        std::vector<float> scaleTimes;
+        std::vector<glm::vec3> scales;
+    };
+
+    struct AnimationClipSource {
+        std::string name;
+        float duration = 1.0f;
+        float ticksPerSecond = 24.0f;
+        std::vector<AnimationTrackSource> tracks;
+    };
+
+    // Сжатие клипов при импорте: раздельные каналы, прореживание ключей с
+    // ограниченной ошибкой и повороты smallest three. Сэмплер читает результат напрямую.
+    class AnimationCompressor {
+    public:
+        static AnimationClip CompressClip(const AnimationClipSource& source, const AnimationCompressionSettings& settings);
+        static AnimationTrack CompressTrack(const AnimationTrackSource& source, const AnimationCompressionSettings& settings);
+
+        static PackedQuat PackQuat(const glm::quat& rotation);
+        static glm::quat UnpackQuat(const PackedQuat& packed);
+
+        // Размер ключей в прежнем формате: общий таймлайн каналов, 44 байта на ключ.
+        static std::size_t GetSourceBytes(const AnimationClipSource& source);
+        static std::size_t GetCompressedBytes(const AnimationClip& clip);
+    };
+}
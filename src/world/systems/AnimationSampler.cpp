@@ -0,0 +1,234 @@
+#include "AnimationSampler.h"
+#include "AnimationCompressor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <glm/gtc/quaternion.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OGLE_ANIMATION_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace OGLE {
+    namespace {
+#ifdef OGLE_ANIMATION_SSE
+        inline __m128 LoadVec3(const glm::vec3& value) {
+            return _mm_setr_ps(value.x, value.y, value.z, 0.0f);
+        }
+
+        inline __m128 LoadQuat(const glm::quat& value) {
+            return _mm_setr_ps(value.x, value.y, value.z, value.w);
+        }
+
+        inline __m128 Lerp(__m128 a, __m128 b, __m128 t) {
+            return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t));
+        }
+
+        // Скалярное произведение, размноженное во все 4 компоненты.
+        inline __m128 Dot4(__m128 a, __m128 b) {
+            __m128 product = _mm_mul_ps(a, b);
+            __m128 shuffled = _mm_shuffle_ps(product, product, _MM_SHUFFLE(2, 3, 0, 1));
+            __m128 sums = _mm_add_ps(product, shuffled);
+            shuffled = _mm_shuffle_ps(sums, sums, _MM_SHUFFLE(1, 0, 3, 2));
+            return _mm_add_ps(sums, shuffled);
+        }
+
+        inline void StoreVec3(__m128 value, glm::vec3& out) {
+            alignas(16) float lanes[4];
+            _mm_store_ps(lanes, value);
+            out = glm::vec3(lanes[0], lanes[1], lanes[2]);
+        }
+
+        inline void StoreQuat(__m128 value, glm::quat& out) {
+            alignas(16) float lanes[4];
+            _mm_store_ps(lanes, value);
+            out.x = lanes[0];
+            out.y = lanes[1];
+            out.z = lanes[2];
+            out.w = lanes[3];
+        }
+#endif
+
+        // Пары значений и веса одного вызова SampleClip по каналам; thread_local,
+        // чтобы параллельные вызовы не выделяли память каждый кадр.
+        struct SampleBatch {
+            std::vector<glm::vec3> translationFrom;
+            std::vector<glm::vec3> translationTo;
+            std::vector<float> translationAlpha;
+            std::vector<glm::quat> rotationFrom;
+            std::vector<glm::quat> rotationTo;
+            std::vector<float> rotationAlpha;
+            std::vector<glm::vec3> scaleFrom;
+            std::vector<glm::vec3> scaleTo;
+            std::vector<float> scaleAlpha;
+        };
+
+        thread_local SampleBatch t_batch;
+
+        constexpr std::size_t kChannelsPerTrack = 3;
+
+        // Сдвигает курсор канала к времени time; возвращает индексы пары ключей и вес.
+        // Для пустого канала возвращает false — берётся значение по умолчанию.
+        bool SeekChannel(const std::vector<float>& times, float time, std::uint32_t& cursor, std::size_t& from, std::size_t& to, float& alpha) {
+            const std::size_t keyCount = times.size();
+            if (keyCount == 0) {
+                return false;
+            }
+
+            if (cursor >= keyCount || times[cursor] > time) {
+                // Перемотка назад: ищем заново, дальше снова идём по одному ключу.
+                const auto it = std::upper_bound(times.begin(), times.end(), time);
+                cursor = it == times.begin() ? 0u : static_cast<std::uint32_t>((it - times.begin()) - 1);
+            }
+            while (cursor + 1 < keyCount && times[cursor + 1] <= time) {
+                ++cursor;
+            }
+
+            from = cursor;
+            if (cursor + 1 >= keyCount || time <= times[cursor]) {
+                to = cursor;
+                alpha = 0.0f;
+                return true;
+            }
+
+            to = cursor + 1;
+            const float span = times[to] - times[from];
+            alpha = span > 0.0f ? (time - times[from]) / span : 0.0f;
+            return true;
+        }
+    }
+
+    void AnimationSampler::BindClip(const AnimationClip& clip, int clipIndex, const std::string& rootNodeName, AnimationPoseComponent& pose) {
+        const std::size_t trackCount = clip.tracks.size();
+        pose.clipIndex = clipIndex;
+        pose.cursors.assign(trackCount * kChannelsPerTrack, 0);
+        pose.translations.assign(trackCount, glm::vec3(0.0f));
+        pose.rotations.assign(trackCount, glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+        pose.scales.assign(trackCount, glm::vec3(1.0f));
+
+        pose.rootTrack = -1;
+        if (!rootNodeName.empty()) {
+            for (std::size_t track = 0; track < trackCount; ++track) {
+                if (clip.tracks[track].nodeName == rootNodeName) {
+                    pose.rootTrack = static_cast<int>(track);
+                    break;
+                }
+            }
+        }
+    }
+
+    void AnimationSampler::SampleClip(const AnimationClip& clip, float time, AnimationPoseComponent& pose) {
+        const std::size_t trackCount = std::min(clip.tracks.size(), pose.cursors.size() / kChannelsPerTrack);
+
+        SampleBatch& batch = t_batch;
+        batch.translationFrom.resize(trackCount);
+        batch.translationTo.resize(trackCount);
+        batch.translationAlpha.resize(trackCount);
+        batch.rotationFrom.resize(trackCount);
+        batch.rotationTo.resize(trackCount);
+        batch.rotationAlpha.resize(trackCount);
+        batch.scaleFrom.resize(trackCount);
+        batch.scaleTo.resize(trackCount);
+        batch.scaleAlpha.resize(trackCount);
+
+        std::size_t from = 0;
+        std::size_t to = 0;
+        float alpha = 0.0f;
+        for (std::size_t track = 0; track < trackCount; ++track) {
+            const AnimationTrack& source = clip.tracks[track];
+            std::uint32_t* cursors = pose.cursors.data() + track * kChannelsPerTrack;
+
+            if (SeekChannel(source.translation.times, time, cursors[0], from, to, alpha)) {
+                batch.translationFrom[track] = source.translation.values[from];
+                batch.translationTo[track] = source.translation.values[to];
+                batch.translationAlpha[track] = alpha;
+            } else {
+                batch.translationFrom[track] = batch.translationTo[track] = glm::vec3(0.0f);
+                batch.translationAlpha[track] = 0.0f;
+            }
+
+            if (SeekChannel(source.rotation.times, time, cursors[1], from, to, alpha)) {
+                batch.rotationFrom[track] = AnimationCompressor::UnpackQuat(source.rotation.values[from]);
+                batch.rotationTo[track] = to == from ? batch.rotationFrom[track] : AnimationCompressor::UnpackQuat(source.rotation.values[to]);
+                batch.rotationAlpha[track] = alpha;
+            } else {
+                batch.rotationFrom[track] = batch.rotationTo[track] = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+                batch.rotationAlpha[track] = 0.0f;
+            }
+
+            if (SeekChannel(source.scale.times, time, cursors[2], from, to, alpha)) {
+                batch.scaleFrom[track] = source.scale.values[from];
+                batch.scaleTo[track] = source.scale.values[to];
+                batch.scaleAlpha[track] = alpha;
+            } else {
+                batch.scaleFrom[track] = batch.scaleTo[track] = glm::vec3(1.0f);
+                batch.scaleAlpha[track] = 0.0f;
+            }
+        }
+
+        LerpVec3(batch.translationFrom.data(), batch.translationTo.data(), batch.translationAlpha.data(), trackCount, pose.translations.data());
+        NlerpQuat(batch.rotationFrom.data(), batch.rotationTo.data(), batch.rotationAlpha.data(), trackCount, pose.rotations.data());
+        LerpVec3(batch.scaleFrom.data(), batch.scaleTo.data(), batch.scaleAlpha.data(), trackCount, pose.scales.data());
+    }
+
+    void AnimationSampler::LerpVec3(const glm::vec3* from, const glm::vec3* to, const float* alpha, std::size_t count, glm::vec3* out) {
+#ifdef OGLE_ANIMATION_SSE
+        for (std::size_t i = 0; i < count; ++i) {
+            StoreVec3(Lerp(LoadVec3(from[i]), LoadVec3(to[i]), _mm_set1_ps(alpha[i])), out[i]);
+        }
+#else
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = from[i] + (to[i] - from[i]) * alpha[i];
+        }
+#endif
+    }
+
+    void AnimationSampler::NlerpQuat(const glm::quat* from, const glm::quat* to, const float* alpha, std::size_t count, glm::quat* out) {
+#ifdef OGLE_ANIMATION_SSE
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        const __m128 zero = _mm_setzero_ps();
+        for (std::size_t i = 0; i < count; ++i) {
+            // nlerp по кратчайшей дуге: при отрицательном dot инвертируем второй кватернион.
+            const __m128 q0 = LoadQuat(from[i]);
+            __m128 q1 = LoadQuat(to[i]);
+            const __m128 flip = _mm_and_ps(_mm_cmplt_ps(Dot4(q0, q1), zero), signMask);
+            q1 = _mm_xor_ps(q1, flip);
+
+            const __m128 q = Lerp(q0, q1, _mm_set1_ps(alpha[i]));
+            const __m128 length = _mm_sqrt_ps(Dot4(q, q));
+            StoreQuat(_mm_div_ps(q, length), out[i]);
+        }
+#else
+        for (std::size_t i = 0; i < count; ++i) {
+            const glm::quat& a = from[i];
+            glm::quat b = to[i];
+            const float t = alpha[i];
+            if (glm::dot(a, b) < 0.0f) {
+                b = -b;
+            }
+            out[i] = glm::normalize(glm::quat(
+                a.w + (b.w - a.w) * t,
+                a.x + (b.x - a.x) * t,
+                a.y + (b.y - a.y) * t,
+                a.z + (b.z - a.z) * t));
+        }
+#endif
+    }
+
+    glm::mat4 AnimationSampler::ComposePoseMatrix(const AnimationPoseComponent& pose, int track) {
+        if (track < 0 || static_cast<std::size_t>(track) >= pose.rotations.size()) {
+            return glm::mat4(1.0f);
+        }
+
+        glm::mat4 matrix = glm::mat4_cast(pose.rotations[track]);
+        const glm::vec3& scale = pose.scales[track];
+        matrix[0] *= scale.x;
+        matrix[1] *= scale.y;
+        matrix[2] *= scale.z;
+        matrix[3] = glm::vec4(pose.translations[track], 1.0f);
+        return matrix;
+    }
+}
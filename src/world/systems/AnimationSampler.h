@@ -0,0 +1,30 @@
+#pragma once
+
+#include "world/WorldComponents.h"
+
+#include <cstddef>
+#include <string>
+
+namespace OGLE {
+    // Сэмплирование треков клипа в буфер позы.
+    // Для каждого канала трека хранится курсор (ключ слева от текущего времени): при
+    // последовательном проигрывании он сдвигается на 0–1 шаг, бинарный поиск
+    // нужен только при перемотке назад (зацикливание, seek). Повороты читаются
+    // прямо из сжатого вида (smallest three), распаковываются только два ключа канала.
+    class AnimationSampler {
+    public:
+        // Готовит позу под клип: размеры буферов, сброс курсоров, поиск корневого трека.
+        static void BindClip(const AnimationClip& clip, int clipIndex, const std::string& rootNodeName, AnimationPoseComponent& pose);
+
+        // Сэмплирует все треки клипа в момент time (секунды). Поза должна быть подготовлена BindClip.
+        static void SampleClip(const AnimationClip& clip, float time, AnimationPoseComponent& pose);
+
+        // Пакетная интерполяция: lerp для смещения/масштаба, nlerp по кратчайшей
+        // дуге для поворота. SSE на x86/x64, скалярный путь иначе.
+        static void LerpVec3(const glm::vec3* from, const glm::vec3* to, const float* alpha, std::size_t count, glm::vec3* out);
+        static void NlerpQuat(const glm::quat* from, const glm::quat* to, const float* alpha, std::size_t count, glm::quat* out);
+
+        // Локальная матрица узла из позы (T * R * S).
+        static glm::mat4 ComposePoseMatrix(const AnimationPoseComponent& pose, int track);
+    };
+}
@@ -1,28 +1,62 @@
 #include "AnimationSystem.h"
 #include <entt/entt.hpp>
 #include "world/WorldComponents.h"
+#include "core/JobSystem.h"
+#include "models/ModelEntity.h"
+#include "AnimationSampler.h"
 #include <cmath>
 
 namespace OGLE {
-    AnimationSystem::AnimationSystem(entt::basic_registry<>& registry) : m_registry(registry) {}
+    AnimationSystem::AnimationSystem(entt::basic_registry<>& registry) : m_registry(registry) {
+        m_registry.on_construct<AnimationComponent>().connect<&AnimationSystem::OnAnimationConstructed>(*this);
+        m_registry.on_destroy<AnimationComponent>().connect<&AnimationSystem::OnAnimationDestroyed>(*this);
+    }
+
+    AnimationSystem::~AnimationSystem() {
+        m_registry.on_construct<AnimationComponent>().disconnect(this);
+        m_registry.on_destroy<AnimationComponent>().disconnect(this);
+    }
+
+    void AnimationSystem::OnAnimationConstructed(entt::basic_registry<>& registry, entt::entity entity) {
+        // Буфер позы создаётся заранее: в параллельном Update структура реестра не меняется.
+        registry.get_or_emplace<AnimationPoseComponent>(entity);
+    }
+
+    void AnimationSystem::OnAnimationDestroyed(entt::basic_registry<>& registry, entt::entity entity) {
+        registry.remove<AnimationPoseComponent>(entity);
+    }
 
     void AnimationSystem::Update(float deltaTime) {
-        auto animationView = m_registry.view<AnimationComponent, WorldObjectComponent>();
-        for (auto entity : animationView) {
-            const auto& object = animationView.get<WorldObjectComponent>(entity);
-            if (!object.enabled) {
-                continue;
+        auto& animations = m_registry.storage<AnimationComponent>();
+        auto& poses = m_registry.storage<AnimationPoseComponent>();
+        const auto& objects = m_registry.storage<WorldObjectComponent>();
+        const auto& models = m_registry.storage<ModelComponent>();
+
+        // Каждая сущность меняет только свои AnimationComponent и позу — куски обрабатываются параллельно.
+        JobSystem::Instance().ParallelForEach(animations, [&](Entity entity) {
+            if (!poses.contains(entity)) {
+                return;
+            }
+            auto& pose = poses.get(entity);
+            pose.changed = false;
+            if (!objects.contains(entity) || !objects.get(entity).enabled) {
+                return;
             }
-            auto& animation = animationView.get<AnimationComponent>(entity);
+            auto& animation = animations.get(entity);
             if (!animation.enabled || !animation.playing) {
-                continue;
+                return;
             }
 
             animation.currentTime += animation.playbackSpeed * deltaTime;
 
-            float maxTime = animation.duration > 0.0f ? animation.duration : 3600.0f;
+            const AnimationClip* clip = nullptr;
             if (animation.currentClipIndex >= 0 && static_cast<size_t>(animation.currentClipIndex) < animation.clips.size()) {
-                maxTime = animation.clips[animation.currentClipIndex].duration;
+                clip = animation.clips[animation.currentClipIndex].get();
+            }
+
+            float maxTime = animation.duration > 0.0f ? animation.duration : 3600.0f;
+            if (clip) {
+                maxTime = clip->duration;
             }
 
             if (animation.loop) {
@@ -43,6 +77,21 @@ namespace OGLE {
             if (animation.currentTime < 0.0f) {
                 animation.currentTime = 0.0f;
             }
-        }
+
+            if (!clip) {
+                return;
+            }
+
+            if (pose.clipIndex != animation.currentClipIndex || pose.translations.size() != clip->tracks.size()) {
+                static const std::string kNoMeshNode;
+                const ModelEntity* model = models.contains(entity) ? models.get(entity).model.get() : nullptr;
+                // У скинированной модели узел меша уже учтён в палитре костей: трансформ сущности не трогаем.
+                const bool rootDriven = model && !model->GetSkin();
+                AnimationSampler::BindClip(*clip, animation.currentClipIndex, rootDriven ? model->GetMeshNodeName() : kNoMeshNode, pose);
+            }
+
+            AnimationSampler::SampleClip(*clip, animation.currentTime, pose);
+            pose.changed = true;
+        }, JobSystem::ChunkSizeFor(sizeof(AnimationComponent) + sizeof(AnimationPoseComponent)));
     }
 }
\ No newline at end of file
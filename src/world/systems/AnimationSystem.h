@@ -6,8 +6,14 @@ namespace OGLE {
     class AnimationSystem {
     public:
         explicit AnimationSystem(entt::basic_registry<>& registry);
+        ~AnimationSystem();
+
+        // Продвигает время проигрывания и сэмплирует текущий клип в AnimationPoseComponent.
         void Update(float deltaTime);
     private:
+        void OnAnimationConstructed(entt::basic_registry<>& registry, entt::entity entity);
+        void OnAnimationDestroyed(entt::basic_registry<>& registry, entt::entity entity);
+
         entt::basic_registry<>& m_registry;
     };
-}
\ No newline at end of file
+}
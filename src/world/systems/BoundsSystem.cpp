@@ -0,0 +1,117 @@
+#include "BoundsSystem.h"
+#include "core/JobSystem.h"
+#include "models/ModelEntity.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OGLE_BOUNDS_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace OGLE {
+    void BoundsSystem::TransformBounds(const MeshBounds& local, const glm::mat4& matrix, WorldBoundsComponent& world) {
+        world.valid = local.valid;
+        if (!local.valid) {
+            return;
+        }
+
+        const glm::vec3 extent = (local.max - local.min) * 0.5f;
+#ifdef OGLE_BOUNDS_SSE
+        const float* columns = &matrix[0][0];
+        const __m128 column0 = _mm_loadu_ps(columns);
+        const __m128 column1 = _mm_loadu_ps(columns + 4);
+        const __m128 column2 = _mm_loadu_ps(columns + 8);
+        const __m128 column3 = _mm_loadu_ps(columns + 12);
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+        const __m128 center = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(column0, _mm_set1_ps(local.center.x)), _mm_mul_ps(column1, _mm_set1_ps(local.center.y))),
+            _mm_add_ps(_mm_mul_ps(column2, _mm_set1_ps(local.center.z)), column3));
+        const __m128 halfSize = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(_mm_and_ps(column0, absMask), _mm_set1_ps(extent.x)),
+                       _mm_mul_ps(_mm_and_ps(column1, absMask), _mm_set1_ps(extent.y))),
+            _mm_mul_ps(_mm_and_ps(column2, absMask), _mm_set1_ps(extent.z)));
+
+        alignas(16) float centerLanes[4];
+        alignas(16) float minLanes[4];
+        alignas(16) float maxLanes[4];
+        _mm_store_ps(centerLanes, center);
+        _mm_store_ps(minLanes, _mm_sub_ps(center, halfSize));
+        _mm_store_ps(maxLanes, _mm_add_ps(center, halfSize));
+        world.center = glm::vec3(centerLanes[0], centerLanes[1], centerLanes[2]);
+        world.min = glm::vec3(minLanes[0], minLanes[1], minLanes[2]);
+        world.max = glm::vec3(maxLanes[0], maxLanes[1], maxLanes[2]);
+#else
+        const glm::mat3 linear(matrix);
+        const glm::vec3 center = glm::vec3(matrix * glm::vec4(local.center, 1.0f));
+        const glm::vec3 halfSize =
+            glm::abs(linear[0]) * extent.x + glm::abs(linear[1]) * extent.y + glm::abs(linear[2]) * extent.z;
+        world.center = center;
+        world.min = center - halfSize;
+        world.max = center + halfSize;
+#endif
+        // Сфера масштабируется по наибольшему масштабу осей.
+        const float scaleSquared = std::max({
+            glm::dot(glm::vec3(matrix[0]), glm::vec3(matrix[0])),
+            glm::dot(glm::vec3(matrix[1]), glm::vec3(matrix[1])),
+            glm::dot(glm::vec3(matrix[2]), glm::vec3(matrix[2]))});
+        world.radius = local.radius * std::sqrt(scaleSquared);
+    }
+
+    void BoundsSystem::Update(entt::basic_registry<>& registry, const entt::sparse_set& candidates) {
+        auto& bounds = registry.storage<WorldBoundsComponent>();
+        const auto& models = registry.storage<ModelComponent>();
+        const auto& worldMatrices = registry.storage<WorldMatrixComponent>();
+        const entt::sparse_set& smaller = bounds.size() < candidates.size()
+            ? static_cast<const entt::sparse_set&>(bounds)
+            : candidates;
+
+        JobSystem::Instance().ParallelForEach(smaller, [&](Entity entity) {
+            if (!candidates.contains(entity) || !bounds.contains(entity)) {
+                return;
+            }
+            WorldBoundsComponent& world = bounds.get(entity);
+            const ModelEntity* model = models.contains(entity) ? models.get(entity).model.get() : nullptr;
+            if (model) {
+                world.modelRevision = model->GetBoundsRevision();
+            }
+            if (!model || !worldMatrices.contains(entity)) {
+                world.valid = false;
+                return;
+            }
+            TransformBounds(model->GetBounds(), worldMatrices.get(entity).matrix, world);
+        }, JobSystem::ChunkSizeFor(sizeof(WorldBoundsComponent) + sizeof(WorldMatrixComponent)));
+    }
+
+    void BoundsSystem::UpdateEntity(entt::basic_registry<>& registry, Entity entity) {
+        auto* world = registry.try_get<WorldBoundsComponent>(entity);
+        if (!world) {
+            return;
+        }
+        const auto* model = registry.try_get<ModelComponent>(entity);
+        const auto* worldMatrix = registry.try_get<WorldMatrixComponent>(entity);
+        if (model && model->model) {
+            world->modelRevision = model->model->GetBoundsRevision();
+        }
+        if (!model || !model->model || !worldMatrix) {
+            world->valid = false;
+            return;
+        }
+        TransformBounds(model->model->GetBounds(), worldMatrix->matrix, *world);
+    }
+
+    void BoundsSystem::CollectStale(entt::basic_registry<>& registry, std::vector<Entity>& changed) {
+        const auto& bounds = registry.storage<WorldBoundsComponent>();
+        const auto& models = registry.storage<ModelComponent>();
+        for (const Entity entity : bounds) {
+            const ModelEntity* model = models.contains(entity) ? models.get(entity).model.get() : nullptr;
+            if (model && model->GetBoundsRevision() != bounds.get(entity).modelRevision) {
+                changed.push_back(entity);
+            }
+        }
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "world/WorldComponents.h"
+
+#include <entt/entt.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <vector>
+
+namespace OGLE {
+    struct MeshBounds;
+
+    // Перевод локальных границ меша (BaseModel::GetBounds) в мировые.
+    // AABB переносится без обхода восьми углов: центр умножается на матрицу,
+    // полуразмеры — на модуль её верхней 3x3 части (по столбцам, SSE).
+    class BoundsSystem {
+    public:
+        static void TransformBounds(const MeshBounds& local, const glm::mat4& matrix, WorldBoundsComponent& world);
+
+        // Пересчитывает WorldBoundsComponent сущностей из candidates, у которых он есть.
+        // Сущности обрабатываются пачками в JobSystem; структура реестра не меняется.
+        static void Update(entt::basic_registry<>& registry, const entt::sparse_set& candidates);
+        static void UpdateEntity(entt::basic_registry<>& registry, Entity entity);
+        // Добавляет в changed сущности, чьи модели сменили границы после последнего
+        // пересчёта (WorldBoundsComponent::modelRevision отстаёт от ревизии модели).
+        static void CollectStale(entt::basic_registry<>& registry, std::vector<Entity>& changed);
+    };
+}
@@ -0,0 +1,43 @@
+#include "LODSystem.h"
+#include "models/MeshSimplifier.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+
+namespace OGLE {
+    float LODSystem::ComputeScreenSize(const glm::vec3& center, float radius, const glm::vec3& cameraPosition, float projectionScaleY) {
+        const float distance = glm::length(center - cameraPosition);
+        if (distance <= radius) {
+            return 1.0f;
+        }
+        return std::min(1.0f, radius * projectionScaleY / distance);
+    }
+
+    int LODSystem::SelectLevel(float screenSize, const MeshLODChain& chain, const LODComponent& lod) {
+        const int levelCount = static_cast<int>(chain.levels.size());
+        if (lod.forcedLevel >= 0) {
+            return std::min(lod.forcedLevel, levelCount);
+        }
+
+        // Пороги убывают от уровня к уровню.
+        const float biasedSize = screenSize * lod.screenSizeBias;
+        int level = 0;
+        while (level < levelCount && biasedSize < chain.levels[level].screenSize) {
+            ++level;
+        }
+        return level;
+    }
+
+    int LODSystem::Update(LODComponent& lod, const MeshLODChain& chain, const glm::mat4& modelMatrix,
+        const glm::vec3& cameraPosition, float projectionScaleY) {
+        const glm::vec3 center = glm::vec3(modelMatrix * glm::vec4(chain.center, 1.0f));
+        const float scale = std::max({
+            glm::length(glm::vec3(modelMatrix[0])),
+            glm::length(glm::vec3(modelMatrix[1])),
+            glm::length(glm::vec3(modelMatrix[2]))});
+        lod.screenSize = ComputeScreenSize(center, chain.radius * scale, cameraPosition, projectionScaleY);
+        lod.level = SelectLevel(lod.screenSize, chain, lod);
+        return lod.level;
+    }
+}
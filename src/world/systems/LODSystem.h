@@ -0,0 +1,27 @@
+#pragma once
+
+#include "world/WorldComponents.h"
+
+#include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
+
+namespace OGLE {
+    struct MeshLODChain;
+
+    // Выбор уровня детализации по доле высоты экрана, которую занимает описанная
+    // сфера меша. Не зависит от OpenGL: рендер вызывает Update для каждой видимой
+    // модели, headless-сборка — напрямую.
+    class LODSystem {
+    public:
+        // Диаметр сферы на экране в долях высоты; projectionScaleY — projection[1][1]
+        // (ctg половины вертикального угла обзора). Камера внутри сферы — 1.
+        static float ComputeScreenSize(const glm::vec3& center, float radius, const glm::vec3& cameraPosition, float projectionScaleY);
+
+        // 0 — исходный меш, i — chain.levels[i - 1]: самый грубый уровень, порог которого выше размера.
+        static int SelectLevel(float screenSize, const MeshLODChain& chain, const LODComponent& lod);
+
+        // Пересчитывает lod.screenSize и lod.level для модели с мировой матрицей modelMatrix.
+        static int Update(LODComponent& lod, const MeshLODChain& chain, const glm::mat4& modelMatrix,
+            const glm::vec3& cameraPosition, float projectionScaleY);
+    };
+}
@@ -3,19 +3,198 @@
 #include "models/ModelEntity.h"
 
 namespace OGLE {
-    RenderSystem::RenderSystem(entt::basic_registry<>& registry) : m_registry(registry) {}
+    RenderSystem::RenderSystem(entt::basic_registry<>& registry) : m_registry(registry) {
+        m_registry.on_construct<ModelComponent>().connect<&RenderSystem::OnModelConstructed>(*this);
+        m_registry.on_update<ModelComponent>().connect<&RenderSystem::OnBindingChanged>(*this);
+        m_registry.on_destroy<ModelComponent>().connect<&RenderSystem::OnModelDestroyed>(*this);
+        m_registry.on_construct<MaterialComponent>().connect<&RenderSystem::OnBindingChanged>(*this);
+        m_registry.on_update<MaterialComponent>().connect<&RenderSystem::OnBindingChanged>(*this);
+        m_registry.on_destroy<MaterialComponent>().connect<&RenderSystem::OnBindingChanged>(*this);
+        m_registry.on_construct<ShaderComponent>().connect<&RenderSystem::OnBindingChanged>(*this);
+        m_registry.on_update<ShaderComponent>().connect<&RenderSystem::OnBindingChanged>(*this);
+        m_registry.on_destroy<ShaderComponent>().connect<&RenderSystem::OnBindingChanged>(*this);
+        m_registry.on_construct<LODComponent>().connect<&RenderSystem::OnBindingChanged>(*this);
+        m_registry.on_destroy<LODComponent>().connect<&RenderSystem::OnBindingChanged>(*this);
+        m_registry.on_update<WorldObjectComponent>().connect<&RenderSystem::OnBindingChanged>(*this);
+        m_registry.on_destroy<WorldObjectComponent>().connect<&RenderSystem::OnBindingChanged>(*this);
+        m_registry.on_construct<TransformDirtyTag>().connect<&RenderSystem::OnTransformDirty>(*this);
+    }
 
-    void RenderSystem::Draw() {
-        auto view = m_registry.view<ModelComponent, WorldObjectComponent>();
-        for (auto entity : view) {
-            const auto& object = view.get<WorldObjectComponent>(entity);
-            if (!object.visible) {
+    RenderSystem::~RenderSystem() {
+        m_registry.on_construct<ModelComponent>().disconnect(this);
+        m_registry.on_update<ModelComponent>().disconnect(this);
+        m_registry.on_destroy<ModelComponent>().disconnect(this);
+        m_registry.on_construct<MaterialComponent>().disconnect(this);
+        m_registry.on_update<MaterialComponent>().disconnect(this);
+        m_registry.on_destroy<MaterialComponent>().disconnect(this);
+        m_registry.on_construct<ShaderComponent>().disconnect(this);
+        m_registry.on_update<ShaderComponent>().disconnect(this);
+        m_registry.on_destroy<ShaderComponent>().disconnect(this);
+        m_registry.on_construct<LODComponent>().disconnect(this);
+        m_registry.on_destroy<LODComponent>().disconnect(this);
+        m_registry.on_update<WorldObjectComponent>().disconnect(this);
+        m_registry.on_destroy<WorldObjectComponent>().disconnect(this);
+        m_registry.on_construct<TransformDirtyTag>().disconnect(this);
+    }
+
+    void RenderSystem::OnModelConstructed(entt::basic_registry<>& registry, Entity entity) {
+        (void)registry;
+        const std::size_t slot = static_cast<std::size_t>(entt::to_entity(entity));
+        if (slot >= m_proxyIndex.size()) {
+            m_proxyIndex.resize(slot + 1, kNoProxy);
+        }
+        m_proxyIndex[slot] = static_cast<std::uint32_t>(m_proxies.size());
+
+        m_proxies.entities.push_back(entity);
+        m_proxies.models.push_back(nullptr);
+        m_proxies.materials.push_back(nullptr);
+        m_proxies.programNames.push_back(nullptr);
+        m_proxies.lods.push_back(nullptr);
+        m_proxies.worldMatrices.emplace_back(1.0f);
+        m_proxies.bounds.emplace_back(0.0f, 0.0f, 0.0f, -1.0f);
+        m_proxies.flags.push_back(0);
+        m_dirtyBits.push_back(0);
+        ++m_proxies.bindingRevision;
+
+        // До Sync прокси невидим: поля заполнятся вместе с остальными изменениями кадра.
+        MarkDirty(entity, DirtyTransform | DirtyBinding);
+    }
+
+    void RenderSystem::OnModelDestroyed(entt::basic_registry<>& registry, Entity entity) {
+        (void)registry;
+        const std::uint32_t index = FindProxy(entity);
+        if (index == kNoProxy) {
+            return;
+        }
+
+        const std::uint32_t last = static_cast<std::uint32_t>(m_proxies.size() - 1);
+        if (index != last) {
+            m_proxies.entities[index] = m_proxies.entities[last];
+            m_proxies.models[index] = m_proxies.models[last];
+            m_proxies.materials[index] = m_proxies.materials[last];
+            m_proxies.programNames[index] = m_proxies.programNames[last];
+            m_proxies.lods[index] = m_proxies.lods[last];
+            m_proxies.worldMatrices[index] = m_proxies.worldMatrices[last];
+            m_proxies.bounds[index] = m_proxies.bounds[last];
+            m_proxies.flags[index] = m_proxies.flags[last];
+            m_dirtyBits[index] = m_dirtyBits[last];
+            m_proxyIndex[static_cast<std::size_t>(entt::to_entity(m_proxies.entities[index]))] = index;
+        }
+
+        m_proxies.entities.pop_back();
+        m_proxies.models.pop_back();
+        m_proxies.materials.pop_back();
+        m_proxies.programNames.pop_back();
+        m_proxies.lods.pop_back();
+        m_proxies.worldMatrices.pop_back();
+        m_proxies.bounds.pop_back();
+        m_proxies.flags.pop_back();
+        m_dirtyBits.pop_back();
+        m_proxyIndex[static_cast<std::size_t>(entt::to_entity(entity))] = kNoProxy;
+        ++m_proxies.bindingRevision;
+    }
+
+    void RenderSystem::OnBindingChanged(entt::basic_registry<>& registry, Entity entity) {
+        (void)registry;
+        MarkDirty(entity, DirtyBinding);
+    }
+
+    void RenderSystem::OnTransformDirty(entt::basic_registry<>& registry, Entity entity) {
+        (void)registry;
+        MarkDirty(entity, DirtyTransform);
+    }
+
+    void RenderSystem::MarkBindingDirty(Entity entity) {
+        MarkDirty(entity, DirtyBinding);
+    }
+
+    void RenderSystem::MarkTransformDirty(Entity entity) {
+        MarkDirty(entity, DirtyTransform);
+    }
+
+    std::uint32_t RenderSystem::FindProxy(Entity entity) const {
+        const std::size_t slot = static_cast<std::size_t>(entt::to_entity(entity));
+        if (slot >= m_proxyIndex.size()) {
+            return kNoProxy;
+        }
+        const std::uint32_t index = m_proxyIndex[slot];
+        return index != kNoProxy && m_proxies.entities[index] == entity ? index : kNoProxy;
+    }
+
+    void RenderSystem::MarkDirty(Entity entity, std::uint8_t bits) {
+        const std::uint32_t index = FindProxy(entity);
+        if (index == kNoProxy) {
+            return;
+        }
+        if (m_dirtyBits[index] == 0) {
+            m_dirtyEntities.push_back(entity);
+        }
+        m_dirtyBits[index] |= bits;
+    }
+
+    void RenderSystem::Sync() {
+        for (const Entity entity : m_dirtyEntities) {
+            const std::uint32_t index = FindProxy(entity);
+            if (index == kNoProxy) {
                 continue;
             }
-            const auto& model = view.get<ModelComponent>(entity);
-            if (model.model) {
-                model.model->Draw();
+            const std::uint8_t bits = m_dirtyBits[index];
+            m_dirtyBits[index] = 0;
+            if (bits & DirtyBinding) {
+                RefreshBinding(index);
+            }
+            // Новая модель — новые границы, поэтому трансформ обновляется при любом бите.
+            RefreshTransform(index);
+        }
+        m_dirtyEntities.clear();
+    }
+
+    void RenderSystem::RefreshBinding(std::uint32_t index) {
+        const Entity entity = m_proxies.entities[index];
+        ModelEntity* model = m_registry.get<ModelComponent>(entity).model.get();
+        const auto* object = m_registry.try_get<WorldObjectComponent>(entity);
+        auto* materialComponent = m_registry.try_get<MaterialComponent>(entity);
+        const auto* shader = m_registry.try_get<ShaderComponent>(entity);
+
+        const Material* material = nullptr;
+        const std::string* programName = nullptr;
+        if (model) {
+            material = materialComponent ? &materialComponent->material : &model->GetMaterial();
+            if (shader) {
+                programName = shader->programName.empty() ? nullptr : &shader->programName;
+            } else if (!material->GetShaderProgram().empty()) {
+                programName = &material->GetShaderProgram();
+            }
+        }
+
+        m_proxies.models[index] = model;
+        m_proxies.materials[index] = material;
+        m_proxies.programNames[index] = programName;
+        m_proxies.lods[index] = m_registry.try_get<LODComponent>(entity);
+        m_proxies.flags[index] = model && object && object->enabled && object->visible ? RenderProxies::Visible : 0;
+        ++m_proxies.bindingRevision;
+    }
+
+    void RenderSystem::RefreshTransform(std::uint32_t index) {
+        const Entity entity = m_proxies.entities[index];
+        if (const auto* worldMatrix = m_registry.try_get<WorldMatrixComponent>(entity)) {
+            m_proxies.worldMatrices[index] = worldMatrix->matrix;
+        } else if (const ModelEntity* model = m_proxies.models[index]) {
+            m_proxies.worldMatrices[index] = model->GetModelMatrix();
+        }
+
+        const auto* bounds = m_registry.try_get<WorldBoundsComponent>(entity);
+        m_proxies.bounds[index] = bounds && bounds->valid
+            ? glm::vec4(bounds->center, bounds->radius)
+            : glm::vec4(glm::vec3(m_proxies.worldMatrices[index][3]), -1.0f);
+    }
+
+    void RenderSystem::Draw() {
+        Sync();
+        for (std::size_t i = 0; i < m_proxies.size(); ++i) {
+            if ((m_proxies.flags[i] & RenderProxies::Visible) && m_proxies.models[i]) {
+                m_proxies.models[i]->Draw();
             }
         }
     }
-}
\ No newline at end of file
+}
@@ -1,13 +1,88 @@
 #pragma once
 
+#include "world/WorldComponents.h"
+
 #include <entt/entt.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 namespace OGLE {
+    class Material;
+    class ModelEntity;
+
+    // Всё, что проходам отрисовки нужно о модели, в плотных массивах (SoA): проходы
+    // идут по ним линейно и не обращаются к реестру. Элемент i всех массивов —
+    // одна сущность с ModelComponent; порядок меняется при удалении (swap-and-pop).
+    struct RenderProxies {
+        enum Flags : std::uint8_t {
+            Visible = 1 << 0 // enabled && visible у WorldObjectComponent
+        };
+
+        std::vector<Entity> entities;
+        std::vector<ModelEntity*> models;
+        std::vector<const Material*> materials;       // MaterialComponent или материал модели
+        std::vector<const std::string*> programNames; // ShaderComponent или программа материала; nullptr — "default"
+        std::vector<LODComponent*> lods;              // nullptr — у модели нет уровней
+        std::vector<glm::mat4> worldMatrices;
+        std::vector<glm::vec4> bounds;                // xyz — центр сферы, w — радиус; w < 0 — меша нет
+        std::vector<std::uint8_t> flags;
+        // Растёт при любой смене модели, материала, программы или состава массивов.
+        // Рендерер по нему пересобирает то, что выводит из этих полей (программы GL).
+        std::uint64_t bindingRevision = 0;
+
+        std::size_t size() const { return entities.size(); }
+    };
+
+    // Ведёт RenderProxies по сигналам реестра: прокси создаётся и удаляется вместе
+    // с ModelComponent, привязки (модель, материал, программа, LOD, видимость)
+    // перечитываются при construct/update/destroy соответствующих компонентов,
+    // матрица и границы — при появлении TransformDirtyTag. Сами изменения копятся
+    // и применяются в Sync, после пересчёта трансформов.
+    //
+    // Указатели на MaterialComponent, ShaderComponent и LODComponent стабильны:
+    // эти компоненты удаляются на месте (in_place_delete), без переноса последнего.
+    // Меняя материал или программу на месте, вызывайте MarkBindingDirty
+    // (или registry.patch) — иначе прокси этого не увидит.
     class RenderSystem {
     public:
         explicit RenderSystem(entt::basic_registry<>& registry);
+        ~RenderSystem();
+
+        // Применяет накопленные изменения. Вызывается после UpdateDirtyTransforms.
+        void Sync();
+        void MarkBindingDirty(Entity entity);
+        void MarkTransformDirty(Entity entity);
+        const RenderProxies& GetProxies() const { return m_proxies; }
+
         void Draw();
+
     private:
+        enum DirtyBits : std::uint8_t {
+            DirtyTransform = 1 << 0,
+            DirtyBinding = 1 << 1
+        };
+
+        void OnModelConstructed(entt::basic_registry<>& registry, Entity entity);
+        void OnModelDestroyed(entt::basic_registry<>& registry, Entity entity);
+        void OnBindingChanged(entt::basic_registry<>& registry, Entity entity);
+        void OnTransformDirty(entt::basic_registry<>& registry, Entity entity);
+
+        std::uint32_t FindProxy(Entity entity) const;
+        void MarkDirty(Entity entity, std::uint8_t bits);
+        void RefreshBinding(std::uint32_t index);
+        void RefreshTransform(std::uint32_t index);
+
+        static constexpr std::uint32_t kNoProxy = 0xFFFFFFFFu;
+
         entt::basic_registry<>& m_registry;
+        RenderProxies m_proxies;
+        std::vector<std::uint8_t> m_dirtyBits;    // По индексу прокси
+        std::vector<Entity> m_dirtyEntities;      // Сущности, а не индексы: индексы сдвигает swap-and-pop
+        std::vector<std::uint32_t> m_proxyIndex;  // По entt::to_entity(entity); kNoProxy — нет прокси
     };
-}
\ No newline at end of file
+}
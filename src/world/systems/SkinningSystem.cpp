@@ -0,0 +1,249 @@
+#include "SkinningSystem.h"
+#include "AnimationSampler.h"
+#include "core/JobSystem.h"
+#include "models/ModelEntity.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <unordered_map>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OGLE_SKINNING_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace OGLE {
+    namespace {
+        constexpr std::size_t kVertexStride = 8;
+        constexpr std::size_t kVerticesPerChunk = 1024;
+    }
+
+    SkinningSystem::SkinningSystem(entt::basic_registry<>& registry) : m_registry(registry) {
+        m_registry.on_construct<SkeletonComponent>().connect<&SkinningSystem::OnSkeletonConstructed>(*this);
+        m_registry.on_destroy<SkeletonComponent>().connect<&SkinningSystem::OnSkeletonDestroyed>(*this);
+    }
+
+    SkinningSystem::~SkinningSystem() {
+        m_registry.on_construct<SkeletonComponent>().disconnect(this);
+        m_registry.on_destroy<SkeletonComponent>().disconnect(this);
+    }
+
+    void SkinningSystem::OnSkeletonConstructed(entt::basic_registry<>& registry, entt::entity entity) {
+        // Состояние создаётся заранее: в параллельном Update структура реестра не меняется.
+        registry.get_or_emplace<SkinningStateComponent>(entity);
+    }
+
+    void SkinningSystem::OnSkeletonDestroyed(entt::basic_registry<>& registry, entt::entity entity) {
+        registry.remove<SkinningStateComponent>(entity);
+    }
+
+    void SkinningSystem::Update() {
+        auto& states = m_registry.storage<SkinningStateComponent>();
+        const auto& skeletons = m_registry.storage<SkeletonComponent>();
+        const auto& objects = m_registry.storage<WorldObjectComponent>();
+        const auto& models = m_registry.storage<ModelComponent>();
+        const auto& poses = m_registry.storage<AnimationPoseComponent>();
+        const auto& animations = m_registry.storage<AnimationComponent>();
+
+        // Сбор задач последовательно: скинируются только модели, чья поза пересчитана в этом кадре.
+        m_tasks.clear();
+        for (const Entity entity : states) {
+            if (!skeletons.contains(entity) || !skeletons.get(entity).enabled) {
+                continue;
+            }
+            if (objects.contains(entity) && !objects.get(entity).enabled) {
+                continue;
+            }
+            if (!models.contains(entity) || !poses.contains(entity) || !animations.contains(entity)) {
+                continue;
+            }
+
+            ModelEntity* model = models.get(entity).model.get();
+            const SkinData* skin = model ? model->GetSkin() : nullptr;
+            const AnimationPoseComponent& pose = poses.get(entity);
+            if (!skin || !skin->IsValid() || !pose.changed) {
+                continue;
+            }
+            // Скинированные вершины у каждой сущности свои: общий меш копируется здесь, в главном потоке.
+            if (!model->DetachMesh()) {
+                continue;
+            }
+            std::vector<float>& vertices = model->GetMutableVertices();
+            if (vertices.size() != skin->bindVertices.size()) {
+                continue; // STATIC-модель без CPU-копии вершин
+            }
+
+            const auto& clips = animations.get(entity).clips;
+            if (pose.clipIndex < 0 || static_cast<std::size_t>(pose.clipIndex) >= clips.size() || !clips[pose.clipIndex]) {
+                continue;
+            }
+
+            SkinTask task;
+            task.model = model;
+            task.skin = skin;
+            task.clip = clips[pose.clipIndex].get();
+            task.pose = &pose;
+            task.state = &states.get(entity);
+            task.vertices = vertices.data();
+            m_tasks.push_back(task);
+        }
+
+        if (m_tasks.empty()) {
+            return;
+        }
+
+        JobSystem& jobSystem = JobSystem::Instance();
+        jobSystem.ParallelFor(m_tasks.size(), [this](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const SkinTask& task = m_tasks[i];
+                ComputePalette(*task.skin, task.clip, task.pose, *task.state);
+            }
+        }, 1);
+
+        // Вершины всех моделей режутся на куски одного размера: и одна большая модель,
+        // и много маленьких загружают все потоки.
+        m_chunks.clear();
+        for (std::size_t taskIndex = 0; taskIndex < m_tasks.size(); ++taskIndex) {
+            const std::size_t vertexCount = m_tasks[taskIndex].skin->influences.size();
+            for (std::size_t begin = 0; begin < vertexCount; begin += kVerticesPerChunk) {
+                m_chunks.push_back(VertexChunk{taskIndex, begin, std::min(vertexCount, begin + kVerticesPerChunk)});
+            }
+        }
+
+        jobSystem.ParallelFor(m_chunks.size(), [this](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const VertexChunk& chunk = m_chunks[i];
+                const SkinTask& task = m_tasks[chunk.task];
+                SkinVertices(*task.skin, task.state->palette.data(), chunk.begin, chunk.end, task.vertices);
+            }
+        }, 1);
+
+        for (const SkinTask& task : m_tasks) {
+            task.model->UpdateGpuData();
+            task.state->skinned = true;
+        }
+    }
+
+    void SkinningSystem::ComputePalette(const SkinData& skin, const AnimationClip* clip, const AnimationPoseComponent* pose, SkinningStateComponent& state) {
+        const std::size_t jointCount = skin.joints.size();
+        const int clipIndex = pose && clip ? pose->clipIndex : -1;
+        if (state.clipIndex != clipIndex || state.jointTracks.size() != jointCount) {
+            // Соответствие суставов трекам строится по имени узла один раз на клип.
+            std::unordered_map<std::string, int> trackIndices;
+            if (clip) {
+                for (std::size_t track = 0; track < clip->tracks.size(); ++track) {
+                    trackIndices.emplace(clip->tracks[track].nodeName, static_cast<int>(track));
+                }
+            }
+            state.jointTracks.assign(jointCount, -1);
+            for (std::size_t joint = 0; joint < jointCount; ++joint) {
+                const auto it = trackIndices.find(skin.joints[joint].name);
+                if (it != trackIndices.end()) {
+                    state.jointTracks[joint] = it->second;
+                }
+            }
+            state.clipIndex = clipIndex;
+        }
+
+        state.jointGlobals.resize(jointCount);
+        for (std::size_t joint = 0; joint < jointCount; ++joint) {
+            const int track = state.jointTracks[joint];
+            const glm::mat4 local = pose && track >= 0
+                ? AnimationSampler::ComposePoseMatrix(*pose, track)
+                : skin.joints[joint].bindLocal;
+            const int parent = skin.joints[joint].parent;
+            state.jointGlobals[joint] = parent >= 0 ? state.jointGlobals[parent] * local : local;
+        }
+
+        const std::size_t boneCount = skin.boneJoints.size();
+        state.palette.resize(boneCount);
+        for (std::size_t bone = 0; bone < boneCount; ++bone) {
+            const int joint = skin.boneJoints[bone];
+            state.palette[bone] = joint >= 0
+                ? skin.rootInverse * state.jointGlobals[joint] * skin.inverseBindMatrices[bone]
+                : glm::mat4(1.0f);
+        }
+    }
+
+    void SkinningSystem::SkinVertices(const SkinData& skin, const glm::mat4* palette, std::size_t begin, std::size_t end, float* outVertices) {
+        const float* bindVertices = skin.bindVertices.data();
+#ifdef OGLE_SKINNING_SSE
+        const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+        for (std::size_t vertex = begin; vertex < end; ++vertex) {
+            const SkinInfluence& influence = skin.influences[vertex];
+            const float* source = bindVertices + vertex * kVertexStride;
+            float* target = outVertices + vertex * kVertexStride;
+
+            // Смешанная матрица: сумма палитр костей с весами, по столбцам (glm хранит матрицы по столбцам).
+            __m128 column0 = _mm_setzero_ps();
+            __m128 column1 = _mm_setzero_ps();
+            __m128 column2 = _mm_setzero_ps();
+            __m128 column3 = _mm_setzero_ps();
+            for (int i = 0; i < 4; ++i) {
+                const float weight = influence.weights[i];
+                if (weight == 0.0f) {
+                    continue;
+                }
+                const float* matrix = &palette[influence.bones[i]][0][0];
+                const __m128 w = _mm_set1_ps(weight);
+                column0 = _mm_add_ps(column0, _mm_mul_ps(_mm_loadu_ps(matrix), w));
+                column1 = _mm_add_ps(column1, _mm_mul_ps(_mm_loadu_ps(matrix + 4), w));
+                column2 = _mm_add_ps(column2, _mm_mul_ps(_mm_loadu_ps(matrix + 8), w));
+                column3 = _mm_add_ps(column3, _mm_mul_ps(_mm_loadu_ps(matrix + 12), w));
+            }
+
+            const __m128 position = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(column0, _mm_set1_ps(source[0])), _mm_mul_ps(column1, _mm_set1_ps(source[1]))),
+                _mm_add_ps(_mm_mul_ps(column2, _mm_set1_ps(source[2])), column3));
+            __m128 normal = _mm_and_ps(_mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(column0, _mm_set1_ps(source[3])), _mm_mul_ps(column1, _mm_set1_ps(source[4]))),
+                _mm_mul_ps(column2, _mm_set1_ps(source[5]))), xyzMask);
+
+            __m128 lengthSquared = _mm_mul_ps(normal, normal);
+            lengthSquared = _mm_add_ps(lengthSquared, _mm_shuffle_ps(lengthSquared, lengthSquared, _MM_SHUFFLE(2, 3, 0, 1)));
+            lengthSquared = _mm_add_ps(lengthSquared, _mm_shuffle_ps(lengthSquared, lengthSquared, _MM_SHUFFLE(1, 0, 3, 2)));
+            if (_mm_cvtss_f32(lengthSquared) > 0.0f) {
+                normal = _mm_div_ps(normal, _mm_sqrt_ps(lengthSquared));
+            }
+
+            // Запись по 4 float перекрывает соседнее поле вершины; UV пишутся последними.
+            const float u = source[6];
+            const float v = source[7];
+            _mm_storeu_ps(target, position);
+            _mm_storeu_ps(target + 3, normal);
+            target[6] = u;
+            target[7] = v;
+        }
+#else
+        for (std::size_t vertex = begin; vertex < end; ++vertex) {
+            const SkinInfluence& influence = skin.influences[vertex];
+            const float* source = bindVertices + vertex * kVertexStride;
+            float* target = outVertices + vertex * kVertexStride;
+
+            glm::mat4 blended(0.0f);
+            for (int i = 0; i < 4; ++i) {
+                if (influence.weights[i] != 0.0f) {
+                    blended += palette[influence.bones[i]] * influence.weights[i];
+                }
+            }
+
+            const glm::vec4 position = blended * glm::vec4(source[0], source[1], source[2], 1.0f);
+            glm::vec3 normal = glm::vec3(blended * glm::vec4(source[3], source[4], source[5], 0.0f));
+            const float length = glm::length(normal);
+            if (length > 0.0f) {
+                normal /= length;
+            }
+
+            target[0] = position.x;
+            target[1] = position.y;
+            target[2] = position.z;
+            target[3] = normal.x;
+            target[4] = normal.y;
+            target[5] = normal.z;
+            target[6] = source[6];
+            target[7] = source[7];
+        }
+#endif
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include "world/WorldComponents.h"
+#include "models/SkinData.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace OGLE {
+    class ModelEntity;
+
+    // CPU-скиннинг (linear blend skinning) анимированных моделей со скелетом.
+    // Палитры костей считаются параллельно по сущностям, вершины — параллельно
+    // кусками по всем моделям сразу; загрузка в GPU идёт в вызывающем (главном) потоке.
+    class SkinningSystem {
+    public:
+        explicit SkinningSystem(entt::basic_registry<>& registry);
+        ~SkinningSystem();
+
+        // Скинирует модели, поза которых изменилась в этом кадре, и обновляет их вершинные буферы.
+        void Update();
+
+        // Матрицы суставов и палитра костей для позы (nullptr — bind-поза).
+        static void ComputePalette(const SkinData& skin, const AnimationClip* clip, const AnimationPoseComponent* pose, SkinningStateComponent& state);
+        // Скинирует вершины [begin, end) из bind-позы в outVertices (та же раскладка, 8 float на вершину).
+        static void SkinVertices(const SkinData& skin, const glm::mat4* palette, std::size_t begin, std::size_t end, float* outVertices);
+
+    private:
+        struct SkinTask {
+            ModelEntity* model = nullptr;
+            const SkinData* skin = nullptr;
+            const AnimationClip* clip = nullptr;
+            const AnimationPoseComponent* pose = nullptr;
+            SkinningStateComponent* state = nullptr;
+            float* vertices = nullptr; // Свои вершины модели; берутся в главном потоке после DetachMesh
+        };
+
+        struct VertexChunk {
+            std::size_t task = 0;
+            std::size_t begin = 0;
+            std::size_t end = 0;
+        };
+
+        void OnSkeletonConstructed(entt::basic_registry<>& registry, entt::entity entity);
+        void OnSkeletonDestroyed(entt::basic_registry<>& registry, entt::entity entity);
+
+        entt::basic_registry<>& m_registry;
+        std::vector<SkinTask> m_tasks;
+        std::vector<VertexChunk> m_chunks;
+    };
+}
@@ -1,32 +1,415 @@
 #include "TransformSystem.h"
 #include "models/ModelEntity.h"
+#include "Logger.h"
+#include "core/JobSystem.h"
+#include "AnimationSampler.h"
+#include "BoundsSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <glm/trigonometric.hpp>
 
 namespace OGLE {
-    TransformSystem::TransformSystem(entt::basic_registry<>& registry) : m_registry(registry) {}
+    TransformSystem::TransformSystem(entt::basic_registry<>& registry) : m_registry(registry) {
+        m_registry.on_construct<TransformComponent>().connect<&TransformSystem::OnTransformConstructed>(*this);
+        m_registry.on_update<TransformComponent>().connect<&TransformSystem::OnTransformChanged>(*this);
+        m_registry.on_construct<ModelComponent>().connect<&TransformSystem::OnModelConstructed>(*this);
+        m_registry.on_update<ModelComponent>().connect<&TransformSystem::OnTransformChanged>(*this);
+        m_registry.on_destroy<ModelComponent>().connect<&TransformSystem::OnModelDestroyed>(*this);
+        m_registry.on_destroy<HierarchyComponent>().connect<&TransformSystem::OnHierarchyDestroyed>(*this);
+    }
+
+    TransformSystem::~TransformSystem() {
+        m_registry.on_construct<TransformComponent>().disconnect(this);
+        m_registry.on_update<TransformComponent>().disconnect(this);
+        m_registry.on_construct<ModelComponent>().disconnect(this);
+        m_registry.on_update<ModelComponent>().disconnect(this);
+        m_registry.on_destroy<ModelComponent>().disconnect(this);
+        m_registry.on_destroy<HierarchyComponent>().disconnect(this);
+    }
+
+    void TransformSystem::OnTransformConstructed(entt::basic_registry<>& registry, Entity entity) {
+        registry.get_or_emplace<WorldMatrixComponent>(entity);
+        MarkDirty(entity);
+    }
+
+    void TransformSystem::OnTransformChanged(entt::basic_registry<>& registry, Entity entity) {
+        (void)registry;
+        MarkDirty(entity);
+    }
+
+    void TransformSystem::OnModelConstructed(entt::basic_registry<>& registry, Entity entity) {
+        // Компонент создаётся здесь, чтобы BoundsSystem::Update не менял структуру реестра.
+        registry.get_or_emplace<WorldBoundsComponent>(entity);
+        MarkDirty(entity);
+    }
+
+    void TransformSystem::OnModelDestroyed(entt::basic_registry<>& registry, Entity entity) {
+        registry.remove<WorldBoundsComponent>(entity);
+    }
+
+    void TransformSystem::OnHierarchyDestroyed(entt::basic_registry<>& registry, Entity entity) {
+        (void)registry;
+        (void)entity;
+        // Удаление из хранилища переставляет последний узел на место удалённого
+        // (в том числе при registry.destroy корня) — порядок по глубине нарушен.
+        m_hierarchyOrderDirty = true;
+    }
+
+    void TransformSystem::MarkDirty(Entity entity) {
+        if (!m_registry.valid(entity) || !m_registry.all_of<TransformComponent>(entity)) {
+            return;
+        }
+
+        if (!m_registry.all_of<TransformDirtyTag>(entity)) {
+            m_registry.emplace<TransformDirtyTag>(entity);
+        }
+    }
+
+    glm::mat4 TransformSystem::ComposeMatrix(const TransformComponent& transform) {
+        // То же, что translate * rotate(X) * rotate(Y) * rotate(Z) * scale,
+        // но без четырёх перемножений матриц 4x4.
+        const float rx = glm::radians(transform.rotation.x);
+        const float ry = glm::radians(transform.rotation.y);
+        const float rz = glm::radians(transform.rotation.z);
+        const float cx = std::cos(rx), sx = std::sin(rx);
+        const float cy = std::cos(ry), sy = std::sin(ry);
+        const float cz = std::cos(rz), sz = std::sin(rz);
+        const glm::vec3& s = transform.scale;
+
+        glm::mat4 matrix(1.0f);
+        matrix[0] = glm::vec4(cy * cz, cx * sz + sx * sy * cz, sx * sz - cx * sy * cz, 0.0f) * s.x;
+        matrix[1] = glm::vec4(-cy * sz, cx * cz - sx * sy * sz, sx * cz + cx * sy * sz, 0.0f) * s.y;
+        matrix[2] = glm::vec4(sy, -sx * cy, cx * cy, 0.0f) * s.z;
+        matrix[3] = glm::vec4(transform.position, 1.0f);
+        return matrix;
+    }
+
+    glm::vec3 TransformSystem::ExtractRotation(const glm::mat3& rotation) {
+        // Третий столбец ComposeMatrix — (sy, -sx*cy, cx*cy), первая строка — (cy*cz, -cy*sz, sy).
+        const float sy = std::clamp(rotation[2][0], -1.0f, 1.0f);
+        const float ry = std::asin(sy);
+        float rx = 0.0f;
+        float rz = 0.0f;
+        if (std::abs(sy) < 0.9999f) {
+            rx = std::atan2(-rotation[2][1], rotation[2][2]);
+            rz = std::atan2(-rotation[1][0], rotation[0][0]);
+        } else {
+            // cy == 0: X и Z вращают вокруг одной оси, весь поворот относится к X.
+            rx = std::atan2(rotation[1][2], rotation[1][1]);
+        }
+        return glm::degrees(glm::vec3(rx, ry, rz));
+    }
+
+    glm::mat4 TransformSystem::ComputeWorldMatrix(Entity entity, const TransformComponent& transform) const {
+        glm::mat4 local = ComposeMatrix(transform);
+        if (const auto* pose = m_registry.try_get<AnimationPoseComponent>(entity); pose && pose->rootTrack >= 0) {
+            local = local * AnimationSampler::ComposePoseMatrix(*pose, pose->rootTrack);
+        }
+        if (const auto* node = m_registry.try_get<HierarchyComponent>(entity); node && node->parent != entt::null) {
+            if (const auto* parentWorld = m_registry.try_get<WorldMatrixComponent>(node->parent)) {
+                return parentWorld->matrix * local;
+            }
+        }
+        return local;
+    }
+
+    void TransformSystem::ApplyWorldMatrix(Entity entity, const TransformComponent& transform) {
+        const glm::mat4 matrix = ComputeWorldMatrix(entity, transform);
+        m_registry.get_or_emplace<WorldMatrixComponent>(entity).matrix = matrix;
+
+        if (auto* model = m_registry.try_get<ModelComponent>(entity); model && model->model) {
+            model->model->SetWorldTransform(transform.position, transform.rotation, transform.scale, matrix);
+        }
+    }
 
     void TransformSystem::SyncModelTransform(Entity entity) {
-        if (!m_registry.all_of<TransformComponent, ModelComponent>(entity)) {
+        if (!m_registry.valid(entity) || !m_registry.all_of<TransformComponent>(entity)) {
             return;
         }
 
-        auto& transform = m_registry.get<TransformComponent>(entity);
-        auto& model = m_registry.get<ModelComponent>(entity);
-        if (!model.model) {
+        ApplyWorldMatrix(entity, m_registry.get<TransformComponent>(entity));
+        BoundsSystem::UpdateEntity(m_registry, entity);
+        m_registry.remove<TransformDirtyTag>(entity);
+
+        // Флаг снят, поэтому прямых потомков помечаем явно — дальше пойдёт обычная протяжка.
+        if (const auto* node = m_registry.try_get<HierarchyComponent>(entity)) {
+            for (Entity child = node->firstChild; child != entt::null;
+                 child = m_registry.get<HierarchyComponent>(child).nextSibling) {
+                MarkDirty(child);
+            }
+        }
+    }
+
+    void TransformSystem::SortHierarchyIfNeeded() {
+        if (!m_hierarchyOrderDirty) {
             return;
         }
 
-        model.model->SetPosition(transform.position);
-        model.model->SetRotation(transform.rotation);
-        model.model->SetScale(transform.scale);
+        // После сортировки обход хранилища идёт по возрастанию глубины:
+        // родитель всегда раньше потомков, протяжка укладывается в один линейный проход.
+        m_registry.sort<HierarchyComponent>([](const HierarchyComponent& lhs, const HierarchyComponent& rhs) {
+            return lhs.depth < rhs.depth;
+        });
+        m_hierarchyOrderDirty = false;
     }
 
-    void TransformSystem::SyncAllModels() {
-        auto view = m_registry.view<TransformComponent, ModelComponent, WorldObjectComponent>();
+    void TransformSystem::PropagateHierarchy(bool forceAll) {
+        SortHierarchyIfNeeded();
+
+        auto view = m_registry.view<HierarchyComponent>();
         for (auto entity : view) {
-            const auto& object = view.get<WorldObjectComponent>(entity);
-            if (object.enabled) {
-                SyncModelTransform(entity);
+            const auto& node = view.get<HierarchyComponent>(entity);
+            auto* transform = m_registry.try_get<TransformComponent>(entity);
+            if (!transform) {
+                continue;
+            }
+
+            bool dirty = forceAll || m_registry.all_of<TransformDirtyTag>(entity);
+            if (!dirty && node.parent != entt::null && m_registry.all_of<TransformDirtyTag>(node.parent)) {
+                // Родитель пересчитан в этом кадре — поддерево тоже грязное.
+                m_registry.emplace<TransformDirtyTag>(entity);
+                dirty = true;
+            }
+
+            if (dirty) {
+                ApplyWorldMatrix(entity, *transform);
+            }
+        }
+    }
+
+    void TransformSystem::UpdateFlatTransforms(const entt::sparse_set& candidates) {
+        const auto& transforms = m_registry.storage<TransformComponent>();
+        const auto& hierarchy = m_registry.storage<HierarchyComponent>();
+        auto& worldMatrices = m_registry.storage<WorldMatrixComponent>();
+        const auto& poses = m_registry.storage<AnimationPoseComponent>();
+
+        // Сущности без иерархии независимы друг от друга: матрицы считаются параллельно,
+        // структура реестра при этом не меняется (WorldMatrixComponent создаётся вместе с трансформом).
+        JobSystem::Instance().ParallelForEach(candidates, [&](Entity entity) {
+            if (!transforms.contains(entity) || hierarchy.contains(entity)) {
+                return;
+            }
+            glm::mat4 matrix = ComposeMatrix(transforms.get(entity));
+            if (poses.contains(entity)) {
+                const auto& pose = poses.get(entity);
+                if (pose.rootTrack >= 0) {
+                    matrix = matrix * AnimationSampler::ComposePoseMatrix(pose, pose.rootTrack);
+                }
+            }
+            worldMatrices.get(entity).matrix = matrix;
+        }, JobSystem::ChunkSizeFor(sizeof(TransformComponent) + sizeof(WorldMatrixComponent)));
+
+        // ModelEntity может быть общим у нескольких сущностей, поэтому в модели пишем последовательно.
+        auto& models = m_registry.storage<ModelComponent>();
+        const entt::sparse_set& smaller = models.size() < candidates.size()
+            ? static_cast<const entt::sparse_set&>(models)
+            : candidates;
+        for (const Entity entity : smaller) {
+            if (!candidates.contains(entity) || !models.contains(entity) ||
+                !transforms.contains(entity) || hierarchy.contains(entity)) {
+                continue;
+            }
+
+            const auto& model = models.get(entity).model;
+            if (model) {
+                const auto& transform = transforms.get(entity);
+                model->SetWorldTransform(transform.position, transform.rotation, transform.scale, worldMatrices.get(entity).matrix);
+            }
+        }
+    }
+
+    void TransformSystem::MarkChangedModelBounds() {
+        const std::uint64_t latest = BaseModel::GetLatestBoundsRevision();
+        if (latest == m_boundsRevision) {
+            return;
+        }
+        m_boundsRevision = latest;
+        m_staleBounds.clear();
+        BoundsSystem::CollectStale(m_registry, m_staleBounds);
+        for (const Entity entity : m_staleBounds) {
+            MarkDirty(entity);
+        }
+    }
+
+    void TransformSystem::UpdateDirtyTransforms() {
+        MarkChangedModelBounds();
+
+        // Анимированный корневой узел меняет локальную матрицу без правки TransformComponent.
+        auto& poses = m_registry.storage<AnimationPoseComponent>();
+        for (const Entity entity : poses) {
+            auto& pose = poses.get(entity);
+            if (pose.changed && pose.rootTrack >= 0) {
+                MarkDirty(entity);
+            }
+            pose.changed = false;
+        }
+
+        m_lastUpdatedCount = m_registry.storage<TransformDirtyTag>().size();
+        if (m_lastUpdatedCount == 0) {
+            SortHierarchyIfNeeded();
+            return;
+        }
+
+        UpdateFlatTransforms(m_registry.storage<TransformDirtyTag>());
+        PropagateHierarchy(false);
+        // После протяжки тег стоит и на пересчитанных потомках.
+        BoundsSystem::Update(m_registry, m_registry.storage<TransformDirtyTag>());
+
+        m_lastUpdatedCount = m_registry.storage<TransformDirtyTag>().size();
+        m_registry.clear<TransformDirtyTag>();
+    }
+
+    void TransformSystem::SyncAllModels() {
+        UpdateFlatTransforms(m_registry.storage<TransformComponent>());
+        PropagateHierarchy(true);
+        BoundsSystem::Update(m_registry, m_registry.storage<TransformComponent>());
+
+        m_lastUpdatedCount = m_registry.storage<TransformComponent>().size();
+        m_registry.clear<TransformDirtyTag>();
+    }
+
+    Entity TransformSystem::GetParent(Entity entity) const {
+        if (!m_registry.valid(entity)) {
+            return entt::null;
+        }
+
+        const auto* node = m_registry.try_get<HierarchyComponent>(entity);
+        return node ? node->parent : entt::null;
+    }
+
+    bool TransformSystem::SetParent(Entity child, Entity parent) {
+        if (!m_registry.valid(child) || (parent != entt::null && !m_registry.valid(parent)) || child == parent) {
+            return false;
+        }
+
+        if (GetParent(child) == parent) {
+            return true;
+        }
+
+        // Нельзя сделать сущность потомком её собственного потомка.
+        for (Entity ancestor = parent; ancestor != entt::null; ancestor = GetParent(ancestor)) {
+            if (ancestor == child) {
+                LOG_WARN("SetParent rejected: would create a cycle in the transform hierarchy");
+                return false;
+            }
+        }
+
+        Unlink(child);
+
+        if (parent != entt::null) {
+            m_registry.get_or_emplace<HierarchyComponent>(child);
+            auto& parentNode = m_registry.get_or_emplace<HierarchyComponent>(parent);
+            const Entity oldFirstChild = parentNode.firstChild;
+            parentNode.firstChild = child;
+            ++parentNode.childCount;
+
+            auto& childNode = m_registry.get<HierarchyComponent>(child);
+            childNode.parent = parent;
+            childNode.prevSibling = entt::null;
+            childNode.nextSibling = oldFirstChild;
+            if (oldFirstChild != entt::null) {
+                m_registry.get<HierarchyComponent>(oldFirstChild).prevSibling = child;
+            }
+        }
+
+        if (m_registry.all_of<HierarchyComponent>(child)) {
+            UpdateSubtreeDepth(child);
+        }
+        PruneNode(child);
+
+        m_hierarchyOrderDirty = true;
+        MarkDirty(child);
+        return true;
+    }
+
+    void TransformSystem::Unlink(Entity entity) {
+        auto* node = m_registry.try_get<HierarchyComponent>(entity);
+        if (!node || node->parent == entt::null) {
+            return;
+        }
+
+        const Entity parent = node->parent;
+        const Entity prev = node->prevSibling;
+        const Entity next = node->nextSibling;
+        node->parent = entt::null;
+        node->prevSibling = entt::null;
+        node->nextSibling = entt::null;
+
+        if (prev != entt::null) {
+            m_registry.get<HierarchyComponent>(prev).nextSibling = next;
+        }
+        if (next != entt::null) {
+            m_registry.get<HierarchyComponent>(next).prevSibling = prev;
+        }
+
+        if (m_registry.valid(parent)) {
+            auto& parentNode = m_registry.get<HierarchyComponent>(parent);
+            if (parentNode.firstChild == entity) {
+                parentNode.firstChild = next;
+            }
+            --parentNode.childCount;
+            PruneNode(parent);
+        }
+
+        m_hierarchyOrderDirty = true;
+    }
+
+    void TransformSystem::UpdateSubtreeDepth(Entity root) {
+        m_traversalStack.clear();
+        m_traversalStack.push_back(root);
+
+        while (!m_traversalStack.empty()) {
+            const Entity entity = m_traversalStack.back();
+            m_traversalStack.pop_back();
+
+            auto& node = m_registry.get<HierarchyComponent>(entity);
+            node.depth = node.parent != entt::null ? m_registry.get<HierarchyComponent>(node.parent).depth + 1 : 0;
+
+            for (Entity child = node.firstChild; child != entt::null;
+                 child = m_registry.get<HierarchyComponent>(child).nextSibling) {
+                m_traversalStack.push_back(child);
+            }
+        }
+    }
+
+    void TransformSystem::PruneNode(Entity entity) {
+        // Узел без родителя и потомков больше не участвует в иерархии —
+        // убираем компонент, чтобы он шёл по быстрому плоскому пути.
+        const auto* node = m_registry.try_get<HierarchyComponent>(entity);
+        if (node && node->parent == entt::null && node->firstChild == entt::null) {
+            m_registry.remove<HierarchyComponent>(entity);
+            m_hierarchyOrderDirty = true;
+            MarkDirty(entity);
+        }
+    }
+
+    void TransformSystem::CollectDescendants(Entity entity, std::vector<Entity>& descendants) const {
+        const auto* rootNode = m_registry.try_get<HierarchyComponent>(entity);
+        if (!rootNode) {
+            return;
+        }
+
+        const std::size_t begin = descendants.size();
+        std::vector<Entity> stack;
+        for (Entity child = rootNode->firstChild; child != entt::null;
+             child = m_registry.get<HierarchyComponent>(child).nextSibling) {
+            stack.push_back(child);
+        }
+
+        while (!stack.empty()) {
+            const Entity current = stack.back();
+            stack.pop_back();
+            descendants.push_back(current);
+
+            const auto& node = m_registry.get<HierarchyComponent>(current);
+            for (Entity child = node.firstChild; child != entt::null;
+                 child = m_registry.get<HierarchyComponent>(child).nextSibling) {
+                stack.push_back(child);
             }
         }
+
+        // Обход даёт порядок от корня к листьям; разворачиваем, чтобы листья шли первыми.
+        std::reverse(descendants.begin() + static_cast<std::ptrdiff_t>(begin), descendants.end());
     }
-}
\ No newline at end of file
+}
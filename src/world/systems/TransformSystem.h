@@ -1,14 +1,68 @@
 #pragma once
 #include "world/WorldComponents.h"
 #include <entt/entt.hpp>
+#include <glm/mat3x3.hpp>
+#include <glm/mat4x4.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 namespace OGLE {
     class TransformSystem {
     public:
         explicit TransformSystem(entt::basic_registry<>& registry);
+        ~TransformSystem();
+
+        // Помечает трансформ сущности как изменённый; матрица будет пересчитана в UpdateDirtyTransforms.
+        void MarkDirty(Entity entity);
+        // Немедленно пересчитывает матрицу одной сущности и снимает с неё флаг.
         void SyncModelTransform(Entity entity);
+        // Пересчитывает только помеченные сущности и их поддеревья (один раз за кадр),
+        // вместе с их WorldBoundsComponent. Сущности, у моделей которых сменились
+        // границы (SetMeshData, UpdateGeometry, ShareMesh), помечаются здесь же.
+        void UpdateDirtyTransforms();
+        // Принудительно пересчитывает все сущности (например, после загрузки сцены).
         void SyncAllModels();
+
+        // Иерархия. parent == entt::null отсоединяет сущность. Локальный трансформ
+        // потомка сохраняется (мировая позиция меняется вместе с родителем).
+        bool SetParent(Entity child, Entity parent);
+        Entity GetParent(Entity entity) const;
+        // Собирает поддерево (без самой сущности) в порядке от листьев к корню.
+        void CollectDescendants(Entity entity, std::vector<Entity>& descendants) const;
+
+        std::size_t GetLastUpdatedCount() const { return m_lastUpdatedCount; }
+
+        static glm::mat4 ComposeMatrix(const TransformComponent& transform);
+        // Обратное к ComposeMatrix для поворота без масштаба: углы X, Y, Z в градусах.
+        static glm::vec3 ExtractRotation(const glm::mat3& rotation);
+
     private:
+        void OnTransformConstructed(entt::basic_registry<>& registry, Entity entity);
+        void OnTransformChanged(entt::basic_registry<>& registry, Entity entity);
+        void OnModelConstructed(entt::basic_registry<>& registry, Entity entity);
+        void OnModelDestroyed(entt::basic_registry<>& registry, Entity entity);
+        void OnHierarchyDestroyed(entt::basic_registry<>& registry, Entity entity);
+
+        glm::mat4 ComputeWorldMatrix(Entity entity, const TransformComponent& transform) const;
+        void ApplyWorldMatrix(Entity entity, const TransformComponent& transform);
+        // Пересчёт сущностей вне иерархии из набора candidates (грязные или все).
+        void UpdateFlatTransforms(const entt::sparse_set& candidates);
+        // Помечает сущности с устаревшими границами модели. Реестр обходится,
+        // только если с прошлого вызова границы какой-то модели менялись.
+        void MarkChangedModelBounds();
+
+        void Unlink(Entity entity);
+        void UpdateSubtreeDepth(Entity root);
+        void PruneNode(Entity entity);
+        void SortHierarchyIfNeeded();
+        void PropagateHierarchy(bool forceAll);
+
         entt::basic_registry<>& m_registry;
+        std::vector<Entity> m_traversalStack;
+        std::size_t m_lastUpdatedCount = 0;
+        bool m_hierarchyOrderDirty = false;
+        std::uint64_t m_boundsRevision = 0; // BaseModel::GetLatestBoundsRevision на прошлой проверке
+        std::vector<Entity> m_staleBounds;
     };
-}
\ No newline at end of file
+}